@@ -0,0 +1,106 @@
+#include "CacheHierarchy.hpp"
+#include "pch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+
+namespace BPlotter
+{
+
+namespace
+{
+
+std::string sizeLabel(const double bytes)
+{
+    if (bytes >= 1024.0 * 1024.0)
+    {
+        return fmt::format("{:g} MiB", bytes / (1024.0 * 1024.0));
+    }
+    if (bytes >= 1024.0)
+    {
+        return fmt::format("{:g} KiB", bytes / 1024.0);
+    }
+    return fmt::format("{:g} B", bytes);
+}
+
+}// namespace
+
+std::vector<CacheBoundary> cacheBoundaries(const BenchmarkContext& context)
+{
+    std::vector<CacheBoundary> boundaries;
+    for (const auto& [type, level, size, numSharing]: context.caches)
+    {
+        if (type == "Instruction" || size <= 0)
+        {
+            continue;
+        }
+
+        auto label = fmt::format("L{}{} {}", level, type == "Data" ? "d" : "", sizeLabel(size));
+        if (numSharing > 1)
+        {
+            label += fmt::format(" (shared by {})", numSharing);
+        }
+        boundaries.push_back({level, size, std::move(label)});
+    }
+    std::ranges::sort(boundaries, {}, &CacheBoundary::bytes);
+    return boundaries;
+}
+
+std::vector<CacheKnee> detectCacheKnees(const Series& series,
+                                        const std::span<const CacheBoundary> boundaries,
+                                        const double minimalSlopeIncrease, const double window)
+{
+    // Log-log coordinates of the points that can be placed on such a plot
+    struct LogPoint
+    {
+        double x;
+        double y;
+        std::size_t index;
+    };
+    std::vector<LogPoint> points;
+    for (std::size_t i = 0; i < series.x.size(); ++i)
+    {
+        if (series.x[i] > 0 && series.y[i] > 0)
+        {
+            points.push_back({std::log(series.x[i]), std::log(series.y[i]), i});
+        }
+    }
+
+    const auto slope = [&points](const std::size_t from, const std::size_t to)
+    {
+        return (points[to].y - points[from].y) / (points[to].x - points[from].x);
+    };
+
+    std::vector<CacheKnee> knees;
+    for (std::size_t boundary = 0; boundary < boundaries.size(); ++boundary)
+    {
+        const auto low = std::log(boundaries[boundary].bytes / window);
+        const auto high = std::log(boundaries[boundary].bytes * window);
+
+        std::optional<CacheKnee> best;
+        for (std::size_t i = 1; i + 1 < points.size(); ++i)
+        {
+            if (points[i].x < low || points[i].x > high || points[i - 1].x == points[i].x ||
+                points[i].x == points[i + 1].x)
+            {
+                continue;
+            }
+
+            const auto increase = slope(i, i + 1) - slope(i - 1, i);
+            if (increase >= minimalSlopeIncrease && (not best || increase > best->slopeIncrease))
+            {
+                const auto index = points[i].index;
+                best = CacheKnee{series.x[index], series.y[index], boundary, increase};
+            }
+        }
+
+        if (best)
+        {
+            knees.push_back(*best);
+        }
+    }
+    return knees;
+}
+
+}// namespace BPlotter
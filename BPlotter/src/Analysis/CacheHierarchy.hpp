@@ -0,0 +1,69 @@
+#pragma once
+
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Benchmark/BenchmarkResults.hpp"
+#include "Plot/Series.hpp"
+
+namespace BPlotter
+{
+
+/**
+ * \brief Working set size at which the data stops fitting into a cache level.
+ */
+struct CacheBoundary
+{
+    int level = 0;
+    double bytes = 0;
+
+    /**
+     * \brief Short description of the cache, e.g. "L1d 32 KiB".
+     */
+    std::string label;
+};
+
+/**
+ * \brief Point of a series where its growth speeds up noticeably, close to a cache boundary.
+ */
+struct CacheKnee
+{
+    double x = 0;
+    double y = 0;
+
+    /**
+     * \brief Index of the boundary the knee was found next to.
+     */
+    std::size_t boundary = 0;
+
+    /**
+     * \brief How much the log-log slope of the series increases at this point.
+     */
+    double slopeIncrease = 0;
+};
+
+/**
+ * \brief Lists the data cache levels of the machine, ordered from the smallest.
+ * \param context Context of the run, containing the description of the caches
+ * \return Boundaries of the data and unified caches. Instruction caches are skipped.
+ */
+std::vector<CacheBoundary> cacheBoundaries(const BenchmarkContext& context);
+
+/**
+ * \brief Looks for the knees of the series near the cache boundaries.
+ * \param series Series with the working set sizes (in bytes) on the X axis, sorted by x
+ * \param boundaries Cache boundaries, in bytes
+ * \param minimalSlopeIncrease Minimal increase of the log-log slope that counts as a knee
+ * \param window Knees are searched for between boundary / window and boundary * window
+ * \return At most one knee per boundary
+ *
+ * A working set that no longer fits into a cache usually makes the time grow faster than
+ * before. This is visible as a sudden increase of the slope of the series on the log-log
+ * plot, which is what this function looks for.
+ */
+std::vector<CacheKnee> detectCacheKnees(const Series& series,
+                                        std::span<const CacheBoundary> boundaries,
+                                        double minimalSlopeIncrease = 0.25, double window = 4);
+
+}// namespace BPlotter
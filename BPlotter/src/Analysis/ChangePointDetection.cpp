@@ -0,0 +1,212 @@
+#include "ChangePointDetection.hpp"
+#include "pch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Memory/AllocationTracker.hpp"
+
+namespace BPlotter
+{
+
+namespace
+{
+
+/**
+ * \brief Median of the absolute differences of consecutive values of the normal distribution
+ * is 0.6745 * sqrt(2) of its standard deviation.
+ */
+constexpr auto MEDIAN_DIFFERENCE_TO_SIGMA = 1.0 / (0.6745 * 1.4142135623730951);
+
+/**
+ * \brief Number of benchmarks analyzed by a single task, to keep the tasks cheap compared
+ * to the detection.
+ */
+constexpr std::size_t BENCHMARKS_PER_TASK = 16;
+
+struct Runs
+{
+    std::vector<std::int64_t> timestamps;
+    std::vector<double> means;
+
+    /**
+     * \brief Standard error of the mean of a run.
+     */
+    double sigma = 0;
+};
+
+Runs groupRuns(const std::span<const HistoryPoint> points)
+{
+    Runs runs;
+    auto squaredDeviations = 0.0;
+    auto degreesOfFreedom = std::size_t{0};
+    for (auto first = points.begin(); first != points.end();)
+    {
+        auto last = first;
+        auto sum = 0.0;
+        while (last != points.end() && last->timestamp == first->timestamp)
+        {
+            sum += last->value;
+            ++last;
+        }
+        const auto count = static_cast<std::size_t>(last - first);
+        const auto mean = sum / static_cast<double>(count);
+        for (auto point = first; point != last; ++point)
+        {
+            squaredDeviations += (point->value - mean) * (point->value - mean);
+        }
+        degreesOfFreedom += count - 1;
+        runs.timestamps.push_back(first->timestamp);
+        runs.means.push_back(mean);
+        first = last;
+    }
+
+    const auto runCount = runs.means.size();
+    auto withinSigma = 0.0;
+    if (degreesOfFreedom > 0)
+    {
+        const auto repetitions = static_cast<double>(points.size()) / runCount;
+        withinSigma = std::sqrt(squaredDeviations / degreesOfFreedom / repetitions);
+    }
+
+    auto betweenSigma = 0.0;
+    if (runCount > 1)
+    {
+        std::vector<double> differences(runCount - 1);
+        for (std::size_t i = 1; i < runCount; ++i)
+        {
+            differences[i - 1] = std::abs(runs.means[i] - runs.means[i - 1]);
+        }
+        const auto middle = differences.begin() + differences.size() / 2;
+        std::ranges::nth_element(differences, middle);
+        betweenSigma = *middle * MEDIAN_DIFFERENCE_TO_SIGMA;
+    }
+
+    auto scale = 0.0;
+    for (const auto mean: runs.means)
+    {
+        scale = std::max(scale, std::abs(mean));
+    }
+    runs.sigma =
+        std::max({withinSigma, betweenSigma, scale * 1e-9, std::numeric_limits<double>::min()});
+    return runs;
+}
+
+}// namespace
+
+std::vector<ChangePoint> detectChangePoints(const std::span<const HistoryPoint> points,
+                                            const ChangePointOptions& options)
+{
+    if (points.empty())
+    {
+        return {};
+    }
+    const auto runs = groupRuns(points);
+    const auto runCount = runs.means.size();
+    const auto minimalSegment = std::max<std::size_t>(options.minimalSegmentRuns, 1);
+    if (runCount < 2 * minimalSegment)
+    {
+        return {};
+    }
+
+    std::vector<double> prefixSums(runCount + 1, 0.0);
+    for (std::size_t i = 0; i < runCount; ++i)
+    {
+        prefixSums[i + 1] = prefixSums[i] + runs.means[i];
+    }
+    const auto meanOf = [&prefixSums](const std::size_t begin, const std::size_t end)
+    {
+        return (prefixSums[end] - prefixSums[begin]) / static_cast<double>(end - begin);
+    };
+
+    std::vector<ChangePoint> changes;
+    std::vector<std::pair<std::size_t, std::size_t>> segments{{0, runCount}};
+    while (!segments.empty())
+    {
+        const auto [begin, end] = segments.back();
+        segments.pop_back();
+        if (end - begin < 2 * minimalSegment)
+        {
+            continue;
+        }
+
+        auto best = ChangePoint{};
+        for (auto split = begin + minimalSegment; split + minimalSegment <= end; ++split)
+        {
+            const auto before = meanOf(begin, split);
+            const auto after = meanOf(split, end);
+            const auto standardError =
+                runs.sigma * std::sqrt(1.0 / static_cast<double>(split - begin) +
+                                       1.0 / static_cast<double>(end - split));
+            const auto score = std::abs(after - before) / standardError;
+            if (score > best.score)
+            {
+                best = {split, runs.timestamps[split], before, after, 0, score};
+            }
+        }
+
+        const auto relativeChange = (best.after - best.before) / std::abs(best.before);
+        if (best.score >= options.minimalScore &&
+            !(std::abs(relativeChange) < options.minimalRelativeChange))
+        {
+            changes.push_back(best);
+            segments.emplace_back(begin, best.run);
+            segments.emplace_back(best.run, end);
+        }
+    }
+
+    // Levels are reported between the neighbouring change points, not the searched segments
+    std::ranges::sort(changes, {}, &ChangePoint::run);
+    for (std::size_t i = 0; i < changes.size(); ++i)
+    {
+        const auto previous = i == 0 ? 0 : changes[i - 1].run;
+        const auto next = i + 1 == changes.size() ? runCount : changes[i + 1].run;
+        auto& change = changes[i];
+        change.before = meanOf(previous, change.run);
+        change.after = meanOf(change.run, next);
+        change.relativeChange = (change.after - change.before) / std::abs(change.before);
+    }
+    return changes;
+}
+
+std::vector<Regression> detectRegressions(const HistoryStore& store, const std::string_view column,
+                                          const bool isHigherBetter, TaskScheduler& scheduler,
+                                          const ChangePointOptions& options,
+                                          const CancellationToken& token)
+{
+    AllocationScope scope(AllocationSubsystem::Statistics);
+    const auto histories = store.histories(column);
+
+    std::vector<std::vector<Regression>> regressionsOfTask(
+        (histories.size() + BENCHMARKS_PER_TASK - 1) / BENCHMARKS_PER_TASK);
+    scheduler.parallelFor(
+        histories.size(), BENCHMARKS_PER_TASK,
+        [&](const std::size_t begin, const std::size_t end)
+        {
+            auto& regressions = regressionsOfTask[begin / BENCHMARKS_PER_TASK];
+            for (auto id = begin; id < end; ++id)
+            {
+                for (const auto& change: detectChangePoints(histories[id], options))
+                {
+                    const auto worsening =
+                        isHigherBetter ? -change.relativeChange : change.relativeChange;
+                    if (worsening > 0)
+                    {
+                        regressions.push_back({static_cast<BenchmarkId>(id), change, worsening});
+                    }
+                }
+            }
+        },
+        TaskPriority::Background, token);
+
+    std::vector<Regression> regressions;
+    for (auto& found: regressionsOfTask)
+    {
+        regressions.insert(regressions.end(), found.begin(), found.end());
+    }
+    std::ranges::sort(regressions, std::ranges::greater(), &Regression::magnitude);
+    return regressions;
+}
+
+}// namespace BPlotter
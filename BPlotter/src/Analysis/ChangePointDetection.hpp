@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "History/HistoryStore.hpp"
+#include "Tasks/TaskScheduler.hpp"
+
+namespace BPlotter
+{
+
+/**
+ * \brief Parameters deciding which level shifts are reported.
+ */
+struct ChangePointOptions
+{
+    /**
+     * \brief Minimal difference of the means of the two segments, in standard errors.
+     */
+    double minimalScore = 5;
+
+    /**
+     * \brief Minimal relative difference of the means of the two segments.
+     */
+    double minimalRelativeChange = 0.02;
+
+    /**
+     * \brief Minimal number of runs on each side of a change point.
+     */
+    std::size_t minimalSegmentRuns = 3;
+};
+
+/**
+ * \brief Run at which the level of the benchmark shifted.
+ */
+struct ChangePoint
+{
+    /**
+     * \brief Index of the first run after the shift, among the runs of the benchmark.
+     */
+    std::size_t run = 0;
+    std::int64_t timestamp = 0;
+
+    /**
+     * \brief Mean value between the previous change point (or the first run) and this one.
+     */
+    double before = 0;
+
+    /**
+     * \brief Mean value between this change point and the next one (or the last run).
+     */
+    double after = 0;
+
+    /**
+     * \brief (after - before) / |before|
+     */
+    double relativeChange = 0;
+
+    /**
+     * \brief Difference of the means of the segments in standard errors.
+     */
+    double score = 0;
+};
+
+/**
+ * \brief Finds the runs at which the level of the series shifted.
+ *
+ * Repetitions of a run are reduced to their mean. The series is split by binary
+ * segmentation: the split maximizing the difference of the means of both parts (in standard
+ * errors) is kept if it is significant, and both parts are searched again. The noise is
+ * estimated from the spread of the repetitions and, robustly, from the differences of
+ * consecutive runs, whichever is larger.
+ *
+ * \param points History of a benchmark sorted by the timestamp
+ * \param options Parameters of the detection
+ * \return Change points sorted by the run
+ */
+std::vector<ChangePoint> detectChangePoints(std::span<const HistoryPoint> points,
+                                            const ChangePointOptions& options = {});
+
+/**
+ * \brief Level shift of a benchmark towards worse values.
+ */
+struct Regression
+{
+    BenchmarkId benchmark = 0;
+    ChangePoint change;
+
+    /**
+     * \brief Relative worsening, positive regardless of whether higher is better.
+     */
+    double magnitude = 0;
+};
+
+/**
+ * \brief Detects the regressions of all the benchmarks of the history, in parallel.
+ * \param store History of the runs
+ * \param column Name of the analyzed column
+ * \param isHigherBetter Whether higher values of the column are better (e.g. throughput)
+ * \param scheduler Scheduler analyzing the benchmarks
+ * \param options Parameters of the detection
+ * \param token Once cancelled, the benchmarks not analyzed yet are skipped
+ * \return Regressions sorted from the largest one
+ */
+std::vector<Regression> detectRegressions(const HistoryStore& store, std::string_view column,
+                                          bool isHigherBetter, TaskScheduler& scheduler,
+                                          const ChangePointOptions& options = {},
+                                          const CancellationToken& token = {});
+
+}// namespace BPlotter
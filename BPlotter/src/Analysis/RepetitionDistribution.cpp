@@ -0,0 +1,304 @@
+#include "RepetitionDistribution.hpp"
+#include "pch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <numeric>
+#include <unordered_map>
+
+#include "Memory/AllocationTracker.hpp"
+
+namespace BPlotter
+{
+
+namespace
+{
+
+/**
+ * \brief Number of benchmarks analyzed by a single task, below which tasks do not pay off.
+ */
+constexpr auto BENCHMARKS_PER_TASK = std::size_t{16};
+
+/**
+ * \brief The kernel is cut off this many bandwidths from its center, where it is below 0.04 %
+ * of its peak. The grid reaches as far beyond the extreme samples.
+ */
+constexpr auto KERNEL_REACH = 4.0;
+constexpr auto GRID_MARGIN = 3.0;
+
+/**
+ * \brief Most bins of a histogram, which would be mostly empty beyond that.
+ */
+constexpr auto MAX_HISTOGRAM_BINS = std::size_t{64};
+
+/**
+ * \brief Two peaks are separate if the density between them falls below this fraction of the
+ * lower one.
+ */
+constexpr auto MODE_VALLEY = 0.8;
+
+double quantile(const std::span<const double> sortedSamples, const double fraction)
+{
+    const auto position = fraction * static_cast<double>(sortedSamples.size() - 1);
+    const auto lower = static_cast<std::size_t>(position);
+    const auto upper = std::min(lower + 1, sortedSamples.size() - 1);
+    const auto weight = position - static_cast<double>(lower);
+    return sortedSamples[lower] + (sortedSamples[upper] - sortedSamples[lower]) * weight;
+}
+
+double meanOf(const std::span<const double> samples)
+{
+    return std::accumulate(samples.begin(), samples.end(), 0.0) /
+           static_cast<double>(samples.size());
+}
+
+double standardDeviationOf(const std::span<const double> samples, const double mean)
+{
+    if (samples.size() < 2)
+    {
+        return 0;
+    }
+    auto sum = 0.0;
+    for (const auto value: samples)
+    {
+        sum += (value - mean) * (value - mean);
+    }
+    return std::sqrt(sum / static_cast<double>(samples.size() - 1));
+}
+
+/**
+ * \brief Silverman's rule of thumb, robust to the outliers thanks to the interquartile range.
+ */
+double silvermanBandwidth(const std::span<const double> sortedSamples)
+{
+    const auto mean = meanOf(sortedSamples);
+    const auto deviation = standardDeviationOf(sortedSamples, mean);
+    const auto interquartile = (quantile(sortedSamples, 0.75) - quantile(sortedSamples, 0.25));
+    auto spread = std::min(deviation, interquartile / 1.34);
+    // Most repetitions may be equal, or all of them
+    if (spread <= 0)
+    {
+        spread = std::max(deviation, interquartile / 1.34);
+    }
+    if (spread <= 0)
+    {
+        spread = std::abs(mean) > 0 ? std::abs(mean) * 0.01 : 1;
+    }
+    return 0.9 * spread * std::pow(static_cast<double>(sortedSamples.size()), -0.2);
+}
+
+Histogram histogramOf(const std::span<const double> sortedSamples)
+{
+    // Rice's rule, which suits the tens to hundreds of repetitions better than Sturges' one
+    const auto bins = std::clamp<std::size_t>(
+        static_cast<std::size_t>(std::ceil(2 * std::cbrt(sortedSamples.size()))), 1,
+        MAX_HISTOGRAM_BINS);
+
+    Histogram histogram;
+    histogram.first = sortedSamples.front();
+    histogram.binWidth = (sortedSamples.back() - sortedSamples.front()) / static_cast<double>(bins);
+    histogram.counts.assign(bins, 0);
+    for (const auto value: sortedSamples)
+    {
+        const auto bin = histogram.binWidth > 0
+                             ? static_cast<std::size_t>((value - histogram.first) /
+                                                        histogram.binWidth)
+                             : 0;
+        // The largest sample falls on the upper edge of the last bin
+        ++histogram.counts[std::min(bin, bins - 1)];
+    }
+    return histogram;
+}
+
+}// namespace
+
+double DensityEstimate::last() const noexcept
+{
+    return density.empty() ? first
+                           : first + step * static_cast<double>(density.size() - 1);
+}
+
+bool RepetitionDistribution::isMultimodal() const noexcept
+{
+    return modes > 1;
+}
+
+std::vector<RepetitionSamples> collectRepetitions(const BenchmarkResults& results,
+                                                  const ColumnIndex metric,
+                                                  const std::size_t minimalRepetitions)
+{
+    std::vector<RepetitionSamples> samples;
+    std::unordered_map<StringId, std::size_t> indexOfName;
+    const auto runNames = results.runNameColumn();
+    const auto runTypes = results.runTypeColumn();
+    const auto values = results.column(metric);
+    for (std::size_t row = 0; row < results.size(); ++row)
+    {
+        if (runTypes[row] != RunType::Iteration || std::isnan(values[row]))
+        {
+            continue;
+        }
+        const auto [index, isNew] = indexOfName.try_emplace(runNames[row], samples.size());
+        if (isNew)
+        {
+            samples.push_back({std::string(results.names().get(runNames[row])), {}});
+        }
+        samples[index->second].values.push_back(values[row]);
+    }
+
+    std::erase_if(samples,
+                  [minimalRepetitions](const RepetitionSamples& benchmark)
+                  {
+                      return benchmark.values.size() < minimalRepetitions;
+                  });
+    return samples;
+}
+
+DensityEstimate estimateDensity(const std::span<const double> sortedSamples,
+                                const std::size_t gridSize, const double bandwidthScale)
+{
+    DensityEstimate estimate;
+    estimate.bandwidth = silvermanBandwidth(sortedSamples) * bandwidthScale;
+    estimate.first = sortedSamples.front() - GRID_MARGIN * estimate.bandwidth;
+    const auto last = sortedSamples.back() + GRID_MARGIN * estimate.bandwidth;
+    estimate.step = (last - estimate.first) / static_cast<double>(gridSize - 1);
+
+    // Every sample is split between its two neighbouring points of the grid
+    std::vector<double> weights(gridSize, 0.0);
+    for (const auto value: sortedSamples)
+    {
+        const auto position = (value - estimate.first) / estimate.step;
+        const auto point = std::min(static_cast<std::size_t>(position), gridSize - 2);
+        const auto fraction = position - static_cast<double>(point);
+        weights[point] += 1 - fraction;
+        weights[point + 1] += fraction;
+    }
+
+    const auto reach = std::min(
+        gridSize - 1,
+        static_cast<std::size_t>(std::ceil(KERNEL_REACH * estimate.bandwidth / estimate.step)));
+    std::vector<double> kernel(reach + 1);
+    for (std::size_t offset = 0; offset <= reach; ++offset)
+    {
+        const auto distance = static_cast<double>(offset) * estimate.step / estimate.bandwidth;
+        kernel[offset] = std::exp(-0.5 * distance * distance);
+    }
+
+    const auto normalization = 1 / (static_cast<double>(sortedSamples.size()) *
+                                    estimate.bandwidth * std::sqrt(2 * std::numbers::pi));
+    estimate.density.resize(gridSize);
+    for (std::size_t point = 0; point < gridSize; ++point)
+    {
+        const auto begin = point > reach ? point - reach : 0;
+        const auto end = std::min(point + reach + 1, gridSize);
+        auto sum = 0.0;
+        for (auto source = begin; source < end; ++source)
+        {
+            sum += weights[source] * kernel[source > point ? source - point : point - source];
+        }
+        estimate.density[point] = static_cast<float>(sum * normalization);
+    }
+    return estimate;
+}
+
+BoxSummary summarizeBox(const std::span<const double> sortedSamples)
+{
+    BoxSummary box;
+    box.firstQuartile = quantile(sortedSamples, 0.25);
+    box.median = quantile(sortedSamples, 0.5);
+    box.thirdQuartile = quantile(sortedSamples, 0.75);
+
+    const auto fence = 1.5 * (box.thirdQuartile - box.firstQuartile);
+    const auto lowerFence = box.firstQuartile - fence;
+    const auto upperFence = box.thirdQuartile + fence;
+    const auto lower = std::ranges::lower_bound(sortedSamples, lowerFence);
+    const auto upper = std::ranges::upper_bound(sortedSamples, upperFence);
+    box.lowerWhisker = *lower;
+    box.upperWhisker = *std::prev(upper);
+    box.outliers = static_cast<std::size_t>((lower - sortedSamples.begin()) +
+                                            (sortedSamples.end() - upper));
+    return box;
+}
+
+std::size_t countModes(const std::span<const float> density, const double minimalHeight)
+{
+    if (density.empty())
+    {
+        return 0;
+    }
+    const auto highest = static_cast<double>(*std::ranges::max_element(density));
+    const auto threshold = highest * minimalHeight;
+
+    auto modes = std::size_t{0};
+    auto lastPeak = 0.0;
+    auto valley = 0.0;
+    for (std::size_t point = 0; point < density.size(); ++point)
+    {
+        const auto value = static_cast<double>(density[point]);
+        valley = std::min(valley, value);
+        const auto isRising = point == 0 || density[point - 1] < density[point];
+        const auto isFalling = point + 1 == density.size() || density[point + 1] <= density[point];
+        if (not isRising || not isFalling || value < threshold)
+        {
+            continue;
+        }
+
+        if (modes > 0 && valley >= MODE_VALLEY * std::min(lastPeak, value))
+        {
+            // The same peak continues, only its highest point is remembered
+            lastPeak = std::max(lastPeak, value);
+        }
+        else
+        {
+            ++modes;
+            lastPeak = value;
+        }
+        valley = value;
+    }
+    return modes;
+}
+
+RepetitionDistribution analyzeDistribution(RepetitionSamples samples,
+                                           const DistributionOptions& options)
+{
+    RepetitionDistribution distribution;
+    distribution.name = std::move(samples.name);
+    distribution.samples = std::move(samples.values);
+    std::ranges::sort(distribution.samples);
+
+    distribution.mean = meanOf(distribution.samples);
+    distribution.standardDeviation = standardDeviationOf(distribution.samples, distribution.mean);
+    distribution.box = summarizeBox(distribution.samples);
+    distribution.density = estimateDensity(distribution.samples,
+                                           std::max<std::size_t>(options.gridSize, 2),
+                                           options.bandwidthScale);
+    distribution.histogram = histogramOf(distribution.samples);
+    distribution.modes = countModes(distribution.density.density, options.minimalModeHeight);
+    return distribution;
+}
+
+std::optional<std::vector<RepetitionDistribution>> analyzeDistributions(
+    std::vector<RepetitionSamples> samples, TaskScheduler& scheduler,
+    const DistributionOptions& options, const CancellationToken& token)
+{
+    AllocationScope scope(AllocationSubsystem::Statistics);
+    std::vector<RepetitionDistribution> distributions(samples.size());
+    const auto isFinished = scheduler.parallelFor(
+        samples.size(), BENCHMARKS_PER_TASK,
+        [&](const std::size_t begin, const std::size_t end)
+        {
+            for (auto index = begin; index < end; ++index)
+            {
+                distributions[index] = analyzeDistribution(std::move(samples[index]), options);
+            }
+        },
+        TaskPriority::Interactive, token);
+    if (not isFinished)
+    {
+        return std::nullopt;
+    }
+    return distributions;
+}
+
+}// namespace BPlotter
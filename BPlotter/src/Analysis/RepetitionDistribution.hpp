@@ -0,0 +1,206 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Benchmark/BenchmarkResults.hpp"
+#include "Tasks/TaskScheduler.hpp"
+
+namespace BPlotter
+{
+
+/**
+ * \brief Parameters of the analysis of the repetitions.
+ */
+struct DistributionOptions
+{
+    /**
+     * \brief Number of the points the density is estimated at.
+     */
+    std::size_t gridSize = 128;
+
+    /**
+     * \brief Benchmarks with fewer repetitions have no distribution to speak of.
+     */
+    std::size_t minimalRepetitions = 3;
+
+    /**
+     * \brief Multiplies the bandwidth of the Silverman's rule; larger values smooth the density.
+     */
+    double bandwidthScale = 1;
+
+    /**
+     * \brief Peaks of the density lower than this fraction of the highest one are noise.
+     */
+    double minimalModeHeight = 0.1;
+};
+
+/**
+ * \brief Values of the metric in all the repetitions of a single benchmark.
+ */
+struct RepetitionSamples
+{
+    /**
+     * \brief Run name of the benchmark.
+     */
+    std::string name;
+    std::vector<double> values;
+};
+
+/**
+ * \brief Five-number summary drawn as a box plot, with Tukey's whiskers.
+ */
+struct BoxSummary
+{
+    /**
+     * \brief Smallest sample within 1.5 IQR below the first quartile.
+     */
+    double lowerWhisker = 0;
+    double firstQuartile = 0;
+    double median = 0;
+    double thirdQuartile = 0;
+
+    /**
+     * \brief Largest sample within 1.5 IQR above the third quartile.
+     */
+    double upperWhisker = 0;
+
+    /**
+     * \brief Samples beyond the whiskers.
+     */
+    std::size_t outliers = 0;
+};
+
+/**
+ * \brief Kernel density estimate evaluated on a uniform grid.
+ */
+struct DensityEstimate
+{
+    /**
+     * \brief Value of the first point of the grid.
+     */
+    double first = 0;
+
+    /**
+     * \brief Distance of the neighbouring points of the grid.
+     */
+    double step = 0;
+    double bandwidth = 0;
+
+    /**
+     * \brief Probability density at every point of the grid.
+     */
+    std::vector<float> density;
+
+    /**
+     * \return Value of the last point of the grid
+     */
+    [[nodiscard]] double last() const noexcept;
+};
+
+/**
+ * \brief Counts of the samples in the bins of equal width between the smallest and the
+ * largest sample.
+ */
+struct Histogram
+{
+    double first = 0;
+    double binWidth = 0;
+    std::vector<std::uint32_t> counts;
+};
+
+/**
+ * \brief Distribution of the repetitions of a single benchmark, which the mean and the
+ * standard deviation reported by the aggregates do not tell: bimodal distributions are the
+ * sign of effects such as frequency scaling or NUMA placement.
+ */
+struct RepetitionDistribution
+{
+    std::string name;
+
+    /**
+     * \brief Values of the repetitions, sorted.
+     */
+    std::vector<double> samples;
+    double mean = 0;
+    double standardDeviation = 0;
+    BoxSummary box;
+    DensityEstimate density;
+    Histogram histogram;
+
+    /**
+     * \brief Number of the separate peaks of the density.
+     */
+    std::size_t modes = 0;
+
+    [[nodiscard]] bool isMultimodal() const noexcept;
+};
+
+/**
+ * \brief Collects the values of the iteration rows of every benchmark, which are its
+ * repetitions when run with --benchmark_repetitions and without aggregates only.
+ * \param results Benchmark results
+ * \param metric Column of the collected values
+ * \param minimalRepetitions Benchmarks with fewer valid values are left out
+ * \return Samples in the order of the first row of every benchmark
+ */
+std::vector<RepetitionSamples> collectRepetitions(const BenchmarkResults& results,
+                                                  ColumnIndex metric,
+                                                  std::size_t minimalRepetitions);
+
+/**
+ * \brief Estimates the density with a Gaussian kernel of the Silverman's bandwidth.
+ *
+ * The samples are linearly binned onto the grid first, so the cost of the convolution with
+ * the kernel depends on the size of the grid and not on the number of the samples.
+ *
+ * \param sortedSamples Samples sorted in ascending order, not empty
+ * \param gridSize Number of the points of the grid, at least 2
+ * \param bandwidthScale Multiplies the bandwidth
+ * \return Density on a grid reaching three bandwidths beyond the extreme samples
+ */
+DensityEstimate estimateDensity(std::span<const double> sortedSamples, std::size_t gridSize,
+                                double bandwidthScale = 1);
+
+/**
+ * \brief Computes the box plot of the samples.
+ * \param sortedSamples Samples sorted in ascending order, not empty
+ * \return Quartiles (linearly interpolated) and whiskers of the samples
+ */
+BoxSummary summarizeBox(std::span<const double> sortedSamples);
+
+/**
+ * \brief Counts the separate peaks of the density. Peaks lower than the given fraction of the
+ * highest one are ignored, and two peaks count as one unless the density between them falls
+ * below 80 % of the lower one.
+ * \param density Density on a uniform grid
+ * \param minimalHeight Fraction of the highest peak
+ * \return Number of the peaks
+ */
+std::size_t countModes(std::span<const float> density, double minimalHeight);
+
+/**
+ * \brief Analyzes the distribution of a single benchmark.
+ * \param samples Repetitions of the benchmark, not empty
+ * \param options Parameters of the analysis
+ * \return The distribution
+ */
+RepetitionDistribution analyzeDistribution(RepetitionSamples samples,
+                                           const DistributionOptions& options = {});
+
+/**
+ * \brief Analyzes the distributions of all the benchmarks in parallel.
+ * \param samples Repetitions of the benchmarks
+ * \param scheduler Scheduler analyzing the benchmarks
+ * \param options Parameters of the analysis
+ * \param token Cancels the analysis
+ * \return Distributions in the order of the samples, nullopt if cancelled
+ */
+std::optional<std::vector<RepetitionDistribution>> analyzeDistributions(
+    std::vector<RepetitionSamples> samples, TaskScheduler& scheduler,
+    const DistributionOptions& options = {}, const CancellationToken& token = {});
+
+}// namespace BPlotter
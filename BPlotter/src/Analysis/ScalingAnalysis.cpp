@@ -0,0 +1,170 @@
+#include "ScalingAnalysis.hpp"
+#include "pch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+#include "Memory/AllocationTracker.hpp"
+
+namespace BPlotter
+{
+
+namespace
+{
+
+/**
+ * \brief Removes the "threads:N" component from the run name.
+ */
+std::string withoutThreads(std::string_view runName)
+{
+    std::string result(runName);
+    if (const auto begin = result.find("/threads:"); begin != std::string::npos)
+    {
+        const auto end = result.find('/', begin + 1);
+        result.erase(begin, end == std::string::npos ? std::string::npos : end - begin);
+    }
+    return result;
+}
+
+/**
+ * \brief Least squares fit of y = s * x, a line going through the origin.
+ */
+double fitThroughOrigin(const std::vector<std::pair<double, double>>& points)
+{
+    auto xy = 0.0;
+    auto xx = 0.0;
+    for (const auto& [x, y]: points)
+    {
+        xy += x * y;
+        xx += x * x;
+    }
+    return xx > 0 ? xy / xx : 0;
+}
+
+template<typename Law>
+ScalingFit fitScalingLaw(const std::vector<ScalingPoint>& points, double serialFraction,
+                         Law law)
+{
+    ScalingFit fit{std::clamp(serialFraction, 0.0, 1.0)};
+    const auto baseline = points.front().threads;
+    for (const auto& point: points)
+    {
+        const auto error = law(fit.serialFraction, point.threads / baseline) - point.speedup;
+        fit.rmsError += error * error;
+    }
+    fit.rmsError = std::sqrt(fit.rmsError / static_cast<double>(points.size()));
+    return fit;
+}
+
+void fitScalingLaws(ScalingFamily& family)
+{
+    const auto baseline = family.points.front().threads;
+
+    // Amdahl: 1/S = s + (1 - s)/N, so 1/S - 1/N = s * (1 - 1/N)
+    // Gustafson: S = N - s * (N - 1), so N - S = s * (N - 1)
+    std::vector<std::pair<double, double>> amdahl;
+    std::vector<std::pair<double, double>> gustafson;
+    for (const auto& point: family.points)
+    {
+        const auto n = point.threads / baseline;
+        amdahl.emplace_back(1 - 1 / n, 1 / point.speedup - 1 / n);
+        gustafson.emplace_back(n - 1, n - point.speedup);
+    }
+
+    family.amdahl = fitScalingLaw(family.points, fitThroughOrigin(amdahl), amdahlSpeedup);
+    family.gustafson = fitScalingLaw(family.points, fitThroughOrigin(gustafson), gustafsonSpeedup);
+}
+
+}// namespace
+
+double ScalingFamily::maxEfficientThreads(const double minimalEfficiency) const
+{
+    auto result = points.front().threads;
+    for (const auto& point: points)
+    {
+        if (point.efficiency >= minimalEfficiency)
+        {
+            result = point.threads;
+        }
+    }
+    return result;
+}
+
+double amdahlSpeedup(const double serialFraction, const double threads)
+{
+    return 1 / (serialFraction + (1 - serialFraction) / threads);
+}
+
+double gustafsonSpeedup(const double serialFraction, const double threads)
+{
+    return threads - serialFraction * (threads - 1);
+}
+
+std::vector<ScalingFamily> analyzeScaling(const BenchmarkResults& results, const ColumnIndex metric,
+                                          const bool isHigherBetter)
+{
+    AllocationScope scope(AllocationSubsystem::Statistics);
+    struct Accumulator
+    {
+        double sum = 0;
+        std::size_t count = 0;
+    };
+
+    // Family name -> thread count -> accumulated metric
+    std::unordered_map<std::string, std::map<double, Accumulator>> families;
+    std::unordered_map<StringId, std::string> familyNames;
+
+    const auto runNames = results.runNameColumn();
+    const auto runTypes = results.runTypeColumn();
+    const auto threads = results.column(BuiltinColumn::Threads);
+    const auto values = results.column(metric);
+    for (std::size_t row = 0; row < results.size(); ++row)
+    {
+        if (runTypes[row] != RunType::Iteration || std::isnan(values[row]) ||
+            std::isnan(threads[row]))
+        {
+            continue;
+        }
+
+        auto [familyName, isNew] = familyNames.try_emplace(runNames[row]);
+        if (isNew)
+        {
+            familyName->second = withoutThreads(results.names().get(runNames[row]));
+        }
+        auto& [sum, count] = families[familyName->second][threads[row]];
+        sum += values[row];
+        ++count;
+    }
+
+    std::vector<ScalingFamily> scaling;
+    for (const auto& [name, measurements]: families)
+    {
+        if (measurements.size() < 2)
+        {
+            continue;
+        }
+
+        auto& family = scaling.emplace_back();
+        family.name = name;
+        for (const auto& [threadCount, accumulator]: measurements)
+        {
+            family.points.push_back(
+                {threadCount, accumulator.sum / static_cast<double>(accumulator.count)});
+        }
+
+        const auto baseline = family.points.front();
+        for (auto& point: family.points)
+        {
+            point.speedup = isHigherBetter ? point.value / baseline.value
+                                           : baseline.value / point.value;
+            point.efficiency = point.speedup / (point.threads / baseline.threads);
+        }
+        fitScalingLaws(family);
+    }
+
+    std::ranges::sort(scaling, {}, &ScalingFamily::name);
+    return scaling;
+}
+
+}// namespace BPlotter
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Benchmark/BenchmarkResults.hpp"
+
+namespace BPlotter
+{
+
+/**
+ * \brief Measurement of a benchmark family at a single thread count.
+ */
+struct ScalingPoint
+{
+    double threads = 1;
+
+    /**
+     * \brief Mean value of the analyzed metric over all the repetitions.
+     */
+    double value = 0;
+
+    /**
+     * \brief How many times faster it is than with the smallest measured thread count.
+     */
+    double speedup = 1;
+
+    /**
+     * \brief Speedup divided by the ideal (linear) speedup.
+     */
+    double efficiency = 1;
+};
+
+/**
+ * \brief Result of the fit of a scaling law to the measured speedups.
+ */
+struct ScalingFit
+{
+    /**
+     * \brief Fitted fraction of the work that does not benefit from additional threads.
+     */
+    double serialFraction = 0;
+
+    /**
+     * \brief Root mean square error of the fitted speedups.
+     */
+    double rmsError = 0;
+};
+
+/**
+ * \brief Scaling of a single benchmark family across the thread counts.
+ *
+ * Speedups are relative to the smallest measured thread count, so the thread counts used
+ * by the fits are normalized by it too.
+ */
+struct ScalingFamily
+{
+    /**
+     * \brief Run name of the benchmark without the "threads:N" component.
+     */
+    std::string name;
+
+    /**
+     * \brief Measurements sorted by the thread count.
+     */
+    std::vector<ScalingPoint> points;
+
+    ScalingFit amdahl;
+    ScalingFit gustafson;
+
+    /**
+     * \brief Finds the largest thread count that still runs with at least the given efficiency.
+     * \param minimalEfficiency Efficiency below which adding threads is considered wasteful
+     * \return The thread count
+     */
+    [[nodiscard]] double maxEfficientThreads(double minimalEfficiency) const;
+};
+
+/**
+ * \brief Speedup predicted by the Amdahl's law (fixed amount of work).
+ * \param serialFraction Fraction of the work that is serial
+ * \param threads Number of threads, relative to the baseline
+ * \return Predicted speedup
+ */
+double amdahlSpeedup(double serialFraction, double threads);
+
+/**
+ * \brief Speedup predicted by the Gustafson's law (work growing with the number of threads).
+ * \param serialFraction Fraction of the work that is serial
+ * \param threads Number of threads, relative to the baseline
+ * \return Predicted speedup
+ */
+double gustafsonSpeedup(double serialFraction, double threads);
+
+/**
+ * \brief Computes the speedup, the efficiency and the scaling law fits of all the benchmark
+ * families that were run with more than one thread count (->Threads(n), ->ThreadRange()).
+ * \param results Benchmark results to analyze. Only the iteration rows are used.
+ * \param metric Column used to measure the performance, usually the real time
+ * \param isHigherBetter True if the metric is a rate (e.g. items_per_second), false if it is
+ * a time
+ * \return Scaling of the families, sorted by their names
+ */
+std::vector<ScalingFamily> analyzeScaling(const BenchmarkResults& results, ColumnIndex metric,
+                                          bool isHigherBetter);
+
+}// namespace BPlotter
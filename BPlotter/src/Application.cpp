@@ -1,8 +1,13 @@
 #include "Application.hpp"
 #include "pch.hpp"
 
+#include "Platform/DesktopWindow.hpp"
+#include "Platform/HeadlessWindow.hpp"
 #include "States/CustomStates/ExitApplicationState.hpp"
+#include "States/CustomStates/MainAppOpen.hpp"
+#include "Utils/FrameArena.hpp"
 
+#include <fstream>
 #include <spdlog/sinks/stdout_color_sinks.h>
 
 namespace BPlotter
@@ -19,8 +24,6 @@ constexpr int MINIMAL_FIXED_UPDATES_PER_FRAME = 60;
 
 const sf::Time Application::TIME_PER_FIXED_UPDATE_CALLS =
     sf::seconds(1.f / MINIMAL_FIXED_UPDATES_PER_FRAME);
-const int Application::SCREEN_WIDTH = 1280;
-const int Application::SCREEN_HEIGHT = 720;
 
 
 void Application::configureImGuiSinks()
@@ -31,17 +34,14 @@ void Application::configureImGuiSinks()
     consoleSink->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] %v");
     const auto logger = std::make_shared<spdlog::logger>(
         "multi_sink", spdlog::sinks_init_list{imguiSink, consoleSink});
-    spdlog::register_logger(logger);
+    // Registered as the default, so it replaces the logger of a previous application
+    mPreviousLogger = spdlog::default_logger();
     spdlog::set_default_logger(logger);
 }
 
 void Application::configureImGui()
 {
     configureImGuiSinks();
-    if (not ImGui::SFML::Init(mWindow))
-    {
-        spdlog::critical("Imgui-SFML not initialized properly");
-    }
     setupImGuiStyle();
     if (auto& io = ImGui::GetIO(); !(io.ConfigFlags & ImGuiConfigFlags_DockingEnable))
     {
@@ -51,64 +51,143 @@ void Application::configureImGui()
 void Application::setupFlowStates()
 {
     mAppStack.saveState<ExitApplicationState>(State_ID::ExitApplicationState);
-    mAppStack.saveState<ExitApplicationState>(State_ID::MainAppOpen);
+    mAppStack.saveState<MainAppOpen>(State_ID::MainAppOpen, mTaskScheduler, mOptions);
 }
 
-Application::Application()
-    : mWindow(sf::VideoMode({SCREEN_WIDTH, SCREEN_HEIGHT}), "BPlotter")
+Application::Application(ApplicationOptions options)
+    : Application(options, createWindow(options), createClock(options))
 {
+}
+
+Application::Application(ApplicationOptions options, std::unique_ptr<ApplicationWindow> window,
+                         std::unique_ptr<FrameClock> clock)
+    : mOptions(std::move(options))
+    , mWindow(std::move(window))
+    , mClock(std::move(clock))
+{
+    loadReplay();
+
+    auto settings = FrameSchedulerSettings{.fixedStep = TIME_PER_FIXED_UPDATE_CALLS.asSeconds()};
+    // A replay runs the same fixed updates whatever the speed of the machine
+    if (isReplaying())
+    {
+        settings.fixedUpdateBudget.reset();
+    }
+    mFrameScheduler.setSettings(settings);
+
     loadResources();
     configureImGui();
     setupFlowStates();
     mAppStack.push(State_ID::MainAppOpen);
 }
 
+Application::~Application()
+{
+    // The sink of the logger refers to the log of this application
+    spdlog::set_default_logger(mPreviousLogger);
+}
+
 void Application::run()
 {
-    spdlog::info("Apps starts, the resolution is {}x{}", mWindow.getSize().x, mWindow.getSize().y);
+    spdlog::info("Apps starts, the resolution is {}x{}", mWindow->getSize().x,
+                 mWindow->getSize().y);
 
     performApplicationLoop();
+    saveFrameResults();
+
+    mWindow->close();
+}
 
-    mWindow.close();
-    ImGui::SFML::Shutdown();
+const FrameTimings& Application::frameTimings() const noexcept
+{
+    return mFrameTimings;
+}
+
+const AllocationTracker& Application::allocationTracker() const noexcept
+{
+    return mAllocationTracker;
+}
+
+std::unique_ptr<ApplicationWindow> Application::createWindow(const ApplicationOptions& options)
+{
+    if (options.isHeadless)
+    {
+        return std::make_unique<HeadlessWindow>(options.resolution);
+    }
+    return std::make_unique<DesktopWindow>(options.resolution, "BPlotter");
+}
+
+std::unique_ptr<FrameClock> Application::createClock(const ApplicationOptions& options)
+{
+    // Without a display to keep up with, the headless frames advance by the frames of a 60 Hz one
+    if (options.isHeadless)
+    {
+        return std::make_unique<FixedFrameClock>();
+    }
+    return std::make_unique<SystemFrameClock>();
 }
 
 void Application::performApplicationLoop()
 {
-    sf::Clock clock;
+    // Measures the real work of every frame, whatever the time steps of the frame clock
+    sf::Clock workClock;
     auto frameTimeElapsed = sf::Time::Zero;
-    mFixedUpdateClock.restart();
-    while (isApplicationRunning)
+    for (std::size_t frame = 0; isApplicationRunning; ++frame)
     {
-        frameTimeElapsed = clock.restart();
+        if (mOptions.frameLimit && frame == *mOptions.frameLimit)
+        {
+            break;
+        }
+        workClock.restart();
+        frameTimeElapsed = mClock->restart();
+        if (isReplaying())
+        {
+            if (mReplayFrame == mRecording.frames().size())
+            {
+                spdlog::info("The replayed session ended");
+                break;
+            }
+            // The recorded time replaces the clock, so every replay updates the states alike
+            frameTimeElapsed = sf::seconds(mRecording.frames()[mReplayFrame].deltaTime);
+        }
+        else if (mOptions.recordPath)
+        {
+            mRecording.beginFrame(frameTimeElapsed.asSeconds());
+        }
+
         update(frameTimeElapsed);
-        fixedUpdateAtEqualIntervals();
+        fixedUpdateAtEqualIntervals(frameTimeElapsed);
         processEvents();
 
         render();
+        const auto frameSeconds = workClock.getElapsedTime().asSeconds();
+        mAllocationTracker.endFrame(frameSeconds);
+        if (mOptions.isMeasuringFrames())
+        {
+            mFrameTimings.record(frameSeconds);
+        }
+        if (isReplaying())
+        {
+            ++mReplayFrame;
+        }
     }
     mAppStack.forceInstantClear();
 }
 
-void Application::fixedUpdateAtEqualIntervals()
+void Application::fixedUpdateAtEqualIntervals(const sf::Time& frameTime)
 {
-    mTimeSinceLastFixedUpdate += mFixedUpdateClock.restart();
-    if (mTimeSinceLastFixedUpdate > TIME_PER_FIXED_UPDATE_CALLS)
-    {
-        do
-        {
-            mTimeSinceLastFixedUpdate -= TIME_PER_FIXED_UPDATE_CALLS;
-            fixedUpdate(TIME_PER_FIXED_UPDATE_CALLS);
-        }
-        while (mTimeSinceLastFixedUpdate > TIME_PER_FIXED_UPDATE_CALLS);
-    }
+    mFrameScheduler.advance(frameTime.asSeconds(),
+                            [this](const float step)
+                            {
+                                fixedUpdate(sf::seconds(step));
+                            });
 }
 
 void Application::updateImGuiLogger()
 {
     if (ImGui::Button("Console"))
     {
-        ImGui::SetNextWindowSize(ImVec2(mWindow.getSize().x, mWindow.getSize().y / 2.f));
+        ImGui::SetNextWindowSize(ImVec2(mWindow->getSize().x, mWindow->getSize().y / 2.f));
         ImGui::SetNextWindowPos(ImVec2(0, 0));
         ImGui::OpenPopup("ConsolePopup");
     }
@@ -149,8 +228,9 @@ void Application::updateImGuiLogger()
 
 void Application::updateImGui(const sf::Time& deltaTime)
 {
-    ImGui::SFML::Update(mWindow, deltaTime);
-    ImGui::SetNextWindowSize(mWindow.getSize());
+    mWindow->updateImGui(deltaTime, isReplaying() ? std::optional(mReplayMousePosition)
+                                                  : std::nullopt);
+    ImGui::SetNextWindowSize(mWindow->getSize());
     ImGui::SetNextWindowPos(ImVec2(0, 0));
     ImGuiWindowFlags window_flags = ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize |
                                     ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoCollapse |
@@ -164,33 +244,136 @@ void Application::updateImGui(const sf::Time& deltaTime)
             if (ImGui::BeginMenu("Help"))
             {
                 updateImGuiLogger();
+                ImGui::MenuItem("Performance", nullptr, &mIsPerformanceShown);
                 ImGui::EndMenu();
             }
         }
         ImGui::EndMainMenuBar();
     }
     ImGui::End();
+
+    if (mIsPerformanceShown)
+    {
+        mPerformancePanel.updateImGui(mAllocationTracker, mFrameScheduler.statistics(),
+                                      mTaskScheduler.statistics(), &mIsPerformanceShown);
+    }
 }
 
 void Application::processEvents()
 {
-    while (const auto optionalEvent = mWindow.pollEvent())
+    if (isReplaying())
     {
-        if (optionalEvent.has_value())
+        // The frame was recorded up to the event that found the window without focus
+        for (const auto& event: mRecording.frames()[mReplayFrame].events)
         {
-            auto event = optionalEvent.value();
-            if (event.is<sf::Event::Closed>())
-            {
-                isApplicationRunning = false;
-            }
+            handleEvent(event);
+        }
+        return;
+    }
 
-            ImGui::SFML::ProcessEvent(mWindow, event);
+    while (const auto optionalEvent = mWindow->pollEvent())
+    {
+        if (mOptions.recordPath)
+        {
+            mRecording.record(*optionalEvent);
+        }
+        if (not handleEvent(*optionalEvent))
+        {
+            return;
+        }
+    }
+}
 
-            if (not mWindow.hasFocus())
-            {
-                return;
-            }
-            mAppStack.handleEvent(event);
+bool Application::handleEvent(const sf::Event& event)
+{
+    if (event.is<sf::Event::Closed>())
+    {
+        isApplicationRunning = false;
+    }
+    else if (event.is<sf::Event::FocusLost>())
+    {
+        mIsReplayFocused = false;
+    }
+    else if (event.is<sf::Event::FocusGained>())
+    {
+        mIsReplayFocused = true;
+    }
+    else if (const auto* moved = event.getIf<sf::Event::MouseMoved>())
+    {
+        mReplayMousePosition = moved->position;
+    }
+
+    mWindow->processImGuiEvent(event);
+
+    if (not hasFocus())
+    {
+        return false;
+    }
+    mAppStack.handleEvent(event);
+    return true;
+}
+
+bool Application::hasFocus() const
+{
+    return isReplaying() ? mIsReplayFocused : mWindow->hasFocus();
+}
+
+bool Application::isReplaying() const noexcept
+{
+    return mOptions.replayPath.has_value();
+}
+
+void Application::loadReplay()
+{
+    if (not isReplaying())
+    {
+        return;
+    }
+
+    std::ifstream input(*mOptions.replayPath);
+    auto recording = EventRecording::read(input);
+    if (recording.has_error())
+    {
+        throw std::runtime_error(fmt::format("Unable to replay {}: {}",
+                                             mOptions.replayPath->string(), recording.error()));
+    }
+    mRecording = std::move(recording.value());
+    spdlog::info("Replaying {} frames with {} events from {}", mRecording.frames().size(),
+                 mRecording.eventCount(), mOptions.replayPath->string());
+}
+
+void Application::saveFrameResults() const
+{
+    if (mOptions.recordPath)
+    {
+        std::ofstream output(*mOptions.recordPath);
+        if (const auto written = mRecording.write(output); written.has_error())
+        {
+            spdlog::error("{}: {}", mOptions.recordPath->string(), written.error());
+        }
+        else
+        {
+            spdlog::info("Recorded {} frames with {} events to {}", mRecording.frames().size(),
+                         mRecording.eventCount(), mOptions.recordPath->string());
+        }
+    }
+
+    if (mOptions.isMeasuringFrames())
+    {
+        constexpr auto MILLISECONDS = 1000.f;
+        spdlog::info("Measured {} frames: mean {:.2f} ms, p50 {:.2f} ms, p95 {:.2f} ms, "
+                     "p99 {:.2f} ms",
+                     mFrameTimings.frameCount(), mFrameTimings.mean() * MILLISECONDS,
+                     mFrameTimings.percentile(0.5) * MILLISECONDS,
+                     mFrameTimings.percentile(0.95) * MILLISECONDS,
+                     mFrameTimings.percentile(0.99) * MILLISECONDS);
+
+        std::ofstream report(mOptions.frameReportPath);
+        mFrameTimings.exportCsv(report);
+        if (not report)
+        {
+            spdlog::error("Unable to write the frame timings to {}",
+                          mOptions.frameReportPath.string());
         }
     }
 }
@@ -217,10 +400,11 @@ void Application::update(const sf::Time& deltaTime)
 
 void Application::render()
 {
-    mWindow.clear();
-    mAppStack.draw(mWindow);
-    ImGui::SFML::Render();
-    mWindow.display();
+    AllocationScope scope(AllocationSubsystem::Rendering);
+    mWindow->render(mAppStack);
+
+    // Everything the frame allocated from the arena has been drawn by now
+    frameArena().reset();
 }
 
 
@@ -1,10 +1,19 @@
 #pragma once
 
 
-#include <SFML/Graphics/RenderWindow.hpp>
+#include <memory>
 
+#include "ApplicationOptions.hpp"
+#include "Memory/AllocationTracker.hpp"
+#include "Panels/PerformancePanel.hpp"
+#include "Platform/ApplicationWindow.hpp"
+#include "Platform/FrameClock.hpp"
+#include "Platform/FrameScheduler.hpp"
+#include "Replay/EventRecording.hpp"
+#include "Replay/FrameTimings.hpp"
 #include "Resources/Resources.hpp"
 #include "States/StateStack.hpp"
+#include "Tasks/TaskScheduler.hpp"
 #include "Utils/ImGuiLog.hpp"
 
 namespace BPlotter
@@ -21,7 +30,26 @@ namespace BPlotter
 class Application
 {
 public:
-    Application();
+    /**
+     * \brief Creates the window and the states of the application.
+     * \param options Command line settings, such as the session to record or replay
+     * \throw std::runtime_error if the session to replay can not be read
+     */
+    explicit Application(ApplicationOptions options = {});
+
+    /**
+     * \brief Creates the states of the application running in the given window, which lets the
+     * tests and the benchmarks run the frames in a HeadlessWindow.
+     * \param options Settings of the application, the window and clock settings aside
+     * \param window Window the events come from and the frames are presented to
+     * \param clock Time steps of the frames, unless a session is replayed
+     * \throw std::runtime_error if the session to replay can not be read
+     */
+    Application(ApplicationOptions options, std::unique_ptr<ApplicationWindow> window,
+                std::unique_ptr<FrameClock> clock);
+    Application(const Application&) = delete;
+    Application& operator=(const Application&) = delete;
+    ~Application();
     /**
      * \brief Starts the engine and keeps it running until the user finishes it.
      *
@@ -30,7 +58,20 @@ public:
      */
     void run();
 
+    /**
+     * \brief Durations of the frames run so far, collected only while replaying or headless.
+     */
+    [[nodiscard]] const FrameTimings& frameTimings() const noexcept;
+
+    /**
+     * \brief Allocations of the last frames, counted only while the tracking is enabled.
+     */
+    [[nodiscard]] const AllocationTracker& allocationTracker() const noexcept;
+
 private:
+    static std::unique_ptr<ApplicationWindow> createWindow(const ApplicationOptions& options);
+    static std::unique_ptr<FrameClock> createClock(const ApplicationOptions& options);
+
     /**
      * \brief The main loop that controls the operation of the engine in the loop.
      *
@@ -41,9 +82,37 @@ private:
 
     /**
      * \brief Intercepts user inputs and passes them to processes inside the application.
+     *
+     * While replaying, the events of the current recorded frame are processed instead of the
+     * ones of the window. While recording, every polled event is recorded.
      */
     void processEvents();
 
+    /**
+     * \brief Passes a single event to ImGui and to the states.
+     * \param event Polled or replayed event
+     * \return False if the window has no focus, so the rest of the events wait for the next frame
+     */
+    bool handleEvent(const sf::Event& event);
+
+    /**
+     * \brief Whether the window has focus, as the replayed events say while replaying, since the
+     * real window does not take part in the replay.
+     */
+    [[nodiscard]] bool hasFocus() const;
+
+    [[nodiscard]] bool isReplaying() const noexcept;
+
+    /**
+     * \brief Reads the session to replay given in the options.
+     */
+    void loadReplay();
+
+    /**
+     * \brief Writes the recorded session and the timings of the measured frames after the loop.
+     */
+    void saveFrameResults() const;
+
     /**
      * \brief Updates the application logic at equal intervals independent of the frame rate.
      * \param deltaTime Time interval
@@ -61,11 +130,13 @@ private:
     void fixedUpdate(const sf::Time& deltaTime);
 
     /**
-     * It performs fixed updates at equal intervals. In case of huge time gaps, it makes up for it
+     * It performs fixed updates at equal intervals. In case of time gaps, it makes up for it
      * by executing one by one successive calls with the same fixed time argument. to avoid behavior
      * where, due to high lag, a character is moved off the wall avoiding collision checking.
+     * The catch-up of a frame is bounded by the FrameScheduler, so huge gaps are dropped.
+     * \param frameTime Time elapsed since the previous frame, the recorded one while replaying
      */
-    void fixedUpdateAtEqualIntervals();
+    void fixedUpdateAtEqualIntervals(const sf::Time& frameTime);
 
     /**
      * \brief Updates the display of the imgui menu for the application logger
@@ -130,30 +201,19 @@ private:
      */
     void setupFlowStates();
 
-    /**
-     * @brief The time it takes for one app frame to be generated.
-     */
-    static const sf::Time TIME_PER_FRAME;
-
     /**
      * @brief Time between one fixed update and another
      */
     static const sf::Time TIME_PER_FIXED_UPDATE_CALLS;
 
-    /**
-     * @brief Default app window width
-     */
-    static const int SCREEN_WIDTH;
-
-    /**
-     * @brief Default app window height
-     */
-    static const int SCREEN_HEIGHT;
+    ApplicationOptions mOptions;
 
     /**
-     * @brief The window to which the app image should be drawn.
+     * @brief The window to which the app image should be drawn. Declared before the states,
+     * so its ImGui context outlives them.
      */
-    sf::RenderWindow mWindow;
+    std::unique_ptr<ApplicationWindow> mWindow;
+    std::unique_ptr<FrameClock> mClock;
 
     /**
      * TODO: THIS
@@ -161,19 +221,20 @@ private:
     bool isApplicationRunning = true;
 
     /**
-     * @brief A clock used to determine the last time the fixedUpdate function was called
+     * @brief Decides how many fixed updates every frame runs
      */
-    sf::Clock mFixedUpdateClock;
+    FrameScheduler mFrameScheduler;
 
     /**
-     * @brief Time since the last call to the fixedUpdate function
+     * @brief Any app assets from textures or fonts
      */
-    sf::Time mTimeSinceLastFixedUpdate = sf::Time::Zero;
+    ApplicationResources mApplicationResources;
 
     /**
-     * @brief Any app assets from textures or fonts
+     * \brief Runs all the background work of the states. Declared before the stack, so the
+     * states that wait for their tasks are destroyed first.
      */
-    ApplicationResources mApplicationResources;
+    TaskScheduler mTaskScheduler;
 
     /**
      * \brief Stores and manages in-app states.
@@ -188,6 +249,36 @@ private:
      * \brief The ImGui log object that stores the logs displayed in the application.
      */
     ImGuiLog mImguiLog;
+
+    /**
+     * \brief Timings and heap allocations of the last frames, shown under Help.
+     */
+    AllocationTracker mAllocationTracker;
+    PerformancePanel mPerformancePanel;
+    bool mIsPerformanceShown = false;
+
+    /**
+     * \brief Logger that was the default before this application, restored once it is gone.
+     */
+    std::shared_ptr<spdlog::logger> mPreviousLogger;
+
+    /**
+     * \brief Session being recorded, or the one being replayed.
+     */
+    EventRecording mRecording;
+
+    /**
+     * \brief Index of the recorded frame replayed by the current frame of the loop.
+     */
+    std::size_t mReplayFrame = 0;
+    FrameTimings mFrameTimings;
+
+    /**
+     * \brief Focus and mouse position as the replayed events left them; ImGui would otherwise
+     * read the position of the real cursor.
+     */
+    bool mIsReplayFocused = true;
+    sf::Vector2i mReplayMousePosition;
 };
 
 }// namespace BPlotter
@@ -0,0 +1,145 @@
+#include "ApplicationOptions.hpp"
+#include "pch.hpp"
+
+#include <charconv>
+
+namespace BPlotter
+{
+
+namespace
+{
+
+template<typename Number>
+std::optional<Number> parseNumber(const std::string_view text)
+{
+    auto value = Number{};
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error != std::errc{} || end != text.data() + text.size())
+    {
+        return std::nullopt;
+    }
+    return value;
+}
+
+/**
+ * \brief Parses a resolution written as WIDTHxHEIGHT, e.g. 1920x1080.
+ */
+std::optional<sf::Vector2u> parseResolution(const std::string_view text)
+{
+    const auto separator = text.find('x');
+    if (separator == std::string_view::npos)
+    {
+        return std::nullopt;
+    }
+    const auto width = parseNumber<unsigned int>(text.substr(0, separator));
+    const auto height = parseNumber<unsigned int>(text.substr(separator + 1));
+    if (not width || not height || *width == 0 || *height == 0)
+    {
+        return std::nullopt;
+    }
+    return sf::Vector2u(*width, *height);
+}
+
+}// namespace
+
+const char* const APPLICATION_USAGE =
+    "Usage: BPlotterApp [options]\n"
+    "       BPlotterApp compare <baseline.json> <candidate.json> [options]\n"
+    "Options:\n"
+    "  --record <file>                 Record the input events of the session to the file\n"
+    "  --replay <file>                 Replay the recorded session and measure its frames\n"
+    "  --headless                      Run the frames without a window and measure them\n"
+    "  --frames <count>                Close the application after the number of frames\n"
+    "  --resolution <width>x<height>   Size of the window (default: 1280x720)\n"
+    "  --frame-report <file.csv>       Durations of the replayed or headless frames\n"
+    "                                  (default: frame_timings.csv)\n"
+    "  --session <directory>           Directory the workspace is restored from and saved to\n"
+    "                                  (default: session, none when replaying or headless)\n";
+
+bool ApplicationOptions::isMeasuringFrames() const noexcept
+{
+    return replayPath || isHeadless;
+}
+
+std::optional<std::filesystem::path> ApplicationOptions::sessionDirectoryInUse() const
+{
+    if (sessionDirectory)
+    {
+        return sessionDirectory;
+    }
+    if (isMeasuringFrames())
+    {
+        return std::nullopt;
+    }
+    return DEFAULT_SESSION_DIRECTORY;
+}
+
+cpp::result<ApplicationOptions, std::string> parseApplicationArguments(
+    const std::span<const std::string_view> arguments)
+{
+    auto parsed = ApplicationOptions{};
+    for (std::size_t i = 0; i < arguments.size(); ++i)
+    {
+        const auto argument = arguments[i];
+        if (argument == "--headless")
+        {
+            parsed.isHeadless = true;
+            continue;
+        }
+
+        if (argument != "--record" && argument != "--replay" && argument != "--frames" &&
+            argument != "--resolution" && argument != "--frame-report" &&
+            argument != "--session")
+        {
+            return cpp::fail(fmt::format("Unknown argument '{}'", argument));
+        }
+        if (i + 1 == arguments.size())
+        {
+            return cpp::fail(fmt::format("{} requires a value", argument));
+        }
+
+        const auto value = arguments[++i];
+        if (argument == "--record")
+        {
+            parsed.recordPath = value;
+        }
+        else if (argument == "--replay")
+        {
+            parsed.replayPath = value;
+        }
+        else if (argument == "--frames")
+        {
+            parsed.frameLimit = parseNumber<std::size_t>(value);
+            if (not parsed.frameLimit)
+            {
+                return cpp::fail(fmt::format("Invalid number of frames '{}'", value));
+            }
+        }
+        else if (argument == "--resolution")
+        {
+            const auto resolution = parseResolution(value);
+            if (not resolution)
+            {
+                return cpp::fail(fmt::format("Invalid resolution '{}'", value));
+            }
+            parsed.resolution = *resolution;
+        }
+        else if (argument == "--frame-report")
+        {
+            parsed.frameReportPath = value;
+        }
+        else
+        {
+            parsed.sessionDirectory = value;
+        }
+    }
+
+    // The replayed events would only be recorded again
+    if (parsed.recordPath && parsed.replayPath)
+    {
+        return cpp::fail(std::string("--record and --replay can not be combined"));
+    }
+    return parsed;
+}
+
+}// namespace BPlotter
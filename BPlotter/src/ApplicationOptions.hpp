@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include <SFML/System/Vector2.hpp>
+#include <result.hpp>
+
+namespace BPlotter
+{
+
+/**
+ * \brief Settings of the application given on the command line.
+ */
+struct ApplicationOptions
+{
+    /**
+     * \brief The events processed by the application are recorded and written to this file
+     * when the application closes.
+     */
+    std::optional<std::filesystem::path> recordPath;
+
+    /**
+     * \brief The events are read from this recording instead of the window, with the frame
+     * times of the recording instead of the clock. The application closes once it ends.
+     */
+    std::optional<std::filesystem::path> replayPath;
+
+    /**
+     * \brief The frames are run without a window and are not rendered, see HeadlessWindow.
+     */
+    bool isHeadless = false;
+
+    /**
+     * \brief The application closes after this many frames.
+     */
+    std::optional<std::size_t> frameLimit;
+
+    /**
+     * \brief Size of the window, or of the display the headless frames are laid out for.
+     */
+    sf::Vector2u resolution{1280, 720};
+
+    /**
+     * \brief Where the durations of the replayed or headless frames are written as CSV.
+     */
+    std::filesystem::path frameReportPath = "frame_timings.csv";
+
+    /**
+     * \brief Directory the workspace is restored from and saved to. If not given, the normal
+     * sessions use DEFAULT_SESSION_DIRECTORY, while the replayed and headless ones start with an
+     * empty workspace and save nothing, so that their frames do not depend on an earlier run.
+     */
+    std::optional<std::filesystem::path> sessionDirectory;
+
+    /**
+     * \brief Directory of the saved session, next to the window layout stored by ImGui.
+     */
+    static constexpr auto DEFAULT_SESSION_DIRECTORY = "session";
+
+    /**
+     * \return Directory of the session of the application, nullopt if it has none
+     */
+    [[nodiscard]] std::optional<std::filesystem::path> sessionDirectoryInUse() const;
+
+    /**
+     * \brief Whether the durations of the frames are collected and reported, which a normal
+     * session does not do to keep its memory bounded.
+     */
+    [[nodiscard]] bool isMeasuringFrames() const noexcept;
+};
+
+/**
+ * \brief Usage of the application printed on invalid arguments.
+ */
+extern const char* const APPLICATION_USAGE;
+
+/**
+ * \brief Parses the command line of the application.
+ * \param arguments Arguments following the name of the executable
+ * \return The parsed options or a description of the error
+ */
+cpp::result<ApplicationOptions, std::string> parseApplicationArguments(
+    std::span<const std::string_view> arguments);
+
+}// namespace BPlotter
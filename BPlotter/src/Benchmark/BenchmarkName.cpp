@@ -0,0 +1,106 @@
+#include "BenchmarkName.hpp"
+#include "pch.hpp"
+
+#include <algorithm>
+#include <array>
+
+namespace BPlotter
+{
+
+namespace
+{
+
+/**
+ * \brief Segments appended by Google Benchmark that do not carry any value.
+ */
+constexpr std::array<std::string_view, 3> FLAGS = {"real_time", "manual_time", "process_time"};
+
+std::string_view trim(std::string_view text)
+{
+    while (not text.empty() && text.front() == ' ')
+    {
+        text.remove_prefix(1);
+    }
+    while (not text.empty() && text.back() == ' ')
+    {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+/**
+ * \brief Splits the text on the separator, ignoring separators nested inside angle brackets.
+ */
+std::vector<std::string_view> splitOutsideBrackets(const std::string_view text,
+                                                   const char separator)
+{
+    std::vector<std::string_view> parts;
+    auto depth = 0;
+    std::size_t begin = 0;
+    for (std::size_t i = 0; i < text.size(); ++i)
+    {
+        if (text[i] == '<')
+        {
+            ++depth;
+        }
+        else if (text[i] == '>' && depth > 0)
+        {
+            --depth;
+        }
+        else if (text[i] == separator && depth == 0)
+        {
+            parts.push_back(text.substr(begin, i - begin));
+            begin = i + 1;
+        }
+    }
+    parts.push_back(text.substr(begin));
+    return parts;
+}
+
+}// namespace
+
+std::string_view BenchmarkName::namedArgument(const std::string_view key) const
+{
+    const auto found = std::ranges::find(namedArguments, key,
+                                         &std::pair<std::string_view, std::string_view>::first);
+    return found != namedArguments.end() ? found->second : std::string_view();
+}
+
+BenchmarkName parseBenchmarkName(const std::string_view name)
+{
+    BenchmarkName result;
+    const auto segments = splitOutsideBrackets(name, '/');
+    result.family = segments.front();
+    result.baseName = result.family;
+
+    if (const auto open = result.family.find('<');
+        open != std::string_view::npos && result.family.back() == '>')
+    {
+        result.baseName = result.family.substr(0, open);
+        const auto parameters = result.family.substr(open + 1, result.family.size() - open - 2);
+        for (const auto parameter: splitOutsideBrackets(parameters, ','))
+        {
+            result.templateParameters.push_back(trim(parameter));
+        }
+    }
+
+    for (auto segment = segments.begin() + 1; segment != segments.end(); ++segment)
+    {
+        if (const auto colon = segment->find(':'); colon != std::string_view::npos)
+        {
+            result.namedArguments.emplace_back(segment->substr(0, colon),
+                                               segment->substr(colon + 1));
+        }
+        else if (std::ranges::find(FLAGS, *segment) != FLAGS.end())
+        {
+            result.flags.push_back(*segment);
+        }
+        else
+        {
+            result.arguments.push_back(*segment);
+        }
+    }
+    return result;
+}
+
+}// namespace BPlotter
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace BPlotter
+{
+
+/**
+ * \brief Components of the name of a benchmark instance generated by Google Benchmark.
+ *
+ * For example "BM_Copy<int, 8>/64/len:16/threads:4/real_time" consists of:
+ * - family "BM_Copy<int, 8>" with the base name "BM_Copy",
+ * - template parameters "int" and "8",
+ * - positional argument "64",
+ * - named arguments "len" = "16" and "threads" = "4",
+ * - flag "real_time".
+ *
+ * All the views point into the parsed name, which has to outlive this object.
+ */
+struct BenchmarkName
+{
+    std::string_view family;
+    std::string_view baseName;
+    std::vector<std::string_view> templateParameters;
+    std::vector<std::string_view> arguments;
+    std::vector<std::pair<std::string_view, std::string_view>> namedArguments;
+    std::vector<std::string_view> flags;
+
+    /**
+     * \brief Returns the value of the named argument.
+     * \param key Name of the argument (e.g. "threads")
+     * \return Value of the argument or an empty view if there is no such argument
+     */
+    [[nodiscard]] std::string_view namedArgument(std::string_view key) const;
+};
+
+/**
+ * \brief Splits the name of a benchmark instance into its components.
+ * \param name The name of the benchmark instance (preferably the run name, without the
+ * aggregate suffix)
+ * \return Components of the name
+ */
+BenchmarkName parseBenchmarkName(std::string_view name);
+
+}// namespace BPlotter
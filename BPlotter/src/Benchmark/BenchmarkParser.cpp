@@ -0,0 +1,215 @@
+#include "BenchmarkParser.hpp"
+#include "pch.hpp"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <limits>
+#include <string_view>
+#include <nlohmann/json.hpp>
+
+#include "Benchmark/DecompressingStreamBuffer.hpp"
+#include "Memory/AllocationTracker.hpp"
+
+namespace BPlotter
+{
+
+namespace
+{
+
+/**
+ * \brief Fields of the benchmark entry that are not user counters.
+ */
+constexpr std::array NON_COUNTER_FIELDS = {
+    "name",           "family_index",    "per_family_instance_index",
+    "run_name",       "run_type",        "repetitions",
+    "repetition_index", "threads",       "iterations",
+    "real_time",      "cpu_time",        "time_unit",
+    "aggregate_name", "aggregate_unit",  "label",
+    "error_occurred", "error_message",   "big_o",
+    "cpu_coefficient", "real_coefficient", "rms",
+};
+
+bool isCounter(const std::string_view field)
+{
+    return std::ranges::find(NON_COUNTER_FIELDS, field) == NON_COUNTER_FIELDS.end();
+}
+
+/**
+ * \brief Returns how many nanoseconds fit in the given Google Benchmark time unit.
+ */
+double nanosecondsPerUnit(const std::string_view timeUnit)
+{
+    if (timeUnit == "us")
+    {
+        return 1e3;
+    }
+    if (timeUnit == "ms")
+    {
+        return 1e6;
+    }
+    if (timeUnit == "s")
+    {
+        return 1e9;
+    }
+    return 1;
+}
+
+template<typename T>
+T valueOr(const nlohmann::json& object, const char* key, T defaultValue)
+{
+    if (const auto found = object.find(key); found != object.end() && not found->is_null())
+    {
+        return found->get<T>();
+    }
+    return defaultValue;
+}
+
+BenchmarkContext parseContext(const nlohmann::json& context)
+{
+    BenchmarkContext result;
+    result.date = valueOr<std::string>(context, "date", {});
+    result.hostName = valueOr<std::string>(context, "host_name", {});
+    result.executable = valueOr<std::string>(context, "executable", {});
+    result.numCpus = valueOr<int>(context, "num_cpus", 0);
+    result.mhzPerCpu = valueOr<double>(context, "mhz_per_cpu", 0);
+    result.cpuScalingEnabled = valueOr<bool>(context, "cpu_scaling_enabled", false);
+    result.libraryBuildType = valueOr<std::string>(context, "library_build_type", {});
+    if (const auto caches = context.find("caches"); caches != context.end() && caches->is_array())
+    {
+        for (const auto& cache: *caches)
+        {
+            result.caches.push_back({valueOr<std::string>(cache, "type", {}),
+                                     valueOr<int>(cache, "level", 0),
+                                     valueOr<double>(cache, "size", 0),
+                                     valueOr<int>(cache, "num_sharing", 0)});
+        }
+    }
+    return result;
+}
+
+cpp::result<BenchmarkResults, std::string> parseDocument(const nlohmann::json& document)
+{
+    if (not document.is_object())
+    {
+        return cpp::fail(std::string("The document is not a JSON object"));
+    }
+
+    const auto benchmarks = document.find("benchmarks");
+    if (benchmarks == document.end() || not benchmarks->is_array())
+    {
+        return cpp::fail(std::string("The document has no \"benchmarks\" array"));
+    }
+
+    BenchmarkResults results;
+    if (const auto context = document.find("context"); context != document.end())
+    {
+        results.setContext(parseContext(*context));
+    }
+
+    constexpr auto NaN = std::numeric_limits<double>::quiet_NaN();
+    BenchmarkRow row;
+    for (const auto& entry: *benchmarks)
+    {
+        if (valueOr<bool>(entry, "error_occurred", false))
+        {
+            spdlog::warn("[BenchmarkParser] Skipping {}: {}",
+                         valueOr<std::string>(entry, "name", "unnamed benchmark"),
+                         valueOr<std::string>(entry, "error_message", "unknown error"));
+            continue;
+        }
+
+        const auto& name = entry.at("name").get_ref<const std::string&>();
+        const auto runName = entry.find("run_name");
+        const auto aggregateName = entry.find("aggregate_name");
+        row.name = name;
+        row.runName = runName != entry.end()
+                          ? std::string_view(runName->get_ref<const std::string&>())
+                          : std::string_view(name);
+        row.runType = valueOr<std::string>(entry, "run_type", "iteration") == "aggregate"
+                          ? RunType::Aggregate
+                          : RunType::Iteration;
+        row.aggregateName = aggregateName != entry.end()
+                                ? std::string_view(aggregateName->get_ref<const std::string&>())
+                                : std::string_view();
+
+        // Relative aggregates (e.g. coefficient of variation) are not expressed in time units
+        const auto isPercentage = valueOr<std::string>(entry, "aggregate_unit", {}) == "percentage";
+        const auto timeScale =
+            isPercentage ? 1 : nanosecondsPerUnit(valueOr<std::string>(entry, "time_unit", "ns"));
+
+        row.iterations = valueOr<double>(entry, "iterations", NaN);
+        row.realTime = valueOr<double>(entry, "real_time", NaN) * timeScale;
+        row.cpuTime = valueOr<double>(entry, "cpu_time", NaN) * timeScale;
+        row.threads = valueOr<double>(entry, "threads", 1);
+        row.repetitionIndex = valueOr<double>(entry, "repetition_index", 0);
+
+        row.counters.clear();
+        for (const auto& [field, value]: entry.items())
+        {
+            if (value.is_number() && isCounter(field))
+            {
+                row.counters.emplace_back(field, value.get<double>());
+            }
+        }
+
+        results.append(row);
+    }
+    return results;
+}
+
+}// namespace
+
+cpp::result<BenchmarkResults, std::string> parseBenchmarkResults(std::istream& input)
+{
+    AllocationScope scope(AllocationSubsystem::Parser);
+    try
+    {
+        return parseDocument(nlohmann::json::parse(input));
+    }
+    catch (const nlohmann::json::exception& e)
+    {
+        return cpp::fail(std::string(e.what()));
+    }
+}
+
+cpp::result<BenchmarkResults, std::string> loadBenchmarkResults(const std::filesystem::path& path,
+                                                                TaskScheduler& scheduler)
+{
+    auto file = std::make_unique<std::ifstream>(path, std::ios::binary);
+    if (not *file)
+    {
+        return cpp::fail("Unable to open the file: " + path.string());
+    }
+
+    const auto compression = detectCompression(*file);
+    if (compression == Compression::None)
+    {
+        return parseBenchmarkResults(*file);
+    }
+
+    // The tasks of the scheduler decompress the next chunks while the parser reads the
+    // previous ones
+    DecompressingStreamBuffer buffer(std::move(file), compression, scheduler);
+    std::istream stream(&buffer);
+    auto results = parseBenchmarkResults(stream);
+    if (const auto error = buffer.error(); not error.empty())
+    {
+        return cpp::fail(fmt::format("Unable to decompress {}: {}", path.string(), error));
+    }
+    return results;
+}
+
+bool isResultFile(const std::filesystem::path& path)
+{
+    constexpr auto EXTENSIONS = std::array<std::string_view, 3>{".json", ".json.gz", ".json.zst"};
+    const auto name = path.filename().string();
+    return std::ranges::any_of(EXTENSIONS,
+                               [&name](const std::string_view extension)
+                               {
+                                   return name.size() > extension.size() &&
+                                          name.ends_with(extension);
+                               });
+}
+
+}// namespace BPlotter
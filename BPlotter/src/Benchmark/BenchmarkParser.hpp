@@ -0,0 +1,45 @@
+#pragma once
+
+#include <filesystem>
+#include <istream>
+#include <string>
+
+#include <result.hpp>
+
+#include "Benchmark/BenchmarkResults.hpp"
+#include "Tasks/TaskScheduler.hpp"
+
+namespace BPlotter
+{
+
+/**
+ * \brief Parses the JSON output of Google Benchmark (--benchmark_format=json).
+ * \param input Stream containing the JSON document
+ * \return The parsed results, or a description of the error
+ *
+ * All times are converted to nanoseconds. Every numeric field of a benchmark entry that is
+ * not a standard Google Benchmark field is treated as a user counter. Entries that
+ * reported an error are skipped.
+ */
+cpp::result<BenchmarkResults, std::string> parseBenchmarkResults(std::istream& input);
+
+/**
+ * \brief Reads and parses the JSON output of Google Benchmark from a file.
+ *
+ * Files compressed with gzip or zstd (e.g. .json.gz, .json.zst) are recognized by their
+ * magic bytes and decompressed on the fly, without storing the decompressed file.
+ * \param path Path to the file containing the results
+ * \param scheduler Scheduler decompressing the file while it is being parsed
+ * \return The parsed results, or a description of the error
+ */
+cpp::result<BenchmarkResults, std::string> loadBenchmarkResults(const std::filesystem::path& path,
+                                                                TaskScheduler& scheduler);
+
+/**
+ * \brief Whether the name of the file is one of a result file loadBenchmarkResults reads.
+ * \param path Path to the file
+ * \return True for .json, .json.gz and .json.zst files
+ */
+bool isResultFile(const std::filesystem::path& path);
+
+}// namespace BPlotter
@@ -0,0 +1,541 @@
+#include "BenchmarkResults.hpp"
+#include "pch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Utils/BinaryIo.hpp"
+
+namespace BPlotter
+{
+
+namespace
+{
+
+constexpr std::uint32_t CACHE_MAGIC = 0x43525042;// "BPRC"
+constexpr std::uint32_t CACHE_VERSION = 1;
+
+/**
+ * \brief Writes the binary cache, counting the written bytes to align the columns.
+ */
+class CacheWriter
+{
+public:
+    explicit CacheWriter(std::ostream& output)
+        : mOutput(output)
+    {
+    }
+
+    template<typename T>
+    void value(const T& value)
+    {
+        bytes(&value, sizeof(T));
+    }
+
+    template<typename T>
+    void array(std::span<const T> values)
+    {
+        bytes(values.data(), values.size_bytes());
+    }
+
+    void string(const std::string_view text)
+    {
+        value(static_cast<std::uint32_t>(text.size()));
+        bytes(text.data(), text.size());
+    }
+
+    void interner(const StringInterner& strings)
+    {
+        value(static_cast<std::uint32_t>(strings.size()));
+        for (StringId id = 0; id < strings.size(); ++id)
+        {
+            string(strings.get(id));
+        }
+    }
+
+    void alignTo(const std::size_t alignment)
+    {
+        constexpr char PADDING[8] = {};
+        bytes(PADDING, (alignment - mWritten % alignment) % alignment);
+    }
+
+private:
+    void bytes(const void* data, const std::size_t size)
+    {
+        mOutput.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        mWritten += size;
+    }
+
+    std::ostream& mOutput;
+    std::size_t mWritten = 0;
+};
+
+/**
+ * \brief Reads the binary cache, remembering whether any of the reads failed.
+ *
+ * Every length read from the cache is checked against the size of the rest of the stream
+ * before anything is allocated for it, so that a corrupted length fails the read instead of
+ * allocating gigabytes.
+ */
+class CacheReader
+{
+public:
+    explicit CacheReader(std::istream& input)
+        : mInput(input)
+        , mSize(remainingBytes(input))
+    {
+    }
+
+    template<typename T>
+    T value()
+    {
+        auto value = T{};
+        bytes(&value, sizeof(T));
+        return value;
+    }
+
+    template<typename T>
+    void array(std::vector<T>& values, const std::size_t size)
+    {
+        if (!fits(size, sizeof(T)))
+        {
+            values.clear();
+            return;
+        }
+        values.resize(size);
+        bytes(values.data(), size * sizeof(T));
+    }
+
+    std::string string()
+    {
+        const auto size = value<std::uint32_t>();
+        if (!fits(size, sizeof(char)))
+        {
+            return {};
+        }
+        std::string text(size, '\0');
+        bytes(text.data(), text.size());
+        return text;
+    }
+
+    std::vector<std::string> strings()
+    {
+        // Every string takes at least its length
+        const auto count = value<std::uint32_t>();
+        if (!fits(count, sizeof(std::uint32_t)))
+        {
+            return {};
+        }
+        std::vector<std::string> texts(count);
+        for (auto& text: texts)
+        {
+            text = string();
+            if (!isGood())
+            {
+                break;
+            }
+        }
+        return texts;
+    }
+
+    void alignTo(const std::size_t alignment)
+    {
+        char padding[8];
+        bytes(padding, (alignment - mRead % alignment) % alignment);
+    }
+
+    [[nodiscard]] bool isGood() const
+    {
+        return static_cast<bool>(mInput);
+    }
+
+    /**
+     * \return True if any of the lengths did not fit into the rest of the stream
+     */
+    [[nodiscard]] bool isCorrupted() const noexcept
+    {
+        return mIsCorrupted;
+    }
+
+private:
+    /**
+     * \brief Checks that the given number of elements can still be read, failing the reader
+     * otherwise.
+     */
+    bool fits(const std::size_t count, const std::size_t elementSize)
+    {
+        if (!isGood())
+        {
+            return false;
+        }
+        if (count > (mSize - std::min(mRead, mSize)) / elementSize)
+        {
+            mIsCorrupted = true;
+            mInput.setstate(std::ios::failbit);
+            return false;
+        }
+        return true;
+    }
+
+    void bytes(void* data, const std::size_t size)
+    {
+        if (mInput)
+        {
+            mInput.read(static_cast<char*>(data), static_cast<std::streamsize>(size));
+            mRead += size;
+        }
+    }
+
+    std::istream& mInput;
+    std::size_t mSize;
+    std::size_t mRead = 0;
+    bool mIsCorrupted = false;
+};
+
+}// namespace
+
+BenchmarkResults::BenchmarkResults()
+{
+    // The order must match the order of BuiltinColumn
+    for (const auto name: {"iterations", "real_time", "cpu_time", "threads", "repetition_index"})
+    {
+        columnFor(name);
+    }
+    assert(mColumns.size() == static_cast<std::size_t>(BuiltinColumn::Count));
+}
+
+void BenchmarkResults::append(const BenchmarkRow& row)
+{
+    mNameColumn.push_back(mNames.intern(row.name));
+    mRunNameColumn.push_back(mNames.intern(row.runName.empty() ? row.name : row.runName));
+    mRunTypeColumn.push_back(row.runType);
+    mAggregateNameColumn.push_back(mAggregateNames.intern(row.aggregateName));
+
+    for (auto& values: mColumns)
+    {
+        values.push_back(std::numeric_limits<double>::quiet_NaN());
+    }
+
+    const auto set = [this](BuiltinColumn column, double value)
+    {
+        mColumns[static_cast<ColumnIndex>(column)].back() = value;
+    };
+    set(BuiltinColumn::Iterations, row.iterations);
+    set(BuiltinColumn::RealTime, row.realTime);
+    set(BuiltinColumn::CpuTime, row.cpuTime);
+    set(BuiltinColumn::Threads, row.threads);
+    set(BuiltinColumn::RepetitionIndex, row.repetitionIndex);
+
+    for (const auto& [name, value]: row.counters)
+    {
+        mColumns[columnFor(name)].back() = value;
+    }
+}
+
+BenchmarkRow BenchmarkResults::row(const std::size_t index) const
+{
+    assert(index < size());
+    const auto value = [this, index](BuiltinColumn column)
+    {
+        return mColumns[static_cast<ColumnIndex>(column)][index];
+    };
+    auto row = BenchmarkRow{.name = mNames.get(mNameColumn[index]),
+                            .runName = mNames.get(mRunNameColumn[index]),
+                            .runType = mRunTypeColumn[index],
+                            .aggregateName = mAggregateNames.get(mAggregateNameColumn[index]),
+                            .iterations = value(BuiltinColumn::Iterations),
+                            .realTime = value(BuiltinColumn::RealTime),
+                            .cpuTime = value(BuiltinColumn::CpuTime),
+                            .threads = value(BuiltinColumn::Threads),
+                            .repetitionIndex = value(BuiltinColumn::RepetitionIndex)};
+    for (auto column = static_cast<ColumnIndex>(BuiltinColumn::Count); column < mColumns.size();
+         ++column)
+    {
+        if (const auto counter = mColumns[column][index]; !std::isnan(counter))
+        {
+            row.counters.emplace_back(columnName(column), counter);
+        }
+    }
+    return row;
+}
+
+std::size_t BenchmarkResults::size() const noexcept
+{
+    return mNameColumn.size();
+}
+
+bool BenchmarkResults::empty() const noexcept
+{
+    return mNameColumn.empty();
+}
+
+const StringInterner& BenchmarkResults::names() const noexcept
+{
+    return mNames;
+}
+
+const StringInterner& BenchmarkResults::aggregateNames() const noexcept
+{
+    return mAggregateNames;
+}
+
+std::span<const StringId> BenchmarkResults::nameColumn() const noexcept
+{
+    return mNameColumn;
+}
+
+std::span<const StringId> BenchmarkResults::runNameColumn() const noexcept
+{
+    return mRunNameColumn;
+}
+
+std::span<const RunType> BenchmarkResults::runTypeColumn() const noexcept
+{
+    return mRunTypeColumn;
+}
+
+std::span<const StringId> BenchmarkResults::aggregateNameColumn() const noexcept
+{
+    return mAggregateNameColumn;
+}
+
+std::size_t BenchmarkResults::columnCount() const noexcept
+{
+    return mColumns.size();
+}
+
+std::string_view BenchmarkResults::columnName(const ColumnIndex index) const
+{
+    return mColumnNames.get(static_cast<StringId>(index));
+}
+
+std::optional<ColumnIndex> BenchmarkResults::findColumn(const std::string_view name) const
+{
+    if (const auto id = mColumnNames.find(name))
+    {
+        return static_cast<ColumnIndex>(*id);
+    }
+    return std::nullopt;
+}
+
+std::span<const double> BenchmarkResults::column(const ColumnIndex index) const
+{
+    assert(index < mColumns.size());
+    return mColumns[index];
+}
+
+std::span<const double> BenchmarkResults::column(const BuiltinColumn column) const
+{
+    return this->column(static_cast<ColumnIndex>(column));
+}
+
+std::optional<ColumnIndex> BenchmarkResults::addColumn(const std::string_view name)
+{
+    if (findColumn(name))
+    {
+        return std::nullopt;
+    }
+    const auto column = columnFor(name);
+    mIsComputedColumn[column] = true;
+    return column;
+}
+
+std::span<double> BenchmarkResults::mutableColumn(const ColumnIndex index)
+{
+    assert(index < mColumns.size());
+    return mColumns[index];
+}
+
+bool BenchmarkResults::isComputedColumn(const ColumnIndex index) const
+{
+    assert(index < mColumns.size());
+    return mIsComputedColumn[index];
+}
+
+std::size_t BenchmarkResults::memoryUsage() const noexcept
+{
+    auto bytes = mNames.memoryUsage() + mAggregateNames.memoryUsage() +
+                 mColumnNames.memoryUsage();
+    bytes += (mNameColumn.capacity() + mRunNameColumn.capacity() +
+              mAggregateNameColumn.capacity()) * sizeof(StringId);
+    bytes += mRunTypeColumn.capacity() * sizeof(RunType);
+    for (const auto& values: mColumns)
+    {
+        bytes += sizeof(values) + values.capacity() * sizeof(double);
+    }
+    return bytes;
+}
+
+const BenchmarkContext& BenchmarkResults::context() const noexcept
+{
+    return mContext;
+}
+
+void BenchmarkResults::setContext(BenchmarkContext context)
+{
+    mContext = std::move(context);
+}
+
+cpp::result<void, std::string> BenchmarkResults::writeCache(std::ostream& output) const
+{
+    CacheWriter writer(output);
+    writer.value(CACHE_MAGIC);
+    writer.value(CACHE_VERSION);
+    writer.value(static_cast<std::uint64_t>(size()));
+
+    writer.interner(mNames);
+    writer.interner(mAggregateNames);
+    writer.interner(mColumnNames);
+    for (const auto isComputed: mIsComputedColumn)
+    {
+        writer.value(static_cast<std::uint8_t>(isComputed));
+    }
+
+    writer.string(mContext.date);
+    writer.string(mContext.hostName);
+    writer.string(mContext.executable);
+    writer.value(static_cast<std::int32_t>(mContext.numCpus));
+    writer.value(mContext.mhzPerCpu);
+    writer.value(static_cast<std::uint8_t>(mContext.cpuScalingEnabled));
+    writer.string(mContext.libraryBuildType);
+    writer.value(static_cast<std::uint32_t>(mContext.caches.size()));
+    for (const auto& cache: mContext.caches)
+    {
+        writer.string(cache.type);
+        writer.value(static_cast<std::int32_t>(cache.level));
+        writer.value(cache.size);
+        writer.value(static_cast<std::int32_t>(cache.numSharing));
+    }
+
+    writer.array(nameColumn());
+    writer.array(runNameColumn());
+    writer.array(runTypeColumn());
+    writer.array(aggregateNameColumn());
+    writer.alignTo(alignof(double));
+    for (const auto& values: mColumns)
+    {
+        writer.array(std::span<const double>(values));
+    }
+
+    if (!output)
+    {
+        return cpp::fail(std::string("Unable to write the results"));
+    }
+    return {};
+}
+
+cpp::result<BenchmarkResults, std::string> BenchmarkResults::readCache(std::istream& input)
+{
+    CacheReader reader(input);
+    if (reader.value<std::uint32_t>() != CACHE_MAGIC ||
+        reader.value<std::uint32_t>() != CACHE_VERSION)
+    {
+        return cpp::fail(std::string("Not a results cache or written by another version"));
+    }
+    const auto corrupted = []
+    {
+        return cpp::fail(std::string("The results cache is corrupted"));
+    };
+
+    const auto rows = reader.value<std::uint64_t>();
+    if (rows > std::numeric_limits<StringId>::max())
+    {
+        return corrupted();
+    }
+
+    BenchmarkResults results;
+    for (const auto& name: reader.strings())
+    {
+        results.mNames.intern(name);
+    }
+    for (const auto& name: reader.strings())
+    {
+        results.mAggregateNames.intern(name);
+    }
+
+    // The builtin columns are already there, the others are created in the written order.
+    // A name at an unexpected index means that the names are duplicated or out of order.
+    const auto columnNames = reader.strings();
+    if (!reader.isGood() || columnNames.size() < results.columnCount())
+    {
+        return corrupted();
+    }
+    for (ColumnIndex column = 0; column < columnNames.size(); ++column)
+    {
+        if (results.columnFor(columnNames[column]) != column)
+        {
+            return corrupted();
+        }
+        results.mIsComputedColumn[column] = reader.value<std::uint8_t>() != 0;
+    }
+
+    auto& context = results.mContext;
+    context.date = reader.string();
+    context.hostName = reader.string();
+    context.executable = reader.string();
+    context.numCpus = reader.value<std::int32_t>();
+    context.mhzPerCpu = reader.value<double>();
+    context.cpuScalingEnabled = reader.value<std::uint8_t>() != 0;
+    context.libraryBuildType = reader.string();
+    const auto caches = reader.value<std::uint32_t>();
+    for (std::uint32_t i = 0; i < caches && reader.isGood(); ++i)
+    {
+        auto& cache = context.caches.emplace_back();
+        cache.type = reader.string();
+        cache.level = reader.value<std::int32_t>();
+        cache.size = reader.value<double>();
+        cache.numSharing = reader.value<std::int32_t>();
+    }
+
+    reader.array(results.mNameColumn, rows);
+    reader.array(results.mRunNameColumn, rows);
+    reader.array(results.mRunTypeColumn, rows);
+    reader.array(results.mAggregateNameColumn, rows);
+    reader.alignTo(alignof(double));
+    for (auto& values: results.mColumns)
+    {
+        reader.array(values, rows);
+    }
+    if (reader.isCorrupted())
+    {
+        return corrupted();
+    }
+    if (!reader.isGood())
+    {
+        return cpp::fail(std::string("The results cache is incomplete"));
+    }
+
+    const auto isKnown = [](const StringInterner& strings)
+    {
+        return [&strings](const StringId id)
+        {
+            return id < strings.size();
+        };
+    };
+    const auto isValidType = [](const RunType type)
+    {
+        return type == RunType::Iteration || type == RunType::Aggregate;
+    };
+    if (!std::ranges::all_of(results.mNameColumn, isKnown(results.mNames)) ||
+        !std::ranges::all_of(results.mRunNameColumn, isKnown(results.mNames)) ||
+        !std::ranges::all_of(results.mAggregateNameColumn, isKnown(results.mAggregateNames)) ||
+        !std::ranges::all_of(results.mRunTypeColumn, isValidType))
+    {
+        return corrupted();
+    }
+    return results;
+}
+
+ColumnIndex BenchmarkResults::columnFor(const std::string_view name)
+{
+    const auto id = mColumnNames.intern(name);
+    if (id == mColumns.size())
+    {
+        mColumns.emplace_back(size(), std::numeric_limits<double>::quiet_NaN());
+        mIsComputedColumn.push_back(false);
+    }
+    return static_cast<ColumnIndex>(id);
+}
+
+}// namespace BPlotter
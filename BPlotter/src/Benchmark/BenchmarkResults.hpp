@@ -0,0 +1,303 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <result.hpp>
+
+#include "Benchmark/StringInterner.hpp"
+
+namespace BPlotter
+{
+
+/**
+ * \brief Index of a numeric column inside the BenchmarkResults.
+ */
+using ColumnIndex = std::size_t;
+
+/**
+ * \brief Numeric columns that are present in every BenchmarkResults, in this exact order.
+ *
+ * Any user counter found in the benchmark file is appended after them.
+ */
+enum class BuiltinColumn : ColumnIndex
+{
+    Iterations,
+    RealTime,
+    CpuTime,
+    Threads,
+    RepetitionIndex,
+    Count,
+};
+
+/**
+ * \brief Type of the row reported by Google Benchmark.
+ */
+enum class RunType : std::uint8_t
+{
+    Iteration,
+    Aggregate,
+};
+
+/**
+ * \brief Description of a single CPU cache, as reported in the context of the run.
+ */
+struct CacheInfo
+{
+    /**
+     * \brief Kind of the cache: "Data", "Instruction" or "Unified".
+     */
+    std::string type;
+    int level = 0;
+    double size = 0;
+
+    /**
+     * \brief Number of the logical CPUs sharing a single instance of this cache.
+     */
+    int numSharing = 0;
+};
+
+/**
+ * \brief Information about the machine and the executable that produced the results.
+ */
+struct BenchmarkContext
+{
+    std::string date;
+    std::string hostName;
+    std::string executable;
+    int numCpus = 0;
+    double mhzPerCpu = 0;
+    bool cpuScalingEnabled = false;
+    std::string libraryBuildType;
+    std::vector<CacheInfo> caches;
+};
+
+/**
+ * \brief A single row of the benchmark results, used only to append data to BenchmarkResults.
+ *
+ * The times are expected to be already converted to nanoseconds.
+ */
+struct BenchmarkRow
+{
+    std::string_view name;
+    std::string_view runName;
+    RunType runType = RunType::Iteration;
+    std::string_view aggregateName;
+    double iterations = 0;
+    double realTime = 0;
+    double cpuTime = 0;
+    double threads = 1;
+    double repetitionIndex = 0;
+    std::vector<std::pair<std::string_view, double>> counters;
+};
+
+/**
+ * \brief Columnar storage of the rows of a single benchmark run.
+ *
+ * Each attribute of a row is kept in its own contiguous vector, so the analysis code
+ * can go through a single attribute of hundreds of thousands of rows without touching the
+ * others. Strings are interned and stored as identifiers. Numeric columns that are missing
+ * in a row (for example a counter reported only by some of the benchmarks) hold NaN.
+ *
+ * Rows are only ever appended, never modified or removed. The only exception are the
+ * columns added with addColumn(), whose values are computed by their owner after the rows
+ * are appended (e.g. derived metrics).
+ */
+class BenchmarkResults
+{
+public:
+    BenchmarkResults();
+
+    /**
+     * \brief Appends a row at the end of the results.
+     * \param row Row to be appended
+     */
+    void append(const BenchmarkRow& row);
+
+    /**
+     * \brief Reconstructs the row, e.g. to append it to other results.
+     * \param index Index of the row
+     * \return The row with the counters that have a value in it. Its strings point to the
+     * interners of these results.
+     */
+    [[nodiscard]] BenchmarkRow row(std::size_t index) const;
+
+    /**
+     * \brief Number of rows stored in the results.
+     * \return Number of rows
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * \brief Checks that there are no rows in the results.
+     * \return True if there are no rows, false otherwise
+     */
+    [[nodiscard]] bool empty() const noexcept;
+
+    /**
+     * \brief Interned benchmark names, used by both the name and the run name columns.
+     * \return Interner containing the benchmark names
+     */
+    [[nodiscard]] const StringInterner& names() const noexcept;
+
+    /**
+     * \brief Interned aggregate names (mean, median, stddev...).
+     * \return Interner containing the aggregate names
+     */
+    [[nodiscard]] const StringInterner& aggregateNames() const noexcept;
+
+    /**
+     * \brief Full names of the benchmarks, one for each row.
+     * \return Column with the identifiers of the names inside names()
+     */
+    [[nodiscard]] std::span<const StringId> nameColumn() const noexcept;
+
+    /**
+     * \brief Names of the runs the rows belong to. Aggregates share it with their iterations.
+     * \return Column with the identifiers of the run names inside names()
+     */
+    [[nodiscard]] std::span<const StringId> runNameColumn() const noexcept;
+
+    /**
+     * \brief Types of the rows.
+     * \return Column with the types of the rows
+     */
+    [[nodiscard]] std::span<const RunType> runTypeColumn() const noexcept;
+
+    /**
+     * \brief Aggregate names of the rows. Iteration rows have an empty aggregate name.
+     * \return Column with the identifiers of the aggregates inside aggregateNames()
+     */
+    [[nodiscard]] std::span<const StringId> aggregateNameColumn() const noexcept;
+
+    /**
+     * \brief Number of numeric columns, including the builtin ones.
+     * \return Number of numeric columns
+     */
+    [[nodiscard]] std::size_t columnCount() const noexcept;
+
+    /**
+     * \brief Name of the numeric column, as it appears in the benchmark file.
+     * \param index Index of the column
+     * \return Name of the column
+     */
+    [[nodiscard]] std::string_view columnName(ColumnIndex index) const;
+
+    /**
+     * \brief Looks for the numeric column with the given name.
+     * \param name Name of the column as it appears in the benchmark file (e.g. "cpu_time")
+     * \return Index of the column or nullopt if there is no such column
+     */
+    [[nodiscard]] std::optional<ColumnIndex> findColumn(std::string_view name) const;
+
+    /**
+     * \brief Values of the numeric column, one for each row.
+     * \param index Index of the column
+     * \return Values of the column
+     */
+    [[nodiscard]] std::span<const double> column(ColumnIndex index) const;
+
+    /**
+     * \brief Values of the builtin numeric column, one for each row.
+     * \param column Builtin column
+     * \return Values of the column
+     */
+    [[nodiscard]] std::span<const double> column(BuiltinColumn column) const;
+
+    /**
+     * \brief Adds a new numeric column filled with NaN, whose values are set by the caller.
+     * \param name Name of the new column
+     * \return Index of the new column or nullopt if a column with such name already exists
+     */
+    std::optional<ColumnIndex> addColumn(std::string_view name);
+
+    /**
+     * \brief Values of the numeric column that can be modified, one for each row.
+     * \param index Index of the column
+     * \return Values of the column
+     */
+    [[nodiscard]] std::span<double> mutableColumn(ColumnIndex index);
+
+    /**
+     * \brief Checks whether the column was added with addColumn() rather than read from
+     * the benchmark file.
+     * \param index Index of the column
+     * \return True if the values of the column are computed by its owner
+     */
+    [[nodiscard]] bool isComputedColumn(ColumnIndex index) const;
+
+    /**
+     * \brief Estimates the heap memory taken by the rows, the columns and the interned names.
+     * \return Number of bytes
+     */
+    [[nodiscard]] std::size_t memoryUsage() const noexcept;
+
+    /**
+     * \brief Information about the machine that produced the results.
+     * \return Context of the run
+     */
+    [[nodiscard]] const BenchmarkContext& context() const noexcept;
+
+    /**
+     * \brief Sets the information about the machine that produced the results.
+     * \param context Context of the run
+     */
+    void setContext(BenchmarkContext context);
+
+    /**
+     * \brief Writes the results in a binary form that is much faster to read than the
+     * benchmark file. The numeric columns are written as raw arrays aligned to 8 bytes
+     * relative to the beginning of the output, so the file can also be memory mapped.
+     * \param output Binary output stream
+     * \return Error message if the results could not be written
+     */
+    cpp::result<void, std::string> writeCache(std::ostream& output) const;
+
+    /**
+     * \brief Reads the results previously written by writeCache(). The string identifiers
+     * and the column indices are the same as in the written results.
+     * \param input Binary input stream positioned at the beginning of the written results
+     * \return Read results or an error message if the data is corrupted or incomplete
+     */
+    static cpp::result<BenchmarkResults, std::string> readCache(std::istream& input);
+
+private:
+    /**
+     * \brief Returns the index of the numeric column with the given name. If there is no
+     * such column, it is created and filled with NaN for all already existing rows.
+     * \param name Name of the column
+     * \return Index of the column
+     */
+    ColumnIndex columnFor(std::string_view name);
+
+    StringInterner mNames;
+    StringInterner mAggregateNames;
+    StringInterner mColumnNames;
+
+    std::vector<StringId> mNameColumn;
+    std::vector<StringId> mRunNameColumn;
+    std::vector<RunType> mRunTypeColumn;
+    std::vector<StringId> mAggregateNameColumn;
+
+    /**
+     * \brief Numeric columns, indexed by ColumnIndex. Column names are stored in
+     * mColumnNames under the identifier equal to the index of the column.
+     */
+    std::vector<std::vector<double>> mColumns;
+
+    /**
+     * \brief Marks the columns added with addColumn(), indexed by ColumnIndex.
+     */
+    std::vector<bool> mIsComputedColumn;
+
+    BenchmarkContext mContext;
+};
+
+}// namespace BPlotter
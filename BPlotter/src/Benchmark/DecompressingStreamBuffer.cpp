@@ -0,0 +1,419 @@
+#include "DecompressingStreamBuffer.hpp"
+#include "pch.hpp"
+
+#include <array>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <zlib.h>
+#include <zstd.h>
+
+#include <result.hpp>
+
+namespace BPlotter
+{
+
+namespace
+{
+
+constexpr std::array<unsigned char, 2> GZIP_MAGIC = {0x1f, 0x8b};
+constexpr std::array<unsigned char, 4> ZSTD_MAGIC = {0x28, 0xb5, 0x2f, 0xfd};
+
+/**
+ * \brief Size of the blocks of compressed data read from the source.
+ */
+constexpr auto INPUT_BLOCK_SIZE = std::size_t{64 * 1024};
+
+template<std::size_t Size>
+bool startsWith(const std::span<const char> data, const std::array<unsigned char, Size>& magic)
+{
+    return data.size() >= Size && std::memcmp(data.data(), magic.data(), Size) == 0;
+}
+
+/**
+ * \brief Decompresses the source into the consecutive output buffers.
+ */
+class Decompressor
+{
+public:
+    explicit Decompressor(std::istream& source)
+        : mSource(source)
+        , mInput(INPUT_BLOCK_SIZE)
+    {
+    }
+    virtual ~Decompressor() = default;
+
+    /**
+     * \brief Fills the output with the decompressed data.
+     * \return Number of bytes written, less than the size of the output only at the end
+     */
+    virtual cpp::result<std::size_t, std::string> read(std::span<char> output) = 0;
+
+protected:
+    /**
+     * \brief Reads the next block of the compressed data.
+     * \return The read block, empty at the end of the source
+     */
+    std::span<const char> readInput()
+    {
+        mSource.read(mInput.data(), static_cast<std::streamsize>(mInput.size()));
+        return {mInput.data(), static_cast<std::size_t>(mSource.gcount())};
+    }
+
+private:
+    std::istream& mSource;
+    std::vector<char> mInput;
+};
+
+class GzipDecompressor : public Decompressor
+{
+public:
+    explicit GzipDecompressor(std::istream& source)
+        : Decompressor(source)
+    {
+        // 32 enables the detection of the gzip and zlib headers
+        mIsInitialized = inflateInit2(&mStream, 15 + 32) == Z_OK;
+    }
+
+    ~GzipDecompressor() override
+    {
+        if (mIsInitialized)
+        {
+            inflateEnd(&mStream);
+        }
+    }
+
+    cpp::result<std::size_t, std::string> read(const std::span<char> output) override
+    {
+        if (!mIsInitialized)
+        {
+            return cpp::fail(std::string("Unable to initialize zlib"));
+        }
+        mStream.next_out = reinterpret_cast<Bytef*>(output.data());
+        mStream.avail_out = static_cast<uInt>(output.size());
+        while (mStream.avail_out > 0 && !mIsEnd)
+        {
+            if (mStream.avail_in == 0)
+            {
+                const auto input = readInput();
+                if (input.empty())
+                {
+                    if (!mIsMemberFinished)
+                    {
+                        return cpp::fail(std::string("The gzip data is truncated"));
+                    }
+                    mIsEnd = true;
+                    break;
+                }
+                mStream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+                mStream.avail_in = static_cast<uInt>(input.size());
+            }
+
+            const auto status = inflate(&mStream, Z_NO_FLUSH);
+            mIsMemberFinished = status == Z_STREAM_END;
+            if (status == Z_STREAM_END)
+            {
+                // Files can consist of several concatenated gzip members
+                inflateReset(&mStream);
+            }
+            else if (status != Z_OK && status != Z_BUF_ERROR)
+            {
+                return cpp::fail(fmt::format("Invalid gzip data: {}",
+                                             mStream.msg ? mStream.msg : "unknown error"));
+            }
+        }
+        return output.size() - mStream.avail_out;
+    }
+
+private:
+    z_stream mStream{};
+    bool mIsInitialized = false;
+    bool mIsMemberFinished = false;
+    bool mIsEnd = false;
+};
+
+class ZstdDecompressor : public Decompressor
+{
+public:
+    explicit ZstdDecompressor(std::istream& source)
+        : Decompressor(source)
+        , mContext(ZSTD_createDCtx())
+    {
+    }
+
+    ~ZstdDecompressor() override
+    {
+        ZSTD_freeDCtx(mContext);
+    }
+
+    cpp::result<std::size_t, std::string> read(const std::span<char> output) override
+    {
+        if (!mContext)
+        {
+            return cpp::fail(std::string("Unable to initialize zstd"));
+        }
+        auto outputBuffer = ZSTD_outBuffer{output.data(), output.size(), 0};
+        while (outputBuffer.pos < outputBuffer.size && !mIsEnd)
+        {
+            if (mInputBuffer.pos == mInputBuffer.size)
+            {
+                const auto input = readInput();
+                if (input.empty())
+                {
+                    // Zero means the last frame was completely decoded and flushed
+                    if (mLastResult != 0)
+                    {
+                        return cpp::fail(std::string("The zstd data is truncated"));
+                    }
+                    mIsEnd = true;
+                    break;
+                }
+                mInputBuffer = ZSTD_inBuffer{input.data(), input.size(), 0};
+            }
+
+            mLastResult = ZSTD_decompressStream(mContext, &outputBuffer, &mInputBuffer);
+            if (ZSTD_isError(mLastResult))
+            {
+                return cpp::fail(
+                    fmt::format("Invalid zstd data: {}", ZSTD_getErrorName(mLastResult)));
+            }
+        }
+        return outputBuffer.pos;
+    }
+
+private:
+    ZSTD_DCtx* mContext;
+    ZSTD_inBuffer mInputBuffer{nullptr, 0, 0};
+    std::size_t mLastResult = 0;
+    bool mIsEnd = false;
+};
+
+/**
+ * \brief Who decompresses the next chunk.
+ */
+enum class Producer
+{
+    Idle,
+
+    /**
+     * \brief A task is queued to decompress it, but has not started yet.
+     */
+    Queued,
+
+    /**
+     * \brief A task or the reader is decompressing it.
+     */
+    Running,
+};
+
+}// namespace
+
+Compression detectCompression(const std::span<const char> header)
+{
+    if (startsWith(header, GZIP_MAGIC))
+    {
+        return Compression::Gzip;
+    }
+    if (startsWith(header, ZSTD_MAGIC))
+    {
+        return Compression::Zstd;
+    }
+    return Compression::None;
+}
+
+Compression detectCompression(std::istream& input)
+{
+    std::array<char, ZSTD_MAGIC.size()> header{};
+    input.read(header.data(), header.size());
+    const auto count = static_cast<std::size_t>(input.gcount());
+    input.clear();
+    input.seekg(-static_cast<std::streamoff>(count), std::ios::cur);
+    return detectCompression(std::span<const char>(header.data(), count));
+}
+
+struct DecompressingStreamBuffer::Decompression
+{
+    /**
+     * \brief Decompresses the next chunk and queues it for the reader. Only the one that set
+     * the producer to Producer::Running calls it, so the decompressor is never used by two
+     * threads at once.
+     */
+    void decompressChunk();
+
+    /**
+     * \brief Body of the decompression tasks, which decompress the chunks until the queue is
+     * full, the data ends or the reader no longer needs them.
+     */
+    void produce();
+
+    std::unique_ptr<std::istream> source;
+    std::unique_ptr<Decompressor> decompressor;
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<std::vector<char>> filledChunks;
+    std::vector<std::vector<char>> freeChunks;
+    Producer producer = Producer::Idle;
+    bool isFinished = false;
+    bool isCancelled = false;
+    std::string error;
+};
+
+void DecompressingStreamBuffer::Decompression::decompressChunk()
+{
+    std::vector<char> chunk;
+    {
+        std::scoped_lock lock(mutex);
+        if (not freeChunks.empty())
+        {
+            chunk = std::move(freeChunks.back());
+            freeChunks.pop_back();
+        }
+    }
+    chunk.resize(CHUNK_SIZE);
+    const auto size = decompressor->read(chunk);
+
+    {
+        std::scoped_lock lock(mutex);
+        if (size.has_error())
+        {
+            isFinished = true;
+            error = size.error();
+        }
+        else
+        {
+            // Only the last chunk is not filled completely
+            isFinished = *size < CHUNK_SIZE;
+            chunk.resize(*size);
+            if (not chunk.empty())
+            {
+                filledChunks.push_back(std::move(chunk));
+            }
+        }
+    }
+    changed.notify_all();
+}
+
+void DecompressingStreamBuffer::Decompression::produce()
+{
+    std::unique_lock lock(mutex);
+    // The reader may have taken over the decompression while the task was queued
+    if (producer != Producer::Queued)
+    {
+        return;
+    }
+
+    producer = Producer::Running;
+    while (not isCancelled && not isFinished && filledChunks.size() < MAX_QUEUED_CHUNKS)
+    {
+        lock.unlock();
+        decompressChunk();
+        lock.lock();
+    }
+    producer = Producer::Idle;
+    lock.unlock();
+    changed.notify_all();
+}
+
+DecompressingStreamBuffer::DecompressingStreamBuffer(std::unique_ptr<std::istream> source,
+                                                     const Compression compression,
+                                                     TaskScheduler& scheduler)
+    : mScheduler(scheduler)
+    , mDecompression(std::make_shared<Decompression>())
+{
+    setg(nullptr, nullptr, nullptr);
+
+    auto& decompression = *mDecompression;
+    decompression.source = std::move(source);
+    switch (compression)
+    {
+        case Compression::Gzip:
+            decompression.decompressor = std::make_unique<GzipDecompressor>(*decompression.source);
+            break;
+        case Compression::Zstd:
+            decompression.decompressor = std::make_unique<ZstdDecompressor>(*decompression.source);
+            break;
+        case Compression::None:
+            decompression.isFinished = true;
+            decompression.error = "The data is not compressed";
+            return;
+    }
+    produceAhead();
+}
+
+DecompressingStreamBuffer::~DecompressingStreamBuffer()
+{
+    std::scoped_lock lock(mDecompression->mutex);
+    mDecompression->isCancelled = true;
+}
+
+std::string DecompressingStreamBuffer::error() const
+{
+    std::scoped_lock lock(mDecompression->mutex);
+    return mDecompression->error;
+}
+
+DecompressingStreamBuffer::int_type DecompressingStreamBuffer::underflow()
+{
+    if (gptr() < egptr())
+    {
+        return traits_type::to_int_type(*gptr());
+    }
+
+    auto& decompression = *mDecompression;
+    std::unique_lock lock(decompression.mutex);
+    if (mCurrentChunk.capacity() > 0)
+    {
+        decompression.freeChunks.push_back(std::move(mCurrentChunk));
+    }
+    while (decompression.filledChunks.empty() && not decompression.isFinished)
+    {
+        if (decompression.producer == Producer::Running)
+        {
+            decompression.changed.wait(lock);
+            continue;
+        }
+
+        // A queued task may never start if all the threads of the scheduler wait for one
+        decompression.producer = Producer::Running;
+        lock.unlock();
+        decompression.decompressChunk();
+        lock.lock();
+        decompression.producer = Producer::Idle;
+    }
+    if (decompression.filledChunks.empty())
+    {
+        mCurrentChunk = {};
+        setg(nullptr, nullptr, nullptr);
+        return traits_type::eof();
+    }
+
+    mCurrentChunk = std::move(decompression.filledChunks.front());
+    decompression.filledChunks.pop_front();
+    lock.unlock();
+    produceAhead();
+
+    setg(mCurrentChunk.data(), mCurrentChunk.data(), mCurrentChunk.data() + mCurrentChunk.size());
+    return traits_type::to_int_type(*gptr());
+}
+
+void DecompressingStreamBuffer::produceAhead()
+{
+    {
+        std::scoped_lock lock(mDecompression->mutex);
+        if (mDecompression->producer != Producer::Idle || mDecompression->isFinished ||
+            mDecompression->filledChunks.size() >= MAX_QUEUED_CHUNKS)
+        {
+            return;
+        }
+        mDecompression->producer = Producer::Queued;
+    }
+    mProduction = mScheduler.submit(TaskPriority::Interactive,
+                                    [decompression = mDecompression]
+                                    {
+                                        decompression->produce();
+                                    });
+}
+
+}// namespace BPlotter
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "Tasks/TaskScheduler.hpp"
+
+#include <cstddef>
+#include <future>
+#include <istream>
+#include <memory>
+#include <span>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace BPlotter
+{
+
+enum class Compression
+{
+    None,
+    Gzip,
+    Zstd,
+};
+
+/**
+ * \brief Recognizes the compression of the data by its magic bytes.
+ * \param header First bytes of the data (at least four are needed to recognize zstd)
+ * \return The recognized compression or Compression::None
+ */
+Compression detectCompression(std::span<const char> header);
+
+/**
+ * \brief Reads the first bytes of the stream and recognizes its compression.
+ * The read bytes are put back, so the stream can be read from its beginning.
+ * \param input Stream positioned at the beginning of the data
+ * \return The recognized compression or Compression::None
+ */
+Compression detectCompression(std::istream& input);
+
+/**
+ * \brief Stream buffer decompressing a gzip or zstd stream in the tasks of the scheduler.
+ *
+ * The tasks fill fixed-size chunks and pass them to the reader through a bounded queue, so
+ * the reader (e.g. the JSON parser) works on one chunk while the next ones are being
+ * decompressed. A task never waits for the reader: it returns once the queue is full and the
+ * reader queues another one after taking a chunk. When the queue is empty and no task runs,
+ * e.g. because all the threads of the scheduler are readers, the reader decompresses the next
+ * chunk itself. At most MAX_QUEUED_CHUNKS + 2 chunks exist at any time, so the whole
+ * decompressed data is never held in memory. Consumed chunks are reused.
+ */
+class DecompressingStreamBuffer : public std::streambuf
+{
+public:
+    /**
+     * \brief Starts decompressing the source.
+     * \param source Compressed stream, read only by the decompression
+     * \param compression Compression of the source, other than Compression::None
+     * \param scheduler Scheduler running the decompression ahead of the reader
+     */
+    DecompressingStreamBuffer(std::unique_ptr<std::istream> source, Compression compression,
+                              TaskScheduler& scheduler);
+    DecompressingStreamBuffer(const DecompressingStreamBuffer&) = delete;
+    DecompressingStreamBuffer& operator=(const DecompressingStreamBuffer&) = delete;
+
+    /**
+     * \brief Stops the decompression if the data was not read till the end. A task already
+     * decompressing a chunk finishes it on its own, without being waited for.
+     */
+    ~DecompressingStreamBuffer() override;
+
+    /**
+     * \brief Description of the decompression error, empty if there was none.
+     * It is known for certain only once the end of the data was reached.
+     * \return Description of the error
+     */
+    [[nodiscard]] std::string error() const;
+
+    static constexpr std::size_t CHUNK_SIZE = 256 * 1024;
+    static constexpr std::size_t MAX_QUEUED_CHUNKS = 4;
+
+protected:
+    int_type underflow() override;
+
+private:
+    /**
+     * \brief Source, decompressor and queue of the chunks. The tasks share it, as they may
+     * outlive the buffer.
+     */
+    struct Decompression;
+
+    /**
+     * \brief Queues a task decompressing the chunks ahead of the reader, unless one is
+     * already queued or running or the decompression finished.
+     */
+    void produceAhead();
+
+    TaskScheduler& mScheduler;
+    std::shared_ptr<Decompression> mDecompression;
+
+    /**
+     * \brief Last queued decompression task. Its result is not needed, as the chunks are
+     * passed through the queue.
+     */
+    std::future<void> mProduction;
+
+    /**
+     * \brief Chunk currently read through the get area of the buffer.
+     */
+    std::vector<char> mCurrentChunk;
+};
+
+}// namespace BPlotter
@@ -0,0 +1,231 @@
+#include "ShardMerge.hpp"
+#include "pch.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <optional>
+#include <queue>
+
+#include "Benchmark/BenchmarkParser.hpp"
+
+namespace BPlotter
+{
+
+namespace
+{
+
+/**
+ * \brief Position in the rows of a shard, ordered by the run name.
+ */
+struct Cursor
+{
+    const BenchmarkResults* results;
+    std::vector<std::uint32_t> order;
+    std::size_t position = 0;
+
+    [[nodiscard]] StringId runNameId() const
+    {
+        return results->runNameColumn()[order[position]];
+    }
+
+    [[nodiscard]] std::string_view runName() const
+    {
+        return results->names().get(runNameId());
+    }
+};
+
+Cursor sortedByRunName(const BenchmarkResults& results)
+{
+    const auto& names = results.names();
+    std::vector<StringId> ids(names.size());
+    std::iota(ids.begin(), ids.end(), 0);
+    std::ranges::sort(ids, {},
+                      [&names](const StringId id)
+                      {
+                          return names.get(id);
+                      });
+    std::vector<std::uint32_t> rankOf(names.size());
+    for (std::size_t rank = 0; rank < ids.size(); ++rank)
+    {
+        rankOf[ids[rank]] = static_cast<std::uint32_t>(rank);
+    }
+
+    auto cursor = Cursor{&results, std::vector<std::uint32_t>(results.size())};
+    std::iota(cursor.order.begin(), cursor.order.end(), 0);
+    const auto runNames = results.runNameColumn();
+    std::ranges::stable_sort(cursor.order, {},
+                             [&](const std::uint32_t row)
+                             {
+                                 return rankOf[runNames[row]];
+                             });
+    return cursor;
+}
+
+std::string describeCaches(const std::vector<CacheInfo>& caches)
+{
+    std::string description;
+    for (const auto& cache: caches)
+    {
+        description += fmt::format("{}L{} {} {}x ", cache.type, cache.level, cache.size,
+                                   cache.numSharing);
+    }
+    return description;
+}
+
+std::vector<std::string> findContextMismatches(const std::span<const Shard> shards)
+{
+    std::vector<std::string> mismatches;
+    const auto& reference = shards.front();
+    const auto& expected = reference.results.context();
+    for (const auto& shard: shards.subspan(1))
+    {
+        const auto& context = shard.results.context();
+        const auto check = [&](const std::string_view field, const auto& value,
+                               const auto& expectedValue)
+        {
+            if (value != expectedValue)
+            {
+                mismatches.push_back(fmt::format("{}: {} '{}' differs from '{}' in {}",
+                                                 shard.name, field, value, expectedValue,
+                                                 reference.name));
+            }
+        };
+        check("num_cpus", context.numCpus, expected.numCpus);
+        check("mhz_per_cpu", context.mhzPerCpu, expected.mhzPerCpu);
+        check("cpu_scaling_enabled", context.cpuScalingEnabled, expected.cpuScalingEnabled);
+        check("library_build_type", context.libraryBuildType, expected.libraryBuildType);
+        check("caches", describeCaches(context.caches), describeCaches(expected.caches));
+    }
+    return mismatches;
+}
+
+}// namespace
+
+MergedResults mergeShards(const std::span<const Shard> shards)
+{
+    MergedResults merged;
+    if (shards.empty())
+    {
+        return merged;
+    }
+    merged.results.setContext(shards.front().results.context());
+    merged.report.contextMismatches = findContextMismatches(shards);
+
+    std::vector<Cursor> cursors;
+    cursors.reserve(shards.size());
+    for (const auto& shard: shards)
+    {
+        cursors.push_back(sortedByRunName(shard.results));
+    }
+
+    // The smallest run name on top, the earlier shard first if the names are equal
+    const auto isAfter = [&cursors](const std::size_t lhs, const std::size_t rhs)
+    {
+        const auto lhsName = cursors[lhs].runName();
+        const auto rhsName = cursors[rhs].runName();
+        return lhsName != rhsName ? lhsName > rhsName : lhs > rhs;
+    };
+    std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(isAfter)> heap(isAfter);
+    for (std::size_t shard = 0; shard < cursors.size(); ++shard)
+    {
+        if (!cursors[shard].order.empty())
+        {
+            heap.push(shard);
+        }
+    }
+
+    auto lastRunName = std::string();
+    auto lastShard = std::optional<std::size_t>();
+    while (!heap.empty())
+    {
+        const auto shard = heap.top();
+        heap.pop();
+        auto& cursor = cursors[shard];
+        const auto runNameId = cursor.runNameId();
+        const auto runName = cursor.runName();
+
+        const auto isDuplicate = lastShard && *lastShard != shard && runName == lastRunName;
+        if (isDuplicate &&
+            (merged.report.duplicates.empty() || merged.report.duplicates.back() != runName))
+        {
+            merged.report.duplicates.emplace_back(runName);
+        }
+        if (!isDuplicate)
+        {
+            lastRunName = runName;
+            lastShard = shard;
+        }
+
+        while (cursor.position < cursor.order.size() && cursor.runNameId() == runNameId)
+        {
+            if (!isDuplicate)
+            {
+                merged.results.append(cursor.results->row(cursor.order[cursor.position]));
+            }
+            ++cursor.position;
+        }
+        if (cursor.position < cursor.order.size())
+        {
+            heap.push(shard);
+        }
+    }
+    return merged;
+}
+
+cpp::result<std::vector<std::filesystem::path>, std::string> listResultFiles(
+    const std::filesystem::path& directory)
+{
+    std::vector<std::filesystem::path> files;
+    std::error_code error;
+    for (const auto& entry: std::filesystem::directory_iterator(directory, error))
+    {
+        if (entry.is_regular_file() && isResultFile(entry.path()))
+        {
+            files.push_back(entry.path());
+        }
+    }
+    if (error)
+    {
+        return cpp::fail(fmt::format("Unable to list {}: {}", directory.string(), error.message()));
+    }
+    std::ranges::sort(files);
+    return files;
+}
+
+cpp::result<MergedResults, std::string> loadShardedResults(const std::filesystem::path& directory,
+                                                           TaskScheduler& scheduler)
+{
+    auto listed = listResultFiles(directory);
+    if (not listed)
+    {
+        return cpp::fail(std::move(listed.error()));
+    }
+    const auto files = std::move(listed.value());
+    if (files.empty())
+    {
+        return cpp::fail(fmt::format("There are no result files in {}", directory.string()));
+    }
+
+    std::vector<std::optional<cpp::result<BenchmarkResults, std::string>>> loaded(files.size());
+    scheduler.parallelFor(files.size(), 1,
+                          [&](const std::size_t file, std::size_t)
+                          {
+                              loaded[file] = loadBenchmarkResults(files[file], scheduler);
+                          });
+
+    std::vector<Shard> shards;
+    shards.reserve(files.size());
+    for (std::size_t i = 0; i < files.size(); ++i)
+    {
+        auto& results = *loaded[i];
+        if (results.has_error())
+        {
+            return cpp::fail(fmt::format("Unable to load the shard {}: {}",
+                                         files[i].filename().string(), results.error()));
+        }
+        shards.push_back({files[i].filename().string(), std::move(results).value()});
+    }
+    return mergeShards(shards);
+}
+
+}// namespace BPlotter
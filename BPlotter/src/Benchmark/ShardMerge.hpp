@@ -0,0 +1,82 @@
+#pragma once
+
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <result.hpp>
+
+#include "Benchmark/BenchmarkResults.hpp"
+#include "Tasks/TaskScheduler.hpp"
+
+namespace BPlotter
+{
+
+/**
+ * \brief Results of a part of the suite, e.g. run on one of the CI hosts with
+ * --benchmark_filter.
+ */
+struct Shard
+{
+    /**
+     * \brief Name of the shard used in the reported problems, e.g. its file name.
+     */
+    std::string name;
+    BenchmarkResults results;
+};
+
+/**
+ * \brief Problems found while merging the shards. None of them prevents the merge.
+ */
+struct ShardMergeReport
+{
+    /**
+     * \brief Run names present in more than one shard. Only the rows of the first shard
+     * containing the run name are kept.
+     */
+    std::vector<std::string> duplicates;
+
+    /**
+     * \brief Descriptions of the differences between the machines that produced the shards.
+     */
+    std::vector<std::string> contextMismatches;
+};
+
+struct MergedResults
+{
+    BenchmarkResults results;
+    ShardMergeReport report;
+};
+
+/**
+ * \brief Merges the shards into a single run.
+ *
+ * Rows of each shard are ordered by the run name, using the ranks of its interned names
+ * rather than comparing the strings of every row, and the shards are combined with a k-way
+ * merge. The merged rows are sorted by the run name, the rows of a single benchmark keep
+ * their original order. The context of the first shard is used for the merged run.
+ * \param shards Shards to merge, earlier shards take precedence on duplicates
+ * \return The merged results and the problems found
+ */
+MergedResults mergeShards(std::span<const Shard> shards);
+
+/**
+ * \brief Lists the result files of the directory (see isResultFile).
+ * \param directory Directory containing the shards
+ * \return Paths of the files sorted by name or a description of the error
+ */
+cpp::result<std::vector<std::filesystem::path>, std::string> listResultFiles(
+    const std::filesystem::path& directory);
+
+/**
+ * \brief Loads every result file of the directory (.json, optionally compressed) in
+ * parallel and merges them into a single run.
+ * \param directory Directory containing the shards
+ * \param scheduler Scheduler loading the shards
+ * \return The merged results or a description of the error
+ */
+cpp::result<MergedResults, std::string> loadShardedResults(const std::filesystem::path& directory,
+                                                           TaskScheduler& scheduler);
+
+}// namespace BPlotter
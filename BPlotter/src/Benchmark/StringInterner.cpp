@@ -0,0 +1,52 @@
+#include "StringInterner.hpp"
+#include "pch.hpp"
+
+namespace BPlotter
+{
+
+StringId StringInterner::intern(const std::string_view text)
+{
+    if (const auto found = mIds.find(text); found != mIds.end())
+    {
+        return found->second;
+    }
+
+    const auto id = static_cast<StringId>(mStrings.size());
+    const auto& stored = mStrings.emplace_back(text);
+    if (stored.capacity() > std::string().capacity())
+    {
+        mHeapCharacters += stored.capacity() + 1;
+    }
+    mIds.emplace(stored, id);
+    return id;
+}
+
+std::optional<StringId> StringInterner::find(const std::string_view text) const
+{
+    if (const auto found = mIds.find(text); found != mIds.end())
+    {
+        return found->second;
+    }
+    return std::nullopt;
+}
+
+std::string_view StringInterner::get(const StringId id) const
+{
+    assert(id < mStrings.size());
+    return mStrings[id];
+}
+
+std::size_t StringInterner::size() const noexcept
+{
+    return mStrings.size();
+}
+
+std::size_t StringInterner::memoryUsage() const noexcept
+{
+    // Every node of the map holds the key, the identifier and the pointer to the next node
+    constexpr auto NODE_SIZE = sizeof(std::string_view) + sizeof(StringId) + sizeof(void*);
+    return mStrings.size() * sizeof(std::string) + mHeapCharacters +
+           mIds.size() * NODE_SIZE + mIds.bucket_count() * sizeof(void*);
+}
+
+}// namespace BPlotter
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace BPlotter
+{
+
+/**
+ * \brief Identifier of a string stored inside the StringInterner.
+ */
+using StringId = std::uint32_t;
+
+/**
+ * \brief Stores every distinct string exactly once and hands out compact identifiers for them.
+ *
+ * Benchmark files repeat the same names over and over (repetitions, aggregates, many runs
+ * of the same suite). Keeping them interned allows the rest of the application to compare
+ * and hash plain integers instead of strings. Identifiers are assigned in insertion order,
+ * starting from zero, so they can be used directly as indices.
+ */
+class StringInterner
+{
+public:
+    StringInterner() = default;
+    StringInterner(const StringInterner&) = delete;
+    StringInterner(StringInterner&&) = default;
+
+    StringInterner& operator=(const StringInterner&) = delete;
+    StringInterner& operator=(StringInterner&&) = default;
+
+    /**
+     * \brief Returns the identifier of the given string, storing it first if it was not seen yet.
+     * \param text String to be interned
+     * \return Identifier of the string
+     */
+    StringId intern(std::string_view text);
+
+    /**
+     * \brief Looks up the identifier of the given string without storing it.
+     * \param text String to be found
+     * \return Identifier of the string or nullopt if it was never interned
+     */
+    [[nodiscard]] std::optional<StringId> find(std::string_view text) const;
+
+    /**
+     * \brief Returns the string stored under the given identifier.
+     * \param id Identifier previously returned by intern()
+     * \return The interned string
+     */
+    [[nodiscard]] std::string_view get(StringId id) const;
+
+    /**
+     * \brief Number of distinct strings stored in the interner.
+     * \return Number of distinct strings
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * \brief Estimates the heap memory taken by the interned strings and their index.
+     * \return Number of bytes
+     */
+    [[nodiscard]] std::size_t memoryUsage() const noexcept;
+
+private:
+    /**
+     * \brief Total capacity of the strings that do not fit into the small string buffer.
+     */
+    std::size_t mHeapCharacters = 0;
+
+    /**
+     * \brief Storage of the strings. A deque never moves its elements when growing,
+     * so the views kept inside mIds stay valid.
+     */
+    std::deque<std::string> mStrings;
+
+    /**
+     * \brief Maps the stored strings to their identifiers.
+     */
+    std::unordered_map<std::string_view, StringId> mIds;
+};
+
+}// namespace BPlotter
@@ -0,0 +1,271 @@
+#include "CompareCommand.hpp"
+#include "pch.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <future>
+
+#include "Benchmark/BenchmarkParser.hpp"
+
+namespace BPlotter
+{
+
+const char* const COMPARE_USAGE =
+    "Usage: BPlotterApp compare <baseline.json> <candidate.json> [options]\n"
+    "Options:\n"
+    "  --metric <column>               Compared column (default: real_time)\n"
+    "  --higher-is-better              Higher values of the metric are better\n"
+    "  --lower-is-better               Lower values of the metric are better\n"
+    "  --threshold <fraction>          Allowed relative worsening (default: 0.05)\n"
+    "  --threshold-for <regex>=<fraction>\n"
+    "                                  Threshold of the benchmarks matching the regex,\n"
+    "                                  the first matching one is used (repeatable)\n"
+    "  --alpha <p>                     Significance level of the test (default: 0.05)\n"
+    "  --no-color                      Do not color the output\n"
+    "Exits with 1 if any benchmark regressed and with 2 on errors.\n";
+
+namespace
+{
+
+constexpr auto RED = "\033[31m";
+constexpr auto GREEN = "\033[32m";
+constexpr auto YELLOW = "\033[33m";
+constexpr auto RESET = "\033[0m";
+
+/**
+ * \brief Longest benchmark name that is not truncated in the summary table.
+ */
+constexpr auto MAX_NAME_WIDTH = std::size_t{80};
+
+std::optional<double> parseDouble(const std::string_view text)
+{
+    auto value = 0.0;
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error != std::errc{} || end != text.data() + text.size())
+    {
+        return std::nullopt;
+    }
+    return value;
+}
+
+const char* colorOf(const Verdict verdict)
+{
+    switch (verdict)
+    {
+        case Verdict::Regression: return RED;
+        case Verdict::Improvement: return GREEN;
+        case Verdict::OnlyInBaseline:
+        case Verdict::OnlyInCandidate: return YELLOW;
+        case Verdict::Unchanged: return "";
+    }
+    return "";
+}
+
+const char* toString(const Verdict verdict)
+{
+    switch (verdict)
+    {
+        case Verdict::Regression: return "REGRESSION";
+        case Verdict::Improvement: return "improvement";
+        case Verdict::OnlyInBaseline: return "only in baseline";
+        case Verdict::OnlyInCandidate: return "only in candidate";
+        case Verdict::Unchanged: return "";
+    }
+    return "";
+}
+
+void printTable(const std::vector<BenchmarkComparison>& comparisons, const bool isColored)
+{
+    auto nameWidth = std::string_view("Benchmark").size();
+    for (const auto& comparison: comparisons)
+    {
+        nameWidth = std::max(nameWidth, std::min(comparison.name.size(), MAX_NAME_WIDTH));
+    }
+
+    fmt::print("{:<{}} {:>12} {:>12} {:>9} {:>8} {:>9}  {}\n", "Benchmark", nameWidth,
+               "Baseline", "Candidate", "Change", "p-value", "Threshold", "Verdict");
+    fmt::print("{:-<{}}\n", "", nameWidth + 70);
+    for (const auto& comparison: comparisons)
+    {
+        const auto isCompared = comparison.verdict != Verdict::OnlyInBaseline &&
+                                comparison.verdict != Verdict::OnlyInCandidate;
+        const auto name = std::string_view(comparison.name).substr(0, nameWidth);
+        const auto color = isColored ? colorOf(comparison.verdict) : "";
+        const auto reset = isColored && *color ? RESET : "";
+        fmt::print("{}{:<{}} {:>12} {:>12} {:>9} {:>8} {:>9}  {}{}\n", color, name, nameWidth,
+                   comparison.baselineRepetitions ? fmt::format("{:.4g}", comparison.baseline)
+                                                  : "-",
+                   comparison.candidateRepetitions ? fmt::format("{:.4g}", comparison.candidate)
+                                                   : "-",
+                   isCompared ? fmt::format("{:+.2f}%", comparison.relativeChange * 100) : "-",
+                   comparison.pValue ? fmt::format("{:.4f}", *comparison.pValue) : "-",
+                   isCompared ? fmt::format("{:.1f}%", comparison.threshold * 100) : "-",
+                   toString(comparison.verdict), reset);
+    }
+}
+
+}// namespace
+
+cpp::result<CompareArguments, std::string> parseCompareArguments(
+    const std::span<const std::string_view> arguments)
+{
+    auto parsed = CompareArguments{};
+    parsed.isColored = std::getenv("NO_COLOR") == nullptr;
+    std::vector<std::string_view> files;
+    for (std::size_t i = 0; i < arguments.size(); ++i)
+    {
+        const auto argument = arguments[i];
+        const auto valueOf = [&]() -> cpp::result<std::string_view, std::string>
+        {
+            if (i + 1 == arguments.size())
+            {
+                return cpp::fail(fmt::format("{} requires a value", argument));
+            }
+            return arguments[++i];
+        };
+        const auto numberOf = [&](const std::string_view text) -> cpp::result<double, std::string>
+        {
+            const auto number = parseDouble(text);
+            if (!number || *number < 0)
+            {
+                return cpp::fail(fmt::format("Invalid value of {}: '{}'", argument, text));
+            }
+            return *number;
+        };
+
+        if (argument == "--higher-is-better" || argument == "--lower-is-better")
+        {
+            parsed.options.isHigherBetter = argument == "--higher-is-better";
+        }
+        else if (argument == "--no-color")
+        {
+            parsed.isColored = false;
+        }
+        else if (argument == "--metric")
+        {
+            const auto value = valueOf();
+            if (value.has_error())
+            {
+                return cpp::fail(value.error());
+            }
+            parsed.options.metric = *value;
+        }
+        else if (argument == "--threshold" || argument == "--alpha")
+        {
+            const auto value = valueOf();
+            if (value.has_error())
+            {
+                return cpp::fail(value.error());
+            }
+            const auto number = numberOf(*value);
+            if (number.has_error())
+            {
+                return cpp::fail(number.error());
+            }
+            (argument == "--threshold" ? parsed.options.threshold : parsed.options.alpha) = *number;
+        }
+        else if (argument == "--threshold-for")
+        {
+            const auto value = valueOf();
+            if (value.has_error())
+            {
+                return cpp::fail(value.error());
+            }
+            // Regular expressions can contain '=', so the threshold follows the last one
+            const auto separator = value->rfind('=');
+            if (separator == std::string_view::npos)
+            {
+                return cpp::fail(fmt::format("Expected <regex>=<fraction>, got '{}'", *value));
+            }
+            const auto number = numberOf(value->substr(separator + 1));
+            if (number.has_error())
+            {
+                return cpp::fail(number.error());
+            }
+            const auto pattern = std::string(value->substr(0, separator));
+            try
+            {
+                parsed.options.thresholds.push_back({std::regex(pattern), pattern, *number});
+            }
+            catch (const std::regex_error& error)
+            {
+                return cpp::fail(
+                    fmt::format("Invalid regular expression '{}': {}", pattern, error.what()));
+            }
+        }
+        else if (argument.starts_with("--"))
+        {
+            return cpp::fail(fmt::format("Unknown option {}", argument));
+        }
+        else
+        {
+            files.push_back(argument);
+        }
+    }
+
+    if (files.size() != 2)
+    {
+        return cpp::fail(std::string("Expected the baseline and the candidate result files"));
+    }
+    parsed.baseline = files[0];
+    parsed.candidate = files[1];
+    return parsed;
+}
+
+CompareExitCode runCompareCommand(const std::span<const std::string_view> arguments)
+{
+    const auto parsed = parseCompareArguments(arguments);
+    if (parsed.has_error())
+    {
+        fmt::print(stderr, "{}\n\n{}", parsed.error(), COMPARE_USAGE);
+        return CompareExitCode::Error;
+    }
+
+    // The command runs without the application, so it has a scheduler of its own
+    TaskScheduler scheduler;
+    auto baselineLoading = scheduler.submit(TaskPriority::Interactive,
+                                            [&path = parsed->baseline, &scheduler]
+                                            {
+                                                return loadBenchmarkResults(path, scheduler);
+                                            });
+    const auto candidate = loadBenchmarkResults(parsed->candidate, scheduler);
+    const auto baseline = baselineLoading.get();
+    for (const auto* results: {&baseline, &candidate})
+    {
+        if (results->has_error())
+        {
+            fmt::print(stderr, "{}\n", results->error());
+            return CompareExitCode::Error;
+        }
+    }
+
+    const auto comparisons = compareResults(*baseline, *candidate, scheduler, parsed->options);
+    if (comparisons.has_error())
+    {
+        fmt::print(stderr, "{}\n", comparisons.error());
+        return CompareExitCode::Error;
+    }
+    printTable(*comparisons, parsed->isColored);
+
+    const auto count = [&comparisons](const Verdict verdict)
+    {
+        return std::ranges::count(*comparisons, verdict, &BenchmarkComparison::verdict);
+    };
+    const auto regressions = count(Verdict::Regression);
+    fmt::print("\n{} regressions, {} improvements, {} unchanged, {} only in baseline, "
+               "{} only in candidate\n",
+               regressions, count(Verdict::Improvement), count(Verdict::Unchanged),
+               count(Verdict::OnlyInBaseline), count(Verdict::OnlyInCandidate));
+
+    // A gate that compared nothing must not pass
+    const auto unmatched = count(Verdict::OnlyInBaseline) + count(Verdict::OnlyInCandidate);
+    if (unmatched == std::ssize(*comparisons))
+    {
+        fmt::print(stderr, "No benchmark is in both the baseline and the candidate\n");
+        return CompareExitCode::Error;
+    }
+    return regressions > 0 ? CompareExitCode::Regression : CompareExitCode::NoRegression;
+}
+
+}// namespace BPlotter
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include <result.hpp>
+
+#include "Compare/RunComparison.hpp"
+
+namespace BPlotter
+{
+
+/**
+ * \brief Exit codes of the compare command, suitable for gating CI pipelines.
+ */
+enum class CompareExitCode
+{
+    NoRegression = 0,
+    Regression = 1,
+    Error = 2,
+};
+
+/**
+ * \brief Parsed command line of the compare command.
+ */
+struct CompareArguments
+{
+    std::filesystem::path baseline;
+    std::filesystem::path candidate;
+    ComparisonOptions options;
+    bool isColored = true;
+};
+
+/**
+ * \brief Usage of the compare command printed on invalid arguments.
+ */
+extern const char* const COMPARE_USAGE;
+
+/**
+ * \brief Parses the arguments of the compare command.
+ * \param arguments Arguments following the "compare" command
+ * \return The parsed arguments or a description of the error
+ */
+cpp::result<CompareArguments, std::string> parseCompareArguments(
+    std::span<const std::string_view> arguments);
+
+/**
+ * \brief Compares the baseline and the candidate result files and prints the summary table.
+ *
+ * Runs without any window, SFML or ImGui, so it can be used in headless CI jobs.
+ * Both files are parsed concurrently. Comparing files that have no benchmark in common is
+ * an error, so that a misconfigured gate does not pass without comparing anything.
+ * \param arguments Arguments following the "compare" command
+ * \return Exit code of the application
+ */
+CompareExitCode runCompareCommand(std::span<const std::string_view> arguments);
+
+}// namespace BPlotter
@@ -0,0 +1,299 @@
+#include "RunComparison.hpp"
+#include "pch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <unordered_map>
+
+#include "Memory/AllocationTracker.hpp"
+
+namespace BPlotter
+{
+
+namespace
+{
+
+/**
+ * \brief Largest product of the sample sizes for which the exact distribution of U is used.
+ */
+constexpr auto EXACT_TEST_LIMIT = std::size_t{400};
+
+/**
+ * \brief Number of benchmarks compared by a single task, below which tasks do not pay off.
+ */
+constexpr auto BENCHMARKS_PER_TASK = std::size_t{64};
+
+/**
+ * \brief Values of the metric of the iteration rows (repetitions) of every benchmark.
+ */
+struct Samples
+{
+    std::vector<std::string_view> order;
+    std::unordered_map<std::string_view, std::vector<double>> values;
+};
+
+/**
+ * \brief Name of the aggregate standing in for the repetitions of a benchmark whose file has
+ * only the aggregates (--benchmark_report_aggregates_only).
+ */
+constexpr std::string_view MEAN_AGGREGATE = "mean";
+
+Samples collectSamples(const BenchmarkResults& results, const ColumnIndex metric)
+{
+    Samples samples;
+    std::unordered_map<std::string_view, double> means;
+    const auto runNames = results.runNameColumn();
+    const auto runTypes = results.runTypeColumn();
+    const auto aggregateNames = results.aggregateNameColumn();
+    const auto values = results.column(metric);
+    for (std::size_t row = 0; row < results.size(); ++row)
+    {
+        const auto isMean = runTypes[row] == RunType::Aggregate &&
+                            results.aggregateNames().get(aggregateNames[row]) == MEAN_AGGREGATE;
+        if (runTypes[row] != RunType::Iteration && !isMean)
+        {
+            continue;
+        }
+        const auto name = results.names().get(runNames[row]);
+        auto [sample, isNew] = samples.values.try_emplace(name);
+        if (isNew)
+        {
+            samples.order.push_back(name);
+        }
+        if (isMean)
+        {
+            means.emplace(name, values[row]);
+        }
+        else if (!std::isnan(values[row]))
+        {
+            sample->second.push_back(values[row]);
+        }
+    }
+
+    // The mean is a single sample, so these benchmarks are judged by the threshold alone
+    for (const auto& [name, mean]: means)
+    {
+        auto& sample = samples.values[name];
+        if (sample.empty() && !std::isnan(mean))
+        {
+            sample.push_back(mean);
+        }
+    }
+    return samples;
+}
+
+/**
+ * \brief Number of the arrangements of the two samples for each value of U, which are the
+ * coefficients of the Gaussian binomial coefficient [n1 + n2 choose n1].
+ */
+std::vector<double> arrangementsOfU(const std::size_t lhsSize, const std::size_t rhsSize)
+{
+    std::vector<std::vector<double>> binomials(lhsSize + 1);
+    binomials[0] = {1.0};
+    for (std::size_t k = 1; k <= lhsSize + rhsSize; ++k)
+    {
+        // [k choose j] = [k - 1 choose j - 1] + q^j [k - 1 choose j]
+        for (auto j = std::min(k, lhsSize); j >= 1; --j)
+        {
+            auto next = binomials[j - 1];
+            const auto& shifted = binomials[j];
+            next.resize(std::max(next.size(), shifted.size() + j), 0.0);
+            for (std::size_t u = 0; u < shifted.size(); ++u)
+            {
+                next[u + j] += shifted[u];
+            }
+            binomials[j] = std::move(next);
+        }
+    }
+    return binomials[lhsSize];
+}
+
+double binomialCoefficient(const std::size_t n, const std::size_t k)
+{
+    auto result = 1.0;
+    for (std::size_t i = 1; i <= k; ++i)
+    {
+        result = result * static_cast<double>(n - k + i) / static_cast<double>(i);
+    }
+    return result;
+}
+
+double mean(const std::vector<double>& values)
+{
+    return std::accumulate(values.begin(), values.end(), 0.0) /
+           static_cast<double>(values.size());
+}
+
+void compare(BenchmarkComparison& comparison, const std::vector<double>* baseline,
+             const std::vector<double>* candidate, const ComparisonOptions& options,
+             const bool isHigherBetter)
+{
+    if (baseline)
+    {
+        comparison.baselineRepetitions = baseline->size();
+        comparison.baseline = mean(*baseline);
+    }
+    if (candidate)
+    {
+        comparison.candidateRepetitions = candidate->size();
+        comparison.candidate = mean(*candidate);
+    }
+    if (!baseline || !candidate)
+    {
+        comparison.verdict = baseline ? Verdict::OnlyInBaseline : Verdict::OnlyInCandidate;
+        return;
+    }
+
+    comparison.relativeChange =
+        (comparison.candidate - comparison.baseline) / std::abs(comparison.baseline);
+    comparison.threshold = options.threshold;
+    for (const auto& rule: options.thresholds)
+    {
+        if (std::regex_search(comparison.name, rule.pattern))
+        {
+            comparison.threshold = rule.threshold;
+            break;
+        }
+    }
+
+    // With few repetitions even completely separated samples are not significant,
+    // in which case the decision is left to the threshold alone
+    const auto lowestPValue = 2 / binomialCoefficient(baseline->size() + candidate->size(),
+                                                      baseline->size());
+    if (!baseline->empty() && !candidate->empty() && lowestPValue < options.alpha)
+    {
+        comparison.pValue = mannWhitneyPValue(*baseline, *candidate);
+    }
+
+    const auto isSignificant = !comparison.pValue || *comparison.pValue < options.alpha;
+    const auto worsening = isHigherBetter ? -comparison.relativeChange : comparison.relativeChange;
+    if (isSignificant && worsening > comparison.threshold)
+    {
+        comparison.verdict = Verdict::Regression;
+    }
+    else if (isSignificant && -worsening > comparison.threshold)
+    {
+        comparison.verdict = Verdict::Improvement;
+    }
+}
+
+}// namespace
+
+double mannWhitneyPValue(const std::span<const double> lhs, const std::span<const double> rhs)
+{
+    if (lhs.empty() || rhs.empty())
+    {
+        return 1;
+    }
+
+    std::vector<std::pair<double, bool>> values;
+    values.reserve(lhs.size() + rhs.size());
+    for (const auto value: lhs)
+    {
+        values.emplace_back(value, true);
+    }
+    for (const auto value: rhs)
+    {
+        values.emplace_back(value, false);
+    }
+    std::ranges::sort(values, {}, &std::pair<double, bool>::first);
+
+    // Tied values get the mean of their ranks
+    auto lhsRanks = 0.0;
+    auto tieCorrection = 0.0;
+    for (std::size_t first = 0; first < values.size();)
+    {
+        auto last = first + 1;
+        while (last < values.size() && values[last].first == values[first].first)
+        {
+            ++last;
+        }
+        const auto ties = static_cast<double>(last - first);
+        const auto rank = static_cast<double>(first + last + 1) / 2;
+        for (auto i = first; i < last; ++i)
+        {
+            lhsRanks += values[i].second ? rank : 0;
+        }
+        tieCorrection += ties * ties * ties - ties;
+        first = last;
+    }
+
+    const auto lhsSize = static_cast<double>(lhs.size());
+    const auto rhsSize = static_cast<double>(rhs.size());
+    const auto u = lhsRanks - lhsSize * (lhsSize + 1) / 2;
+
+    if (tieCorrection == 0 && lhs.size() * rhs.size() <= EXACT_TEST_LIMIT)
+    {
+        const auto arrangements = arrangementsOfU(lhs.size(), rhs.size());
+        const auto observed = static_cast<std::size_t>(std::lround(u));
+        const auto total = std::accumulate(arrangements.begin(), arrangements.end(), 0.0);
+        const auto atMost = std::accumulate(arrangements.begin(),
+                                            arrangements.begin() + observed + 1, 0.0);
+        const auto atLeast =
+            std::accumulate(arrangements.begin() + observed, arrangements.end(), 0.0);
+        return std::min(1.0, 2 * std::min(atMost, atLeast) / total);
+    }
+
+    const auto size = lhsSize + rhsSize;
+    const auto variance =
+        lhsSize * rhsSize / 12 * ((size + 1) - tieCorrection / (size * (size - 1)));
+    if (variance <= 0)
+    {
+        return 1;
+    }
+    const auto z = std::max(0.0, std::abs(u - lhsSize * rhsSize / 2) - 0.5) / std::sqrt(variance);
+    return std::erfc(z / std::sqrt(2.0));
+}
+
+cpp::result<std::vector<BenchmarkComparison>, std::string> compareResults(
+    const BenchmarkResults& baseline, const BenchmarkResults& candidate, TaskScheduler& scheduler,
+    const ComparisonOptions& options)
+{
+    AllocationScope scope(AllocationSubsystem::Statistics);
+    const auto baselineMetric = baseline.findColumn(options.metric);
+    const auto candidateMetric = candidate.findColumn(options.metric);
+    if (!baselineMetric || !candidateMetric)
+    {
+        return cpp::fail(fmt::format("The {} has no '{}' column",
+                                     baselineMetric ? "candidate" : "baseline", options.metric));
+    }
+    const auto isHigherBetter =
+        options.isHigherBetter.value_or(options.metric.ends_with("_per_second"));
+
+    const auto baselineSamples = collectSamples(baseline, *baselineMetric);
+    const auto candidateSamples = collectSamples(candidate, *candidateMetric);
+    std::vector<BenchmarkComparison> comparisons;
+    for (const auto name: baselineSamples.order)
+    {
+        comparisons.push_back({.name = std::string(name)});
+    }
+    for (const auto name: candidateSamples.order)
+    {
+        if (!baselineSamples.values.contains(name))
+        {
+            comparisons.push_back({.name = std::string(name)});
+        }
+    }
+
+    const auto samplesOf = [](const Samples& samples,
+                              const std::string& name) -> const std::vector<double>*
+    {
+        const auto found = samples.values.find(name);
+        return found == samples.values.end() ? nullptr : &found->second;
+    };
+    scheduler.parallelFor(comparisons.size(), BENCHMARKS_PER_TASK,
+                          [&](const std::size_t begin, const std::size_t end)
+                          {
+                              for (auto i = begin; i < end; ++i)
+                              {
+                                  auto& comparison = comparisons[i];
+                                  compare(comparison, samplesOf(baselineSamples, comparison.name),
+                                          samplesOf(candidateSamples, comparison.name), options,
+                                          isHigherBetter);
+                              }
+                          });
+    return comparisons;
+}
+
+}// namespace BPlotter
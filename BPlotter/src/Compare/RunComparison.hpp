@@ -0,0 +1,124 @@
+#pragma once
+
+#include <optional>
+#include <regex>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <result.hpp>
+
+#include "Benchmark/BenchmarkResults.hpp"
+#include "Tasks/TaskScheduler.hpp"
+
+namespace BPlotter
+{
+
+/**
+ * \brief Threshold applied to the benchmarks whose run name matches the pattern.
+ */
+struct ThresholdRule
+{
+    std::regex pattern;
+    std::string source;
+    double threshold = 0;
+};
+
+/**
+ * \brief Settings of the comparison of two runs.
+ */
+struct ComparisonOptions
+{
+    /**
+     * \brief Name of the compared column.
+     */
+    std::string metric = "real_time";
+
+    /**
+     * \brief Whether higher values of the metric are better. If not set, it is inferred from
+     * the name of the metric (rates ending with "_per_second" are better when higher).
+     */
+    std::optional<bool> isHigherBetter;
+
+    /**
+     * \brief Relative worsening above which a benchmark regressed, unless a rule matches it.
+     */
+    double threshold = 0.05;
+
+    /**
+     * \brief Per-benchmark thresholds, the first matching rule is used.
+     */
+    std::vector<ThresholdRule> thresholds;
+
+    /**
+     * \brief Significance level of the test comparing the repetitions.
+     */
+    double alpha = 0.05;
+};
+
+enum class Verdict
+{
+    Unchanged,
+    Improvement,
+    Regression,
+    OnlyInBaseline,
+    OnlyInCandidate,
+};
+
+/**
+ * \brief Result of the comparison of a single benchmark.
+ */
+struct BenchmarkComparison
+{
+    /**
+     * \brief Run name of the benchmark.
+     */
+    std::string name;
+    std::size_t baselineRepetitions = 0;
+    std::size_t candidateRepetitions = 0;
+    double baseline = 0;
+    double candidate = 0;
+
+    /**
+     * \brief (candidate - baseline) / |baseline|
+     */
+    double relativeChange = 0;
+
+    /**
+     * \brief Two-sided p-value of the Mann-Whitney U test, if there were enough repetitions
+     * for the test to be able to reach the significance level.
+     */
+    std::optional<double> pValue;
+    double threshold = 0;
+    Verdict verdict = Verdict::Unchanged;
+};
+
+/**
+ * \brief Two-sided p-value of the Mann-Whitney U test of the two samples.
+ *
+ * Uses the exact distribution of U for small samples without ties, and the normal
+ * approximation with the tie and continuity corrections otherwise.
+ * \param lhs First sample
+ * \param rhs Second sample
+ * \return The p-value, 1 if any of the samples is empty
+ */
+double mannWhitneyPValue(std::span<const double> lhs, std::span<const double> rhs);
+
+/**
+ * \brief Aligns the benchmarks of both runs by their run name and compares their repetitions.
+ *
+ * A benchmark regressed if it got worse by more than its threshold and, when there are
+ * enough repetitions to tell, the difference is statistically significant. Benchmarks are
+ * compared in parallel.
+ * \param baseline Results of the reference run
+ * \param candidate Results of the compared run
+ * \param scheduler Scheduler comparing the benchmarks
+ * \param options Settings of the comparison
+ * \return Comparisons in the order of the baseline followed by the benchmarks present only
+ * in the candidate, or a description of the error
+ */
+cpp::result<std::vector<BenchmarkComparison>, std::string> compareResults(
+    const BenchmarkResults& baseline, const BenchmarkResults& candidate, TaskScheduler& scheduler,
+    const ComparisonOptions& options);
+
+}// namespace BPlotter
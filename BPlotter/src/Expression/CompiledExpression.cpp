@@ -0,0 +1,415 @@
+#include "CompiledExpression.hpp"
+#include "pch.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+
+namespace BPlotter
+{
+
+namespace
+{
+
+/**
+ * \brief Number of rows evaluated at once. Small enough for all registers to fit in L1/L2.
+ */
+constexpr auto BLOCK_SIZE = std::size_t{1024};
+
+struct CompileError
+{
+    std::string message;
+};
+
+bool isIdentifierCharacter(const char character)
+{
+    return std::isalnum(static_cast<unsigned char>(character)) || character == '_' ||
+           character == '.' || character == ':';
+}
+
+/**
+ * \brief Values of an operand within the evaluated block, either a vector or a scalar.
+ */
+struct BlockValues
+{
+    const double* values = nullptr;
+    double constant = 0;
+};
+
+template<typename Operation>
+void applyKernel(const Operation operation, const BlockValues lhs, const BlockValues rhs,
+                 double* output, const std::size_t count)
+{
+    if (lhs.values && rhs.values)
+    {
+        for (auto i = std::size_t{0}; i < count; ++i)
+        {
+            output[i] = operation(lhs.values[i], rhs.values[i]);
+        }
+    }
+    else if (lhs.values)
+    {
+        const auto constant = rhs.constant;
+        for (auto i = std::size_t{0}; i < count; ++i)
+        {
+            output[i] = operation(lhs.values[i], constant);
+        }
+    }
+    else
+    {
+        const auto constant = lhs.constant;
+        for (auto i = std::size_t{0}; i < count; ++i)
+        {
+            output[i] = operation(constant, rhs.values[i]);
+        }
+    }
+}
+
+}// namespace
+
+/**
+ * \brief Recursive descent parser emitting the program while parsing.
+ *
+ * expression := term (('+' | '-') term)*
+ * term       := unary (('*' | '/') unary)*
+ * unary      := '-' unary | primary
+ * primary    := number | column | '"' column '"' | '(' expression ')'
+ */
+class CompiledExpression::Compiler
+{
+public:
+    Compiler(std::string_view source, const BenchmarkResults& results,
+             CompiledExpression& expression)
+        : mSource(source)
+        , mResults(results)
+        , mExpression(expression)
+    {
+    }
+
+    void compile()
+    {
+        mExpression.mResult = parseExpression();
+        skipWhitespace();
+        if (mPosition != mSource.size())
+        {
+            fail(fmt::format("unexpected '{}'", mSource[mPosition]));
+        }
+    }
+
+private:
+    Operand parseExpression()
+    {
+        auto lhs = parseTerm();
+        while (true)
+        {
+            if (consume('+'))
+            {
+                lhs = emit(OpCode::Add, lhs, parseTerm());
+            }
+            else if (consume('-'))
+            {
+                lhs = emit(OpCode::Subtract, lhs, parseTerm());
+            }
+            else
+            {
+                return lhs;
+            }
+        }
+    }
+
+    Operand parseTerm()
+    {
+        auto lhs = parseUnary();
+        while (true)
+        {
+            if (consume('*'))
+            {
+                lhs = emit(OpCode::Multiply, lhs, parseUnary());
+            }
+            else if (consume('/'))
+            {
+                lhs = emit(OpCode::Divide, lhs, parseUnary());
+            }
+            else
+            {
+                return lhs;
+            }
+        }
+    }
+
+    Operand parseUnary()
+    {
+        if (consume('-'))
+        {
+            return emit(OpCode::Negate, parseUnary(), {});
+        }
+        return parsePrimary();
+    }
+
+    Operand parsePrimary()
+    {
+        skipWhitespace();
+        if (mPosition == mSource.size())
+        {
+            fail("unexpected end of the expression");
+        }
+        if (consume('('))
+        {
+            const auto operand = parseExpression();
+            if (!consume(')'))
+            {
+                fail("expected ')'");
+            }
+            return operand;
+        }
+        if (consume('"'))
+        {
+            const auto end = mSource.find('"', mPosition);
+            if (end == std::string_view::npos)
+            {
+                fail("unterminated quoted column name");
+            }
+            const auto name = mSource.substr(mPosition, end - mPosition);
+            mPosition = end + 1;
+            return columnOperand(name);
+        }
+
+        const auto character = mSource[mPosition];
+        if (std::isdigit(static_cast<unsigned char>(character)) || character == '.')
+        {
+            return parseNumber();
+        }
+        if (isIdentifierCharacter(character))
+        {
+            return parseColumn();
+        }
+        fail(fmt::format("unexpected '{}'", character));
+    }
+
+    Operand parseNumber()
+    {
+        auto value = 0.0;
+        const auto* begin = mSource.data() + mPosition;
+        const auto [end, error] = std::from_chars(begin, mSource.data() + mSource.size(), value);
+        if (error != std::errc{})
+        {
+            fail("invalid number");
+        }
+        mPosition += static_cast<std::size_t>(end - begin);
+        return {.kind = Operand::Kind::Constant, .constant = value};
+    }
+
+    /**
+     * \brief Reads a column name. The name is extended over '-' as long as the longer name
+     * refers to an existing column, so that "CACHE-MISSES/INSTRUCTIONS" works unquoted.
+     */
+    Operand parseColumn()
+    {
+        auto end = identifierEnd(mPosition);
+        for (auto next = end; next < mSource.size() && mSource[next] == '-';)
+        {
+            const auto extended = identifierEnd(next + 1);
+            if (extended == next + 1)
+            {
+                break;
+            }
+            if (mResults.findColumn(mSource.substr(mPosition, extended - mPosition)))
+            {
+                end = extended;
+            }
+            next = extended;
+        }
+        const auto name = mSource.substr(mPosition, end - mPosition);
+        mPosition = end;
+        return columnOperand(name);
+    }
+
+    Operand columnOperand(const std::string_view name)
+    {
+        const auto column = mResults.findColumn(name);
+        if (!column)
+        {
+            fail(fmt::format("unknown column '{}'", name));
+        }
+        return {.kind = Operand::Kind::Column, .index = *column};
+    }
+
+    /**
+     * \brief Appends the instruction to the program, or folds it if all inputs are constant.
+     */
+    Operand emit(const OpCode operation, const Operand lhs, const Operand rhs)
+    {
+        const auto isUnary = operation == OpCode::Negate;
+        if (lhs.kind == Operand::Kind::Constant && (isUnary || rhs.kind == Operand::Kind::Constant))
+        {
+            return {.kind = Operand::Kind::Constant,
+                    .constant = fold(operation, lhs.constant, rhs.constant)};
+        }
+
+        // Kernels work element by element, so the result may overwrite one of the inputs.
+        release(lhs);
+        release(rhs);
+        const auto destination = allocateRegister();
+        mExpression.mProgram.push_back({operation, lhs, rhs, destination});
+        return {.kind = Operand::Kind::Register, .index = destination};
+    }
+
+    static double fold(const OpCode operation, const double lhs, const double rhs)
+    {
+        switch (operation)
+        {
+            case OpCode::Add: return lhs + rhs;
+            case OpCode::Subtract: return lhs - rhs;
+            case OpCode::Multiply: return lhs * rhs;
+            case OpCode::Divide: return lhs / rhs;
+            case OpCode::Negate: return -lhs;
+        }
+        return lhs;
+    }
+
+    std::size_t allocateRegister()
+    {
+        if (mFreeRegisters.empty())
+        {
+            return mExpression.mRegisters++;
+        }
+        const auto index = mFreeRegisters.back();
+        mFreeRegisters.pop_back();
+        return index;
+    }
+
+    void release(const Operand& operand)
+    {
+        if (operand.kind == Operand::Kind::Register)
+        {
+            mFreeRegisters.push_back(operand.index);
+        }
+    }
+
+    std::size_t identifierEnd(std::size_t position) const
+    {
+        while (position < mSource.size() && isIdentifierCharacter(mSource[position]))
+        {
+            ++position;
+        }
+        return position;
+    }
+
+    void skipWhitespace()
+    {
+        while (mPosition < mSource.size() &&
+               std::isspace(static_cast<unsigned char>(mSource[mPosition])))
+        {
+            ++mPosition;
+        }
+    }
+
+    bool consume(const char character)
+    {
+        skipWhitespace();
+        if (mPosition < mSource.size() && mSource[mPosition] == character)
+        {
+            ++mPosition;
+            return true;
+        }
+        return false;
+    }
+
+    [[noreturn]] void fail(std::string message) const
+    {
+        throw CompileError{fmt::format("{} at position {}", message, mPosition + 1)};
+    }
+
+private:
+    std::string_view mSource;
+    std::size_t mPosition = 0;
+    const BenchmarkResults& mResults;
+    CompiledExpression& mExpression;
+    std::vector<std::size_t> mFreeRegisters;
+};
+
+cpp::result<CompiledExpression, std::string> CompiledExpression::compile(
+    const std::string_view source, const BenchmarkResults& results)
+{
+    auto expression = CompiledExpression();
+    expression.mSource = source;
+    try
+    {
+        Compiler(source, results, expression).compile();
+    }
+    catch (const CompileError& error)
+    {
+        return cpp::fail(error.message);
+    }
+    return expression;
+}
+
+void CompiledExpression::evaluate(const BenchmarkResults& results, const std::size_t firstRow,
+                                  const std::span<double> output) const
+{
+    assert(firstRow + output.size() <= results.size());
+
+    auto registers = std::vector<double>(mRegisters * BLOCK_SIZE);
+    for (auto blockBegin = std::size_t{0}; blockBegin < output.size(); blockBegin += BLOCK_SIZE)
+    {
+        const auto count = std::min(BLOCK_SIZE, output.size() - blockBegin);
+        const auto valuesOf = [&](const Operand& operand) -> BlockValues
+        {
+            switch (operand.kind)
+            {
+                case Operand::Kind::Column:
+                    return {.values = results.column(operand.index).data() + firstRow + blockBegin};
+                case Operand::Kind::Register:
+                    return {.values = registers.data() + operand.index * BLOCK_SIZE};
+                case Operand::Kind::Constant: return {.constant = operand.constant};
+            }
+            return {};
+        };
+
+        for (const auto& instruction: mProgram)
+        {
+            auto* destination = registers.data() + instruction.destination * BLOCK_SIZE;
+            const auto lhs = valuesOf(instruction.lhs);
+            const auto rhs = valuesOf(instruction.rhs);
+            switch (instruction.operation)
+            {
+                case OpCode::Add:
+                    applyKernel(std::plus<>(), lhs, rhs, destination, count);
+                    break;
+                case OpCode::Subtract:
+                    applyKernel(std::minus<>(), lhs, rhs, destination, count);
+                    break;
+                case OpCode::Multiply:
+                    applyKernel(std::multiplies<>(), lhs, rhs, destination, count);
+                    break;
+                case OpCode::Divide:
+                    applyKernel(std::divides<>(), lhs, rhs, destination, count);
+                    break;
+                case OpCode::Negate:
+                    for (auto i = std::size_t{0}; i < count; ++i)
+                    {
+                        destination[i] = -lhs.values[i];
+                    }
+                    break;
+            }
+        }
+
+        const auto result = valuesOf(mResult);
+        auto* target = output.data() + blockBegin;
+        if (result.values)
+        {
+            std::copy_n(result.values, count, target);
+        }
+        else
+        {
+            std::fill_n(target, count, result.constant);
+        }
+    }
+}
+
+const std::string& CompiledExpression::source() const noexcept
+{
+    return mSource;
+}
+
+}// namespace BPlotter
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <result.hpp>
+
+#include "Benchmark/BenchmarkResults.hpp"
+
+namespace BPlotter
+{
+
+/**
+ * \brief Arithmetic expression over the numeric columns, compiled once and evaluated
+ * for whole ranges of rows at a time.
+ *
+ * Supports numbers, column names, parentheses, unary minus and the + - * / operators,
+ * e.g. "INSTRUCTIONS / CYCLES" or "bytes / (real_time * 1e-9)". Column names containing
+ * characters other than letters, digits, '_', '.' and ':' can be quoted ("CACHE-MISSES"),
+ * although names with '-' are recognized without quotes as long as such a column exists.
+ *
+ * The expression is compiled into a short program of vector instructions. The program is run
+ * over blocks of rows small enough to keep the temporary values in the cache, and each
+ * instruction is a simple loop over the whole block that the compiler can vectorize.
+ * Constant subexpressions are folded during the compilation.
+ */
+class CompiledExpression
+{
+public:
+    /**
+     * \brief Parses and compiles the expression.
+     * \param source Text of the expression
+     * \param results Results whose columns can be referred to by the expression
+     * \return The compiled expression or a description of the error
+     */
+    static cpp::result<CompiledExpression, std::string> compile(std::string_view source,
+                                                                const BenchmarkResults& results);
+
+    /**
+     * \brief Evaluates the expression for consecutive rows.
+     * \param results Results the expression was compiled for
+     * \param firstRow First row to be evaluated
+     * \param output Receives the values of the expression for the rows starting at firstRow
+     */
+    void evaluate(const BenchmarkResults& results, std::size_t firstRow,
+                  std::span<double> output) const;
+
+    /**
+     * \brief Text the expression was compiled from.
+     * \return Source of the expression
+     */
+    [[nodiscard]] const std::string& source() const noexcept;
+
+private:
+    class Compiler;
+
+    enum class OpCode : std::uint8_t
+    {
+        Add,
+        Subtract,
+        Multiply,
+        Divide,
+        Negate,
+    };
+
+    /**
+     * \brief Input of an instruction: a column, a temporary register or a constant.
+     */
+    struct Operand
+    {
+        enum class Kind : std::uint8_t
+        {
+            Column,
+            Register,
+            Constant,
+        };
+
+        Kind kind = Kind::Constant;
+        std::size_t index = 0;
+        double constant = 0;
+    };
+
+    struct Instruction
+    {
+        OpCode operation;
+        Operand lhs;
+        Operand rhs;
+        std::size_t destination;
+    };
+
+    std::string mSource;
+    std::vector<Instruction> mProgram;
+    Operand mResult;
+    std::size_t mRegisters = 0;
+};
+
+}// namespace BPlotter
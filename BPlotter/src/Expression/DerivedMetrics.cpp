@@ -0,0 +1,90 @@
+#include "DerivedMetrics.hpp"
+#include "pch.hpp"
+
+#include <algorithm>
+
+namespace BPlotter
+{
+
+cpp::result<ColumnIndex, std::string> DerivedMetrics::define(BenchmarkResults& results,
+                                                             const std::string_view name,
+                                                             const std::string_view expression)
+{
+    if (name.empty())
+    {
+        return cpp::fail(std::string("The metric needs a name"));
+    }
+
+    // A computed column that no metric owns is left by a metric defined for these results
+    // before (e.g. results restored from the run library), so it is computed again
+    const auto existing = results.findColumn(name);
+    const auto isOwned = std::ranges::any_of(mMetrics,
+                                             [name](const DerivedMetric& metric)
+                                             {
+                                                 return metric.name == name;
+                                             });
+    if (existing && (!results.isComputedColumn(*existing) || isOwned))
+    {
+        return cpp::fail(fmt::format("Column '{}' already exists", name));
+    }
+
+    auto compiled = CompiledExpression::compile(expression, results);
+    if (compiled.has_error())
+    {
+        return cpp::fail(std::move(compiled).error());
+    }
+
+    const auto column = existing ? existing : results.addColumn(name);
+    assert(column);
+    auto& metric = mMetrics.emplace_back(DerivedMetric{.name = std::string(name),
+                                                       .expression = std::move(compiled).value(),
+                                                       .column = *column});
+    evaluate(results, metric);
+    return *column;
+}
+
+void DerivedMetrics::update(BenchmarkResults& results)
+{
+    for (auto& metric: mMetrics)
+    {
+        if (metric.evaluatedRows < results.size())
+        {
+            evaluate(results, metric);
+        }
+    }
+}
+
+void DerivedMetrics::reapply(BenchmarkResults& results)
+{
+    auto previous = std::exchange(mMetrics, {});
+    for (const auto& metric: previous)
+    {
+        if (const auto defined = define(results, metric.name, metric.expression.source());
+            defined.has_error())
+        {
+            spdlog::warn("[DerivedMetrics] Dropping metric {}: {}", metric.name, defined.error());
+        }
+    }
+}
+
+void DerivedMetrics::clear()
+{
+    mMetrics.clear();
+}
+
+std::span<const DerivedMetric> DerivedMetrics::metrics() const noexcept
+{
+    return mMetrics;
+}
+
+void DerivedMetrics::evaluate(BenchmarkResults& results, DerivedMetric& metric)
+{
+    const auto start = std::chrono::steady_clock::now();
+    const auto values = results.mutableColumn(metric.column).subspan(metric.evaluatedRows);
+    metric.expression.evaluate(results, metric.evaluatedRows, values);
+    metric.evaluatedRows = results.size();
+    metric.lastEvaluationTime = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+}
+
+}// namespace BPlotter
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <chrono>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <result.hpp>
+
+#include "Benchmark/BenchmarkResults.hpp"
+#include "Expression/CompiledExpression.hpp"
+
+namespace BPlotter
+{
+
+/**
+ * \brief Metric computed from the other columns, stored as a regular column of the results.
+ */
+struct DerivedMetric
+{
+    std::string name;
+    CompiledExpression expression;
+    ColumnIndex column = 0;
+    std::size_t evaluatedRows = 0;
+    std::chrono::microseconds lastEvaluationTime{0};
+};
+
+/**
+ * \brief User defined metrics (e.g. "INSTRUCTIONS / CYCLES") added to the benchmark results
+ * as columns, so they can be plotted, pivoted and analyzed like any measured value.
+ */
+class DerivedMetrics
+{
+public:
+    /**
+     * \brief Compiles the expression, adds a column for it and evaluates it for all rows.
+     * If the results already have a computed column with this name that no metric owns
+     * (e.g. they were restored from a cache), the column is reused.
+     * \param results Results the metric is added to
+     * \param name Name of the new column
+     * \param expression Expression computing the metric, it may use earlier derived metrics
+     * \return Index of the new column or a description of the error
+     */
+    cpp::result<ColumnIndex, std::string> define(BenchmarkResults& results,
+                                                 std::string_view name,
+                                                 std::string_view expression);
+
+    /**
+     * \brief Evaluates the metrics for the rows appended since the last evaluation.
+     * \param results Results the metrics were defined for
+     */
+    void update(BenchmarkResults& results);
+
+    /**
+     * \brief Defines all the metrics again for other results, e.g. after loading a new file.
+     * Metrics that can not be computed from the new results are dropped.
+     * \param results New results
+     */
+    void reapply(BenchmarkResults& results);
+
+    /**
+     * \brief Removes all the metrics. Their columns stay in the results.
+     */
+    void clear();
+
+    /**
+     * \brief Currently defined metrics in the order of definition.
+     * \return Defined metrics
+     */
+    [[nodiscard]] std::span<const DerivedMetric> metrics() const noexcept;
+
+private:
+    static void evaluate(BenchmarkResults& results, DerivedMetric& metric);
+
+private:
+    std::vector<DerivedMetric> mMetrics;
+};
+
+}// namespace BPlotter
@@ -0,0 +1,322 @@
+#include "NameFilter.hpp"
+#include "pch.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <numeric>
+
+namespace BPlotter
+{
+
+namespace
+{
+
+/**
+ * \brief How many names are checked between subsequent reads of the clock.
+ */
+constexpr std::size_t CHECKS_PER_CLOCK_READ = 64;
+
+bool equalIgnoreCase(const char lhs, const char rhs)
+{
+    return std::tolower(static_cast<unsigned char>(lhs)) ==
+           std::tolower(static_cast<unsigned char>(rhs));
+}
+
+bool containsIgnoreCase(const std::string_view text, const std::string_view part)
+{
+    return part.empty() || std::ranges::search(text, part, equalIgnoreCase).begin() != text.end();
+}
+
+/**
+ * \brief Finds the end of an escape sequence starting with a letter or a digit.
+ * \param pattern Regular expression
+ * \param letter Index of the character following the backslash
+ * \return Index of the first character after the escape sequence
+ */
+std::size_t endOfEscape(const std::string_view pattern, const std::size_t letter)
+{
+    // Skips at most the given number of the characters the sequence may continue with
+    const auto skip = [pattern](std::size_t i, const std::size_t count, const auto isPart)
+    {
+        const auto end = std::min(i + count, pattern.size());
+        while (i < end && isPart(static_cast<unsigned char>(pattern[i])))
+        {
+            ++i;
+        }
+        return i;
+    };
+    const auto isHexDigit = [](const unsigned char character)
+    {
+        return std::isxdigit(character) != 0;
+    };
+    const auto isDigit = [](const unsigned char character)
+    {
+        return std::isdigit(character) != 0;
+    };
+    const auto isLetter = [](const unsigned char character)
+    {
+        return std::isalpha(character) != 0;
+    };
+
+    switch (pattern[letter])
+    {
+        case 'x': return skip(letter + 1, 2, isHexDigit);
+        case 'u': return skip(letter + 1, 4, isHexDigit);
+        case 'c': return skip(letter + 1, 1, isLetter);
+        default: break;
+    }
+    // Back-references and \0 may have any number of digits
+    if (isDigit(static_cast<unsigned char>(pattern[letter])))
+    {
+        return skip(letter + 1, pattern.size(), isDigit);
+    }
+    return letter + 1;
+}
+
+/**
+ * \brief Extracts literal fragments that every string matching the regular expression must
+ * contain.
+ *
+ * It is deliberately conservative: anything inside groups or character classes is ignored,
+ * an optional character ends the fragment, and an alternation anywhere in the pattern gives
+ * up completely. A fragment is returned only if it is long enough to contain a trigram.
+ */
+std::vector<std::string> requiredLiterals(const std::string_view pattern)
+{
+    std::vector<std::string> literals;
+    std::string current;
+    const auto flush = [&]()
+    {
+        if (current.size() >= 3)
+        {
+            literals.push_back(current);
+        }
+        current.clear();
+    };
+
+    auto groupDepth = 0;
+    for (std::size_t i = 0; i < pattern.size(); ++i)
+    {
+        auto character = pattern[i];
+        switch (character)
+        {
+            case '|': return {};
+            case '(':
+                ++groupDepth;
+                flush();
+                continue;
+            case ')':
+                --groupDepth;
+                flush();
+                continue;
+            case '[':
+                // Skips the whole character class. A closing bracket right after the opening
+                // one (or after the negation) belongs to the class.
+                ++i;
+                if (i < pattern.size() && pattern[i] == '^')
+                {
+                    ++i;
+                }
+                if (i < pattern.size() && pattern[i] == ']')
+                {
+                    ++i;
+                }
+                while (i < pattern.size() && pattern[i] != ']')
+                {
+                    i += pattern[i] == '\\' ? 2 : 1;
+                }
+                flush();
+                continue;
+            case '*':
+            case '?':
+            case '{':
+                // The preceding character may not be present at all
+                if (not current.empty())
+                {
+                    current.pop_back();
+                }
+                flush();
+                if (character == '{')
+                {
+                    i = std::min(pattern.find('}', i), pattern.size());
+                }
+                continue;
+            case '+':
+            case '.':
+            case '^':
+            case '$': flush(); continue;
+            case '\\':
+                // Escaped letters and digits are classes (\d, \w), assertions (\b), character
+                // codes (\x41, \u0041, \cJ) or back-references (\1), none of them a literal
+                if (i + 1 >= pattern.size())
+                {
+                    ++i;
+                    flush();
+                    continue;
+                }
+                if (std::isalnum(static_cast<unsigned char>(pattern[i + 1])))
+                {
+                    i = endOfEscape(pattern, i + 1) - 1;
+                    flush();
+                    continue;
+                }
+                character = pattern[++i];
+                break;
+            default: break;
+        }
+
+        if (groupDepth == 0)
+        {
+            current.push_back(character);
+        }
+    }
+    flush();
+    return literals;
+}
+
+}// namespace
+
+void NameFilter::reset(const StringInterner& names)
+{
+    mNames = &names;
+    mIndex.clear();
+    mIndexedNames = 0;
+    mQuery.clear();
+    mMode = FilterMode::Substring;
+    indexNewNames();
+}
+
+void NameFilter::indexNewNames()
+{
+    if (mNames == nullptr)
+    {
+        return;
+    }
+
+    for (auto id = static_cast<StringId>(mIndexedNames); id < mNames->size(); ++id)
+    {
+        mIndex.add(id, mNames->get(id));
+    }
+    mIndexedNames = mNames->size();
+    applyQuery();
+}
+
+void NameFilter::setQuery(const std::string_view query, const FilterMode mode)
+{
+    if (query == mQuery && mode == mMode)
+    {
+        return;
+    }
+
+    // Every name containing the extended query also contains the previous one, so it is
+    // enough to look through the previous matches and the names that were not checked yet.
+    // This does not hold for regular expressions: "a" extended to "a?" matches more.
+    const auto isRefinement = mode == FilterMode::Substring && mMode == FilterMode::Substring &&
+                              containsIgnoreCase(query, mQuery);
+
+    mQuery = query;
+    mMode = mode;
+
+    if (not isRefinement)
+    {
+        applyQuery();
+        return;
+    }
+
+    auto candidates = std::move(mMatches);
+    candidates.insert(candidates.end(), mCandidates.begin() + mNextCandidate, mCandidates.end());
+    restart(std::move(candidates));
+}
+
+bool NameFilter::update(const std::chrono::microseconds budget)
+{
+    const auto deadline = std::chrono::steady_clock::now() + budget;
+    while (mNextCandidate < mCandidates.size())
+    {
+        const auto id = mCandidates[mNextCandidate++];
+        if (isMatching(mNames->get(id)))
+        {
+            mMatches.push_back(id);
+        }
+
+        if (mNextCandidate % CHECKS_PER_CLOCK_READ == 0 &&
+            std::chrono::steady_clock::now() >= deadline)
+        {
+            break;
+        }
+    }
+    return isFinished();
+}
+
+bool NameFilter::isFinished() const noexcept
+{
+    return mNextCandidate >= mCandidates.size();
+}
+
+std::span<const StringId> NameFilter::matches() const noexcept
+{
+    return mMatches;
+}
+
+const std::string& NameFilter::error() const noexcept
+{
+    return mError;
+}
+
+void NameFilter::applyQuery()
+{
+    mRegex.reset();
+    mError.clear();
+
+    std::vector<Trigram> trigrams;
+    if (mMode == FilterMode::Substring)
+    {
+        TrigramIndex::trigramsOf(mQuery, trigrams);
+    }
+    else
+    {
+        try
+        {
+            mRegex.emplace(mQuery, std::regex::ECMAScript | std::regex::icase |
+                                       std::regex::optimize);
+        }
+        catch (const std::regex_error& e)
+        {
+            mError = e.what();
+            restart(std::vector<StringId>{});
+            return;
+        }
+
+        for (const auto& literal: requiredLiterals(mQuery))
+        {
+            TrigramIndex::trigramsOf(literal, trigrams);
+        }
+    }
+    restart(mIndex.candidates(trigrams));
+}
+
+void NameFilter::restart(std::optional<std::vector<StringId>> candidates)
+{
+    if (candidates)
+    {
+        mCandidates = std::move(*candidates);
+    }
+    else
+    {
+        mCandidates.resize(mIndexedNames);
+        std::iota(mCandidates.begin(), mCandidates.end(), StringId{0});
+    }
+    mNextCandidate = 0;
+    mMatches.clear();
+}
+
+bool NameFilter::isMatching(const std::string_view name) const
+{
+    if (mRegex)
+    {
+        return std::regex_search(name.begin(), name.end(), *mRegex);
+    }
+    return containsIgnoreCase(name, mQuery);
+}
+
+}// namespace BPlotter
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <regex>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Benchmark/StringInterner.hpp"
+#include "Filter/TrigramIndex.hpp"
+
+namespace BPlotter
+{
+
+/**
+ * \brief How the query of the NameFilter is interpreted.
+ */
+enum class FilterMode
+{
+    Substring,
+    Regex,
+};
+
+/**
+ * \brief Incrementally filters interned benchmark names as the user types the query.
+ *
+ * Names are indexed by trigrams once, when they are loaded. Every query is first narrowed
+ * down with the index to the names that can possibly match, and only those candidates are
+ * checked against the query. When a substring query is extended, the new matches are
+ * searched only among the previous ones. Checking the candidates is spread over frames with
+ * a time budget, which is checked between the names, so filtering many names does not stall a
+ * frame. A single name is matched at once though, and a pathological regular expression can
+ * still take long on one name.
+ *
+ * Matching is case-insensitive in both modes.
+ */
+class NameFilter
+{
+public:
+    /**
+     * \brief Indexes all names of the interner, discarding the previous index and query.
+     * \param names Interned names to filter. Must outlive the filter or the next reset.
+     */
+    void reset(const StringInterner& names);
+
+    /**
+     * \brief Indexes names that were interned after the last call to reset() or indexNewNames().
+     *
+     * The current query is applied again so the new names can appear in the matches.
+     */
+    void indexNewNames();
+
+    /**
+     * \brief Sets the query. Does nothing if neither the query nor the mode changed.
+     * \param query Substring or regular expression to search for
+     * \param mode How the query should be interpreted
+     */
+    void setQuery(std::string_view query, FilterMode mode);
+
+    /**
+     * \brief Checks the pending candidates against the query until the time budget runs out.
+     * \param budget Maximum time that can be spent on checking the candidates
+     * \return True if all the candidates were checked
+     */
+    bool update(std::chrono::microseconds budget);
+
+    /**
+     * \brief Checks if all the candidates for the current query were already checked.
+     * \return True if the matches are complete
+     */
+    [[nodiscard]] bool isFinished() const noexcept;
+
+    /**
+     * \brief Names matching the query that were found so far, in increasing order.
+     * \return Identifiers of the matching names
+     */
+    [[nodiscard]] std::span<const StringId> matches() const noexcept;
+
+    /**
+     * \brief Description of the problem with the query, such as an invalid regular expression.
+     * \return Description of the error or an empty string if the query is valid
+     */
+    [[nodiscard]] const std::string& error() const noexcept;
+
+private:
+    /**
+     * \brief Looks for the candidates of the current query from scratch, using the index.
+     */
+    void applyQuery();
+
+    /**
+     * \brief Starts checking the given candidates against the current query from scratch.
+     * \param candidates Names that may match the query, or nullopt if every name may match
+     */
+    void restart(std::optional<std::vector<StringId>> candidates);
+
+    /**
+     * \brief Checks whether the name matches the current query.
+     * \param name Name to check
+     * \return True if the name matches the query
+     */
+    [[nodiscard]] bool isMatching(std::string_view name) const;
+
+    const StringInterner* mNames = nullptr;
+    TrigramIndex mIndex;
+    std::size_t mIndexedNames = 0;
+
+    std::string mQuery;
+    FilterMode mMode = FilterMode::Substring;
+    std::optional<std::regex> mRegex;
+    std::string mError;
+
+    /**
+     * \brief Names that still have to be checked against the query, starting at mNextCandidate.
+     */
+    std::vector<StringId> mCandidates;
+    std::size_t mNextCandidate = 0;
+    std::vector<StringId> mMatches;
+};
+
+}// namespace BPlotter
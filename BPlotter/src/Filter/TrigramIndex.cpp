@@ -0,0 +1,94 @@
+#include "TrigramIndex.hpp"
+#include "pch.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+namespace BPlotter
+{
+
+namespace
+{
+
+Trigram makeTrigram(const std::string_view text, const std::size_t position)
+{
+    const auto lower = [&](const std::size_t offset)
+    {
+        return static_cast<Trigram>(
+            std::tolower(static_cast<unsigned char>(text[position + offset])));
+    };
+    return lower(0) << 16 | lower(1) << 8 | lower(2);
+}
+
+}// namespace
+
+void TrigramIndex::add(const StringId id, const std::string_view text)
+{
+    for (std::size_t i = 0; i + 3 <= text.size(); ++i)
+    {
+        // Ids are added in increasing order, so a repeated trigram of the same text
+        // can only ever be at the back of the posting list
+        auto& postings = mPostings[makeTrigram(text, i)];
+        assert(postings.empty() || postings.back() <= id);
+        if (postings.empty() || postings.back() != id)
+        {
+            postings.push_back(id);
+        }
+    }
+}
+
+void TrigramIndex::clear()
+{
+    mPostings.clear();
+}
+
+std::optional<std::vector<StringId>> TrigramIndex::candidates(
+    const std::span<const Trigram> trigrams) const
+{
+    if (trigrams.empty())
+    {
+        return std::nullopt;
+    }
+
+    std::vector<const std::vector<StringId>*> lists;
+    lists.reserve(trigrams.size());
+    for (const auto trigram: trigrams)
+    {
+        const auto found = mPostings.find(trigram);
+        if (found == mPostings.end())
+        {
+            return std::vector<StringId>{};
+        }
+        lists.push_back(&found->second);
+    }
+
+    // Starting from the rarest trigram keeps the intermediate results as small as possible
+    std::ranges::sort(lists, {},
+                      [](const auto* list)
+                      {
+                          return list->size();
+                      });
+
+    std::vector<StringId> result = *lists.front();
+    std::vector<StringId> intersection;
+    for (std::size_t i = 1; i < lists.size() && not result.empty(); ++i)
+    {
+        intersection.clear();
+        std::ranges::set_intersection(result, *lists[i], std::back_inserter(intersection));
+        std::swap(result, intersection);
+    }
+    return result;
+}
+
+void TrigramIndex::trigramsOf(const std::string_view text, std::vector<Trigram>& output)
+{
+    const auto firstNew = output.size();
+    for (std::size_t i = 0; i + 3 <= text.size(); ++i)
+    {
+        output.push_back(makeTrigram(text, i));
+    }
+    std::sort(output.begin() + firstNew, output.end());
+    output.erase(std::unique(output.begin() + firstNew, output.end()), output.end());
+}
+
+}// namespace BPlotter
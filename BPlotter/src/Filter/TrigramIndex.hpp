@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Benchmark/StringInterner.hpp"
+
+namespace BPlotter
+{
+
+/**
+ * \brief Three consecutive (lowercase) characters packed into a single integer.
+ */
+using Trigram = std::uint32_t;
+
+/**
+ * \brief Inverted index from trigrams to the strings containing them.
+ *
+ * Used to quickly narrow down the strings that may contain a given substring: a string
+ * can contain the substring only if it contains every trigram of that substring. The index
+ * is case-insensitive, so it can serve case-insensitive queries too.
+ */
+class TrigramIndex
+{
+public:
+    /**
+     * \brief Adds the string to the index.
+     * \param id Identifier of the string. Identifiers have to be added in increasing order.
+     * \param text The string to be indexed
+     */
+    void add(StringId id, std::string_view text);
+
+    /**
+     * \brief Removes all strings from the index.
+     */
+    void clear();
+
+    /**
+     * \brief Finds the strings that contain all the given trigrams.
+     * \param trigrams Trigrams that must be present in the string
+     * \return Sorted identifiers of the matching strings, or nullopt if no trigrams were given
+     * and thus any string is a candidate.
+     */
+    [[nodiscard]] std::optional<std::vector<StringId>> candidates(
+        std::span<const Trigram> trigrams) const;
+
+    /**
+     * \brief Computes the distinct trigrams of the text.
+     * \param text Text to split into trigrams
+     * \param output Vector to which the trigrams are appended
+     */
+    static void trigramsOf(std::string_view text, std::vector<Trigram>& output);
+
+private:
+    /**
+     * \brief Sorted identifiers of the strings containing a given trigram.
+     */
+    std::unordered_map<Trigram, std::vector<StringId>> mPostings;
+};
+
+}// namespace BPlotter
@@ -0,0 +1,535 @@
+#include "HistoryStore.hpp"
+#include "pch.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+#include <unordered_map>
+
+#include "Benchmark/BenchmarkParser.hpp"
+#include "Utils/BinaryIo.hpp"
+
+namespace BPlotter
+{
+
+namespace
+{
+
+constexpr auto NAMES_FILE = "names.bin";
+constexpr auto INDEX_FILE = "index.bin";
+constexpr auto RUNS_FILE = "runs.bin";
+constexpr auto SEGMENTS_DIRECTORY = "segments";
+
+/**
+ * \brief Size of the file before records are appended to it, so that they can be truncated
+ * away should appending them fail.
+ * \return Size of the file, zero if it does not exist yet
+ */
+std::uintmax_t sizeBeforeAppend(const std::filesystem::path& path)
+{
+    std::error_code error;
+    const auto size = std::filesystem::file_size(path, error);
+    return error ? 0 : size;
+}
+
+/**
+ * \brief Truncates the file back to its size before a failed append.
+ */
+void rollBackAppend(const std::filesystem::path& path, const std::uintmax_t previousSize)
+{
+    if (std::error_code error; std::filesystem::is_regular_file(path, error))
+    {
+        std::filesystem::resize_file(path, previousSize, error);
+    }
+}
+
+/**
+ * \brief Reads records from the file until the end or until a record is incomplete,
+ * in which case the file is truncated to the last complete record.
+ * \param path Path to the file
+ * \param readRecord Reads a single record, returns false if the record is not complete
+ * or should be dropped together with all the following ones
+ */
+template<typename ReadRecord>
+void readRecords(const std::filesystem::path& path, ReadRecord readRecord)
+{
+    auto validSize = std::uintmax_t{0};
+    {
+        std::ifstream input(path, std::ios::binary);
+        while (input && input.peek() != std::ifstream::traits_type::eof() && readRecord(input))
+        {
+            validSize = static_cast<std::uintmax_t>(input.tellg());
+        }
+    }
+    if (std::error_code error; std::filesystem::file_size(path, error) > validSize && !error)
+    {
+        spdlog::warn("[HistoryStore] Dropping incomplete records of {}", path.string());
+        std::filesystem::resize_file(path, validSize);
+    }
+}
+
+std::optional<int> parseNumber(const std::string_view text)
+{
+    auto value = 0;
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error != std::errc{} || end != text.data() + text.size())
+    {
+        return std::nullopt;
+    }
+    return value;
+}
+
+}// namespace
+
+std::optional<std::int64_t> parseTimestamp(const std::string_view date)
+{
+    if (date.size() < 19 || date[4] != '-' || date[7] != '-' ||
+        (date[10] != 'T' && date[10] != ' ') || date[13] != ':' || date[16] != ':')
+    {
+        return std::nullopt;
+    }
+    const auto year = parseNumber(date.substr(0, 4));
+    const auto month = parseNumber(date.substr(5, 2));
+    const auto day = parseNumber(date.substr(8, 2));
+    const auto hour = parseNumber(date.substr(11, 2));
+    const auto minute = parseNumber(date.substr(14, 2));
+    const auto second = parseNumber(date.substr(17, 2));
+    if (!year || !month || !day || !hour || !minute || !second)
+    {
+        return std::nullopt;
+    }
+
+    auto zone = date.substr(19);
+    if (zone.starts_with('.'))
+    {
+        zone.remove_prefix(std::min(zone.find_first_not_of("0123456789", 1), zone.size()));
+    }
+    auto offset = 0;
+    if (zone.size() == 6 && (zone[0] == '+' || zone[0] == '-') && zone[3] == ':')
+    {
+        const auto zoneHours = parseNumber(zone.substr(1, 2));
+        const auto zoneMinutes = parseNumber(zone.substr(4, 2));
+        if (!zoneHours || !zoneMinutes)
+        {
+            return std::nullopt;
+        }
+        offset = (zone[0] == '-' ? -1 : 1) * (*zoneHours * 3600 + *zoneMinutes * 60);
+    }
+    else if (!zone.empty() && zone != "Z")
+    {
+        return std::nullopt;
+    }
+
+    const auto calendarDate = std::chrono::year{*year} / *month / *day;
+    if (!calendarDate.ok())
+    {
+        return std::nullopt;
+    }
+    const auto days = std::chrono::sys_days(calendarDate).time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::seconds>(days).count() + *hour * 3600 +
+           *minute * 60 + *second - offset;
+}
+
+HistoryStore::HistoryStore(std::filesystem::path directory)
+    : mDirectory(std::move(directory))
+{
+}
+
+cpp::result<HistoryStore, std::string> HistoryStore::open(const std::filesystem::path& directory)
+{
+    std::error_code error;
+    std::filesystem::create_directories(directory / SEGMENTS_DIRECTORY, error);
+    if (error)
+    {
+        return cpp::fail(fmt::format("Unable to create {}: {}", directory.string(),
+                                     error.message()));
+    }
+
+    auto store = HistoryStore(directory);
+    if (auto loaded = store.load(); loaded.has_error())
+    {
+        return cpp::fail(loaded.error());
+    }
+    return store;
+}
+
+cpp::result<void, std::string> HistoryStore::load()
+{
+    try
+    {
+        readRecords(mDirectory / RUNS_FILE,
+                    [this](std::istream& input)
+                    {
+                        auto segment = Segment{};
+                        auto key = std::string();
+                        auto columnCount = std::uint32_t{0};
+                        if (!readValue(input, segment.rowCount) ||
+                            !readValue(input, segment.timestamp) || !readString(input, key) ||
+                            !readValue(input, columnCount))
+                        {
+                            return false;
+                        }
+                        auto column = std::string();
+                        for (auto i = std::uint32_t{0}; i < columnCount; ++i)
+                        {
+                            if (!readString(input, column))
+                            {
+                                return false;
+                            }
+                            segment.columns.push_back(mColumns.intern(column));
+                        }
+                        mSegments.push_back(std::move(segment));
+                        mRunKeys.insert(std::move(key));
+                        return true;
+                    });
+
+        readRecords(mDirectory / NAMES_FILE,
+                    [this](std::istream& input)
+                    {
+                        auto name = std::string();
+                        if (!readString(input, name))
+                        {
+                            return false;
+                        }
+                        mBenchmarks.intern(name);
+                        return true;
+                    });
+
+        // Entries of runs that were not committed are at the end of the index
+        readRecords(mDirectory / INDEX_FILE,
+                    [this](std::istream& input)
+                    {
+                        auto entry = IndexEntry{};
+                        if (!readValue(input, entry.benchmark) ||
+                            !readValue(input, entry.segment) ||
+                            !readValue(input, entry.timestamp) ||
+                            !readValue(input, entry.firstRow) || !readValue(input, entry.rowCount))
+                        {
+                            return false;
+                        }
+                        if (entry.segment >= mSegments.size() ||
+                            entry.benchmark >= mBenchmarks.size())
+                        {
+                            return false;
+                        }
+                        mIndex.push_back(entry);
+                        return true;
+                    });
+    }
+    catch (const std::filesystem::filesystem_error& error)
+    {
+        return cpp::fail(fmt::format("Unable to load the history: {}", error.what()));
+    }
+
+    std::ranges::sort(mIndex,
+                      [](const IndexEntry& lhs, const IndexEntry& rhs)
+                      {
+                          return std::tie(lhs.benchmark, lhs.timestamp) <
+                                 std::tie(rhs.benchmark, rhs.timestamp);
+                      });
+    return {};
+}
+
+cpp::result<bool, std::string> HistoryStore::ingest(const BenchmarkResults& results,
+                                                    const std::string_view runKey,
+                                                    const std::int64_t timestamp)
+{
+    if (mRunKeys.contains(std::string(runKey)))
+    {
+        return false;
+    }
+
+    // Names not stored yet get consecutive identifiers after the existing ones
+    const auto segment = static_cast<std::uint32_t>(mSegments.size());
+    std::vector<std::optional<BenchmarkId>> idOfName(results.names().size());
+    std::vector<std::string_view> newNames;
+    std::vector<BenchmarkId> ids;
+    ids.reserve(results.size());
+    for (const auto name: results.nameColumn())
+    {
+        auto& id = idOfName[name];
+        if (!id)
+        {
+            const auto text = results.names().get(name);
+            id = mBenchmarks.find(text);
+            if (!id)
+            {
+                id = static_cast<BenchmarkId>(mBenchmarks.size() + newNames.size());
+                newNames.push_back(text);
+            }
+        }
+        ids.push_back(*id);
+    }
+
+    std::vector<std::uint32_t> order(results.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::stable_sort(order, {}, [&ids](const std::uint32_t row) { return ids[row]; });
+
+    {
+        std::ofstream output(segmentPath(segment), std::ios::binary | std::ios::trunc);
+        std::vector<BenchmarkId> sortedIds(order.size());
+        std::ranges::transform(order, sortedIds.begin(),
+                               [&ids](const std::uint32_t row) { return ids[row]; });
+        output.write(reinterpret_cast<const char*>(sortedIds.data()),
+                     static_cast<std::streamsize>(sortedIds.size() * sizeof(BenchmarkId)));
+
+        std::vector<double> sortedValues(order.size());
+        for (ColumnIndex column = 0; column < results.columnCount(); ++column)
+        {
+            const auto values = results.column(column);
+            std::ranges::transform(order, sortedValues.begin(),
+                                   [&values](const std::uint32_t row) { return values[row]; });
+            output.write(reinterpret_cast<const char*>(sortedValues.data()),
+                         static_cast<std::streamsize>(sortedValues.size() * sizeof(double)));
+        }
+        if (!output.flush())
+        {
+            return cpp::fail(fmt::format("Unable to write {}", segmentPath(segment).string()));
+        }
+    }
+
+    if (!newNames.empty())
+    {
+        const auto namesPath = mDirectory / NAMES_FILE;
+        const auto previousSize = sizeBeforeAppend(namesPath);
+        std::ofstream output(namesPath, std::ios::binary | std::ios::app);
+        for (const auto name: newNames)
+        {
+            writeString(output, name);
+        }
+        if (!output.flush())
+        {
+            output.close();
+            rollBackAppend(namesPath, previousSize);
+            return cpp::fail(fmt::format("Unable to write {}", namesPath.string()));
+        }
+        for (const auto name: newNames)
+        {
+            mBenchmarks.intern(name);
+        }
+    }
+
+    std::vector<IndexEntry> entries;
+    for (auto first = std::size_t{0}; first < order.size();)
+    {
+        const auto benchmark = ids[order[first]];
+        auto last = first + 1;
+        while (last < order.size() && ids[order[last]] == benchmark)
+        {
+            ++last;
+        }
+        entries.push_back({benchmark, segment, timestamp, static_cast<std::uint32_t>(first),
+                           static_cast<std::uint32_t>(last - first)});
+        first = last;
+    }
+    // The entries of a run that failed to commit would be taken for those of the next run
+    // reusing its segment, so both files are truncated back on any failure
+    const auto indexPath = mDirectory / INDEX_FILE;
+    const auto runsPath = mDirectory / RUNS_FILE;
+    const auto previousIndexSize = sizeBeforeAppend(indexPath);
+    const auto previousRunsSize = sizeBeforeAppend(runsPath);
+    const auto rollBack = [&]
+    {
+        rollBackAppend(indexPath, previousIndexSize);
+        rollBackAppend(runsPath, previousRunsSize);
+    };
+
+    auto isWritten = false;
+    {
+        std::ofstream output(indexPath, std::ios::binary | std::ios::app);
+        for (const auto& entry: entries)
+        {
+            writeValue(output, entry.benchmark);
+            writeValue(output, entry.segment);
+            writeValue(output, entry.timestamp);
+            writeValue(output, entry.firstRow);
+            writeValue(output, entry.rowCount);
+        }
+        isWritten = static_cast<bool>(output.flush());
+    }
+    if (!isWritten)
+    {
+        rollBack();
+        return cpp::fail(std::string("Unable to write the history index"));
+    }
+
+    // Appending the run commits it
+    auto stored = Segment{timestamp, static_cast<std::uint32_t>(results.size())};
+    {
+        std::ofstream output(runsPath, std::ios::binary | std::ios::app);
+        writeValue(output, stored.rowCount);
+        writeValue(output, stored.timestamp);
+        writeString(output, runKey);
+        writeValue(output, static_cast<std::uint32_t>(results.columnCount()));
+        for (ColumnIndex column = 0; column < results.columnCount(); ++column)
+        {
+            writeString(output, results.columnName(column));
+        }
+        isWritten = static_cast<bool>(output.flush());
+    }
+    if (!isWritten)
+    {
+        rollBack();
+        return cpp::fail(std::string("Unable to write the history runs"));
+    }
+    for (ColumnIndex column = 0; column < results.columnCount(); ++column)
+    {
+        stored.columns.push_back(mColumns.intern(results.columnName(column)));
+    }
+
+    mSegments.push_back(std::move(stored));
+    mRunKeys.emplace(runKey);
+    const auto previousSize = static_cast<std::ptrdiff_t>(mIndex.size());
+    // The new entries are already sorted, as they all share the same timestamp
+    mIndex.insert(mIndex.end(), entries.begin(), entries.end());
+    std::ranges::inplace_merge(mIndex, mIndex.begin() + previousSize,
+                               [](const IndexEntry& lhs, const IndexEntry& rhs)
+                               {
+                                   return std::tie(lhs.benchmark, lhs.timestamp) <
+                                          std::tie(rhs.benchmark, rhs.timestamp);
+                               });
+    return true;
+}
+
+cpp::result<bool, std::string> HistoryStore::ingestFile(const std::filesystem::path& path,
+                                                        TaskScheduler& scheduler)
+{
+    auto results = loadBenchmarkResults(path, scheduler);
+    if (not results)
+    {
+        return cpp::fail(results.error());
+    }
+
+    const auto& context = results->context();
+    const auto timestamp = parseTimestamp(context.date);
+    if (!timestamp)
+    {
+        return cpp::fail(fmt::format("{} has no valid date: '{}'", path.string(), context.date));
+    }
+    const auto runKey = fmt::format("{}|{}|{}", context.date, context.hostName,
+                                    context.executable);
+    return ingest(*results, runKey, *timestamp);
+}
+
+std::vector<HistoryPoint> HistoryStore::history(const std::string_view benchmark,
+                                                const std::string_view column) const
+{
+    const auto benchmarkId = mBenchmarks.find(benchmark);
+    const auto columnId = mColumns.find(column);
+    if (!benchmarkId || !columnId)
+    {
+        return {};
+    }
+
+    std::vector<HistoryPoint> points;
+    std::vector<double> values;
+    for (const auto& entry: std::ranges::equal_range(mIndex, *benchmarkId, {},
+                                                     &IndexEntry::benchmark))
+    {
+        const auto& segment = mSegments[entry.segment];
+        const auto position = std::ranges::find(segment.columns, *columnId);
+        if (position == segment.columns.end())
+        {
+            continue;
+        }
+
+        const auto columnPosition = static_cast<std::size_t>(position - segment.columns.begin());
+        const auto offset = segment.rowCount * sizeof(BenchmarkId) +
+                            (columnPosition * segment.rowCount + entry.firstRow) * sizeof(double);
+        values.resize(entry.rowCount);
+        std::ifstream input(segmentPath(entry.segment), std::ios::binary);
+        input.seekg(static_cast<std::streamoff>(offset));
+        if (!input.read(reinterpret_cast<char*>(values.data()),
+                        static_cast<std::streamsize>(values.size() * sizeof(double))))
+        {
+            spdlog::warn("[HistoryStore] Unable to read {}", segmentPath(entry.segment).string());
+            continue;
+        }
+        for (const auto value: values)
+        {
+            if (!std::isnan(value))
+            {
+                points.push_back({entry.timestamp, value});
+            }
+        }
+    }
+    return points;
+}
+
+std::vector<std::vector<HistoryPoint>> HistoryStore::histories(
+    const std::string_view column) const
+{
+    std::vector<std::vector<HistoryPoint>> histories(mBenchmarks.size());
+    const auto columnId = mColumns.find(column);
+    if (!columnId)
+    {
+        return histories;
+    }
+
+    std::vector<BenchmarkId> ids;
+    std::vector<double> values;
+    for (std::size_t segmentIndex = 0; segmentIndex < mSegments.size(); ++segmentIndex)
+    {
+        const auto& segment = mSegments[segmentIndex];
+        const auto position = std::ranges::find(segment.columns, *columnId);
+        if (position == segment.columns.end())
+        {
+            continue;
+        }
+
+        const auto columnPosition = static_cast<std::size_t>(position - segment.columns.begin());
+        ids.resize(segment.rowCount);
+        values.resize(segment.rowCount);
+        std::ifstream input(segmentPath(segmentIndex), std::ios::binary);
+        input.read(reinterpret_cast<char*>(ids.data()),
+                   static_cast<std::streamsize>(ids.size() * sizeof(BenchmarkId)));
+        input.seekg(static_cast<std::streamoff>(segment.rowCount * sizeof(BenchmarkId) +
+                                                columnPosition * segment.rowCount *
+                                                    sizeof(double)));
+        if (!input.read(reinterpret_cast<char*>(values.data()),
+                        static_cast<std::streamsize>(values.size() * sizeof(double))))
+        {
+            spdlog::warn("[HistoryStore] Unable to read {}", segmentPath(segmentIndex).string());
+            continue;
+        }
+        for (std::size_t row = 0; row < ids.size(); ++row)
+        {
+            if (ids[row] < histories.size() && !std::isnan(values[row]))
+            {
+                histories[ids[row]].push_back({segment.timestamp, values[row]});
+            }
+        }
+    }
+
+    // Segments are stored in the order of ingestion, which does not have to be chronological
+    for (auto& points: histories)
+    {
+        std::ranges::stable_sort(points, {}, &HistoryPoint::timestamp);
+    }
+    return histories;
+}
+
+const StringInterner& HistoryStore::benchmarks() const noexcept
+{
+    return mBenchmarks;
+}
+
+const StringInterner& HistoryStore::columns() const noexcept
+{
+    return mColumns;
+}
+
+std::size_t HistoryStore::runCount() const noexcept
+{
+    return mSegments.size();
+}
+
+std::filesystem::path HistoryStore::segmentPath(const std::size_t segment) const
+{
+    return mDirectory / SEGMENTS_DIRECTORY / fmt::format("{:08}.bin", segment);
+}
+
+}// namespace BPlotter
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include <result.hpp>
+
+#include "Benchmark/BenchmarkResults.hpp"
+#include "Benchmark/StringInterner.hpp"
+#include "Tasks/TaskScheduler.hpp"
+
+namespace BPlotter
+{
+
+/**
+ * \brief Identifier of a benchmark (its full name) within the history store.
+ */
+using BenchmarkId = StringId;
+
+/**
+ * \brief Value of a benchmark in one of the runs stored in the history.
+ */
+struct HistoryPoint
+{
+    /**
+     * \brief Seconds since the Unix epoch at which the run was started.
+     */
+    std::int64_t timestamp;
+    double value;
+};
+
+/**
+ * \brief Converts the date of the run written by Google Benchmark to a Unix timestamp.
+ * \param date Date in the "YYYY-MM-DD[T ]HH:MM:SS[Z|+HH:MM|-HH:MM]" format
+ * \return Seconds since the Unix epoch or nullopt if the date is malformed
+ */
+std::optional<std::int64_t> parseTimestamp(std::string_view date);
+
+/**
+ * \brief Append-only on-disk database of benchmark runs, answering the history of a single
+ * benchmark without reading the original JSON files.
+ *
+ * Every ingested run becomes a segment file holding its rows sorted by the benchmark,
+ * stored columnar: the benchmark identifiers followed by the values of each column.
+ * The (benchmark, timestamp) index points to the rows of a benchmark in each segment, so a
+ * history query reads only the values of one column for one benchmark from each run.
+ *
+ * Layout of the directory (all numbers in the native byte order):
+ *  - names.bin    benchmark names, the position of a name is its identifier
+ *  - index.bin    fixed size entries (benchmark, segment, timestamp, first row, row count)
+ *  - runs.bin     description of each segment (timestamp, run key, row count, columns)
+ *  - segments/    one file per ingested run
+ *
+ * A run is committed by appending its description to runs.bin, which is written last.
+ * Index entries of runs that were not committed (e.g. after a crash) are dropped on open.
+ */
+class HistoryStore
+{
+public:
+    HistoryStore(const HistoryStore&) = delete;
+    HistoryStore(HistoryStore&&) = default;
+    HistoryStore& operator=(const HistoryStore&) = delete;
+    HistoryStore& operator=(HistoryStore&&) = default;
+
+    /**
+     * \brief Opens the store in the directory, creating it if it does not exist.
+     * \param directory Directory of the store
+     * \return The opened store or a description of the error
+     */
+    static cpp::result<HistoryStore, std::string> open(const std::filesystem::path& directory);
+
+    /**
+     * \brief Stores the rows of the run unless a run with the same key was already ingested.
+     * \param results Results of the run
+     * \param runKey Key identifying the run
+     * \param timestamp Seconds since the Unix epoch at which the run was started
+     * \return Whether the run was stored, or a description of the error
+     */
+    cpp::result<bool, std::string> ingest(const BenchmarkResults& results,
+                                          std::string_view runKey, std::int64_t timestamp);
+
+    /**
+     * \brief Parses the JSON file and stores it, identified by its date, host and executable.
+     * \param path Path to the JSON output of Google Benchmark
+     * \param scheduler Scheduler decompressing the file while it is being parsed
+     * \return Whether the run was stored, or a description of the error
+     */
+    cpp::result<bool, std::string> ingestFile(const std::filesystem::path& path,
+                                              TaskScheduler& scheduler);
+
+    /**
+     * \brief Values of the column of the benchmark in all the stored runs.
+     * \param benchmark Full name of the benchmark
+     * \param column Name of the column
+     * \return Points sorted by the timestamp, one for each row (so each repetition)
+     */
+    [[nodiscard]] std::vector<HistoryPoint> history(std::string_view benchmark,
+                                                    std::string_view column) const;
+
+    /**
+     * \brief Values of the column of every benchmark in all the stored runs.
+     *
+     * Reads each segment once, which is much faster than querying the benchmarks one by one
+     * when the history of all of them is needed.
+     * \param column Name of the column
+     * \return Points of each benchmark (indexed by its identifier) sorted by the timestamp
+     */
+    [[nodiscard]] std::vector<std::vector<HistoryPoint>> histories(std::string_view column) const;
+
+    /**
+     * \brief Names of all the benchmarks that appear in the stored runs.
+     * \return Names of the benchmarks
+     */
+    [[nodiscard]] const StringInterner& benchmarks() const noexcept;
+
+    /**
+     * \brief Names of all the columns that appear in the stored runs.
+     * \return Names of the columns
+     */
+    [[nodiscard]] const StringInterner& columns() const noexcept;
+
+    /**
+     * \brief Number of runs stored.
+     * \return Number of runs
+     */
+    [[nodiscard]] std::size_t runCount() const noexcept;
+
+private:
+    explicit HistoryStore(std::filesystem::path directory);
+
+    /**
+     * \brief Reads the description of the runs, the names and the index.
+     */
+    cpp::result<void, std::string> load();
+
+    [[nodiscard]] std::filesystem::path segmentPath(std::size_t segment) const;
+
+    struct Segment
+    {
+        std::int64_t timestamp;
+        std::uint32_t rowCount;
+        std::vector<StringId> columns;
+    };
+
+    struct IndexEntry
+    {
+        BenchmarkId benchmark;
+        std::uint32_t segment;
+        std::int64_t timestamp;
+        std::uint32_t firstRow;
+        std::uint32_t rowCount;
+    };
+
+    std::filesystem::path mDirectory;
+    StringInterner mBenchmarks;
+    StringInterner mColumns;
+    std::vector<Segment> mSegments;
+    std::unordered_set<std::string> mRunKeys;
+
+    /**
+     * \brief Index entries sorted by the benchmark and the timestamp.
+     */
+    std::vector<IndexEntry> mIndex;
+};
+
+}// namespace BPlotter
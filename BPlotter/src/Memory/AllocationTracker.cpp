@@ -0,0 +1,411 @@
+#include "AllocationTracker.hpp"
+#include "pch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace BPlotter
+{
+
+namespace
+{
+
+/**
+ * \brief Counters shared by all the threads. Relaxed atomics are enough, nobody synchronizes
+ * on them and a frame that reads them slightly early only moves a count to the next frame.
+ */
+struct AtomicCounts
+{
+    std::atomic<std::uint64_t> allocations = 0;
+    std::atomic<std::uint64_t> frees = 0;
+    std::atomic<std::uint64_t> bytes = 0;
+};
+
+// Constant-initialized, so they are usable by allocations made before main()
+constinit std::array<AtomicCounts, ALLOCATION_SUBSYSTEM_COUNT> gCounts{};
+constinit std::atomic<bool> gIsEnabled = false;
+constinit thread_local AllocationSubsystem tSubsystem = AllocationSubsystem::Other;
+
+AtomicCounts& countsOfThread() noexcept
+{
+    return gCounts[static_cast<std::size_t>(tSubsystem)];
+}
+
+}// namespace
+
+const char* toString(const AllocationSubsystem subsystem)
+{
+    switch (subsystem)
+    {
+        case AllocationSubsystem::Other: return "Other";
+        case AllocationSubsystem::Parser: return "Parser";
+        case AllocationSubsystem::Statistics: return "Statistics";
+        case AllocationSubsystem::Rendering: return "Rendering";
+        case AllocationSubsystem::Logging: return "Logging";
+    }
+    return "Unknown";
+}
+
+AllocationCounts& AllocationCounts::operator+=(const AllocationCounts& other) noexcept
+{
+    allocations += other.allocations;
+    frees += other.frees;
+    bytes += other.bytes;
+    return *this;
+}
+
+AllocationCounts AllocationCounts::operator-(const AllocationCounts& other) const noexcept
+{
+    return {allocations - other.allocations, frees - other.frees, bytes - other.bytes};
+}
+
+bool isAllocationHookInstalled() noexcept
+{
+#ifdef BPLOTTER_ALLOCATION_TRACKING
+    return true;
+#else
+    return false;
+#endif
+}
+
+void setAllocationTrackingEnabled(const bool isEnabled) noexcept
+{
+    gIsEnabled.store(isEnabled, std::memory_order_relaxed);
+}
+
+bool isAllocationTrackingEnabled() noexcept
+{
+    return gIsEnabled.load(std::memory_order_relaxed);
+}
+
+void recordAllocation(const std::size_t bytes) noexcept
+{
+    if (isAllocationTrackingEnabled())
+    {
+        auto& counts = countsOfThread();
+        counts.allocations.fetch_add(1, std::memory_order_relaxed);
+        counts.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+}
+
+void recordFree() noexcept
+{
+    if (isAllocationTrackingEnabled())
+    {
+        countsOfThread().frees.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+AllocationTotals allocationTotals() noexcept
+{
+    AllocationTotals totals;
+    for (std::size_t i = 0; i < ALLOCATION_SUBSYSTEM_COUNT; ++i)
+    {
+        totals[i] = {gCounts[i].allocations.load(std::memory_order_relaxed),
+                     gCounts[i].frees.load(std::memory_order_relaxed),
+                     gCounts[i].bytes.load(std::memory_order_relaxed)};
+    }
+    return totals;
+}
+
+AllocationSubsystem currentAllocationSubsystem() noexcept
+{
+    return tSubsystem;
+}
+
+AllocationScope::AllocationScope(const AllocationSubsystem subsystem) noexcept
+    : mPrevious(tSubsystem)
+{
+    tSubsystem = subsystem;
+}
+
+AllocationScope::~AllocationScope()
+{
+    tSubsystem = mPrevious;
+}
+
+AllocationCounts FrameAllocations::total() const noexcept
+{
+    AllocationCounts total;
+    for (const auto& counts: subsystems)
+    {
+        total += counts;
+    }
+    return total;
+}
+
+void AllocationTracker::endFrame(const float seconds) noexcept
+{
+    const auto totals = allocationTotals();
+    auto& frame = mFrames[mNextFrame];
+    frame.seconds = seconds;
+    for (std::size_t i = 0; i < ALLOCATION_SUBSYSTEM_COUNT; ++i)
+    {
+        frame.subsystems[i] = totals[i] - mLastTotals[i];
+    }
+    mLastTotals = totals;
+
+    mNextFrame = (mNextFrame + 1) % HISTORY_SIZE;
+    mFrameCount = std::min(mFrameCount + 1, HISTORY_SIZE);
+}
+
+std::size_t AllocationTracker::frameCount() const noexcept
+{
+    return mFrameCount;
+}
+
+const FrameAllocations& AllocationTracker::frame(const std::size_t index) const noexcept
+{
+    assert(index < mFrameCount);
+    // Until the ring is full the oldest frame is the first one
+    const auto oldest = mFrameCount < HISTORY_SIZE ? 0 : mNextFrame;
+    return mFrames[(oldest + index) % HISTORY_SIZE];
+}
+
+FrameAllocations AllocationTracker::average() const noexcept
+{
+    FrameAllocations average;
+    if (mFrameCount == 0)
+    {
+        return average;
+    }
+
+    for (std::size_t index = 0; index < mFrameCount; ++index)
+    {
+        const auto& recorded = frame(index);
+        average.seconds += recorded.seconds;
+        for (std::size_t i = 0; i < ALLOCATION_SUBSYSTEM_COUNT; ++i)
+        {
+            average.subsystems[i] += recorded.subsystems[i];
+        }
+    }
+    average.seconds /= static_cast<float>(mFrameCount);
+    for (auto& counts: average.subsystems)
+    {
+        counts = {counts.allocations / mFrameCount, counts.frees / mFrameCount,
+                  counts.bytes / mFrameCount};
+    }
+    return average;
+}
+
+void AllocationTracker::exportCsv(std::ostream& output) const
+{
+    output << "frame,milliseconds";
+    for (std::size_t i = 0; i < ALLOCATION_SUBSYSTEM_COUNT; ++i)
+    {
+        const auto* name = toString(static_cast<AllocationSubsystem>(i));
+        output << ',' << name << " allocations," << name << " frees," << name << " bytes";
+    }
+    output << '\n';
+
+    for (std::size_t index = 0; index < mFrameCount; ++index)
+    {
+        const auto& recorded = frame(index);
+        output << index << ',' << recorded.seconds * 1000.f;
+        for (const auto& counts: recorded.subsystems)
+        {
+            output << ',' << counts.allocations << ',' << counts.frees << ',' << counts.bytes;
+        }
+        output << '\n';
+    }
+}
+
+}// namespace BPlotter
+
+#ifdef BPLOTTER_ALLOCATION_TRACKING
+
+// Replacements of the global allocation functions counting every heap operation of the
+// program. The aligned ones must be freed by the matching function of the platform.
+
+namespace
+{
+
+void* allocateCounted(std::size_t bytes)
+{
+    BPlotter::recordAllocation(bytes);
+    bytes = std::max<std::size_t>(bytes, 1);
+    while (true)
+    {
+        if (auto* memory = std::malloc(bytes))
+        {
+            return memory;
+        }
+        const auto handler = std::get_new_handler();
+        if (handler == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void* allocateAlignedCounted(std::size_t bytes, const std::align_val_t alignment)
+{
+    BPlotter::recordAllocation(bytes);
+    const auto alignmentBytes = static_cast<std::size_t>(alignment);
+    // aligned_alloc() requires a size that is a multiple of the alignment
+    bytes = std::max<std::size_t>(bytes, 1);
+    bytes = (bytes + alignmentBytes - 1) / alignmentBytes * alignmentBytes;
+    while (true)
+    {
+    #ifdef _MSC_VER
+        auto* memory = _aligned_malloc(bytes, alignmentBytes);
+    #else
+        auto* memory = std::aligned_alloc(alignmentBytes, bytes);
+    #endif
+        if (memory != nullptr)
+        {
+            return memory;
+        }
+        const auto handler = std::get_new_handler();
+        if (handler == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void freeCounted(void* memory) noexcept
+{
+    if (memory != nullptr)
+    {
+        BPlotter::recordFree();
+        std::free(memory);
+    }
+}
+
+void freeAlignedCounted(void* memory) noexcept
+{
+    if (memory != nullptr)
+    {
+        BPlotter::recordFree();
+    #ifdef _MSC_VER
+        _aligned_free(memory);
+    #else
+        std::free(memory);
+    #endif
+    }
+}
+
+}// namespace
+
+void* operator new(const std::size_t bytes)
+{
+    return allocateCounted(bytes);
+}
+
+void* operator new[](const std::size_t bytes)
+{
+    return allocateCounted(bytes);
+}
+
+void* operator new(const std::size_t bytes, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return allocateCounted(bytes);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
+}
+
+void* operator new[](const std::size_t bytes, const std::nothrow_t&) noexcept
+{
+    return operator new(bytes, std::nothrow);
+}
+
+void* operator new(const std::size_t bytes, const std::align_val_t alignment)
+{
+    return allocateAlignedCounted(bytes, alignment);
+}
+
+void* operator new[](const std::size_t bytes, const std::align_val_t alignment)
+{
+    return allocateAlignedCounted(bytes, alignment);
+}
+
+void* operator new(const std::size_t bytes, const std::align_val_t alignment,
+                   const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return allocateAlignedCounted(bytes, alignment);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
+}
+
+void* operator new[](const std::size_t bytes, const std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept
+{
+    return operator new(bytes, alignment, std::nothrow);
+}
+
+void operator delete(void* memory) noexcept
+{
+    freeCounted(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    freeCounted(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    freeCounted(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+    freeCounted(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+    freeCounted(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept
+{
+    freeCounted(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+    freeAlignedCounted(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t) noexcept
+{
+    freeAlignedCounted(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept
+{
+    freeAlignedCounted(memory);
+}
+
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept
+{
+    freeAlignedCounted(memory);
+}
+
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    freeAlignedCounted(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    freeAlignedCounted(memory);
+}
+
+#endif
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace BPlotter
+{
+
+/**
+ * \brief Part of the application the heap allocations are attributed to.
+ */
+enum class AllocationSubsystem : std::uint8_t
+{
+    /**
+     * \brief Everything outside of the scopes of the other subsystems.
+     */
+    Other,
+    Parser,
+    Statistics,
+    Rendering,
+    Logging,
+};
+
+constexpr std::size_t ALLOCATION_SUBSYSTEM_COUNT = 5;
+
+/**
+ * \brief Converts the subsystem to text that can be displayed.
+ * \param subsystem Subsystem the allocations are attributed to
+ * \return Name of the subsystem
+ */
+const char* toString(AllocationSubsystem subsystem);
+
+/**
+ * \brief Heap operations of a subsystem.
+ */
+struct AllocationCounts
+{
+    std::uint64_t allocations = 0;
+    std::uint64_t frees = 0;
+
+    /**
+     * \brief Bytes requested by the allocations.
+     */
+    std::uint64_t bytes = 0;
+
+    AllocationCounts& operator+=(const AllocationCounts& other) noexcept;
+    AllocationCounts operator-(const AllocationCounts& other) const noexcept;
+    bool operator==(const AllocationCounts&) const = default;
+};
+
+using AllocationTotals = std::array<AllocationCounts, ALLOCATION_SUBSYSTEM_COUNT>;
+
+/**
+ * \brief Whether the global operator new and delete are replaced by the counting ones, which
+ * is decided by the BPLOTTER_ALLOCATION_TRACKING option of the build.
+ * \return True if the allocations can be tracked
+ */
+bool isAllocationHookInstalled() noexcept;
+
+/**
+ * \brief Turns the counting on or off. It is off by default, so the hook costs only a check
+ * of the flag until somebody asks for the numbers.
+ * \param isEnabled Whether the allocations are counted
+ */
+void setAllocationTrackingEnabled(bool isEnabled) noexcept;
+
+/**
+ * \brief Whether the allocations are counted at the moment.
+ * \return True if they are counted
+ */
+bool isAllocationTrackingEnabled() noexcept;
+
+/**
+ * \brief Counts an allocation in the subsystem of the calling thread, if the tracking is on.
+ * Called by the hook, it neither allocates nor throws.
+ * \param bytes Number of bytes requested
+ */
+void recordAllocation(std::size_t bytes) noexcept;
+
+/**
+ * \brief Counts a free in the subsystem of the calling thread, if the tracking is on.
+ */
+void recordFree() noexcept;
+
+/**
+ * \brief Number of heap operations counted so far in every subsystem, on all threads.
+ * \return Counts indexed by the subsystem
+ */
+AllocationTotals allocationTotals() noexcept;
+
+/**
+ * \brief Subsystem the allocations of the calling thread are attributed to.
+ * \return Subsystem of the innermost scope of the thread, Other outside of any scope
+ */
+AllocationSubsystem currentAllocationSubsystem() noexcept;
+
+/**
+ * \brief Attributes the allocations of the current thread to the subsystem until the scope
+ * ends. Scopes can be nested, the innermost one wins. The tasks of the TaskScheduler run in
+ * the scope of the thread that queued them.
+ */
+class AllocationScope
+{
+public:
+    explicit AllocationScope(AllocationSubsystem subsystem) noexcept;
+    ~AllocationScope();
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+private:
+    AllocationSubsystem mPrevious;
+};
+
+/**
+ * \brief Duration of a frame and the heap operations done while it was built.
+ */
+struct FrameAllocations
+{
+    float seconds = 0.f;
+    AllocationTotals subsystems{};
+
+    /**
+     * \brief Operations of all the subsystems together.
+     */
+    [[nodiscard]] AllocationCounts total() const noexcept;
+};
+
+/**
+ * \brief Keeps the timings and the allocations of the last frames.
+ *
+ * The frames are stored in a fixed ring, so recording them allocates nothing and does not
+ * disturb the very numbers it records.
+ */
+class AllocationTracker
+{
+public:
+    static constexpr std::size_t HISTORY_SIZE = 240;
+
+    /**
+     * \brief Closes the frame, attributing to it everything counted since the previous one.
+     * \param seconds Duration of the frame
+     */
+    void endFrame(float seconds) noexcept;
+
+    /**
+     * \brief Number of the recorded frames, at most HISTORY_SIZE.
+     */
+    [[nodiscard]] std::size_t frameCount() const noexcept;
+
+    /**
+     * \brief Recorded frame.
+     * \param index Index of the frame, zero is the oldest one
+     * \return Timing and allocations of the frame
+     */
+    [[nodiscard]] const FrameAllocations& frame(std::size_t index) const noexcept;
+
+    /**
+     * \brief Average of all the recorded frames.
+     * \return Mean duration and mean counts of a frame
+     */
+    [[nodiscard]] FrameAllocations average() const noexcept;
+
+    /**
+     * \brief Writes the recorded frames as CSV, one row per frame from the oldest one.
+     * \param output Stream the CSV is written to
+     */
+    void exportCsv(std::ostream& output) const;
+
+private:
+    std::array<FrameAllocations, HISTORY_SIZE> mFrames{};
+    std::size_t mNextFrame = 0;
+    std::size_t mFrameCount = 0;
+    AllocationTotals mLastTotals{};
+};
+
+}// namespace BPlotter
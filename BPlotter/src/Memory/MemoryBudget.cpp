@@ -0,0 +1,158 @@
+#include "MemoryBudget.hpp"
+#include "pch.hpp"
+
+#include <algorithm>
+
+namespace BPlotter
+{
+
+std::string toString(const MemoryCategory category)
+{
+    switch (category)
+    {
+        case MemoryCategory::Run: return "Run";
+        case MemoryCategory::DerivedCache: return "Derived cache";
+    }
+    return "Unknown";
+}
+
+MemoryBudget::MemoryBudget(const std::size_t limit)
+    : mLimit(limit)
+{
+}
+
+MemoryEntryId MemoryBudget::track(std::string name, const MemoryCategory category,
+                                  MemoryEvictor evict)
+{
+    const auto id = mNextId++;
+    mEntries.push_back(MemoryEntry{.id = id,
+                                   .name = std::move(name),
+                                   .category = category,
+                                   .lastUse = ++mTick,
+                                   .evict = std::move(evict)});
+    return id;
+}
+
+void MemoryBudget::untrack(const MemoryEntryId id)
+{
+    const auto& removed = entry(id);
+    mUsed -= removed.bytes;
+    mEntries.erase(mEntries.begin() + (&removed - mEntries.data()));
+}
+
+void MemoryBudget::update(const MemoryEntryId id, const std::size_t bytes)
+{
+    auto& updated = entry(id);
+    mUsed = mUsed - updated.bytes + bytes;
+    updated.bytes = bytes;
+    updated.lastUse = ++mTick;
+}
+
+void MemoryBudget::resize(const MemoryEntryId id, const std::size_t bytes)
+{
+    auto& resized = entry(id);
+    mUsed = mUsed - resized.bytes + bytes;
+    resized.bytes = bytes;
+}
+
+void MemoryBudget::touch(const MemoryEntryId id)
+{
+    entry(id).lastUse = ++mTick;
+}
+
+void MemoryBudget::setPinned(const MemoryEntryId id, const bool isPinned)
+{
+    entry(id).isPinned = isPinned;
+}
+
+std::size_t MemoryBudget::evict(const MemoryEntryId id)
+{
+    auto& evicted = entry(id);
+    if (evicted.bytes == 0)
+    {
+        return 0;
+    }
+
+    const auto remaining = std::min(evicted.evict(), evicted.bytes);
+    const auto released = evicted.bytes - remaining;
+    evicted.bytes = remaining;
+    mUsed -= released;
+    spdlog::debug("[MemoryBudget] Evicted {} bytes of {}", released, evicted.name);
+    return released;
+}
+
+void MemoryBudget::beginFrame() noexcept
+{
+    mFrameStart = mTick;
+}
+
+std::size_t MemoryBudget::enforce()
+{
+    if (mUsed <= mLimit)
+    {
+        return 0;
+    }
+
+    std::vector<MemoryEntryId> candidates;
+    auto evictable = std::size_t{0};
+    for (const auto& candidate: mEntries)
+    {
+        if (!candidate.isPinned && candidate.bytes > 0 && candidate.lastUse <= mFrameStart)
+        {
+            candidates.push_back(candidate.id);
+            evictable += candidate.bytes;
+        }
+    }
+
+    // The rest would be evicted every frame without ever fitting the limit
+    if (mUsed - evictable > mLimit)
+    {
+        return 0;
+    }
+
+    std::ranges::sort(candidates, {},
+                      [this](const MemoryEntryId id)
+                      {
+                          return entry(id).lastUse;
+                      });
+
+    auto released = std::size_t{0};
+    for (const auto id: candidates)
+    {
+        if (mUsed <= mLimit)
+        {
+            break;
+        }
+        released += evict(id);
+    }
+    return released;
+}
+
+std::size_t MemoryBudget::limit() const noexcept
+{
+    return mLimit;
+}
+
+void MemoryBudget::setLimit(const std::size_t limit) noexcept
+{
+    mLimit = limit;
+}
+
+std::size_t MemoryBudget::used() const noexcept
+{
+    return mUsed;
+}
+
+std::span<const MemoryEntry> MemoryBudget::entries() const noexcept
+{
+    return mEntries;
+}
+
+MemoryEntry& MemoryBudget::entry(const MemoryEntryId id)
+{
+    const auto found = std::ranges::lower_bound(mEntries, id, {}, &MemoryEntry::id);
+    assert(found != mEntries.end() && found->id == id);
+    return *found;
+}
+
+}// namespace BPlotter
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace BPlotter
+{
+
+/**
+ * \brief Identifier of a memory consumer tracked by the MemoryBudget.
+ */
+using MemoryEntryId = std::uint32_t;
+
+/**
+ * \brief Kind of the data held by a memory consumer.
+ */
+enum class MemoryCategory
+{
+    /**
+     * \brief Rows of a loaded benchmark run.
+     */
+    Run,
+
+    /**
+     * \brief Data computed out of a run that can be computed again, such as the pivoted series.
+     */
+    DerivedCache,
+};
+
+/**
+ * \brief Converts the category to text that can be displayed.
+ * \param category Category of the memory consumer
+ * \return Name of the category
+ */
+std::string toString(MemoryCategory category);
+
+/**
+ * \brief Releases the memory of a consumer.
+ * \return Number of bytes the consumer still holds, zero if it released everything
+ */
+using MemoryEvictor = std::function<std::size_t()>;
+
+/**
+ * \brief Memory consumer tracked by the MemoryBudget.
+ */
+struct MemoryEntry
+{
+    MemoryEntryId id = 0;
+    std::string name;
+    MemoryCategory category = MemoryCategory::Run;
+
+    /**
+     * \brief Number of bytes the consumer holds at the moment.
+     */
+    std::size_t bytes = 0;
+
+    /**
+     * \brief Tick of the budget at which the consumer was last used. Greater is more recent.
+     */
+    std::uint64_t lastUse = 0;
+
+    /**
+     * \brief Pinned consumers are never evicted, e.g. the run that is currently displayed.
+     */
+    bool isPinned = false;
+
+    MemoryEvictor evict;
+};
+
+/**
+ * \brief Keeps the memory held by the loaded runs and the caches derived from them within
+ * a configurable limit.
+ *
+ * Consumers report how many bytes they hold and when they are used. Once the sum exceeds the
+ * limit, the least recently used consumers that are not pinned are asked to release their
+ * memory (e.g. by writing a run to its cache file) until the sum fits the limit again.
+ * Evicted consumers stay tracked, so they can report their memory again once they reload.
+ *
+ * Consumers used in the current frame are not evicted, as they would be built again right away,
+ * and nothing is evicted when the pinned and used consumers alone exceed the limit.
+ */
+class MemoryBudget
+{
+public:
+    /**
+     * \brief Limit used when nothing else is configured.
+     */
+    static constexpr std::size_t DEFAULT_LIMIT = std::size_t{1} << 30;
+
+    explicit MemoryBudget(std::size_t limit = DEFAULT_LIMIT);
+
+    /**
+     * \brief Starts tracking a memory consumer. It holds no memory until it is updated.
+     * \param name Name of the consumer displayed to the user
+     * \param category Kind of the data held by the consumer
+     * \param evict Releases the memory of the consumer. It must not call the budget.
+     * \return Identifier of the consumer
+     */
+    MemoryEntryId track(std::string name, MemoryCategory category, MemoryEvictor evict);
+
+    /**
+     * \brief Stops tracking the consumer, e.g. because it was destroyed.
+     * \param id Identifier of the consumer
+     */
+    void untrack(MemoryEntryId id);
+
+    /**
+     * \brief Sets the number of bytes held by the consumer and marks it as used.
+     * \param id Identifier of the consumer
+     * \param bytes Number of bytes held by the consumer
+     */
+    void update(MemoryEntryId id, std::size_t bytes);
+
+    /**
+     * \brief Sets the number of bytes held by the consumer without marking it as used, e.g.
+     * when the consumer reports its memory every frame.
+     * \param id Identifier of the consumer
+     * \param bytes Number of bytes held by the consumer
+     */
+    void resize(MemoryEntryId id, std::size_t bytes);
+
+    /**
+     * \brief Marks the consumer as used, so it is the last one to be evicted.
+     * \param id Identifier of the consumer
+     */
+    void touch(MemoryEntryId id);
+
+    /**
+     * \brief Protects the consumer from the eviction or allows to evict it again.
+     * \param id Identifier of the consumer
+     * \param isPinned True if the consumer must not be evicted
+     */
+    void setPinned(MemoryEntryId id, bool isPinned);
+
+    /**
+     * \brief Releases the memory of the consumer regardless of the limit.
+     * \param id Identifier of the consumer
+     * \return Number of the released bytes
+     */
+    std::size_t evict(MemoryEntryId id);
+
+    /**
+     * \brief Starts a new frame. The consumers used from now on are not evicted by enforce()
+     * until the next frame starts.
+     */
+    void beginFrame() noexcept;
+
+    /**
+     * \brief Evicts the least recently used consumers that are neither pinned nor used in the
+     * current frame until the used memory fits the limit. If evicting all of them would not
+     * make the memory fit the limit, nothing is evicted.
+     * \return Number of the released bytes
+     */
+    std::size_t enforce();
+
+    /**
+     * \brief Maximum number of bytes the consumers should hold together.
+     * \return Limit in bytes
+     */
+    [[nodiscard]] std::size_t limit() const noexcept;
+
+    /**
+     * \brief Changes the limit. The consumers are evicted only on the next enforce().
+     * \param limit Limit in bytes
+     */
+    void setLimit(std::size_t limit) noexcept;
+
+    /**
+     * \brief Number of bytes held by all the consumers together.
+     * \return Used memory in bytes
+     */
+    [[nodiscard]] std::size_t used() const noexcept;
+
+    /**
+     * \brief All tracked consumers in the order they started to be tracked.
+     * \return Tracked consumers
+     */
+    [[nodiscard]] std::span<const MemoryEntry> entries() const noexcept;
+
+private:
+    MemoryEntry& entry(MemoryEntryId id);
+
+    std::size_t mLimit;
+    std::size_t mUsed = 0;
+    std::uint64_t mTick = 0;
+
+    /**
+     * \brief Tick at which the current frame started. No frame is started at first, so no
+     * consumer is protected.
+     */
+    std::uint64_t mFrameStart = std::numeric_limits<std::uint64_t>::max();
+    MemoryEntryId mNextId = 0;
+
+    /**
+     * \brief Tracked consumers, sorted by their identifiers. There are at most a few dozens
+     * of them, so they are simply searched.
+     */
+    std::vector<MemoryEntry> mEntries;
+};
+
+}// namespace BPlotter
@@ -0,0 +1,128 @@
+#include "RunLibrary.hpp"
+#include "pch.hpp"
+
+#include <fstream>
+
+namespace BPlotter
+{
+
+RunLibrary::RunLibrary(MemoryBudget& budget, std::filesystem::path cacheDirectory)
+    : mBudget(budget)
+    , mCacheDirectory(std::move(cacheDirectory))
+{
+}
+
+RunLibrary::~RunLibrary()
+{
+    for (const auto& run: mRuns)
+    {
+        mBudget.untrack(run->memory);
+    }
+    if (mCacheFiles > 0)
+    {
+        std::error_code error;
+        std::filesystem::remove_all(mCacheDirectory, error);
+    }
+}
+
+void RunLibrary::store(std::string name, BenchmarkResults results)
+{
+    auto& run = add(std::move(name));
+    run.results = std::move(results);
+    mBudget.update(run.memory, run.results->memoryUsage());
+}
+
+void RunLibrary::storeCached(std::string name, std::filesystem::path cacheFile)
+{
+    auto& run = add(std::move(name));
+    run.cacheFile = std::move(cacheFile);
+}
+
+cpp::result<BenchmarkResults, std::string> RunLibrary::take(const std::size_t index)
+{
+    assert(index < mRuns.size());
+    auto& run = *mRuns[index];
+    if (!run.results)
+    {
+        std::ifstream input(run.cacheFile, std::ios::binary);
+        auto results = BenchmarkResults::readCache(input);
+        if (results.has_error())
+        {
+            return cpp::fail(fmt::format("Unable to read {}: {}", run.cacheFile.string(),
+                                         results.error()));
+        }
+        run.results = std::move(results).value();
+    }
+
+    auto results = std::move(*run.results);
+    if (run.isCacheFileOwned)
+    {
+        std::error_code error;
+        std::filesystem::remove(run.cacheFile, error);
+    }
+    mBudget.untrack(run.memory);
+    mRuns.erase(mRuns.begin() + static_cast<std::ptrdiff_t>(index));
+    return results;
+}
+
+std::size_t RunLibrary::size() const noexcept
+{
+    return mRuns.size();
+}
+
+const std::string& RunLibrary::name(const std::size_t index) const
+{
+    assert(index < mRuns.size());
+    return mRuns[index]->name;
+}
+
+bool RunLibrary::isResident(const std::size_t index) const
+{
+    assert(index < mRuns.size());
+    return mRuns[index]->results.has_value();
+}
+
+RunLibrary::StoredRun& RunLibrary::add(std::string name)
+{
+    auto& run = *mRuns.emplace_back(std::make_unique<StoredRun>());
+    run.name = std::move(name);
+    run.memory = mBudget.track(run.name, MemoryCategory::Run,
+                               [this, &run]
+                               {
+                                   return evict(run);
+                               });
+    return run;
+}
+
+std::size_t RunLibrary::evict(StoredRun& run)
+{
+    if (!run.results)
+    {
+        return 0;
+    }
+
+    if (run.cacheFile.empty())
+    {
+        auto path = mCacheDirectory / fmt::format("{:08}.bin", mCacheFiles++);
+        std::error_code error;
+        std::filesystem::create_directories(mCacheDirectory, error);
+
+        std::ofstream output(path, std::ios::binary | std::ios::trunc);
+        if (const auto written = run.results->writeCache(output);
+            written.has_error() || !output.flush())
+        {
+            spdlog::warn("[RunLibrary] Unable to write {} to {}, keeping it in memory",
+                         run.name, path.string());
+            output.close();
+            std::filesystem::remove(path, error);
+            return run.results->memoryUsage();
+        }
+        run.cacheFile = std::move(path);
+        run.isCacheFileOwned = true;
+    }
+
+    run.results.reset();
+    return 0;
+}
+
+}// namespace BPlotter
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <result.hpp>
+
+#include "Benchmark/BenchmarkResults.hpp"
+#include "Memory/MemoryBudget.hpp"
+
+namespace BPlotter
+{
+
+/**
+ * \brief Keeps the runs that were opened but are not displayed at the moment, so they can
+ * be compared or displayed again without parsing their files.
+ *
+ * Every run is accounted in the MemoryBudget. When the budget evicts a run, it is written
+ * to its cache file (only once, the stored runs never change) and its rows are released.
+ * Taking an evicted run back reads it from the cache file, which is much faster than parsing
+ * the original benchmark file.
+ */
+class RunLibrary
+{
+public:
+    /**
+     * \brief Creates an empty library.
+     * \param budget Budget accounting the stored runs. Must outlive the library.
+     * \param cacheDirectory Directory for the cache files of the evicted runs. It is created
+     * on the first eviction and removed together with the library.
+     */
+    RunLibrary(MemoryBudget& budget, std::filesystem::path cacheDirectory);
+    RunLibrary(const RunLibrary&) = delete;
+    RunLibrary& operator=(const RunLibrary&) = delete;
+    ~RunLibrary();
+
+    /**
+     * \brief Stores the run at the end of the library.
+     * \param name Name of the run displayed to the user, e.g. the path of its file
+     * \param results Rows of the run
+     */
+    void store(std::string name, BenchmarkResults results);
+
+    /**
+     * \brief Stores an evicted run whose rows are already in a cache file, e.g. one saved
+     * with the previous session. The file is only read, never removed by the library.
+     * \param name Name of the run displayed to the user, e.g. the path of its file
+     * \param cacheFile File written by BenchmarkResults::writeCache()
+     */
+    void storeCached(std::string name, std::filesystem::path cacheFile);
+
+    /**
+     * \brief Removes the run from the library, reading it from its cache file if evicted.
+     * \param index Index of the run
+     * \return Rows of the run or an error message if its cache file could not be read,
+     * in which case the run stays in the library
+     */
+    cpp::result<BenchmarkResults, std::string> take(std::size_t index);
+
+    /**
+     * \brief Number of the stored runs.
+     * \return Number of the stored runs
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * \brief Name of the stored run.
+     * \param index Index of the run
+     * \return Name given when the run was stored
+     */
+    [[nodiscard]] const std::string& name(std::size_t index) const;
+
+    /**
+     * \brief Checks whether the rows of the run are in memory rather than in its cache file.
+     * \param index Index of the run
+     * \return True if the run was not evicted
+     */
+    [[nodiscard]] bool isResident(std::size_t index) const;
+
+private:
+    struct StoredRun
+    {
+        std::string name;
+        std::optional<BenchmarkResults> results;
+        std::filesystem::path cacheFile;
+        bool isCacheFileOwned = false;
+        MemoryEntryId memory = 0;
+    };
+
+    /**
+     * \brief Stores the run at the end of the library and starts accounting its memory.
+     */
+    StoredRun& add(std::string name);
+
+    /**
+     * \brief Writes the run to its cache file unless it was written already, and releases
+     * its rows.
+     * \return Number of bytes the run still holds: zero, or all of them if it could not
+     * be written
+     */
+    std::size_t evict(StoredRun& run);
+
+    MemoryBudget& mBudget;
+    std::filesystem::path mCacheDirectory;
+    std::size_t mCacheFiles = 0;
+
+    /**
+     * \brief Stored runs. They are allocated separately, so the evictors registered in the
+     * budget can point to them.
+     */
+    std::vector<std::unique_ptr<StoredRun>> mRuns;
+};
+
+}// namespace BPlotter
@@ -0,0 +1,86 @@
+#include "DerivedMetricsPanel.hpp"
+#include "pch.hpp"
+
+namespace BPlotter
+{
+
+void DerivedMetricsPanel::updateImGui(BenchmarkResults& results,
+                                      const std::function<void()>& beforeChange)
+{
+    mMetrics.update(results);
+
+    if (ImGui::Begin("Derived metrics"))
+    {
+        ImGui::SetNextItemWidth(150.f);
+        ImGui::InputText("Name", mNameInput.data(), mNameInput.size());
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(300.f);
+        const auto isSubmitted =
+            ImGui::InputText("Expression", mExpressionInput.data(), mExpressionInput.size(),
+                             ImGuiInputTextFlags_EnterReturnsTrue);
+        ImGui::SameLine();
+        if (ImGui::Button("Add") || isSubmitted)
+        {
+            beforeChange();
+            if (const auto column =
+                    mMetrics.define(results, mNameInput.data(), mExpressionInput.data());
+                column.has_error())
+            {
+                mError = column.error();
+            }
+            else
+            {
+                mError.clear();
+                mNameInput.fill('\0');
+                mExpressionInput.fill('\0');
+            }
+        }
+        if (!mError.empty())
+        {
+            ImGui::TextColored(ImVec4(1.f, 0.4f, 0.4f, 1.f), "%s", mError.c_str());
+        }
+        ImGui::TextDisabled("Operators: + - * / ( ), quote names with other characters: "
+                            "\"CACHE-MISSES\"");
+
+        constexpr auto flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders;
+        if (!mMetrics.metrics().empty() && ImGui::BeginTable("DerivedMetrics", 3, flags))
+        {
+            ImGui::TableSetupColumn("Name");
+            ImGui::TableSetupColumn("Expression", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Last evaluation");
+            ImGui::TableHeadersRow();
+            for (const auto& metric: mMetrics.metrics())
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(metric.name.c_str());
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(metric.expression.source().c_str());
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f ms", metric.lastEvaluationTime.count() / 1000.0);
+            }
+            ImGui::EndTable();
+        }
+    }
+    ImGui::End();
+}
+
+void DerivedMetricsPanel::reapply(BenchmarkResults& results)
+{
+    mMetrics.reapply(results);
+    mError.clear();
+}
+
+cpp::result<ColumnIndex, std::string> DerivedMetricsPanel::define(BenchmarkResults& results,
+                                                                  const std::string_view name,
+                                                                  const std::string_view expression)
+{
+    return mMetrics.define(results, name, expression);
+}
+
+std::span<const DerivedMetric> DerivedMetricsPanel::metrics() const noexcept
+{
+    return mMetrics.metrics();
+}
+
+}// namespace BPlotter
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <functional>
+#include <string>
+
+#include "Expression/DerivedMetrics.hpp"
+
+namespace BPlotter
+{
+
+/**
+ * \brief ImGui panel allowing to define metrics computed from the other columns,
+ * e.g. "INSTRUCTIONS / CYCLES", which then appear among the columns of the results.
+ */
+class DerivedMetricsPanel
+{
+public:
+    /**
+     * \brief Displays the panel and evaluates the metrics for newly appended rows.
+     * \param results Currently opened benchmark results
+     * \param beforeChange Called right before a new metric changes the results, e.g. to wait
+     * for the background work reading them
+     */
+    void updateImGui(BenchmarkResults& results, const std::function<void()>& beforeChange);
+
+    /**
+     * \brief Defines the metrics again for newly opened results.
+     * \param results Newly opened benchmark results
+     */
+    void reapply(BenchmarkResults& results);
+
+    /**
+     * \brief Defines the metric without the user input, e.g. when restoring the session.
+     * \param results Currently opened benchmark results
+     * \param name Name of the new column
+     * \param expression Expression computing the metric
+     * \return Index of the new column or a description of the error
+     */
+    cpp::result<ColumnIndex, std::string> define(BenchmarkResults& results,
+                                                 std::string_view name,
+                                                 std::string_view expression);
+
+    /**
+     * \brief Currently defined metrics in the order of definition.
+     * \return Defined metrics
+     */
+    [[nodiscard]] std::span<const DerivedMetric> metrics() const noexcept;
+
+private:
+    std::array<char, 128> mNameInput{};
+    std::array<char, 512> mExpressionInput{};
+    std::string mError;
+    DerivedMetrics mMetrics;
+};
+
+}// namespace BPlotter
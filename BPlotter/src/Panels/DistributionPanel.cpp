@@ -0,0 +1,385 @@
+#include "DistributionPanel.hpp"
+#include "pch.hpp"
+
+#include "Utils/FrameArena.hpp"
+
+#include <algorithm>
+#include <array>
+
+namespace BPlotter
+{
+
+namespace
+{
+
+constexpr auto VIOLIN_COLOR = IM_COL32(189, 147, 249, 160);
+constexpr auto HISTOGRAM_COLOR = IM_COL32(139, 233, 253, 160);
+constexpr auto BOX_COLOR = IM_COL32(248, 248, 242, 255);
+
+/**
+ * \brief Horizontal range of a drawing and the values at its edges.
+ */
+struct ValueAxis
+{
+    float left = 0;
+    float right = 0;
+    double first = 0;
+    double last = 0;
+
+    [[nodiscard]] float toX(const double value) const
+    {
+        const auto fraction = last > first ? (value - first) / (last - first) : 0.5;
+        return left + static_cast<float>(fraction) * (right - left);
+    }
+};
+
+/**
+ * \brief Draws the density mirrored around the center line, one quad per segment of the grid.
+ */
+void drawViolin(ImDrawList& drawList, const DensityEstimate& estimate, const ValueAxis& axis,
+                const float centerY, const float halfHeight)
+{
+    const auto& density = estimate.density;
+    const auto peak = density.empty() ? 0.f : std::ranges::max(density);
+    if (peak <= 0)
+    {
+        return;
+    }
+    const auto scale = halfHeight / peak;
+    for (std::size_t point = 1; point < density.size(); ++point)
+    {
+        const auto x0 = axis.toX(estimate.first + estimate.step * static_cast<double>(point - 1));
+        const auto x1 = axis.toX(estimate.first + estimate.step * static_cast<double>(point));
+        const auto h0 = density[point - 1] * scale;
+        const auto h1 = density[point] * scale;
+        drawList.AddQuadFilled(ImVec2(x0, centerY - h0), ImVec2(x1, centerY - h1),
+                               ImVec2(x1, centerY + h1), ImVec2(x0, centerY + h0), VIOLIN_COLOR);
+    }
+}
+
+/**
+ * \brief Draws the whiskers, the box between the quartiles and the median over the violin.
+ */
+void drawBox(ImDrawList& drawList, const BoxSummary& box, const ValueAxis& axis,
+             const float centerY, const float halfHeight)
+{
+    const auto boxHalfHeight = std::max(halfHeight * 0.25f, 1.f);
+    drawList.AddLine(ImVec2(axis.toX(box.lowerWhisker), centerY),
+                     ImVec2(axis.toX(box.upperWhisker), centerY), BOX_COLOR);
+    drawList.AddRect(ImVec2(axis.toX(box.firstQuartile), centerY - boxHalfHeight),
+                     ImVec2(axis.toX(box.thirdQuartile), centerY + boxHalfHeight), BOX_COLOR);
+    const auto median = axis.toX(box.median);
+    drawList.AddLine(ImVec2(median, centerY - boxHalfHeight * 1.5f),
+                     ImVec2(median, centerY + boxHalfHeight * 1.5f), BOX_COLOR, 2.f);
+}
+
+void drawHistogram(ImDrawList& drawList, const Histogram& histogram, const ValueAxis& axis,
+                   const float top, const float bottom)
+{
+    const auto highest = histogram.counts.empty() ? 0u : std::ranges::max(histogram.counts);
+    if (highest == 0)
+    {
+        return;
+    }
+    for (std::size_t bin = 0; bin < histogram.counts.size(); ++bin)
+    {
+        const auto begin = histogram.first + histogram.binWidth * static_cast<double>(bin);
+        // All the samples are equal, so the single bin is given some width to be seen
+        const auto left = histogram.binWidth > 0 ? axis.toX(begin) : axis.toX(begin) - 2.f;
+        const auto right = histogram.binWidth > 0 ? axis.toX(begin + histogram.binWidth)
+                                                  : axis.toX(begin) + 2.f;
+        const auto height = (bottom - top) * static_cast<float>(histogram.counts[bin]) /
+                            static_cast<float>(highest);
+        drawList.AddRectFilled(ImVec2(left + 1.f, bottom - height), ImVec2(right, bottom),
+                               HISTOGRAM_COLOR);
+    }
+}
+
+}// namespace
+
+DistributionPanel::DistributionPanel(TaskScheduler& scheduler)
+    : mScheduler(&scheduler)
+{
+}
+
+DistributionPanel& DistributionPanel::operator=(DistributionPanel&& other) noexcept
+{
+    if (this != &other)
+    {
+        cancelAnalysis();
+        mScheduler = other.mScheduler;
+        mMetric = other.mMetric;
+        mBandwidthScale = other.mBandwidthScale;
+        mIsMultimodalOnly = other.mIsMultimodalOnly;
+        mAnalyzedResults = other.mAnalyzedResults;
+        mAnalyzedRows = other.mAnalyzedRows;
+        mAnalyzedMetric = other.mAnalyzedMetric;
+        mAnalyzedBandwidthScale = other.mAnalyzedBandwidthScale;
+        mFormat = other.mFormat;
+        mCancellation = std::move(other.mCancellation);
+        mAnalysis = std::move(other.mAnalysis);
+        mDistributions = std::move(other.mDistributions);
+        mVisible = std::move(other.mVisible);
+        mSelected = other.mSelected;
+    }
+    return *this;
+}
+
+DistributionPanel::~DistributionPanel()
+{
+    cancelAnalysis();
+}
+
+void DistributionPanel::updateImGui(const BenchmarkResults& results)
+{
+    if (mMetric >= results.columnCount())
+    {
+        mMetric = static_cast<ColumnIndex>(BuiltinColumn::RealTime);
+    }
+
+    if (ImGui::Begin("Distributions"))
+    {
+        ImGui::SetNextItemWidth(200.f);
+        if (ImGui::BeginCombo("Metric", frameArena().copy(results.columnName(mMetric))))
+        {
+            for (ColumnIndex column = 0; column < results.columnCount(); ++column)
+            {
+                if (ImGui::Selectable(frameArena().copy(results.columnName(column)),
+                                      column == mMetric))
+                {
+                    mMetric = column;
+                }
+            }
+            ImGui::EndCombo();
+        }
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(150.f);
+        ImGui::SliderFloat("Smoothing", &mBandwidthScale, 0.25f, 4.f, "%.2f",
+                           ImGuiSliderFlags_Logarithmic);
+        ImGui::SameLine();
+        if (ImGui::Checkbox("Only multimodal", &mIsMultimodalOnly))
+        {
+            updateVisible();
+        }
+
+        analyzeIfChanged(results);
+        collectAnalysis();
+        if (mAnalysis.valid())
+        {
+            ImGui::TextUnformatted("Estimating the densities...");
+        }
+        else if (mDistributions.empty())
+        {
+            ImGui::Text("No benchmark was run with %zu or more repetitions.",
+                        DistributionOptions().minimalRepetitions);
+        }
+        else
+        {
+            updateImGuiDistributions();
+            updateImGuiDetail();
+        }
+    }
+    ImGui::End();
+}
+
+std::size_t DistributionPanel::memoryUsage() const noexcept
+{
+    auto bytes = mDistributions.capacity() * sizeof(RepetitionDistribution) +
+                 mVisible.capacity() * sizeof(std::size_t);
+    for (const auto& distribution: mDistributions)
+    {
+        bytes += distribution.name.capacity() +
+                 distribution.samples.capacity() * sizeof(double) +
+                 distribution.density.density.capacity() * sizeof(float) +
+                 distribution.histogram.counts.capacity() * sizeof(std::uint32_t);
+    }
+    return bytes;
+}
+
+void DistributionPanel::analyzeIfChanged(const BenchmarkResults& results)
+{
+    if (mAnalyzedResults == &results && mAnalyzedRows == results.size() &&
+        mAnalyzedMetric == mMetric && mAnalyzedBandwidthScale == mBandwidthScale)
+    {
+        return;
+    }
+
+    // Dragging the smoothing starts a new analysis every frame, so the outdated ones stop
+    cancelAnalysis();
+    mCancellation = CancellationSource();
+
+    DistributionOptions options;
+    options.bandwidthScale = mBandwidthScale;
+    // The task owns the samples, so the results can change while it runs
+    mAnalysis = mScheduler->submit(
+        TaskPriority::Interactive,
+        [samples = collectRepetitions(results, mMetric, options.minimalRepetitions), options,
+         scheduler = mScheduler, token = mCancellation.token()]() mutable
+        {
+            return analyzeDistributions(std::move(samples), *scheduler, options, token);
+        });
+    mFormat = formatOfColumn(results.columnName(mMetric));
+
+    mAnalyzedResults = &results;
+    mAnalyzedRows = results.size();
+    mAnalyzedMetric = mMetric;
+    mAnalyzedBandwidthScale = mBandwidthScale;
+}
+
+void DistributionPanel::collectAnalysis()
+{
+    if (not mAnalysis.valid() ||
+        mAnalysis.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+        return;
+    }
+    if (auto distributions = mAnalysis.get())
+    {
+        mDistributions = std::move(*distributions);
+        updateVisible();
+    }
+}
+
+void DistributionPanel::cancelAnalysis() noexcept
+{
+    // A moved-from panel has no analysis, and no source either
+    if (mAnalysis.valid())
+    {
+        mCancellation.cancel();
+    }
+}
+
+void DistributionPanel::updateVisible()
+{
+    const auto selected =
+        mSelected < mVisible.size() ? std::optional(mVisible[mSelected]) : std::nullopt;
+    mVisible.clear();
+    for (std::size_t i = 0; i < mDistributions.size(); ++i)
+    {
+        if (not mIsMultimodalOnly || mDistributions[i].isMultimodal())
+        {
+            mVisible.push_back(i);
+        }
+    }
+
+    // The selected benchmark stays selected if the filter still shows it
+    const auto found = selected ? std::ranges::find(mVisible, *selected) : mVisible.end();
+    mSelected = found != mVisible.end() ? static_cast<std::size_t>(found - mVisible.begin()) : 0;
+}
+
+void DistributionPanel::updateImGuiDistributions()
+{
+    constexpr auto flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders |
+                           ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable;
+    const auto height = ImGui::GetTextLineHeightWithSpacing() * 12;
+    if (ImGui::BeginTable("Distributions", 6, flags, ImVec2(0, height)))
+    {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Benchmark", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Repetitions");
+        ImGui::TableSetupColumn("Mean");
+        ImGui::TableSetupColumn("Std. dev.");
+        ImGui::TableSetupColumn("Modes");
+        ImGui::TableSetupColumn("Density", ImGuiTableColumnFlags_WidthFixed, 150.f);
+        ImGui::TableHeadersRow();
+
+        std::array<char, NUMBER_BUFFER_SIZE> buffer{};
+        auto& drawList = *ImGui::GetWindowDrawList();
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(mVisible.size()));
+        while (clipper.Step())
+        {
+            for (auto row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+            {
+                const auto index = static_cast<std::size_t>(row);
+                const auto& distribution = mDistributions[mVisible[index]];
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::PushID(row);
+                if (ImGui::Selectable(distribution.name.c_str(), index == mSelected,
+                                      ImGuiSelectableFlags_SpanAllColumns))
+                {
+                    mSelected = index;
+                }
+                ImGui::PopID();
+                ImGui::TableNextColumn();
+                ImGui::Text("%zu", distribution.samples.size());
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(formatNumber(distribution.mean, mFormat, buffer).data());
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(
+                    formatNumber(distribution.standardDeviation, mFormat, buffer).data());
+                ImGui::TableNextColumn();
+                ImGui::Text("%zu", distribution.modes);
+
+                // Every violin spans its own range, only its shape is compared
+                if (ImGui::TableNextColumn())
+                {
+                    const auto position = ImGui::GetCursorScreenPos();
+                    const ImVec2 size(ImGui::GetContentRegionAvail().x,
+                                      ImGui::GetTextLineHeight());
+                    const ValueAxis axis{position.x, position.x + size.x,
+                                         distribution.density.first,
+                                         distribution.density.last()};
+                    drawViolin(drawList, distribution.density, axis, position.y + size.y / 2,
+                               size.y / 2);
+                    ImGui::Dummy(size);
+                }
+            }
+        }
+        ImGui::EndTable();
+    }
+}
+
+void DistributionPanel::updateImGuiDetail()
+{
+    if (mSelected >= mVisible.size())
+    {
+        return;
+    }
+    const auto& distribution = mDistributions[mVisible[mSelected]];
+    const auto& box = distribution.box;
+
+    std::array<char, NUMBER_BUFFER_SIZE> buffer{};
+    const auto format = [this, &buffer](const double value)
+    {
+        return formatNumber(value, mFormat, buffer).data();
+    };
+    ImGui::TextUnformatted(distribution.name.c_str());
+    ImGui::Text("Median %s", format(box.median));
+    ImGui::SameLine();
+    ImGui::Text("IQR %s", format(box.thirdQuartile - box.firstQuartile));
+    ImGui::SameLine();
+    ImGui::Text("Bandwidth %s", format(distribution.density.bandwidth));
+    ImGui::SameLine();
+    ImGui::Text("Outliers %zu", box.outliers);
+
+    const auto width = ImGui::GetContentRegionAvail().x;
+    if (width <= 0)
+    {
+        return;
+    }
+    const auto violinHeight = ImGui::GetTextLineHeight() * 6;
+    const auto histogramHeight = ImGui::GetTextLineHeight() * 4;
+    const auto position = ImGui::GetCursorScreenPos();
+    // The violin reaches beyond the samples, so the histogram below it shares its range
+    const ValueAxis axis{position.x, position.x + width, distribution.density.first,
+                         distribution.density.last()};
+
+    auto& drawList = *ImGui::GetWindowDrawList();
+    const auto centerY = position.y + violinHeight / 2;
+    drawViolin(drawList, distribution.density, axis, centerY, violinHeight / 2);
+    drawBox(drawList, box, axis, centerY, violinHeight / 2);
+    const auto histogramTop = position.y + violinHeight + ImGui::GetStyle().ItemSpacing.y;
+    drawHistogram(drawList, distribution.histogram, axis, histogramTop,
+                  histogramTop + histogramHeight);
+    ImGui::Dummy(ImVec2(width, histogramTop + histogramHeight - position.y));
+
+    ImGui::TextUnformatted(format(axis.first));
+    // The offset of SameLine() is measured from the edge of the window, not from the cursor
+    const auto* last = format(axis.last);
+    ImGui::SameLine(position.x - ImGui::GetWindowPos().x + width - ImGui::CalcTextSize(last).x);
+    ImGui::TextUnformatted(last);
+}
+
+}// namespace BPlotter
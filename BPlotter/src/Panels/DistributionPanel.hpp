@@ -0,0 +1,112 @@
+#pragma once
+
+#include <future>
+#include <optional>
+#include <vector>
+
+#include "Analysis/RepetitionDistribution.hpp"
+#include "Utils/NumberFormat.hpp"
+
+namespace BPlotter
+{
+
+/**
+ * \brief ImGui panel presenting how the repetitions of every benchmark are distributed.
+ *
+ * Lists every repeated benchmark with a small violin of its density, so that thousands of
+ * them can be skimmed for multimodal ones, and draws the violin, the box plot and the
+ * histogram of the selected benchmark. The densities are estimated on the TaskScheduler,
+ * so the frames go on while a large run is analyzed.
+ */
+class DistributionPanel
+{
+public:
+    /**
+     * \param scheduler Scheduler of the analysis, must outlive the panel
+     */
+    explicit DistributionPanel(TaskScheduler& scheduler);
+    DistributionPanel(const DistributionPanel&) = delete;
+    DistributionPanel& operator=(const DistributionPanel&) = delete;
+    DistributionPanel(DistributionPanel&&) noexcept = default;
+
+    /**
+     * \brief Cancels the running analysis of this panel and takes over the other one.
+     */
+    DistributionPanel& operator=(DistributionPanel&& other) noexcept;
+
+    /**
+     * \brief Cancels the running analysis, which owns everything it reads, so it is not
+     * waited for.
+     */
+    ~DistributionPanel();
+
+    /**
+     * \brief Displays the panel, analyzing the results again if they changed.
+     * \param results Currently opened benchmark results
+     */
+    void updateImGui(const BenchmarkResults& results);
+
+    /**
+     * \brief Estimates the heap memory taken by the analyzed distributions.
+     * \return Number of bytes
+     */
+    [[nodiscard]] std::size_t memoryUsage() const noexcept;
+
+private:
+    /**
+     * \brief Starts the analysis again if the results, the metric or the smoothing changed.
+     */
+    void analyzeIfChanged(const BenchmarkResults& results);
+
+    /**
+     * \brief Takes the distributions of the analysis once it finishes.
+     */
+    void collectAnalysis();
+
+    void cancelAnalysis() noexcept;
+
+    /**
+     * \brief Lists the distributions shown by the filter.
+     */
+    void updateVisible();
+
+    /**
+     * \brief Displays the table with a small violin of every shown distribution.
+     */
+    void updateImGuiDistributions();
+
+    /**
+     * \brief Draws the violin, the box plot and the histogram of the selected distribution.
+     */
+    void updateImGuiDetail();
+
+    TaskScheduler* mScheduler;
+    ColumnIndex mMetric = static_cast<ColumnIndex>(BuiltinColumn::RealTime);
+    float mBandwidthScale = 1.f;
+    bool mIsMultimodalOnly = false;
+
+    /**
+     * \brief What the current analysis was started for, to detect when it is outdated.
+     */
+    const BenchmarkResults* mAnalyzedResults = nullptr;
+    std::size_t mAnalyzedRows = 0;
+    ColumnIndex mAnalyzedMetric = 0;
+    float mAnalyzedBandwidthScale = 0.f;
+    NumberFormat mFormat;
+
+    /**
+     * \brief Running analysis, invalid once its distributions are taken.
+     */
+    CancellationSource mCancellation;
+    std::future<std::optional<std::vector<RepetitionDistribution>>> mAnalysis;
+
+    std::vector<RepetitionDistribution> mDistributions;
+
+    /**
+     * \brief Indices of the distributions shown by the filter.
+     */
+    std::vector<std::size_t> mVisible;
+    std::size_t mSelected = 0;
+};
+
+}// namespace BPlotter
@@ -0,0 +1,472 @@
+#include "HistoryPanel.hpp"
+#include "pch.hpp"
+
+#include "Benchmark/ShardMerge.hpp"
+#include "Utils/FrameArena.hpp"
+#include "Utils/NumberFormat.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+
+namespace BPlotter
+{
+
+namespace
+{
+
+constexpr auto SECONDS_PER_DAY = 24.0 * 60 * 60;
+
+std::string formatDate(const std::int64_t timestamp)
+{
+    const auto date = std::chrono::year_month_day(
+        std::chrono::floor<std::chrono::days>(std::chrono::sys_seconds{
+            std::chrono::seconds{timestamp}}));
+    return fmt::format("{:04}-{:02}-{:02}", static_cast<int>(date.year()),
+                       static_cast<unsigned>(date.month()), static_cast<unsigned>(date.day()));
+}
+
+/**
+ * \brief Ingests the file, or every result file of the directory, into the store.
+ * \param store Store which nothing else uses until the ingestion is done
+ * \param path Path to the file or to the directory
+ * \param scheduler Scheduler decompressing the files while they are being parsed
+ * \param ingested Incremented after each file
+ * \param total Set to the number of files once the directory is listed
+ * \param token Checked before each file, the files already ingested stay in the store
+ * \return Summary of the ingestion displayed to the user
+ */
+std::string ingestFiles(HistoryStore& store, const std::filesystem::path& path,
+                        TaskScheduler& scheduler, std::atomic<std::size_t>& ingested,
+                        std::atomic<std::size_t>& total, const CancellationToken& token)
+{
+    std::vector<std::filesystem::path> files;
+    std::error_code error;
+    if (std::filesystem::is_directory(path, error))
+    {
+        auto listed = listResultFiles(path);
+        if (listed.has_error())
+        {
+            return listed.error();
+        }
+        files = std::move(listed).value();
+    }
+    else
+    {
+        files.push_back(path);
+    }
+    total = files.size();
+
+    auto stored = 0;
+    auto skipped = 0;
+    auto failed = 0;
+    for (const auto& file: files)
+    {
+        if (token.isCancelled())
+        {
+            break;
+        }
+        const auto result = store.ingestFile(file, scheduler);
+        if (result.has_error())
+        {
+            spdlog::warn("[HistoryPanel] Unable to ingest {}: {}", file.string(), result.error());
+            ++failed;
+        }
+        else
+        {
+            ++(result.value() ? stored : skipped);
+        }
+        ++ingested;
+    }
+
+    auto summary = fmt::format("Ingested {} runs, {} already stored, {} failed. {} runs in total.",
+                               stored, skipped, failed, store.runCount());
+    if (ingested < files.size())
+    {
+        summary = fmt::format("Cancelled after {} of {} files. {}", ingested.load(), files.size(),
+                              summary);
+    }
+    return summary;
+}
+
+}// namespace
+
+HistoryPanel::HistoryPanel(TaskScheduler& scheduler)
+    : mScheduler(scheduler)
+    , mPlotView(scheduler)
+{
+}
+
+HistoryPanel::~HistoryPanel()
+{
+    if (mIngestion.valid())
+    {
+        mIngestCancellation.cancel();
+        mIngestion.wait();
+    }
+    if (mDetection.valid())
+    {
+        mDetectionCancellation.cancel();
+        mDetection.wait();
+    }
+}
+
+void HistoryPanel::updateImGui()
+{
+    // Opening and ingesting are disabled while detecting, so it is collected whichever tab is shown
+    collectDetection();
+    if (ImGui::Begin("History"))
+    {
+        ImGui::SetNextItemWidth(300.f);
+        ImGui::InputText("Store directory", mStoreInput.data(), mStoreInput.size());
+        ImGui::SameLine();
+        ImGui::BeginDisabled(isDetecting() || isIngesting());
+        if (ImGui::Button("Open store"))
+        {
+            openStore();
+        }
+
+        if (mStore)
+        {
+            ImGui::SetNextItemWidth(300.f);
+            ImGui::InputText("JSON file or directory", mIngestInput.data(), mIngestInput.size());
+            ImGui::SameLine();
+            if (ImGui::Button("Ingest"))
+            {
+                ingest();
+            }
+        }
+        ImGui::EndDisabled();
+        if (isIngesting())
+        {
+            updateImGuiIngestion();
+        }
+        if (!mStatus.empty())
+        {
+            ImGui::TextUnformatted(mStatus.c_str());
+        }
+
+        // The benchmarks of the store change while it ingests, so they are listed once it is done
+        if (mStore && !isIngesting() && ImGui::BeginTabBar("HistoryTabs"))
+        {
+            if (ImGui::BeginTabItem("Trend"))
+            {
+                updateImGuiBenchmarks();
+                if (mSelectedBenchmark)
+                {
+                    ImGui::Text("Days since %s", formatDate(mFirstTimestamp).c_str());
+                    mPlotView.updateImGui(mSeries, mSeriesVersion);
+                }
+                ImGui::EndTabItem();
+            }
+            if (ImGui::BeginTabItem("Regressions"))
+            {
+                updateImGuiRegressions();
+                ImGui::EndTabItem();
+            }
+            ImGui::EndTabBar();
+        }
+    }
+    ImGui::End();
+}
+
+void HistoryPanel::openStore()
+{
+    auto store = HistoryStore::open(mStoreInput.data());
+    if (store.has_error())
+    {
+        mStatus = store.error();
+        return;
+    }
+
+    mStore.emplace(std::move(store).value());
+    mStatus = fmt::format("{} runs, {} benchmarks", mStore->runCount(),
+                          mStore->benchmarks().size());
+    mVisibleBenchmarksCount = 0;
+    mVisibleBenchmarks.clear();
+    mSelectedBenchmark.reset();
+    mSeries.clear();
+    ++mSeriesVersion;
+    mRegressions.clear();
+    mRegressionsColumn.clear();
+}
+
+void HistoryPanel::ingest()
+{
+    mStatus.clear();
+    mIngestedFiles = 0;
+    mFilesToIngest = 0;
+    mIngestCancellation = CancellationSource();
+    // Parsing a directory of runs takes seconds, so it gives way to the work the plots wait for
+    mIngestion = mScheduler.submit(
+        TaskPriority::Background,
+        [store = &*mStore, path = std::filesystem::path(mIngestInput.data()),
+         scheduler = &mScheduler, ingested = &mIngestedFiles, total = &mFilesToIngest,
+         token = mIngestCancellation.token()]
+        {
+            return ingestFiles(*store, path, *scheduler, *ingested, *total, token);
+        });
+}
+
+void HistoryPanel::updateImGuiIngestion()
+{
+    if (mIngestion.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+        const auto ingested = mIngestedFiles.load();
+        const auto total = mFilesToIngest.load();
+        const auto fraction =
+            total == 0 ? 0.f : static_cast<float>(ingested) / static_cast<float>(total);
+        ImGui::ProgressBar(fraction, ImVec2(300.f, 0.f),
+                           frameArena().format("%zu / %zu files", ingested, total));
+        ImGui::SameLine();
+        ImGui::BeginDisabled(mIngestCancellation.isCancelled());
+        if (ImGui::Button("Cancel"))
+        {
+            mIngestCancellation.cancel();
+        }
+        ImGui::EndDisabled();
+        return;
+    }
+
+    mStatus = mIngestion.get();
+    if (mSelectedBenchmark)
+    {
+        queryTrend();
+    }
+}
+
+void HistoryPanel::updateImGuiBenchmarks()
+{
+    const auto& benchmarks = mStore->benchmarks();
+    ImGui::SetNextItemWidth(300.f);
+    ImGui::InputText("Filter", mFilterInput.data(), mFilterInput.size());
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(200.f);
+    if (ImGui::BeginCombo("Column", mSelectedColumn.c_str()))
+    {
+        const auto& columns = mStore->columns();
+        for (StringId column = 0; column < columns.size(); ++column)
+        {
+            const auto name = columns.get(column);
+            if (ImGui::Selectable(frameArena().copy(name), name == mSelectedColumn))
+            {
+                mSelectedColumn = name;
+                queryTrend();
+            }
+        }
+        ImGui::EndCombo();
+    }
+
+    if (mVisibleFilter != mFilterInput.data() || mVisibleBenchmarksCount != benchmarks.size())
+    {
+        mVisibleFilter = mFilterInput.data();
+        mVisibleBenchmarksCount = benchmarks.size();
+        mVisibleBenchmarks.clear();
+        for (BenchmarkId id = 0; id < benchmarks.size(); ++id)
+        {
+            if (benchmarks.get(id).find(mVisibleFilter) != std::string_view::npos)
+            {
+                mVisibleBenchmarks.push_back(id);
+            }
+        }
+    }
+
+    const auto height = ImGui::GetTextLineHeightWithSpacing() * 8;
+    if (ImGui::BeginChild("HistoryBenchmarks", ImVec2(0, height), true))
+    {
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(mVisibleBenchmarks.size()));
+        while (clipper.Step())
+        {
+            for (auto row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+            {
+                const auto id = mVisibleBenchmarks[row];
+                if (ImGui::Selectable(frameArena().copy(benchmarks.get(id)),
+                                      mSelectedBenchmark == id))
+                {
+                    mSelectedBenchmark = id;
+                    queryTrend();
+                }
+            }
+        }
+    }
+    ImGui::EndChild();
+}
+
+void HistoryPanel::queryTrend()
+{
+    mSeries.clear();
+    ++mSeriesVersion;
+    mPlotView.setMarkers({});
+    mPlotView.requestFit();
+    if (!mSelectedBenchmark)
+    {
+        return;
+    }
+
+    const auto points =
+        mStore->history(mStore->benchmarks().get(*mSelectedBenchmark), mSelectedColumn);
+    if (points.empty())
+    {
+        return;
+    }
+
+    // Repetitions of the same run share the timestamp and are reduced to their mean and min
+    mFirstTimestamp = points.front().timestamp;
+    mSeries.reserve(2);
+    auto& mean = mSeries.emplace_back(Series{"Mean"});
+    auto& min = mSeries.emplace_back(Series{"Min"});
+    for (auto first = points.begin(); first != points.end();)
+    {
+        const auto last = std::find_if(first, points.end(),
+                                       [first](const HistoryPoint& point)
+                                       {
+                                           return point.timestamp != first->timestamp;
+                                       });
+        auto sum = 0.0;
+        auto minimum = first->value;
+        for (auto point = first; point != last; ++point)
+        {
+            sum += point->value;
+            minimum = std::min(minimum, point->value);
+        }
+        const auto day = static_cast<double>(first->timestamp - mFirstTimestamp) / SECONDS_PER_DAY;
+        mean.x.push_back(day);
+        mean.y.push_back(sum / static_cast<double>(last - first));
+        min.x.push_back(day);
+        min.y.push_back(minimum);
+        first = last;
+    }
+
+    std::vector<PlotMarker> markers;
+    for (const auto& change: detectChangePoints(points, mChangePointOptions))
+    {
+        const auto isWorse = mIsHigherBetter == (change.relativeChange < 0);
+        markers.push_back({.x = static_cast<double>(change.timestamp - mFirstTimestamp) /
+                                SECONDS_PER_DAY,
+                           .label = fmt::format("{:+.1f}%", change.relativeChange * 100),
+                           .color = isWorse ? IM_COL32(255, 90, 90, 200)
+                                            : IM_COL32(90, 255, 90, 200)});
+    }
+    mPlotView.setMarkers(std::move(markers));
+}
+
+void HistoryPanel::collectDetection()
+{
+    if (!isDetecting() ||
+        mDetection.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+        return;
+    }
+
+    mRegressions = mDetection.get();
+    mDetectionTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - mDetectionStart);
+}
+
+void HistoryPanel::updateImGuiRegressions()
+{
+    ImGui::BeginDisabled(isDetecting());
+    ImGui::SetNextItemWidth(120.f);
+    ImGui::InputDouble("Minimal score", &mChangePointOptions.minimalScore, 0.5, 1, "%.1f");
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(120.f);
+    ImGui::InputDouble("Minimal change", &mChangePointOptions.minimalRelativeChange, 0.01, 0.05,
+                       "%.3f");
+    ImGui::SameLine();
+    ImGui::Checkbox("Higher is better", &mIsHigherBetter);
+    ImGui::SameLine();
+    if (ImGui::Button("Detect"))
+    {
+        mRegressionsColumn = mSelectedColumn;
+        mDetectionStart = std::chrono::steady_clock::now();
+        mDetectionCancellation = CancellationSource();
+        // A batch job over the whole history, so it gives way to the work the plots wait for
+        mDetection = mScheduler.submit(TaskPriority::Background,
+                                       [store = &*mStore, column = mRegressionsColumn,
+                                        isHigherBetter = mIsHigherBetter,
+                                        options = mChangePointOptions, scheduler = &mScheduler,
+                                        token = mDetectionCancellation.token()]
+                                       {
+                                           return detectRegressions(*store, column,
+                                                                    isHigherBetter, *scheduler,
+                                                                    options, token);
+                                       });
+    }
+    ImGui::EndDisabled();
+
+    if (isDetecting())
+    {
+        ImGui::TextUnformatted("Detecting...");
+        return;
+    }
+    if (mRegressionsColumn.empty())
+    {
+        return;
+    }
+
+    ImGui::Text("%zu regressions of %s found in %lld ms", mRegressions.size(),
+                mRegressionsColumn.c_str(), static_cast<long long>(mDetectionTime.count()));
+    constexpr auto flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders |
+                           ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable;
+    if (ImGui::BeginTable("Regressions", 5, flags))
+    {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Benchmark", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Change");
+        ImGui::TableSetupColumn("Before");
+        ImGui::TableSetupColumn("After");
+        ImGui::TableSetupColumn("Date");
+        ImGui::TableHeadersRow();
+
+        auto format = formatOfColumn(mRegressionsColumn);
+        format.precision = 4;
+        std::array<char, NUMBER_BUFFER_SIZE> buffer{};
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(mRegressions.size()));
+        while (clipper.Step())
+        {
+            for (auto row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+            {
+                const auto& regression = mRegressions[row];
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::PushID(row);
+                const auto* name =
+                    frameArena().copy(mStore->benchmarks().get(regression.benchmark));
+                if (ImGui::Selectable(name, mSelectedBenchmark == regression.benchmark,
+                                      ImGuiSelectableFlags_SpanAllColumns))
+                {
+                    // Show the trend of the regressed benchmark in the trend tab
+                    mSelectedBenchmark = regression.benchmark;
+                    mSelectedColumn = mRegressionsColumn;
+                    queryTrend();
+                }
+                ImGui::PopID();
+                ImGui::TableNextColumn();
+                ImGui::Text("%+.1f%%", regression.change.relativeChange * 100);
+                ImGui::TableNextColumn();
+                const auto before = formatNumber(regression.change.before, format, buffer);
+                ImGui::TextUnformatted(before.data(), before.data() + before.size());
+                ImGui::TableNextColumn();
+                const auto after = formatNumber(regression.change.after, format, buffer);
+                ImGui::TextUnformatted(after.data(), after.data() + after.size());
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(formatDate(regression.change.timestamp).c_str());
+            }
+        }
+        ImGui::EndTable();
+    }
+}
+
+bool HistoryPanel::isDetecting() const
+{
+    return mDetection.valid();
+}
+
+bool HistoryPanel::isIngesting() const
+{
+    return mIngestion.valid();
+}
+
+}// namespace BPlotter
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <future>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Analysis/ChangePointDetection.hpp"
+#include "History/HistoryStore.hpp"
+#include "Plot/PlotView.hpp"
+#include "Tasks/TaskScheduler.hpp"
+
+namespace BPlotter
+{
+
+/**
+ * \brief ImGui panel managing the history of the benchmark runs and plotting the trend
+ * of a single benchmark over time.
+ *
+ * Runs are ingested into the HistoryStore once, in the background, so plotting the trend reads
+ * only the store and never the original JSON files. The level shifts of the trend are marked on the
+ * plot, and the regressions of all the benchmarks can be detected in the background and
+ * listed from the largest one.
+ */
+class HistoryPanel
+{
+public:
+    /**
+     * \param scheduler Scheduler of the ingestion, of the detection and of the plot, must
+     * outlive the panel
+     */
+    explicit HistoryPanel(TaskScheduler& scheduler);
+    HistoryPanel(const HistoryPanel&) = delete;
+    HistoryPanel& operator=(const HistoryPanel&) = delete;
+
+    /**
+     * \brief Cancels the running ingestion and detection and waits for them, as they both use
+     * the store.
+     */
+    ~HistoryPanel();
+
+    /**
+     * \brief Displays the panel.
+     */
+    void updateImGui();
+
+private:
+    /**
+     * \brief Opens (or creates) the store in the directory typed by the user.
+     */
+    void openStore();
+
+    /**
+     * \brief Starts ingesting the file, or every result file of the directory, typed by the user.
+     */
+    void ingest();
+
+    /**
+     * \brief Displays the progress of the ingestion, and takes its summary once it is done.
+     */
+    void updateImGuiIngestion();
+
+    /**
+     * \brief Displays the filterable list of the benchmarks in the store.
+     */
+    void updateImGuiBenchmarks();
+
+    /**
+     * \brief Queries the store for the trend of the selected benchmark.
+     */
+    void queryTrend();
+
+    /**
+     * \brief Takes the regressions once the detection is done, whichever tab is displayed.
+     */
+    void collectDetection();
+
+    /**
+     * \brief Displays the controls of the regression detection and the detected regressions.
+     */
+    void updateImGuiRegressions();
+
+    /**
+     * \brief Whether the regressions are being detected, during which the store must not change.
+     */
+    [[nodiscard]] bool isDetecting() const;
+
+    /**
+     * \brief Whether files are being ingested, during which the store must not be read.
+     */
+    [[nodiscard]] bool isIngesting() const;
+
+    TaskScheduler& mScheduler;
+    std::array<char, 512> mStoreInput{"history"};
+    std::array<char, 512> mIngestInput{};
+    std::array<char, 256> mFilterInput{};
+    std::string mStatus;
+
+    std::optional<HistoryStore> mStore;
+
+    /**
+     * \brief Ingestion running in the background, returning its summary.
+     */
+    CancellationSource mIngestCancellation;
+    std::future<std::string> mIngestion;
+    std::atomic<std::size_t> mIngestedFiles = 0;
+    std::atomic<std::size_t> mFilesToIngest = 0;
+
+    /**
+     * \brief Benchmarks matching the filter, recomputed when the filter or the store changes.
+     */
+    std::vector<BenchmarkId> mVisibleBenchmarks;
+    std::string mVisibleFilter;
+    std::size_t mVisibleBenchmarksCount = 0;
+
+    std::optional<BenchmarkId> mSelectedBenchmark;
+    std::string mSelectedColumn = "real_time";
+
+    /**
+     * \brief Timestamp corresponding to zero on the X axis of the trend.
+     */
+    std::int64_t mFirstTimestamp = 0;
+    std::vector<Series> mSeries;
+
+    /**
+     * \brief Incremented whenever the trend changes, so that the plot does not reuse its caches.
+     */
+    std::uint64_t mSeriesVersion = 0;
+    PlotView mPlotView;
+
+    ChangePointOptions mChangePointOptions;
+    bool mIsHigherBetter = false;
+
+    /**
+     * \brief Detection running in the background.
+     */
+    CancellationSource mDetectionCancellation;
+    std::future<std::vector<Regression>> mDetection;
+    std::chrono::steady_clock::time_point mDetectionStart;
+    std::chrono::milliseconds mDetectionTime{0};
+    std::string mRegressionsColumn;
+    std::vector<Regression> mRegressions;
+};
+
+}// namespace BPlotter
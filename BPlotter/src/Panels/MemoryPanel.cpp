@@ -0,0 +1,93 @@
+#include "MemoryPanel.hpp"
+#include "pch.hpp"
+
+#include "Utils/FrameArena.hpp"
+
+#include <algorithm>
+#include <optional>
+
+namespace BPlotter
+{
+
+namespace
+{
+
+constexpr double BYTES_PER_MIB = 1024.0 * 1024.0;
+
+const char* formatMiB(const std::size_t bytes)
+{
+    return frameArena().format("%.1f MiB", static_cast<double>(bytes) / BYTES_PER_MIB);
+}
+
+}// namespace
+
+void MemoryPanel::updateImGui(MemoryBudget& budget)
+{
+    if (ImGui::Begin("Memory"))
+    {
+        auto limit = static_cast<int>(static_cast<double>(budget.limit()) / BYTES_PER_MIB);
+        ImGui::SetNextItemWidth(150.f);
+        if (ImGui::InputInt("Budget (MiB)", &limit, 64, 256))
+        {
+            budget.setLimit(static_cast<std::size_t>(std::max(limit, 1)) * 1024 * 1024);
+        }
+
+        const auto fraction = static_cast<float>(static_cast<double>(budget.used()) /
+                                                  static_cast<double>(budget.limit()));
+        const auto* overlay = frameArena().format("%s / %s", formatMiB(budget.used()),
+                                                  formatMiB(budget.limit()));
+        ImGui::ProgressBar(std::min(fraction, 1.f), ImVec2(-1.f, 0.f), overlay);
+
+        constexpr auto flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders |
+                               ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable;
+        std::optional<MemoryEntryId> evicted;
+        if (ImGui::BeginTable("MemoryEntries", 4, flags))
+        {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Kind");
+            ImGui::TableSetupColumn("Resident");
+            ImGui::TableSetupColumn("");
+            ImGui::TableHeadersRow();
+
+            for (const auto& entry: budget.entries())
+            {
+                ImGui::PushID(static_cast<int>(entry.id));
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(entry.name.c_str());
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(toString(entry.category).c_str());
+                ImGui::TableNextColumn();
+                if (entry.bytes == 0)
+                {
+                    ImGui::TextDisabled("evicted");
+                }
+                else
+                {
+                    ImGui::TextUnformatted(formatMiB(entry.bytes));
+                }
+                ImGui::TableNextColumn();
+                if (entry.isPinned)
+                {
+                    ImGui::TextDisabled("in use");
+                }
+                else if (entry.bytes > 0 && ImGui::SmallButton("Evict"))
+                {
+                    // Evicted only after the loop, the entries must not change while listed
+                    evicted = entry.id;
+                }
+                ImGui::PopID();
+            }
+            ImGui::EndTable();
+        }
+
+        if (evicted)
+        {
+            budget.evict(*evicted);
+        }
+    }
+    ImGui::End();
+}
+
+}// namespace BPlotter
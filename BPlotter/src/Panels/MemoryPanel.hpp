@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Memory/MemoryBudget.hpp"
+
+namespace BPlotter
+{
+
+/**
+ * \brief ImGui panel showing how much memory the loaded runs and the caches derived from
+ * them hold, and allowing to change the memory budget or evict any of them by hand.
+ */
+class MemoryPanel
+{
+public:
+    /**
+     * \brief Displays the panel.
+     * \param budget Budget accounting the memory of the application
+     */
+    void updateImGui(MemoryBudget& budget);
+};
+
+}// namespace BPlotter
@@ -0,0 +1,171 @@
+#include "PerformancePanel.hpp"
+#include "pch.hpp"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+
+namespace BPlotter
+{
+
+namespace
+{
+
+constexpr auto EXPORT_FILE = "frame_statistics.csv";
+
+/**
+ * \brief Adds a table row with the counts of the last frame and of an average frame.
+ */
+void countsRow(const char* name, const AllocationCounts& last, const AllocationCounts& average)
+{
+    ImGui::TableNextRow();
+    ImGui::TableNextColumn();
+    ImGui::TextUnformatted(name);
+    for (const auto value: {last.allocations, last.frees, last.bytes, average.allocations,
+                            average.bytes})
+    {
+        ImGui::TableNextColumn();
+        ImGui::Text("%llu", static_cast<unsigned long long>(value));
+    }
+}
+
+}// namespace
+
+void PerformancePanel::updateImGui(const AllocationTracker& tracker,
+                                   const FrameSchedulerStatistics& fixedUpdates,
+                                   const TaskSchedulerStatistics& tasks, bool* isOpen)
+{
+    if (ImGui::Begin("Performance", isOpen))
+    {
+        if (tracker.frameCount() == 0)
+        {
+            ImGui::TextUnformatted("No frame has been recorded yet.");
+        }
+        else
+        {
+            updateImGuiFrames(tracker);
+        }
+        updateImGuiFixedUpdates(fixedUpdates);
+        updateImGuiTasks(tasks);
+    }
+    ImGui::End();
+}
+
+void PerformancePanel::updateImGuiFrames(const AllocationTracker& tracker)
+{
+    const auto& last = tracker.frame(tracker.frameCount() - 1);
+    const auto average = tracker.average();
+    std::array<float, AllocationTracker::HISTORY_SIZE> milliseconds{};
+    for (std::size_t index = 0; index < tracker.frameCount(); ++index)
+    {
+        milliseconds[index] = tracker.frame(index).seconds * 1000.f;
+    }
+    const auto frames = static_cast<int>(tracker.frameCount());
+    const auto slowest = *std::max_element(milliseconds.begin(), milliseconds.begin() + frames);
+    ImGui::Text("Frame: %.2f ms, average %.2f ms, slowest %.2f ms", last.seconds * 1000.f,
+                average.seconds * 1000.f, slowest);
+    ImGui::PlotLines("##FrameTimes", milliseconds.data(), frames, 0, nullptr, 0.f, FLT_MAX,
+                     ImVec2(-1.f, 60.f));
+
+    if (isAllocationHookInstalled())
+    {
+        auto isTracking = isAllocationTrackingEnabled();
+        if (ImGui::Checkbox("Track allocations", &isTracking))
+        {
+            setAllocationTrackingEnabled(isTracking);
+        }
+    }
+    else
+    {
+        ImGui::TextDisabled("Built without BPLOTTER_ALLOCATION_TRACKING.");
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Export CSV"))
+    {
+        exportFrames(tracker);
+    }
+
+    constexpr auto flags =
+        ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit;
+    if (ImGui::BeginTable("Allocations", 6, flags))
+    {
+        ImGui::TableSetupColumn("Subsystem");
+        ImGui::TableSetupColumn("Allocations");
+        ImGui::TableSetupColumn("Frees");
+        ImGui::TableSetupColumn("Bytes");
+        ImGui::TableSetupColumn("Allocations / frame");
+        ImGui::TableSetupColumn("Bytes / frame");
+        ImGui::TableHeadersRow();
+
+        for (std::size_t i = 0; i < ALLOCATION_SUBSYSTEM_COUNT; ++i)
+        {
+            countsRow(toString(static_cast<AllocationSubsystem>(i)), last.subsystems[i],
+                      average.subsystems[i]);
+        }
+        countsRow("Total", last.total(), average.total());
+        ImGui::EndTable();
+    }
+}
+
+void PerformancePanel::updateImGuiFixedUpdates(const FrameSchedulerStatistics& fixedUpdates)
+{
+    ImGui::SeparatorText("Fixed updates");
+    ImGui::Text("%zu in the last frame, %llu run in total", fixedUpdates.lastFrameSteps,
+                static_cast<unsigned long long>(fixedUpdates.fixedSteps));
+    ImGui::Text("%llu made up for, %llu dropped in %llu slow frames",
+                static_cast<unsigned long long>(fixedUpdates.compensatedSteps),
+                static_cast<unsigned long long>(fixedUpdates.droppedSteps),
+                static_cast<unsigned long long>(fixedUpdates.framesWithDroppedSteps));
+
+    // Below 100 % the dropped steps made the simulated time fall behind the real one
+    if (fixedUpdates.elapsedSeconds > 0)
+    {
+        ImGui::Text("Simulated time: %.1f %% of the real time",
+                    fixedUpdates.simulatedSeconds / fixedUpdates.elapsedSeconds * 100);
+    }
+}
+
+void PerformancePanel::updateImGuiTasks(const TaskSchedulerStatistics& tasks)
+{
+    // The counters only grow, so the rates are their differences over a whole second
+    const auto now = std::chrono::steady_clock::now();
+    if (const auto elapsed = std::chrono::duration<double>(now - mSecondStart).count();
+        elapsed >= 1)
+    {
+        mExecutedPerSecond =
+            static_cast<double>(tasks.executedTasks - mTasksAtSecondStart.executedTasks) / elapsed;
+        mStolenPerSecond =
+            static_cast<double>(tasks.stolenTasks - mTasksAtSecondStart.stolenTasks) / elapsed;
+        mTasksAtSecondStart = tasks;
+        mSecondStart = now;
+    }
+
+    ImGui::SeparatorText("Tasks");
+    ImGui::Text("%zu threads, %.0f tasks/s run, %.0f tasks/s stolen", tasks.threadCount,
+                mExecutedPerSecond, mStolenPerSecond);
+    for (std::size_t priority = 0; priority < TASK_PRIORITY_COUNT; ++priority)
+    {
+        ImGui::Text("%s queue: %zu", toString(static_cast<TaskPriority>(priority)),
+                    tasks.queuedTasks[priority]);
+    }
+    ImGui::Text("Total: %llu run, %llu stolen",
+                static_cast<unsigned long long>(tasks.executedTasks),
+                static_cast<unsigned long long>(tasks.stolenTasks));
+}
+
+void PerformancePanel::exportFrames(const AllocationTracker& tracker)
+{
+    std::ofstream output(EXPORT_FILE, std::ios::trunc);
+    tracker.exportCsv(output);
+    if (output)
+    {
+        spdlog::info("The statistics of {} frames were exported to {}", tracker.frameCount(),
+                     EXPORT_FILE);
+    }
+    else
+    {
+        spdlog::error("Unable to export the frame statistics to {}", EXPORT_FILE);
+    }
+}
+
+}// namespace BPlotter
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <chrono>
+
+#include "Memory/AllocationTracker.hpp"
+#include "Platform/FrameScheduler.hpp"
+#include "Tasks/TaskScheduler.hpp"
+
+namespace BPlotter
+{
+
+/**
+ * \brief ImGui window with the timings of the last frames and the heap allocations done by
+ * each subsystem while building them, so that it can be checked the hot paths do not
+ * allocate. The recorded frames can be exported as CSV. Below them are the fixed updates the
+ * frames had to make up for or drop, and the queues of the TaskScheduler, to see whether the
+ * background work keeps up.
+ */
+class PerformancePanel
+{
+public:
+    /**
+     * \brief Displays the window.
+     * \param tracker Tracker of the last frames
+     * \param fixedUpdates Current counters of the frame scheduler
+     * \param tasks Current counters of the task scheduler
+     * \param isOpen Cleared when the user closes the window
+     */
+    void updateImGui(const AllocationTracker& tracker,
+                     const FrameSchedulerStatistics& fixedUpdates,
+                     const TaskSchedulerStatistics& tasks, bool* isOpen);
+
+private:
+    /**
+     * \brief Displays the timings and the allocations of the recorded frames.
+     */
+    static void updateImGuiFrames(const AllocationTracker& tracker);
+
+    /**
+     * \brief Displays how many fixed updates were made up for or dropped after slow frames.
+     */
+    static void updateImGuiFixedUpdates(const FrameSchedulerStatistics& fixedUpdates);
+
+    /**
+     * \brief Displays the queued tasks and how many tasks were run and stolen per second.
+     */
+    void updateImGuiTasks(const TaskSchedulerStatistics& tasks);
+
+    /**
+     * \brief Writes the recorded frames to a CSV file in the working directory.
+     */
+    static void exportFrames(const AllocationTracker& tracker);
+
+    /**
+     * \brief Counters of the scheduler at the start of the current second, and the rates
+     * measured over the previous one.
+     */
+    TaskSchedulerStatistics mTasksAtSecondStart;
+    std::chrono::steady_clock::time_point mSecondStart;
+    double mExecutedPerSecond = 0;
+    double mStolenPerSecond = 0;
+};
+
+}// namespace BPlotter
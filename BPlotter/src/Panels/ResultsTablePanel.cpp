@@ -0,0 +1,157 @@
+#include "ResultsTablePanel.hpp"
+#include "pch.hpp"
+
+#include "Utils/FrameArena.hpp"
+#include "Utils/NumberFormat.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <optional>
+#include <span>
+
+namespace BPlotter
+{
+
+namespace
+{
+
+/**
+ * \brief Columns preceding the numeric ones: the name and the aggregate.
+ */
+constexpr std::size_t TEXT_COLUMNS = 2;
+
+/**
+ * \brief Most columns an ImGui table can have.
+ */
+constexpr std::size_t MAX_TABLE_COLUMNS = 512;
+
+/**
+ * \brief Key of the column the table is sorted by, if any.
+ */
+std::optional<SortKey> sortKeyOfTable()
+{
+    const auto* specs = ImGui::TableGetSortSpecs();
+    if (specs == nullptr || specs->SpecsCount == 0)
+    {
+        return std::nullopt;
+    }
+
+    const auto& spec = specs->Specs[0];
+    SortKey key{.direction = spec.SortDirection == ImGuiSortDirection_Descending
+                                 ? SortDirection::Descending
+                                 : SortDirection::Ascending};
+    if (spec.ColumnIndex == 0)
+    {
+        key.kind = TableColumnKind::Name;
+    }
+    else if (spec.ColumnIndex == 1)
+    {
+        key.kind = TableColumnKind::Aggregate;
+    }
+    else
+    {
+        key.kind = TableColumnKind::Numeric;
+        key.column = static_cast<ColumnIndex>(spec.ColumnIndex) - TEXT_COLUMNS;
+    }
+    return key;
+}
+
+}// namespace
+
+ResultsTablePanel::ResultsTablePanel(TaskScheduler& scheduler)
+    : mSorter(scheduler)
+{
+}
+
+void ResultsTablePanel::updateImGui(const BenchmarkResults& results)
+{
+    if (ImGui::Begin("Results table"))
+    {
+        const auto numericColumns =
+            std::min(results.columnCount(), MAX_TABLE_COLUMNS - TEXT_COLUMNS);
+        ImGui::Text("%zu rows", results.size());
+
+        constexpr auto flags = ImGuiTableFlags_Sortable | ImGuiTableFlags_SortTristate |
+                               ImGuiTableFlags_Resizable | ImGuiTableFlags_Reorderable |
+                               ImGuiTableFlags_Hideable | ImGuiTableFlags_ScrollX |
+                               ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg |
+                               ImGuiTableFlags_BordersV | ImGuiTableFlags_SizingFixedFit;
+        if (ImGui::BeginTable("ResultRows", static_cast<int>(TEXT_COLUMNS + numericColumns),
+                              flags))
+        {
+            ImGui::TableSetupScrollFreeze(1, 1);
+            ImGui::TableSetupColumn("Benchmark", ImGuiTableColumnFlags_NoHide);
+            ImGui::TableSetupColumn("Aggregate");
+            for (ColumnIndex column = 0; column < numericColumns; ++column)
+            {
+                ImGui::TableSetupColumn(frameArena().copy(results.columnName(column)));
+            }
+            ImGui::TableHeadersRow();
+
+            auto formats = FrameVector<NumberFormat>(FrameAllocator<NumberFormat>(frameArena()));
+            formats.reserve(numericColumns);
+            for (ColumnIndex column = 0; column < numericColumns; ++column)
+            {
+                formats.push_back(formatOfColumn(results.columnName(column)));
+            }
+            std::array<char, NUMBER_BUFFER_SIZE> buffer{};
+
+            // The order is cached, so asking for it every frame costs nothing
+            const auto key = sortKeyOfTable();
+            const auto order =
+                key ? mSorter.order(results, *key) : std::span<const std::uint32_t>();
+
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(results.size()));
+            while (clipper.Step())
+            {
+                for (auto displayed = clipper.DisplayStart; displayed < clipper.DisplayEnd;
+                     ++displayed)
+                {
+                    const auto row = order.empty() ? static_cast<std::size_t>(displayed)
+                                                   : order[static_cast<std::size_t>(displayed)];
+                    ImGui::TableNextRow();
+
+                    // Cells scrolled out of view horizontally are not formatted at all
+                    if (ImGui::TableNextColumn())
+                    {
+                        const auto name = results.names().get(results.nameColumn()[row]);
+                        ImGui::TextUnformatted(name.data(), name.data() + name.size());
+                    }
+                    if (ImGui::TableNextColumn() &&
+                        results.runTypeColumn()[row] == RunType::Aggregate)
+                    {
+                        const auto aggregate =
+                            results.aggregateNames().get(results.aggregateNameColumn()[row]);
+                        ImGui::TextUnformatted(aggregate.data(),
+                                               aggregate.data() + aggregate.size());
+                    }
+                    for (ColumnIndex column = 0; column < numericColumns; ++column)
+                    {
+                        if (const auto value = results.column(column)[row];
+                            ImGui::TableNextColumn() && not std::isnan(value))
+                        {
+                            const auto text = formatNumber(value, formats[column], buffer);
+                            ImGui::TextUnformatted(text.data(), text.data() + text.size());
+                        }
+                    }
+                }
+            }
+            ImGui::EndTable();
+        }
+    }
+    ImGui::End();
+}
+
+std::size_t ResultsTablePanel::memoryUsage() const noexcept
+{
+    return mSorter.memoryUsage();
+}
+
+std::size_t ResultsTablePanel::evict()
+{
+    return mSorter.evict();
+}
+
+}// namespace BPlotter
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Table/RowSorter.hpp"
+
+namespace BPlotter
+{
+
+/**
+ * \brief ImGui panel listing every row of the results with all its columns, like
+ * a spreadsheet.
+ *
+ * Only the visible rows and columns are formatted, so scrolling stays smooth with hundreds
+ * of thousands of rows. Clicking a header sorts the rows by the column through RowSorter,
+ * which caches the order of every column that was sorted by.
+ */
+class ResultsTablePanel
+{
+public:
+    /**
+     * \param scheduler Scheduler sorting the rows, must outlive the panel
+     */
+    explicit ResultsTablePanel(TaskScheduler& scheduler);
+
+    /**
+     * \brief Displays the panel.
+     * \param results Currently opened benchmark results
+     */
+    void updateImGui(const BenchmarkResults& results);
+
+    /**
+     * \brief Estimates the heap memory taken by the cached orders of the rows.
+     * \return Number of bytes
+     */
+    [[nodiscard]] std::size_t memoryUsage() const noexcept;
+
+    /**
+     * \brief Releases the cached orders of the rows except the displayed one.
+     * \return Number of bytes still held
+     */
+    std::size_t evict();
+
+private:
+    RowSorter mSorter;
+};
+
+}// namespace BPlotter
@@ -0,0 +1,192 @@
+#include "ScalingPanel.hpp"
+#include "pch.hpp"
+
+#include "Utils/FrameArena.hpp"
+
+#include <algorithm>
+
+namespace BPlotter
+{
+
+namespace
+{
+
+/**
+ * \brief Number of points used to draw the curves of the fitted scaling laws.
+ */
+constexpr int FIT_CURVE_POINTS = 64;
+
+}// namespace
+
+ScalingPanel::ScalingPanel(TaskScheduler& scheduler)
+    : mPlotView(scheduler)
+{
+}
+
+void ScalingPanel::updateImGui(const BenchmarkResults& results)
+{
+    if (mMetric >= results.columnCount())
+    {
+        mMetric = static_cast<ColumnIndex>(BuiltinColumn::RealTime);
+    }
+
+    if (ImGui::Begin("Scaling"))
+    {
+        ImGui::SetNextItemWidth(200.f);
+        if (ImGui::BeginCombo("Metric", frameArena().copy(results.columnName(mMetric))))
+        {
+            for (ColumnIndex column = 0; column < results.columnCount(); ++column)
+            {
+                const auto name = results.columnName(column);
+                if (ImGui::Selectable(frameArena().copy(name), column == mMetric))
+                {
+                    mMetric = column;
+                    // Counters measured per second are rates, everything else is a time
+                    mIsHigherBetter = name.ends_with("_per_second");
+                }
+            }
+            ImGui::EndCombo();
+        }
+        ImGui::SameLine();
+        ImGui::Checkbox("Higher is better", &mIsHigherBetter);
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(150.f);
+        ImGui::SliderFloat("Minimal efficiency", &mMinimalEfficiency, 0.f, 1.f, "%.2f");
+
+        analyzeIfChanged(results);
+        if (mFamilies.empty())
+        {
+            ImGui::TextUnformatted("No benchmark was run with more than one thread count.");
+        }
+        else
+        {
+            updateImGuiFamilies();
+            updateImGuiPlot();
+        }
+    }
+    ImGui::End();
+}
+
+void ScalingPanel::analyzeIfChanged(const BenchmarkResults& results)
+{
+    if (mAnalyzedResults == &results && mAnalyzedRows == results.size() &&
+        mAnalyzedMetric == mMetric && mAnalyzedIsHigherBetter == mIsHigherBetter)
+    {
+        return;
+    }
+
+    mFamilies = analyzeScaling(results, mMetric, mIsHigherBetter);
+    mSelectedFamily = std::min(mSelectedFamily, mFamilies.empty() ? 0 : mFamilies.size() - 1);
+    mSeries.clear();
+    ++mSeriesVersion;
+    mPlotView.requestFit();
+
+    mAnalyzedResults = &results;
+    mAnalyzedRows = results.size();
+    mAnalyzedMetric = mMetric;
+    mAnalyzedIsHigherBetter = mIsHigherBetter;
+}
+
+void ScalingPanel::updateImGuiFamilies()
+{
+    constexpr auto flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders |
+                           ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable;
+    const auto height = ImGui::GetTextLineHeightWithSpacing() * 8;
+    if (ImGui::BeginTable("ScalingFamilies", 5, flags, ImVec2(0, height)))
+    {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Benchmark", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Max speedup");
+        ImGui::TableSetupColumn("Serial (Amdahl)");
+        ImGui::TableSetupColumn("Serial (Gustafson)");
+        ImGui::TableSetupColumn("Efficient threads");
+        ImGui::TableHeadersRow();
+
+        for (std::size_t i = 0; i < mFamilies.size(); ++i)
+        {
+            const auto& family = mFamilies[i];
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            if (ImGui::Selectable(family.name.c_str(), i == mSelectedFamily,
+                                  ImGuiSelectableFlags_SpanAllColumns))
+            {
+                mSelectedFamily = i;
+                mSeries.clear();
+                ++mSeriesVersion;
+                mPlotView.requestFit();
+            }
+
+            const auto maxSpeedup = std::ranges::max(family.points, {}, &ScalingPoint::speedup);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2fx", maxSpeedup.speedup);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", family.amdahl.serialFraction);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", family.gustafson.serialFraction);
+            ImGui::TableNextColumn();
+            ImGui::Text("%g", family.maxEfficientThreads(mMinimalEfficiency));
+        }
+        ImGui::EndTable();
+    }
+}
+
+void ScalingPanel::updateImGuiPlot()
+{
+    if (ImGui::Checkbox("Plot efficiency", &mIsEfficiencyPlotted))
+    {
+        mSeries.clear();
+        ++mSeriesVersion;
+        mPlotView.requestFit();
+    }
+
+    const auto& family = mFamilies[mSelectedFamily];
+    ImGui::SameLine();
+    ImGui::Text("Amdahl RMS error: %.3f, Gustafson RMS error: %.3f", family.amdahl.rmsError,
+                family.gustafson.rmsError);
+
+    if (mSeries.empty())
+    {
+        const auto baseline = family.points.front().threads;
+        const auto lastThreads = family.points.back().threads;
+        const auto toPlotted = [this](const double speedup, const double relativeThreads)
+        {
+            return mIsEfficiencyPlotted ? speedup / relativeThreads : speedup;
+        };
+
+        mSeries.reserve(4);
+        auto& measured = mSeries.emplace_back(Series{"Measured"});
+        for (const auto& point: family.points)
+        {
+            measured.x.push_back(point.threads);
+            measured.y.push_back(mIsEfficiencyPlotted ? point.efficiency : point.speedup);
+        }
+
+        auto& ideal = mSeries.emplace_back(Series{"Ideal"});
+        auto& amdahl = mSeries.emplace_back(Series{"Amdahl"});
+        auto& gustafson = mSeries.emplace_back(Series{"Gustafson"});
+        for (auto i = 0; i <= FIT_CURVE_POINTS; ++i)
+        {
+            const auto threads = baseline + (lastThreads - baseline) * i / FIT_CURVE_POINTS;
+            const auto relativeThreads = threads / baseline;
+            for (auto* series: {&ideal, &amdahl, &gustafson})
+            {
+                series->x.push_back(threads);
+            }
+            ideal.y.push_back(toPlotted(relativeThreads, relativeThreads));
+            amdahl.y.push_back(
+                toPlotted(amdahlSpeedup(family.amdahl.serialFraction, relativeThreads),
+                          relativeThreads));
+            gustafson.y.push_back(
+                toPlotted(gustafsonSpeedup(family.gustafson.serialFraction, relativeThreads),
+                          relativeThreads));
+        }
+    }
+    mPlotView.updateImGui(mSeries, mSeriesVersion);
+}
+
+std::size_t ScalingPanel::staticLayersDrawCount() const noexcept
+{
+    return mPlotView.staticLayersDrawCount();
+}
+
+}// namespace BPlotter
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Analysis/ScalingAnalysis.hpp"
+#include "Plot/PlotView.hpp"
+
+namespace BPlotter
+{
+
+/**
+ * \brief ImGui panel presenting the multi-core scaling of the benchmarks run with
+ * several thread counts.
+ *
+ * Lists every family with its fitted serial fractions and the largest thread count that is
+ * still used efficiently, and plots the speedup (or efficiency) of the selected family
+ * against the ideal scaling and the fitted Amdahl's and Gustafson's laws.
+ */
+class ScalingPanel
+{
+public:
+    /**
+     * \param scheduler Scheduler of the plot, must outlive the panel
+     */
+    explicit ScalingPanel(TaskScheduler& scheduler);
+
+    /**
+     * \brief Displays the panel, analyzing the results again if they changed.
+     * \param results Currently opened benchmark results
+     */
+    void updateImGui(const BenchmarkResults& results);
+
+    /**
+     * \return Number of times the static layers of the plot were drawn, see
+     * PlotView::staticLayersDrawCount()
+     */
+    [[nodiscard]] std::size_t staticLayersDrawCount() const noexcept;
+
+private:
+    /**
+     * \brief Analyzes the results again if they or the analyzed metric changed.
+     */
+    void analyzeIfChanged(const BenchmarkResults& results);
+
+    /**
+     * \brief Displays the table with all the analyzed families.
+     */
+    void updateImGuiFamilies();
+
+    /**
+     * \brief Plots the scaling of the selected family.
+     */
+    void updateImGuiPlot();
+
+    ColumnIndex mMetric = static_cast<ColumnIndex>(BuiltinColumn::RealTime);
+    bool mIsHigherBetter = false;
+    float mMinimalEfficiency = 0.75f;
+    bool mIsEfficiencyPlotted = false;
+
+    /**
+     * \brief What the current analysis was computed for, to detect when it is outdated.
+     */
+    const BenchmarkResults* mAnalyzedResults = nullptr;
+    std::size_t mAnalyzedRows = 0;
+    ColumnIndex mAnalyzedMetric = 0;
+    bool mAnalyzedIsHigherBetter = false;
+
+    std::vector<ScalingFamily> mFamilies;
+    std::size_t mSelectedFamily = 0;
+    std::vector<Series> mSeries;
+
+    /**
+     * \brief Incremented whenever the series are rebuilt, so that the plot does not reuse its
+     * caches.
+     */
+    std::uint64_t mSeriesVersion = 0;
+    PlotView mPlotView;
+};
+
+}// namespace BPlotter
@@ -0,0 +1,420 @@
+#include "PivotEngine.hpp"
+#include "pch.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <optional>
+
+#include "Memory/AllocationTracker.hpp"
+
+namespace BPlotter
+{
+
+namespace
+{
+
+template<typename T>
+void hashCombine(std::size_t& seed, const T& value)
+{
+    seed ^= std::hash<T>{}(value) + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+}
+
+std::optional<double> toNumber(const std::string_view text)
+{
+    double value = 0;
+    const auto end = text.data() + text.size();
+    if (const auto [last, error] = std::from_chars(text.data(), end, value);
+        error == std::errc() && last == end)
+    {
+        return value;
+    }
+    return std::nullopt;
+}
+
+double aggregate(const std::size_t count, const double sum, const double min, const double max,
+                 const Aggregation aggregation)
+{
+    switch (aggregation)
+    {
+        case Aggregation::Mean: return sum / static_cast<double>(count);
+        case Aggregation::Min: return min;
+        case Aggregation::Max: return max;
+        case Aggregation::Sum: return sum;
+        case Aggregation::Count: return static_cast<double>(count);
+    }
+    return sum;
+}
+
+}// namespace
+
+const char* toString(const Dimension& dimension, const BenchmarkResults& results,
+                     FrameArena& arena)
+{
+    switch (dimension.kind)
+    {
+        case DimensionKind::Family: return "Family";
+        case DimensionKind::Name: return "Name";
+        case DimensionKind::Argument: return arena.format("Argument %zu", dimension.index + 1);
+        case DimensionKind::NamedArgument: return arena.copy(dimension.key);
+        case DimensionKind::TemplateParameter:
+            return arena.format("Template parameter %zu", dimension.index + 1);
+        case DimensionKind::Column: return arena.copy(results.columnName(dimension.index));
+    }
+    return "Unknown dimension";
+}
+
+std::string toString(const Aggregation aggregation)
+{
+    switch (aggregation)
+    {
+        case Aggregation::Mean: return "Mean";
+        case Aggregation::Min: return "Min";
+        case Aggregation::Max: return "Max";
+        case Aggregation::Sum: return "Sum";
+        case Aggregation::Count: return "Count";
+    }
+    return "Unknown aggregation";
+}
+
+std::size_t PivotKeyHash::operator()(const PivotKey& key) const noexcept
+{
+    std::size_t seed = 0;
+    for (const auto* dimension: {&key.x, &key.group})
+    {
+        hashCombine(seed, dimension->kind);
+        hashCombine(seed, dimension->index);
+        hashCombine(seed, dimension->key);
+    }
+    hashCombine(seed, key.y);
+    hashCombine(seed, key.aggregation);
+    hashCombine(seed, key.aggregateName);
+    hashCombine(seed, key.nameFilter);
+    return seed;
+}
+
+std::size_t PivotEngine::CellHash::operator()(const Cell& cell) const noexcept
+{
+    std::size_t seed = 0;
+    hashCombine(seed, cell.group);
+    hashCombine(seed, cell.x);
+    return seed;
+}
+
+std::size_t PivotEngine::DimensionHash::operator()(const Dimension& dimension) const noexcept
+{
+    std::size_t seed = 0;
+    hashCombine(seed, dimension.kind);
+    hashCombine(seed, dimension.index);
+    hashCombine(seed, dimension.key);
+    return seed;
+}
+
+void PivotEngine::reset(const BenchmarkResults& results)
+{
+    mResults = &results;
+    mParsedNames.clear();
+    mValues = StringInterner();
+    mNameValues.clear();
+    mViews.clear();
+    mLastKey.reset();
+    mDimensions.clear();
+    mDimensionsNames = 0;
+    mDimensionsColumns = 0;
+}
+
+const PivotResult& PivotEngine::pivot(const PivotKey& key,
+                                      const std::span<const StringId> matchingNames)
+{
+    assert(mResults != nullptr);
+    AllocationScope scope(AllocationSubsystem::Statistics);
+    auto& view = mViews[key];
+    if (mLastKey != key)
+    {
+        mLastKey = key;
+    }
+    if (aggregateNewRows(key, matchingNames, view))
+    {
+        buildSeries(key, view);
+    }
+    return view.result;
+}
+
+const std::vector<Dimension>& PivotEngine::dimensions()
+{
+    assert(mResults != nullptr);
+    if (mDimensionsNames == mResults->names().size() &&
+        mDimensionsColumns == mResults->columnCount())
+    {
+        return mDimensions;
+    }
+    parseNewNames();
+
+    std::size_t arguments = 0;
+    std::size_t templateParameters = 0;
+    std::vector<std::string_view> namedArguments;
+    for (const auto& name: mParsedNames)
+    {
+        arguments = std::max(arguments, name.arguments.size());
+        templateParameters = std::max(templateParameters, name.templateParameters.size());
+        for (const auto& [key, value]: name.namedArguments)
+        {
+            if (std::ranges::find(namedArguments, key) == namedArguments.end())
+            {
+                namedArguments.push_back(key);
+            }
+        }
+    }
+
+    mDimensions = {{DimensionKind::Family}, {DimensionKind::Name}};
+    for (std::size_t i = 0; i < arguments; ++i)
+    {
+        mDimensions.push_back({DimensionKind::Argument, i});
+    }
+    for (std::size_t i = 0; i < templateParameters; ++i)
+    {
+        mDimensions.push_back({DimensionKind::TemplateParameter, i});
+    }
+    for (const auto key: namedArguments)
+    {
+        mDimensions.push_back({DimensionKind::NamedArgument, 0, std::string(key)});
+    }
+    for (ColumnIndex i = 0; i < mResults->columnCount(); ++i)
+    {
+        mDimensions.push_back({DimensionKind::Column, i});
+    }
+
+    mDimensionsNames = mResults->names().size();
+    mDimensionsColumns = mResults->columnCount();
+    return mDimensions;
+}
+
+std::size_t PivotEngine::memoizedViews() const noexcept
+{
+    return mViews.size();
+}
+
+std::size_t PivotEngine::memoryUsage() const noexcept
+{
+    // The nodes of the maps hold the key, the value and the pointer to the next node
+    constexpr auto CELL_SIZE = sizeof(Cell) + sizeof(Accumulator) + sizeof(void*);
+    auto bytes = mValues.memoryUsage() + mParsedNames.capacity() * sizeof(BenchmarkName);
+    for (const auto& [dimension, values]: mNameValues)
+    {
+        bytes += values.capacity() * sizeof(ValueKey);
+    }
+    for (const auto& [key, view]: mViews)
+    {
+        bytes += sizeof(View) + view.cells.size() * CELL_SIZE +
+                 view.cells.bucket_count() * sizeof(void*);
+        for (const auto& series: view.result.series)
+        {
+            bytes += sizeof(Series) + series.name.capacity() +
+                     (series.x.capacity() + series.y.capacity()) * sizeof(double);
+        }
+        for (const auto& category: view.result.xCategories)
+        {
+            bytes += sizeof(std::string) + category.capacity();
+        }
+    }
+    return bytes;
+}
+
+std::size_t PivotEngine::evictViews()
+{
+    std::erase_if(mViews,
+                  [this](const auto& view)
+                  {
+                      return view.first != mLastKey;
+                  });
+    return memoryUsage();
+}
+
+bool PivotEngine::aggregateNewRows(const PivotKey& key,
+                                   const std::span<const StringId> matchingNames, View& view)
+{
+    const auto rows = mResults->size();
+    const auto firstRow = view.processedRows;
+    view.processedRows = rows;
+
+    const auto expectedType = key.aggregateName.empty() ? RunType::Iteration : RunType::Aggregate;
+    const auto aggregateId = mResults->aggregateNames().find(key.aggregateName);
+    if (firstRow == rows || not aggregateId)
+    {
+        // If the aggregate was never seen, none of the rows so far can be a part of the view
+        return false;
+    }
+
+    std::vector<bool> isMatching;
+    if (not key.nameFilter.empty())
+    {
+        isMatching.resize(mResults->names().size());
+        for (const auto id: matchingNames)
+        {
+            isMatching[id] = true;
+        }
+    }
+
+    // Values of the dimensions are taken either from the names or straight from a column
+    const auto valuesOf = [this](const Dimension& dimension)
+    {
+        return dimension.kind == DimensionKind::Column ? std::span<const ValueKey>()
+                                                       : nameValues(dimension);
+    };
+    const auto xNameValues = valuesOf(key.x);
+    const auto groupNameValues = valuesOf(key.group);
+    const auto valueOf = [this](const Dimension& dimension,
+                                const std::span<const ValueKey> nameValues, const std::size_t row)
+    {
+        if (dimension.kind != DimensionKind::Column)
+        {
+            return nameValues[mResults->runNameColumn()[row]];
+        }
+        const auto value = mResults->column(dimension.index)[row];
+        return std::isnan(value) ? MISSING : std::bit_cast<ValueKey>(value);
+    };
+
+    const auto runNames = mResults->runNameColumn();
+    const auto runTypes = mResults->runTypeColumn();
+    const auto aggregateNames = mResults->aggregateNameColumn();
+    const auto values = mResults->column(key.y);
+    auto isAnyRowAggregated = false;
+    for (auto row = firstRow; row < rows; ++row)
+    {
+        if (runTypes[row] != expectedType || aggregateNames[row] != *aggregateId ||
+            (not isMatching.empty() && not isMatching[runNames[row]]) || std::isnan(values[row]))
+        {
+            continue;
+        }
+
+        const auto x = valueOf(key.x, xNameValues, row);
+        const auto group = valueOf(key.group, groupNameValues, row);
+        if (x == MISSING || group == MISSING)
+        {
+            continue;
+        }
+
+        auto& [count, sum, min, max] = view.cells[{group, x}];
+        min = count == 0 ? values[row] : std::min(min, values[row]);
+        max = count == 0 ? values[row] : std::max(max, values[row]);
+        sum += values[row];
+        ++count;
+        isAnyRowAggregated = true;
+    }
+    return isAnyRowAggregated;
+}
+
+void PivotEngine::buildSeries(const PivotKey& key, View& view) const
+{
+    const auto isColumn = key.x.kind == DimensionKind::Column;
+    const auto isNumericValue = [this](const auto& entry)
+    {
+        return toNumber(mValues.get(static_cast<StringId>(entry.first.x))).has_value();
+    };
+    const auto isNumeric = isColumn || std::ranges::all_of(view.cells, isNumericValue);
+
+    auto& result = view.result;
+    result.series.clear();
+    result.xCategories.clear();
+
+    std::map<std::string, double> categories;
+    if (not isNumeric)
+    {
+        for (const auto& [cell, accumulator]: view.cells)
+        {
+            categories.emplace(valueText(key.x, cell.x), 0);
+        }
+        auto index = 0.0;
+        for (auto& [label, position]: categories)
+        {
+            position = index++;
+            result.xCategories.push_back(label);
+        }
+    }
+
+    std::unordered_map<ValueKey, std::vector<std::pair<double, double>>> groups;
+    for (const auto& [cell, accumulator]: view.cells)
+    {
+        auto x = 0.0;
+        if (isColumn)
+        {
+            x = std::bit_cast<double>(cell.x);
+        }
+        else if (isNumeric)
+        {
+            x = *toNumber(mValues.get(static_cast<StringId>(cell.x)));
+        }
+        else
+        {
+            x = categories.at(valueText(key.x, cell.x));
+        }
+        const auto& [count, sum, min, max] = accumulator;
+        groups[cell.group].emplace_back(x, aggregate(count, sum, min, max, key.aggregation));
+    }
+
+    for (auto& [group, points]: groups)
+    {
+        std::ranges::sort(points);
+        auto& series = result.series.emplace_back();
+        series.name = valueText(key.group, group);
+        series.x.reserve(points.size());
+        series.y.reserve(points.size());
+        for (const auto& [x, y]: points)
+        {
+            series.x.push_back(x);
+            series.y.push_back(y);
+        }
+    }
+    std::ranges::sort(result.series, {}, &Series::name);
+}
+
+void PivotEngine::parseNewNames()
+{
+    const auto& names = mResults->names();
+    for (auto id = static_cast<StringId>(mParsedNames.size()); id < names.size(); ++id)
+    {
+        mParsedNames.push_back(parseBenchmarkName(names.get(id)));
+    }
+}
+
+std::span<const PivotEngine::ValueKey> PivotEngine::nameValues(const Dimension& dimension)
+{
+    parseNewNames();
+
+    const auto& names = mResults->names();
+    auto& values = mNameValues[dimension];
+    for (auto id = static_cast<StringId>(values.size()); id < names.size(); ++id)
+    {
+        const auto& name = mParsedNames[id];
+        const auto elementAt = [&dimension](const std::vector<std::string_view>& elements)
+        {
+            return dimension.index < elements.size() ? elements[dimension.index]
+                                                     : std::string_view();
+        };
+
+        std::string_view text;
+        switch (dimension.kind)
+        {
+            case DimensionKind::Family: text = name.family; break;
+            case DimensionKind::Name: text = names.get(id); break;
+            case DimensionKind::Argument: text = elementAt(name.arguments); break;
+            case DimensionKind::NamedArgument: text = name.namedArgument(dimension.key); break;
+            case DimensionKind::TemplateParameter: text = elementAt(name.templateParameters); break;
+            case DimensionKind::Column: assert(false); break;
+        }
+        values.push_back(text.empty() ? MISSING : mValues.intern(text));
+    }
+    return values;
+}
+
+std::string PivotEngine::valueText(const Dimension& dimension, const ValueKey value) const
+{
+    if (dimension.kind == DimensionKind::Column)
+    {
+        return fmt::format("{}", std::bit_cast<double>(value));
+    }
+    return std::string(mValues.get(static_cast<StringId>(value)));
+}
+
+}// namespace BPlotter
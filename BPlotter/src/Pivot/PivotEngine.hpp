@@ -0,0 +1,266 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Benchmark/BenchmarkName.hpp"
+#include "Benchmark/BenchmarkResults.hpp"
+#include "Plot/Series.hpp"
+#include "Utils/FrameArena.hpp"
+
+namespace BPlotter
+{
+
+/**
+ * \brief Where the value of a dimension of the row comes from.
+ */
+enum class DimensionKind
+{
+    Family,
+    Name,
+    Argument,
+    NamedArgument,
+    TemplateParameter,
+    Column,
+};
+
+/**
+ * \brief A property of the rows by which they can be placed on the X axis or grouped.
+ */
+struct Dimension
+{
+    DimensionKind kind = DimensionKind::Family;
+
+    /**
+     * \brief Index of the argument or the template parameter, or the index of the column.
+     */
+    std::size_t index = 0;
+
+    /**
+     * \brief Key of the named argument (e.g. "threads").
+     */
+    std::string key;
+
+    bool operator==(const Dimension&) const = default;
+};
+
+/**
+ * \brief Converts the dimension to text that can be displayed to the user
+ * \param dimension Dimension to be converted
+ * \param results Results whose column names are used
+ * \param arena Arena holding the text, e.g. until the end of the frame
+ * \return Textual representation of the dimension
+ */
+const char* toString(const Dimension& dimension, const BenchmarkResults& results,
+                     FrameArena& arena);
+
+/**
+ * \brief How the values of the rows falling into the same point are combined.
+ */
+enum class Aggregation
+{
+    Mean,
+    Min,
+    Max,
+    Sum,
+    Count,
+};
+
+/**
+ * \brief Converts the aggregation to text
+ * \param aggregation Aggregation to be converted
+ * \return Textual representation of the aggregation
+ */
+std::string toString(Aggregation aggregation);
+
+/**
+ * \brief Describes a single view over the results: what is plotted and which rows are used.
+ */
+struct PivotKey
+{
+    Dimension x;
+    ColumnIndex y = static_cast<ColumnIndex>(BuiltinColumn::RealTime);
+    Dimension group;
+    Aggregation aggregation = Aggregation::Mean;
+
+    /**
+     * \brief Only aggregate rows with this name are used (e.g. "mean").
+     * If empty, only the iteration rows are used.
+     */
+    std::string aggregateName;
+
+    /**
+     * \brief Identity of the name filter that selected the rows. If empty, all rows are used.
+     */
+    std::string nameFilter;
+
+    bool operator==(const PivotKey&) const = default;
+};
+
+/**
+ * \brief Hashes the PivotKey so it can be used in unordered containers.
+ */
+struct PivotKeyHash
+{
+    std::size_t operator()(const PivotKey& key) const noexcept;
+};
+
+/**
+ * \brief Series produced for a single PivotKey.
+ */
+struct PivotResult
+{
+    std::vector<Series> series;
+
+    /**
+     * \brief Labels of the X values if they are not numeric. In such case the x coordinate of
+     * a point is the index of its label.
+     */
+    std::vector<std::string> xCategories;
+};
+
+/**
+ * \brief Turns the flat benchmark rows into series that can be plotted.
+ *
+ * The rows are grouped by the group dimension, and inside each group by the X dimension,
+ * using a hash aggregation over the columns of the results. Each group becomes a series.
+ *
+ * Every requested view is memoized, so switching back to it is instant. Since the results
+ * are append-only, a memoized view only aggregates the rows that arrived after it was built.
+ */
+class PivotEngine
+{
+public:
+    /**
+     * \brief Binds the engine to the results, discarding all memoized views.
+     * \param results Results to be pivoted. Must outlive the engine or the next reset.
+     */
+    void reset(const BenchmarkResults& results);
+
+    /**
+     * \brief Returns the series for the given view, computing only what is not memoized yet.
+     * \param key Description of the view
+     * \param matchingNames Sorted identifiers of the run names selected by key.nameFilter.
+     * Ignored if the key has no name filter.
+     * \return Series of the view
+     */
+    const PivotResult& pivot(const PivotKey& key, std::span<const StringId> matchingNames);
+
+    /**
+     * \brief Lists the dimensions present in the results: the name components found in any of
+     * the benchmark names and all the numeric columns.
+     * \return Available dimensions
+     */
+    const std::vector<Dimension>& dimensions();
+
+    /**
+     * \brief Number of the memoized views.
+     * \return Number of the memoized views
+     */
+    [[nodiscard]] std::size_t memoizedViews() const noexcept;
+
+    /**
+     * \brief Estimates the heap memory taken by the memoized views and the parsed names.
+     * \return Number of bytes
+     */
+    [[nodiscard]] std::size_t memoryUsage() const noexcept;
+
+    /**
+     * \brief Drops the memoized views except the most recently requested one, so the result
+     * of the last pivot() stays valid. The dropped views are computed again once requested.
+     * \return Number of bytes the engine still holds
+     */
+    std::size_t evictViews();
+
+private:
+    /**
+     * \brief Value of a dimension for a row. For the name based dimensions it is an
+     * identifier inside mValues, for the columns it is the bit pattern of the value.
+     */
+    using ValueKey = std::uint64_t;
+
+    /**
+     * \brief Marks the rows that have no value for the dimension, such as a missing argument.
+     */
+    static constexpr ValueKey MISSING = ~ValueKey{0};
+
+    struct Cell
+    {
+        ValueKey group;
+        ValueKey x;
+        bool operator==(const Cell&) const = default;
+    };
+
+    struct CellHash
+    {
+        std::size_t operator()(const Cell& cell) const noexcept;
+    };
+
+    struct Accumulator
+    {
+        std::size_t count = 0;
+        double sum = 0;
+        double min = 0;
+        double max = 0;
+    };
+
+    /**
+     * \brief Memoized state of a single view.
+     */
+    struct View
+    {
+        std::size_t processedRows = 0;
+        std::unordered_map<Cell, Accumulator, CellHash> cells;
+        PivotResult result;
+    };
+
+    /**
+     * \brief Aggregates the rows that arrived since the view was last updated.
+     * \return True if any row was aggregated
+     */
+    bool aggregateNewRows(const PivotKey& key, std::span<const StringId> matchingNames,
+                          View& view);
+
+    /**
+     * \brief Rebuilds the series of the view out of its aggregated cells.
+     */
+    void buildSeries(const PivotKey& key, View& view) const;
+
+    /**
+     * \brief Parses the names that were interned since the last call.
+     */
+    void parseNewNames();
+
+    /**
+     * \brief Returns the values of the name based dimension for every interned name,
+     * parsing the names that were not parsed yet.
+     */
+    std::span<const ValueKey> nameValues(const Dimension& dimension);
+
+    /**
+     * \brief Converts the value of the dimension to text.
+     */
+    [[nodiscard]] std::string valueText(const Dimension& dimension, ValueKey value) const;
+
+    struct DimensionHash
+    {
+        std::size_t operator()(const Dimension& dimension) const noexcept;
+    };
+
+    const BenchmarkResults* mResults = nullptr;
+    std::vector<BenchmarkName> mParsedNames;
+    StringInterner mValues;
+    std::unordered_map<Dimension, std::vector<ValueKey>, DimensionHash> mNameValues;
+    std::unordered_map<PivotKey, View, PivotKeyHash> mViews;
+    std::optional<PivotKey> mLastKey;
+
+    std::vector<Dimension> mDimensions;
+    std::size_t mDimensionsNames = 0;
+    std::size_t mDimensionsColumns = 0;
+};
+
+}// namespace BPlotter
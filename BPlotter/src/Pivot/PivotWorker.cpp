@@ -0,0 +1,155 @@
+#include "PivotWorker.hpp"
+#include "pch.hpp"
+
+#include <algorithm>
+
+namespace BPlotter
+{
+
+namespace
+{
+
+std::size_t memoryOf(const PivotResult& result)
+{
+    auto bytes = sizeof(PivotSnapshot);
+    for (const auto& series: result.series)
+    {
+        bytes += sizeof(Series) + series.name.capacity() +
+                 (series.x.capacity() + series.y.capacity()) * sizeof(double);
+    }
+    for (const auto& category: result.xCategories)
+    {
+        bytes += sizeof(std::string) + category.capacity();
+    }
+    return bytes;
+}
+
+}// namespace
+
+PivotWorker::PivotWorker(TaskScheduler& scheduler)
+    : mScheduler(scheduler)
+{
+}
+
+PivotWorker::~PivotWorker()
+{
+    wait();
+}
+
+void PivotWorker::reset(const BenchmarkResults& results)
+{
+    wait();
+    mEngine.reset(results);
+    mFront.reset();
+    mPending.reset();
+    mLastRequest.reset();
+    mDimensions.clear();
+    refreshFromEngine();
+}
+
+void PivotWorker::request(const PivotKey& key, const std::span<const StringId> matchingNames)
+{
+    // The names matter only to a filtered view, so they are not even compared otherwise
+    const auto names = key.nameFilter.empty() ? std::span<const StringId>() : matchingNames;
+    if (mLastRequest && mLastRequest->key == key &&
+        std::ranges::equal(mLastRequest->matchingNames, names))
+    {
+        return;
+    }
+
+    Request request{key, std::vector<StringId>(names.begin(), names.end())};
+    mLastRequest = request;
+    if (isBusy())
+    {
+        mPending = std::move(request);
+    }
+    else
+    {
+        launch(std::move(request));
+    }
+}
+
+void PivotWorker::update()
+{
+    if (mBack.valid() && mBack.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    {
+        mFront = mBack.get();
+        if (mPending)
+        {
+            launch(std::move(*mPending));
+            mPending.reset();
+        }
+    }
+
+    // E.g. a derived metric adds a dimension without any new pivot
+    if (not isBusy())
+    {
+        refreshFromEngine();
+    }
+}
+
+void PivotWorker::wait()
+{
+    // The update starts the pending pivot, which is waited for as well
+    while (mBack.valid())
+    {
+        mBack.wait();
+        update();
+    }
+}
+
+bool PivotWorker::isBusy() const
+{
+    return mBack.valid();
+}
+
+const PivotSnapshot* PivotWorker::snapshot() const noexcept
+{
+    return mFront.get();
+}
+
+const std::vector<Dimension>& PivotWorker::dimensions() const noexcept
+{
+    return mDimensions;
+}
+
+std::size_t PivotWorker::memoryUsage() const noexcept
+{
+    return mEngineMemory + (mFront ? memoryOf(mFront->result) : 0);
+}
+
+std::size_t PivotWorker::evictViews()
+{
+    if (not isBusy())
+    {
+        mEngineMemory = mEngine.evictViews();
+    }
+    return memoryUsage();
+}
+
+void PivotWorker::launch(Request request)
+{
+    // The user waits for the plot, so the pivot goes before any background work
+    mBack = mScheduler.submit(TaskPriority::Interactive,
+                              [this, request = std::move(request), generation = mNextGeneration++]
+                              {
+                                  auto snapshot = std::make_shared<PivotSnapshot>();
+                                  snapshot->generation = generation;
+                                  snapshot->key = request.key;
+                                  snapshot->result =
+                                      mEngine.pivot(request.key, request.matchingNames);
+                                  return std::shared_ptr<const PivotSnapshot>(std::move(snapshot));
+                              });
+}
+
+void PivotWorker::refreshFromEngine()
+{
+    // Without a reset the dimensions only grow, so they are copied only when some were found
+    if (const auto& dimensions = mEngine.dimensions(); dimensions.size() != mDimensions.size())
+    {
+        mDimensions = dimensions;
+    }
+    mEngineMemory = mEngine.memoryUsage();
+}
+
+}// namespace BPlotter
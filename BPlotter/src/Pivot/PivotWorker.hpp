@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "Pivot/PivotEngine.hpp"
+#include "Tasks/TaskScheduler.hpp"
+
+namespace BPlotter
+{
+
+/**
+ * \brief Immutable result of a pivot, safe to be displayed while the next one is computed.
+ */
+struct PivotSnapshot
+{
+    /**
+     * \brief Grows with every published snapshot, so it identifies the snapshot.
+     */
+    std::uint64_t generation = 0;
+    PivotKey key;
+    PivotResult result;
+};
+
+/**
+ * \brief Runs the PivotEngine on the threads of the TaskScheduler, so that building the
+ * series of a large run does not stall the frames.
+ *
+ * The results are double-buffered: the front snapshot is what the UI displays and it never
+ * changes, while the back one is being computed. Once the back one is ready, it replaces the
+ * front one in update(), on the UI thread, so reading the snapshot needs no locks.
+ *
+ * While a pivot runs, the engine reads the results, so they must not change. Everything that
+ * changes them has to call wait() first.
+ */
+class PivotWorker
+{
+public:
+    /**
+     * \param scheduler Scheduler running the pivots, must outlive the worker
+     */
+    explicit PivotWorker(TaskScheduler& scheduler);
+    PivotWorker(const PivotWorker&) = delete;
+    PivotWorker& operator=(const PivotWorker&) = delete;
+
+    /**
+     * \brief Waits for the running pivot.
+     */
+    ~PivotWorker();
+
+    /**
+     * \brief Binds the engine to the results, discarding the snapshot and all the views.
+     * \param results Results to be pivoted. Must outlive the worker or the next reset.
+     */
+    void reset(const BenchmarkResults& results);
+
+    /**
+     * \brief Asks for the view, which is computed in the background. Asking for the view that
+     * was asked for the last time does nothing, so it can be called every frame.
+     * \param key Description of the view
+     * \param matchingNames Sorted identifiers of the run names selected by key.nameFilter
+     */
+    void request(const PivotKey& key, std::span<const StringId> matchingNames);
+
+    /**
+     * \brief Publishes the finished pivot as the front snapshot and starts the next requested
+     * one. Called every frame, it also refreshes the dimensions while the engine is idle.
+     */
+    void update();
+
+    /**
+     * \brief Waits until the running pivot finishes, e.g. before the results change.
+     */
+    void wait();
+
+    /**
+     * \brief Whether a pivot is running at the moment.
+     */
+    [[nodiscard]] bool isBusy() const;
+
+    /**
+     * \brief Last published snapshot.
+     * \return Snapshot, or nullptr if no pivot finished since the last reset
+     */
+    [[nodiscard]] const PivotSnapshot* snapshot() const noexcept;
+
+    /**
+     * \brief Dimensions present in the results, as of the last time the engine was idle.
+     * \return Available dimensions
+     */
+    [[nodiscard]] const std::vector<Dimension>& dimensions() const noexcept;
+
+    /**
+     * \brief Memory of the engine as of the last time it was idle, plus the front snapshot.
+     * \return Number of bytes
+     */
+    [[nodiscard]] std::size_t memoryUsage() const noexcept;
+
+    /**
+     * \brief Drops the memoized views of the engine, unless it is busy.
+     * \return Number of bytes still held
+     */
+    std::size_t evictViews();
+
+private:
+    struct Request
+    {
+        PivotKey key;
+        std::vector<StringId> matchingNames;
+        bool operator==(const Request&) const = default;
+    };
+
+    /**
+     * \brief Starts computing the view in the background.
+     */
+    void launch(Request request);
+
+    /**
+     * \brief Copies what the UI needs out of the idle engine.
+     */
+    void refreshFromEngine();
+
+    TaskScheduler& mScheduler;
+    PivotEngine mEngine;
+
+    /**
+     * \brief Snapshot displayed by the UI.
+     */
+    std::shared_ptr<const PivotSnapshot> mFront;
+
+    /**
+     * \brief Snapshot being computed.
+     */
+    std::future<std::shared_ptr<const PivotSnapshot>> mBack;
+
+    /**
+     * \brief Request waiting for the running pivot, only the latest one is kept.
+     */
+    std::optional<Request> mPending;
+    std::optional<Request> mLastRequest;
+    std::uint64_t mNextGeneration = 1;
+
+    std::vector<Dimension> mDimensions;
+    std::size_t mEngineMemory = 0;
+};
+
+}// namespace BPlotter
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <optional>
+
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Window/Event.hpp>
+
+namespace BPlotter
+{
+
+class StateStack;
+
+/**
+ * \brief Where the application gets its events from and presents its frames to, together
+ * with the ImGui backend that goes with it.
+ *
+ * The application normally runs in a DesktopWindow; the HeadlessWindow runs the same frames
+ * without a display server, for the tests and the benchmarks.
+ */
+class ApplicationWindow
+{
+public:
+    virtual ~ApplicationWindow() = default;
+
+    /**
+     * \brief Takes the next event waiting to be processed.
+     * \return The event, nullopt if there are no more events in this frame
+     */
+    [[nodiscard]] virtual std::optional<sf::Event> pollEvent() = 0;
+
+    [[nodiscard]] virtual bool hasFocus() const = 0;
+    [[nodiscard]] virtual sf::Vector2u getSize() const = 0;
+
+    /**
+     * \brief Passes the event to ImGui.
+     * \param event Polled or replayed event
+     */
+    virtual void processImGuiEvent(const sf::Event& event) = 0;
+
+    /**
+     * \brief Starts a new ImGui frame.
+     * \param deltaTime Time elapsed since the previous frame
+     * \param mousePosition Position of the mouse to use instead of the real cursor, while
+     * replaying
+     */
+    virtual void updateImGui(const sf::Time& deltaTime,
+                             const std::optional<sf::Vector2i>& mousePosition) = 0;
+
+    /**
+     * \brief Draws the states and the ImGui frame and presents them.
+     * \param states States of the application, drawn from the lowest one
+     */
+    virtual void render(const StateStack& states) = 0;
+
+    virtual void close() = 0;
+};
+
+}// namespace BPlotter
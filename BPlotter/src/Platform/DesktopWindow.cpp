@@ -0,0 +1,69 @@
+#include "DesktopWindow.hpp"
+#include "pch.hpp"
+
+#include "States/StateStack.hpp"
+
+namespace BPlotter
+{
+
+DesktopWindow::DesktopWindow(const sf::Vector2u size, const std::string& title)
+    : mWindow(sf::VideoMode(size), title)
+{
+    if (not ImGui::SFML::Init(mWindow))
+    {
+        spdlog::critical("Imgui-SFML not initialized properly");
+    }
+}
+
+DesktopWindow::~DesktopWindow()
+{
+    ImGui::SFML::Shutdown();
+}
+
+std::optional<sf::Event> DesktopWindow::pollEvent()
+{
+    return mWindow.pollEvent();
+}
+
+bool DesktopWindow::hasFocus() const
+{
+    return mWindow.hasFocus();
+}
+
+sf::Vector2u DesktopWindow::getSize() const
+{
+    return mWindow.getSize();
+}
+
+void DesktopWindow::processImGuiEvent(const sf::Event& event)
+{
+    ImGui::SFML::ProcessEvent(mWindow, event);
+}
+
+void DesktopWindow::updateImGui(const sf::Time& deltaTime,
+                                const std::optional<sf::Vector2i>& mousePosition)
+{
+    if (mousePosition)
+    {
+        ImGui::SFML::Update(*mousePosition, sf::Vector2f(mWindow.getSize()), deltaTime);
+    }
+    else
+    {
+        ImGui::SFML::Update(mWindow, deltaTime);
+    }
+}
+
+void DesktopWindow::render(const StateStack& states)
+{
+    mWindow.clear();
+    states.draw(mWindow);
+    ImGui::SFML::Render();
+    mWindow.display();
+}
+
+void DesktopWindow::close()
+{
+    mWindow.close();
+}
+
+}// namespace BPlotter
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+
+#include <SFML/Graphics/RenderWindow.hpp>
+
+#include "Platform/ApplicationWindow.hpp"
+
+namespace BPlotter
+{
+
+/**
+ * \brief Window of the operating system, rendered by the GPU through ImGui-SFML.
+ */
+class DesktopWindow final : public ApplicationWindow
+{
+public:
+    /**
+     * \brief Opens the window and initializes ImGui-SFML for it.
+     * \param size Size of the window in pixels
+     * \param title Title of the window
+     */
+    DesktopWindow(sf::Vector2u size, const std::string& title);
+    DesktopWindow(const DesktopWindow&) = delete;
+    DesktopWindow& operator=(const DesktopWindow&) = delete;
+    ~DesktopWindow() override;
+
+    [[nodiscard]] std::optional<sf::Event> pollEvent() override;
+    [[nodiscard]] bool hasFocus() const override;
+    [[nodiscard]] sf::Vector2u getSize() const override;
+    void processImGuiEvent(const sf::Event& event) override;
+    void updateImGui(const sf::Time& deltaTime,
+                     const std::optional<sf::Vector2i>& mousePosition) override;
+    void render(const StateStack& states) override;
+    void close() override;
+
+private:
+    sf::RenderWindow mWindow;
+};
+
+}// namespace BPlotter
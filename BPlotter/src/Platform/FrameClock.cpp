@@ -0,0 +1,22 @@
+#include "FrameClock.hpp"
+#include "pch.hpp"
+
+namespace BPlotter
+{
+
+sf::Time SystemFrameClock::restart()
+{
+    return mClock.restart();
+}
+
+FixedFrameClock::FixedFrameClock(const sf::Time step)
+    : mStep(step)
+{
+}
+
+sf::Time FixedFrameClock::restart()
+{
+    return mStep;
+}
+
+}// namespace BPlotter
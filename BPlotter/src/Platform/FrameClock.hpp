@@ -0,0 +1,54 @@
+#pragma once
+
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+
+namespace BPlotter
+{
+
+/**
+ * \brief Source of the time steps the application loop advances by, so that tests and
+ * benchmarks can drive the frames with steps independent of how long they really take.
+ */
+class FrameClock
+{
+public:
+    virtual ~FrameClock() = default;
+
+    /**
+     * \brief Starts the next frame.
+     * \return Time elapsed since the previous frame started
+     */
+    virtual sf::Time restart() = 0;
+};
+
+/**
+ * \brief Measures the real time between the frames.
+ */
+class SystemFrameClock final : public FrameClock
+{
+public:
+    sf::Time restart() override;
+
+private:
+    sf::Clock mClock;
+};
+
+/**
+ * \brief Advances every frame by the same step, whatever time passed.
+ */
+class FixedFrameClock final : public FrameClock
+{
+public:
+    /**
+     * \param step Time step of every frame, by default that of a 60 Hz display
+     */
+    explicit FixedFrameClock(sf::Time step = sf::seconds(1.f / 60));
+
+    sf::Time restart() override;
+
+private:
+    sf::Time mStep;
+};
+
+}// namespace BPlotter
@@ -0,0 +1,70 @@
+#include "FrameScheduler.hpp"
+#include "pch.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace BPlotter
+{
+
+FrameScheduler::FrameScheduler(FrameSchedulerSettings settings)
+    : mSettings(std::move(settings))
+{
+}
+
+std::size_t FrameScheduler::advance(const float frameSeconds,
+                                    const std::function<void(float)>& fixedUpdate)
+{
+    const auto step = static_cast<double>(mSettings.fixedStep);
+    const auto start = std::chrono::steady_clock::now();
+    const auto isOverBudget = [this, &start]
+    {
+        const auto spent = std::chrono::duration<float>(std::chrono::steady_clock::now() - start);
+        return mSettings.fixedUpdateBudget && spent.count() >= *mSettings.fixedUpdateBudget;
+    };
+
+    mAccumulated += frameSeconds;
+    std::size_t steps = 0;
+    while (mAccumulated >= step)
+    {
+        // A due step always runs, so the simulation never stops however slow the frames are
+        if (steps > 0 &&
+            (steps >= std::max<std::size_t>(1, mSettings.maxStepsPerFrame) || isOverBudget()))
+        {
+            const auto dropped = std::floor(mAccumulated / step);
+            mAccumulated -= dropped * step;
+            mStatistics.droppedSteps += static_cast<std::uint64_t>(dropped);
+            ++mStatistics.framesWithDroppedSteps;
+            break;
+        }
+        mAccumulated -= step;
+        fixedUpdate(mSettings.fixedStep);
+        ++steps;
+    }
+
+    ++mStatistics.frames;
+    mStatistics.fixedSteps += steps;
+    mStatistics.compensatedSteps += steps > 1 ? steps - 1 : 0;
+    mStatistics.lastFrameSteps = steps;
+    mStatistics.simulatedSeconds += static_cast<double>(steps) * step;
+    mStatistics.elapsedSeconds += frameSeconds;
+    return steps;
+}
+
+const FrameSchedulerSettings& FrameScheduler::settings() const noexcept
+{
+    return mSettings;
+}
+
+void FrameScheduler::setSettings(const FrameSchedulerSettings& settings)
+{
+    mSettings = settings;
+}
+
+const FrameSchedulerStatistics& FrameScheduler::statistics() const noexcept
+{
+    return mStatistics;
+}
+
+}// namespace BPlotter
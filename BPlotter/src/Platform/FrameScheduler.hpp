@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+
+namespace BPlotter
+{
+
+/**
+ * \brief Limits of the fixed updates run by a single frame.
+ */
+struct FrameSchedulerSettings
+{
+    /**
+     * \brief Time simulated by a single fixed update, in seconds, positive.
+     */
+    float fixedStep = 1.f / 60;
+
+    /**
+     * \brief Most fixed updates a frame runs, however far it is behind. A due update always
+     * runs, so zero is treated as one.
+     */
+    std::size_t maxStepsPerFrame = 4;
+
+    /**
+     * \brief Time a frame may spend in its fixed updates, in seconds; nullopt for no limit,
+     * which keeps the number of the updates independent of the speed of the machine.
+     */
+    std::optional<float> fixedUpdateBudget = 0.008f;
+};
+
+/**
+ * \brief Counters of the scheduler displayed in the performance panel.
+ */
+struct FrameSchedulerStatistics
+{
+    std::uint64_t frames = 0;
+    std::uint64_t fixedSteps = 0;
+
+    /**
+     * \brief Steps a frame ran in addition to its first one, to make up for a slow frame.
+     */
+    std::uint64_t compensatedSteps = 0;
+
+    /**
+     * \brief Steps skipped once a frame ran out of its steps or its budget. Their time is not
+     * simulated, so the simulation falls behind the real time instead of catching up.
+     */
+    std::uint64_t droppedSteps = 0;
+    std::uint64_t framesWithDroppedSteps = 0;
+    std::size_t lastFrameSteps = 0;
+
+    double simulatedSeconds = 0;
+    double elapsedSeconds = 0;
+};
+
+/**
+ * \brief Runs the fixed updates of the frames at equal intervals, independent of the frame
+ * rate, without letting a stall turn into a spiral.
+ *
+ * A slow frame is made up for by running several fixed updates in the next ones. Unbounded,
+ * a long stall would make the next frame run hundreds of updates, which makes it slow too, so
+ * the catch-up is capped by a number of steps and a time budget per frame. The time beyond
+ * them is dropped: the simulation slows down (dilates) for a frame instead of freezing the UI.
+ */
+class FrameScheduler
+{
+public:
+    explicit FrameScheduler(FrameSchedulerSettings settings = {});
+
+    /**
+     * \brief Advances the time by a frame and runs the fixed updates that became due.
+     * \param frameSeconds Time elapsed since the previous frame
+     * \param fixedUpdate Called with the fixed step for every update
+     * \return Number of the fixed updates run
+     */
+    std::size_t advance(float frameSeconds, const std::function<void(float)>& fixedUpdate);
+
+    [[nodiscard]] const FrameSchedulerSettings& settings() const noexcept;
+
+    /**
+     * \brief Changes the limits, keeping the time that is due.
+     * \param settings New limits
+     */
+    void setSettings(const FrameSchedulerSettings& settings);
+
+    [[nodiscard]] const FrameSchedulerStatistics& statistics() const noexcept;
+
+private:
+    FrameSchedulerSettings mSettings;
+    FrameSchedulerStatistics mStatistics;
+
+    /**
+     * \brief Time elapsed and not simulated yet, less than a step between the frames.
+     */
+    double mAccumulated = 0;
+};
+
+}// namespace BPlotter
@@ -0,0 +1,232 @@
+#include "HeadlessWindow.hpp"
+#include "pch.hpp"
+
+#include "Plot/PlotView.hpp"
+
+#include <algorithm>
+#include <cfloat>
+
+namespace BPlotter
+{
+
+namespace
+{
+
+/**
+ * \brief ImGui refuses frames that take no time, which an edited recording may contain.
+ */
+constexpr auto MINIMAL_DELTA_TIME = 1e-6f;
+
+/**
+ * \brief Translates the keys the widgets of ImGui react to, the others are ignored.
+ */
+ImGuiKey toImGuiKey(const sf::Keyboard::Key key)
+{
+    using Key = sf::Keyboard::Key;
+    const auto offset = [key](const Key first)
+    {
+        return static_cast<int>(key) - static_cast<int>(first);
+    };
+    if (key >= Key::A && key <= Key::Z)
+    {
+        return static_cast<ImGuiKey>(ImGuiKey_A + offset(Key::A));
+    }
+    if (key >= Key::Num0 && key <= Key::Num9)
+    {
+        return static_cast<ImGuiKey>(ImGuiKey_0 + offset(Key::Num0));
+    }
+    if (key >= Key::F1 && key <= Key::F12)
+    {
+        return static_cast<ImGuiKey>(ImGuiKey_F1 + offset(Key::F1));
+    }
+
+    switch (key)
+    {
+        case Key::Tab: return ImGuiKey_Tab;
+        case Key::Left: return ImGuiKey_LeftArrow;
+        case Key::Right: return ImGuiKey_RightArrow;
+        case Key::Up: return ImGuiKey_UpArrow;
+        case Key::Down: return ImGuiKey_DownArrow;
+        case Key::PageUp: return ImGuiKey_PageUp;
+        case Key::PageDown: return ImGuiKey_PageDown;
+        case Key::Home: return ImGuiKey_Home;
+        case Key::End: return ImGuiKey_End;
+        case Key::Insert: return ImGuiKey_Insert;
+        case Key::Delete: return ImGuiKey_Delete;
+        case Key::Backspace: return ImGuiKey_Backspace;
+        case Key::Space: return ImGuiKey_Space;
+        case Key::Enter: return ImGuiKey_Enter;
+        case Key::Escape: return ImGuiKey_Escape;
+        case Key::LControl: return ImGuiKey_LeftCtrl;
+        case Key::LShift: return ImGuiKey_LeftShift;
+        case Key::LAlt: return ImGuiKey_LeftAlt;
+        case Key::LSystem: return ImGuiKey_LeftSuper;
+        case Key::RControl: return ImGuiKey_RightCtrl;
+        case Key::RShift: return ImGuiKey_RightShift;
+        case Key::RAlt: return ImGuiKey_RightAlt;
+        case Key::RSystem: return ImGuiKey_RightSuper;
+        default: return ImGuiKey_None;
+    }
+}
+
+template<typename KeyEvent>
+void addKeyEvent(ImGuiIO& io, const KeyEvent& key, const bool isPressed)
+{
+    io.AddKeyEvent(ImGuiMod_Ctrl, key.control);
+    io.AddKeyEvent(ImGuiMod_Shift, key.shift);
+    io.AddKeyEvent(ImGuiMod_Alt, key.alt);
+    io.AddKeyEvent(ImGuiMod_Super, key.system);
+    if (const auto imGuiKey = toImGuiKey(key.code); imGuiKey != ImGuiKey_None)
+    {
+        io.AddKeyEvent(imGuiKey, isPressed);
+    }
+}
+
+}// namespace
+
+HeadlessWindow::HeadlessWindow(const sf::Vector2u size)
+    : mContext(ImGui::CreateContext())
+    , mSize(size)
+{
+    auto& io = ImGui::GetIO();
+    io.BackendPlatformName = "BPlotter headless";
+
+    // The layout of the user is neither read nor overwritten
+    io.IniFilename = nullptr;
+
+    // The atlas is built as the real backend builds it, it is just never uploaded
+    io.Fonts->AddFontDefault();
+    unsigned char* pixels = nullptr;
+    auto width = 0;
+    auto height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    PlotView::setRenderTexturesEnabled(false);
+}
+
+HeadlessWindow::~HeadlessWindow()
+{
+    PlotView::setRenderTexturesEnabled(true);
+    ImGui::DestroyContext(mContext);
+}
+
+void HeadlessWindow::pushEvent(const sf::Event& event)
+{
+    mEvents.push_back(event);
+}
+
+std::size_t HeadlessWindow::frameCount() const noexcept
+{
+    return mFrameCount;
+}
+
+std::optional<sf::Event> HeadlessWindow::pollEvent()
+{
+    if (mEvents.empty())
+    {
+        return std::nullopt;
+    }
+    auto event = mEvents.front();
+    mEvents.pop_front();
+    return event;
+}
+
+bool HeadlessWindow::hasFocus() const
+{
+    return mHasFocus;
+}
+
+sf::Vector2u HeadlessWindow::getSize() const
+{
+    return mSize;
+}
+
+void HeadlessWindow::processImGuiEvent(const sf::Event& event)
+{
+    auto& io = ImGui::GetIO();
+    if (const auto* resized = event.getIf<sf::Event::Resized>())
+    {
+        mSize = resized->size;
+    }
+    else if (event.is<sf::Event::FocusLost>() || event.is<sf::Event::FocusGained>())
+    {
+        mHasFocus = event.is<sf::Event::FocusGained>();
+        io.AddFocusEvent(mHasFocus);
+    }
+    else if (const auto* text = event.getIf<sf::Event::TextEntered>())
+    {
+        // Control characters arrive as the key events
+        if (text->unicode >= ' ' && text->unicode != 127)
+        {
+            io.AddInputCharacter(static_cast<unsigned int>(text->unicode));
+        }
+    }
+    else if (const auto* key = event.getIf<sf::Event::KeyPressed>())
+    {
+        addKeyEvent(io, *key, true);
+    }
+    else if (const auto* key = event.getIf<sf::Event::KeyReleased>())
+    {
+        addKeyEvent(io, *key, false);
+    }
+    else if (const auto* moved = event.getIf<sf::Event::MouseMoved>())
+    {
+        io.AddMousePosEvent(static_cast<float>(moved->position.x),
+                            static_cast<float>(moved->position.y));
+    }
+    else if (const auto* pressed = event.getIf<sf::Event::MouseButtonPressed>())
+    {
+        io.AddMousePosEvent(static_cast<float>(pressed->position.x),
+                            static_cast<float>(pressed->position.y));
+        io.AddMouseButtonEvent(static_cast<int>(pressed->button), true);
+    }
+    else if (const auto* released = event.getIf<sf::Event::MouseButtonReleased>())
+    {
+        io.AddMousePosEvent(static_cast<float>(released->position.x),
+                            static_cast<float>(released->position.y));
+        io.AddMouseButtonEvent(static_cast<int>(released->button), false);
+    }
+    else if (const auto* scrolled = event.getIf<sf::Event::MouseWheelScrolled>())
+    {
+        if (scrolled->wheel == sf::Mouse::Wheel::Vertical)
+        {
+            io.AddMouseWheelEvent(0, scrolled->delta);
+        }
+        else
+        {
+            io.AddMouseWheelEvent(scrolled->delta, 0);
+        }
+    }
+    else if (event.is<sf::Event::MouseLeft>())
+    {
+        io.AddMousePosEvent(-FLT_MAX, -FLT_MAX);
+    }
+}
+
+void HeadlessWindow::updateImGui(const sf::Time& deltaTime,
+                                 const std::optional<sf::Vector2i>& mousePosition)
+{
+    auto& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(static_cast<float>(mSize.x), static_cast<float>(mSize.y));
+    io.DeltaTime = std::max(deltaTime.asSeconds(), MINIMAL_DELTA_TIME);
+    if (mousePosition)
+    {
+        io.AddMousePosEvent(static_cast<float>(mousePosition->x),
+                            static_cast<float>(mousePosition->y));
+    }
+    ImGui::NewFrame();
+}
+
+void HeadlessWindow::render(const StateStack&)
+{
+    // Builds the draw lists of the frame, which is all the work the CPU does for them
+    ImGui::Render();
+    ++mFrameCount;
+}
+
+void HeadlessWindow::close()
+{
+    mEvents.clear();
+}
+
+}// namespace BPlotter
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <deque>
+
+#include "Platform/ApplicationWindow.hpp"
+
+struct ImGuiContext;
+
+namespace BPlotter
+{
+
+/**
+ * \brief Window without a display, so that the frames of the application can be run by the
+ * tests and the benchmarks where there is no display server or GPU.
+ *
+ * ImGui is driven directly rather than through ImGui-SFML, which needs a real window: the
+ * events are translated here, and every frame still builds its ImGui draw lists, which are
+ * never rendered. The states are not drawn, and the plots draw their layers with ImGui
+ * instead of caching them in textures, which would need a graphics context.
+ */
+class HeadlessWindow final : public ApplicationWindow
+{
+public:
+    /**
+     * \brief Creates the ImGui context of the window with its fonts.
+     * \param size Size of the display the frames are laid out for
+     */
+    explicit HeadlessWindow(sf::Vector2u size);
+    HeadlessWindow(const HeadlessWindow&) = delete;
+    HeadlessWindow& operator=(const HeadlessWindow&) = delete;
+    ~HeadlessWindow() override;
+
+    /**
+     * \brief Queues an event to be polled by the application, as if the user did it.
+     * \param event Event to be processed
+     */
+    void pushEvent(const sf::Event& event);
+
+    /**
+     * \brief Number of the frames rendered so far.
+     */
+    [[nodiscard]] std::size_t frameCount() const noexcept;
+
+    [[nodiscard]] std::optional<sf::Event> pollEvent() override;
+    [[nodiscard]] bool hasFocus() const override;
+    [[nodiscard]] sf::Vector2u getSize() const override;
+    void processImGuiEvent(const sf::Event& event) override;
+    void updateImGui(const sf::Time& deltaTime,
+                     const std::optional<sf::Vector2i>& mousePosition) override;
+    void render(const StateStack& states) override;
+    void close() override;
+
+private:
+    ImGuiContext* mContext = nullptr;
+    std::deque<sf::Event> mEvents;
+    sf::Vector2u mSize;
+    bool mHasFocus = true;
+    std::size_t mFrameCount = 0;
+};
+
+}// namespace BPlotter
@@ -0,0 +1,114 @@
+#include "MinMaxPyramid.hpp"
+#include "pch.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+namespace BPlotter
+{
+
+MinMaxPyramid::MinMaxPyramid(std::vector<double> x, std::vector<double> y)
+    : mX(std::move(x))
+    , mY(std::move(y))
+{
+    assert(mX.size() == mY.size());
+    assert(mX.size() <= std::numeric_limits<std::uint32_t>::max());
+
+    // The first level is built out of the points, every next one out of the previous level
+    std::vector<Extremes> previous(mY.size());
+    for (std::uint32_t i = 0; i < previous.size(); ++i)
+    {
+        previous[i] = {i, i};
+    }
+    while (previous.size() > 1)
+    {
+        auto& level = mLevels.emplace_back((previous.size() + 1) / 2);
+        for (std::size_t block = 0; block < level.size(); ++block)
+        {
+            const auto left = previous[2 * block];
+            level[block] = 2 * block + 1 < previous.size() ? merge(left, previous[2 * block + 1])
+                                                            : left;
+        }
+        previous = level;
+    }
+}
+
+void MinMaxPyramid::envelope(const double xMin, const double xMax, const std::size_t buckets,
+                             std::vector<EnvelopePoint>& output) const
+{
+    output.clear();
+    const auto lower = std::ranges::lower_bound(mX, xMin) - mX.begin();
+    const auto upper = std::ranges::upper_bound(mX, xMax) - mX.begin();
+    const auto first = static_cast<std::size_t>(std::max<std::ptrdiff_t>(lower - 1, 0));
+    const auto last = std::min(static_cast<std::size_t>(upper) + 1, mX.size());
+    if (first >= last)
+    {
+        return;
+    }
+
+    // The smallest blocks that still give at most one block per bucket
+    const auto bucketCount = std::max<std::size_t>(buckets, 1);
+    const auto pointsPerBucket = (last - first + bucketCount - 1) / bucketCount;
+    const auto levelIndex = static_cast<std::size_t>(std::bit_width(pointsPerBucket - 1));
+    if (levelIndex == 0 || mLevels.empty())
+    {
+        for (auto i = first; i < last; ++i)
+        {
+            emit(static_cast<std::uint32_t>(i), output);
+        }
+        return;
+    }
+
+    // Level k has blocks of 2^(k+1) points
+    const auto shift = std::min<std::size_t>(levelIndex, mLevels.size());
+    const auto& level = mLevels[shift - 1];
+    for (auto block = first >> shift; block <= (last - 1) >> shift; ++block)
+    {
+        const auto [min, max] = level[block];
+        emit(std::min(min, max), output);
+        if (min != max)
+        {
+            emit(std::max(min, max), output);
+        }
+    }
+}
+
+std::size_t MinMaxPyramid::size() const noexcept
+{
+    return mX.size();
+}
+
+std::size_t MinMaxPyramid::memoryUsage() const noexcept
+{
+    auto bytes = (mX.capacity() + mY.capacity()) * sizeof(double);
+    for (const auto& level: mLevels)
+    {
+        bytes += sizeof(level) + level.capacity() * sizeof(Extremes);
+    }
+    return bytes;
+}
+
+MinMaxPyramid::Extremes MinMaxPyramid::merge(const Extremes left, const Extremes right) const
+{
+    // Comparisons with NaN are false, so a missing value never replaces a present one
+    const auto pick = [this](const std::uint32_t current, const std::uint32_t candidate,
+                             const bool isBetter)
+    {
+        return std::isnan(mY[current]) || (!std::isnan(mY[candidate]) && isBetter) ? candidate
+                                                                                   : current;
+    };
+    return {pick(left.min, right.min, mY[right.min] < mY[left.min]),
+            pick(left.max, right.max, mY[right.max] > mY[left.max])};
+}
+
+void MinMaxPyramid::emit(const std::uint32_t index, std::vector<EnvelopePoint>& output) const
+{
+    if (!std::isnan(mY[index]))
+    {
+        output.push_back({mX[index], mY[index]});
+    }
+}
+
+}// namespace BPlotter
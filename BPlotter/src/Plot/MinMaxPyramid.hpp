@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace BPlotter
+{
+
+/**
+ * \brief Point of a series chosen to represent it at a lower resolution.
+ */
+struct EnvelopePoint
+{
+    double x = 0;
+    double y = 0;
+};
+
+/**
+ * \brief Multi-resolution summary of a series that allows to draw any part of it with
+ * a number of points proportional to the number of pixels rather than to its length.
+ *
+ * Level k splits the points into blocks of 2^(k+1) consecutive points and keeps the points
+ * with the lowest and the highest y of every block. Drawing a line through these extremes in
+ * their original order looks the same as drawing all the points, since the points inside
+ * a block fall into the same column of pixels anyway. All the levels together take about
+ * as much memory as the series itself.
+ *
+ * The pyramid keeps its own copy of the series, so it can be built on another thread
+ * while the series changes.
+ */
+class MinMaxPyramid
+{
+public:
+    MinMaxPyramid() = default;
+
+    /**
+     * \brief Builds all the levels of the pyramid in linear time.
+     * \param x X coordinates of the points, sorted in the ascending order
+     * \param y Y coordinates of the points. NaN marks a missing value.
+     */
+    MinMaxPyramid(std::vector<double> x, std::vector<double> y);
+
+    /**
+     * \brief Computes the points that represent the part of the series between the given
+     * x coordinates. The neighboring points outside of the range are included as well,
+     * so the line leaves the visible range in the right direction.
+     * \param xMin Lowest visible x coordinate
+     * \param xMax Highest visible x coordinate
+     * \param buckets Number of parts (e.g. columns of pixels) the range is displayed in.
+     * At most two points per bucket are produced, plus the ones of partially visible blocks.
+     * \param output Filled with the points in the ascending order of x, skipping missing values
+     */
+    void envelope(double xMin, double xMax, std::size_t buckets,
+                  std::vector<EnvelopePoint>& output) const;
+
+    /**
+     * \brief Number of points of the summarized series.
+     * \return Number of points
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * \brief Estimates the heap memory taken by the copy of the series and all the levels.
+     * \return Number of bytes
+     */
+    [[nodiscard]] std::size_t memoryUsage() const noexcept;
+
+private:
+    /**
+     * \brief Indices of the points with the lowest and the highest y inside a block.
+     * Both point at a NaN only if all the values of the block are missing.
+     */
+    struct Extremes
+    {
+        std::uint32_t min = 0;
+        std::uint32_t max = 0;
+    };
+
+    /**
+     * \brief Picks the extremes out of two sets of candidates, ignoring the missing values.
+     */
+    [[nodiscard]] Extremes merge(Extremes left, Extremes right) const;
+
+    /**
+     * \brief Appends the point unless its value is missing.
+     */
+    void emit(std::uint32_t index, std::vector<EnvelopePoint>& output) const;
+
+    std::vector<double> mX;
+    std::vector<double> mY;
+
+    /**
+     * \brief Level k holds the extremes of the blocks of 2^(k+1) points.
+     */
+    std::vector<std::vector<Extremes>> mLevels;
+};
+
+}// namespace BPlotter
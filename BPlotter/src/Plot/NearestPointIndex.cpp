@@ -0,0 +1,141 @@
+#include "NearestPointIndex.hpp"
+#include "pch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace BPlotter
+{
+
+namespace
+{
+
+/**
+ * \brief Ranges of at most this many points are not split any further, as scanning them is
+ * faster than descending into them.
+ */
+constexpr std::size_t LEAF_SIZE = 8;
+
+}// namespace
+
+NearestPointIndex::NearestPointIndex(const std::span<const double> x,
+                                     const std::span<const double> y)
+{
+    assert(x.size() == y.size());
+    assert(x.size() <= std::numeric_limits<std::uint32_t>::max());
+
+    mPoints.reserve(x.size());
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        if (std::isfinite(x[i]) && std::isfinite(y[i]))
+        {
+            mPoints.push_back({x[i], y[i], static_cast<std::uint32_t>(i)});
+        }
+    }
+    build(0, mPoints.size(), true);
+}
+
+std::optional<NearestPoint> NearestPointIndex::nearest(const double x, const double y,
+                                                       const double scaleX, const double scaleY,
+                                                       const double maxDistance) const
+{
+    Search state{.x = x,
+                 .y = y,
+                 .scaleX = scaleX,
+                 .scaleY = scaleY,
+                 .bestSquaredDistance = maxDistance * maxDistance};
+    search(0, mPoints.size(), true, state);
+    if (not state.best)
+    {
+        return std::nullopt;
+    }
+    const auto& point = mPoints[*state.best];
+    return NearestPoint{point.index, std::sqrt(state.bestSquaredDistance)};
+}
+
+std::size_t NearestPointIndex::size() const noexcept
+{
+    return mPoints.size();
+}
+
+std::size_t NearestPointIndex::memoryUsage() const noexcept
+{
+    return mPoints.capacity() * sizeof(IndexedPoint);
+}
+
+void NearestPointIndex::build(const std::size_t first, const std::size_t last,
+                              const bool isSplitByX)
+{
+    if (last - first <= LEAF_SIZE)
+    {
+        return;
+    }
+
+    const auto middle = first + (last - first) / 2;
+    std::nth_element(mPoints.begin() + static_cast<std::ptrdiff_t>(first),
+                     mPoints.begin() + static_cast<std::ptrdiff_t>(middle),
+                     mPoints.begin() + static_cast<std::ptrdiff_t>(last),
+                     [isSplitByX](const IndexedPoint& left, const IndexedPoint& right)
+                     {
+                         return isSplitByX ? left.x < right.x : left.y < right.y;
+                     });
+    build(first, middle, not isSplitByX);
+    build(middle + 1, last, not isSplitByX);
+}
+
+void NearestPointIndex::search(const std::size_t first, const std::size_t last,
+                               const bool isSplitByX, Search& state) const
+{
+    if (last - first <= LEAF_SIZE)
+    {
+        for (auto i = first; i < last; ++i)
+        {
+            visit(mPoints[i], state);
+        }
+        return;
+    }
+
+    const auto middle = first + (last - first) / 2;
+    const auto& split = mPoints[middle];
+    visit(split, state);
+
+    // The half on the side of the searched position is more likely to hold the nearest point
+    const auto offset = isSplitByX ? (state.x - split.x) * state.scaleX
+                                   : (state.y - split.y) * state.scaleY;
+    if (offset < 0)
+    {
+        search(first, middle, not isSplitByX, state);
+    }
+    else
+    {
+        search(middle + 1, last, not isSplitByX, state);
+    }
+
+    // The other half can only hold a nearer point if it is not farther than the best one
+    if (offset * offset <= state.bestSquaredDistance)
+    {
+        if (offset < 0)
+        {
+            search(middle + 1, last, not isSplitByX, state);
+        }
+        else
+        {
+            search(first, middle, not isSplitByX, state);
+        }
+    }
+}
+
+void NearestPointIndex::visit(const IndexedPoint& point, Search& state) const
+{
+    const auto dx = (point.x - state.x) * state.scaleX;
+    const auto dy = (point.y - state.y) * state.scaleY;
+    if (const auto squaredDistance = dx * dx + dy * dy;
+        squaredDistance <= state.bestSquaredDistance)
+    {
+        state.bestSquaredDistance = squaredDistance;
+        state.best = static_cast<std::size_t>(&point - mPoints.data());
+    }
+}
+
+}// namespace BPlotter
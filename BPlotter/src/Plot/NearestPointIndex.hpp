@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace BPlotter
+{
+
+/**
+ * \brief Point found by NearestPointIndex::nearest().
+ */
+struct NearestPoint
+{
+    /**
+     * \brief Index of the point in the coordinates the index was built from.
+     */
+    std::size_t index = 0;
+
+    /**
+     * \brief Scaled distance of the point from the searched position.
+     */
+    double distance = 0;
+};
+
+/**
+ * \brief Static k-d tree that finds the point nearest to a position in logarithmic time,
+ * e.g. the point under the mouse cursor among millions of points of a plot.
+ *
+ * The tree is built once in the coordinates of the points and can be searched with any
+ * scale of the axes, so it stays valid while the view is zoomed and panned. The nodes are
+ * stored implicitly in a single array: the middle point of every range splits it into its
+ * two halves, alternating between the axes.
+ */
+class NearestPointIndex
+{
+public:
+    NearestPointIndex() = default;
+
+    /**
+     * \brief Builds the tree in O(n log n) time. Points with a non-finite coordinate are left
+     * out, so they are never found.
+     * \param x X coordinates of the points
+     * \param y Y coordinates of the points, as many as the x coordinates
+     */
+    NearestPointIndex(std::span<const double> x, std::span<const double> y);
+
+    /**
+     * \brief Finds the point nearest to the position. The distance is measured after
+     * multiplying the coordinates by the scales, e.g. in pixels when the scales convert
+     * the coordinates to the screen.
+     * \param x X coordinate of the searched position
+     * \param y Y coordinate of the searched position
+     * \param scaleX Scale of the X axis
+     * \param scaleY Scale of the Y axis
+     * \param maxDistance Points farther than this are not considered
+     * \return The nearest point, or nullopt if there is no point close enough
+     */
+    [[nodiscard]] std::optional<NearestPoint> nearest(double x, double y, double scaleX,
+                                                      double scaleY, double maxDistance) const;
+
+    /**
+     * \brief Number of the indexed points.
+     * \return Number of points
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * \brief Estimates the heap memory taken by the tree.
+     * \return Number of bytes
+     */
+    [[nodiscard]] std::size_t memoryUsage() const noexcept;
+
+private:
+    struct IndexedPoint
+    {
+        double x = 0;
+        double y = 0;
+        std::uint32_t index = 0;
+    };
+
+    /**
+     * \brief State of a single search, passed down the recursion.
+     */
+    struct Search
+    {
+        double x = 0;
+        double y = 0;
+        double scaleX = 1;
+        double scaleY = 1;
+        double bestSquaredDistance = 0;
+        std::optional<std::size_t> best;
+    };
+
+    /**
+     * \brief Arranges the points of the range into a subtree split by the given axis.
+     */
+    void build(std::size_t first, std::size_t last, bool isSplitByX);
+
+    /**
+     * \brief Searches the subtree of the range, updating the best point found so far.
+     */
+    void search(std::size_t first, std::size_t last, bool isSplitByX, Search& state) const;
+
+    /**
+     * \brief Makes the point the best one if it is not farther than the best one so far.
+     */
+    void visit(const IndexedPoint& point, Search& state) const;
+
+    std::vector<IndexedPoint> mPoints;
+};
+
+}// namespace BPlotter
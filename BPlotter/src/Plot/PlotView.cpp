@@ -0,0 +1,862 @@
+#include "PlotView.hpp"
+#include "pch.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+
+#include <SFML/OpenGL.hpp>
+
+#include "Memory/AllocationTracker.hpp"
+#include "Utils/FrameArena.hpp"
+
+namespace BPlotter
+{
+
+namespace
+{
+
+/**
+ * \brief Space left around the plot area for the tick labels, in pixels.
+ */
+constexpr float LEFT_MARGIN = 84.f;
+constexpr float BOTTOM_MARGIN = 24.f;
+constexpr float TOP_MARGIN = 8.f;
+constexpr float RIGHT_MARGIN = 12.f;
+
+/**
+ * \brief Approximate number of ticks that are displayed on a single axis.
+ */
+constexpr int TICKS_PER_AXIS = 8;
+
+/**
+ * \brief Most ticks of a single axis, should its ticks be computed for a degenerate range.
+ */
+constexpr std::size_t MAX_TICKS_PER_AXIS = 4 * TICKS_PER_AXIS;
+
+/**
+ * \brief Narrowest visible range relative to the magnitude of its ends, a few thousand ulps,
+ * so the ticks stay distinct.
+ */
+constexpr double MIN_RELATIVE_RANGE = 4096 * std::numeric_limits<double>::epsilon();
+
+/**
+ * \brief Significant digits of the tick labels, which hides the rounding errors of the ticks.
+ */
+constexpr std::uint8_t TICK_PRECISION = 6;
+
+/**
+ * \brief Series with at most this many points have their points marked.
+ */
+constexpr std::size_t MAX_MARKED_POINTS = 200;
+
+/**
+ * \brief Series with at least this many points are drawn out of their level of detail.
+ * Until it is built, only this many evenly spaced points of them are drawn.
+ */
+constexpr std::size_t MIN_LEVEL_OF_DETAIL_POINTS = 16384;
+
+/**
+ * \brief Points farther from the mouse cursor than this many pixels are not hovered.
+ */
+constexpr double MAX_HOVER_DISTANCE = 12.0;
+
+/**
+ * \brief Multisampling of the texture of the static layers, which smooths the series lines.
+ */
+constexpr unsigned int ANTIALIASING_LEVEL = 4;
+
+/**
+ * \brief Number of vertices passed to ImGui at once when the static layers are drawn
+ * without their texture, kept well below the limit of 16-bit indices.
+ */
+constexpr std::size_t VERTICES_PER_BATCH = 3 * 4096;
+
+constexpr std::array<ImU32, 8> SERIES_COLORS = {
+    IM_COL32(189, 147, 249, 255), IM_COL32(80, 250, 123, 255),  IM_COL32(255, 121, 198, 255),
+    IM_COL32(139, 233, 253, 255), IM_COL32(255, 184, 108, 255), IM_COL32(241, 250, 140, 255),
+    IM_COL32(255, 85, 85, 255),   IM_COL32(98, 114, 164, 255),
+};
+
+constexpr ImU32 GRID_COLOR = IM_COL32(255, 255, 255, 28);
+constexpr ImU32 AXIS_COLOR = IM_COL32(255, 255, 255, 90);
+constexpr ImU32 LABEL_COLOR = IM_COL32(255, 255, 255, 200);
+
+/**
+ * \brief Distance between the ticks that is a "nice" number (1, 2 or 5 times a power of ten).
+ */
+double niceTickStep(const double range)
+{
+    const auto roughStep = range / TICKS_PER_AXIS;
+    const auto magnitude = std::pow(10.0, std::floor(std::log10(roughStep)));
+    for (const auto multiplier: {1.0, 2.0, 5.0})
+    {
+        if (roughStep <= multiplier * magnitude)
+        {
+            return multiplier * magnitude;
+        }
+    }
+    return 10.0 * magnitude;
+}
+
+/**
+ * \brief Ticks of the axis in its plot space, valid until the end of the frame. Logarithmic
+ * axes are ticked only at whole powers of ten whenever it is possible.
+ */
+FrameVector<double> ticks(const double min, const double max, const bool isLog)
+{
+    FrameVector<double> result{FrameAllocator<double>(frameArena())};
+    if (not(max > min))
+    {
+        return result;
+    }
+
+    auto step = niceTickStep(max - min);
+    if (isLog && max - min >= 2)
+    {
+        step = std::max(1.0, std::round(step));
+    }
+    for (auto tick = std::ceil(min / step) * step;
+         tick <= max && result.size() < MAX_TICKS_PER_AXIS; tick += step)
+    {
+        result.push_back(tick);
+        // Below the ulp of the ticks, adding the step would not advance them
+        if (tick + step == tick)
+        {
+            break;
+        }
+    }
+    return result;
+}
+
+/**
+ * \brief Draw callback that makes the following ImGui commands expect premultiplied colors,
+ * which is what drawing onto a transparent texture leaves in it.
+ */
+void usePremultipliedAlpha(const ImDrawList*, const ImDrawCmd*)
+{
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+sf::Color toColor(const ImU32 color)
+{
+    return {static_cast<std::uint8_t>(color >> IM_COL32_R_SHIFT),
+            static_cast<std::uint8_t>(color >> IM_COL32_G_SHIFT),
+            static_cast<std::uint8_t>(color >> IM_COL32_B_SHIFT),
+            static_cast<std::uint8_t>(color >> IM_COL32_A_SHIFT)};
+}
+
+/**
+ * \brief Appends the line as two triangles.
+ */
+void appendLine(sf::VertexArray& vertices, const sf::Vector2f from, const sf::Vector2f to,
+                const float thickness, const sf::Color color)
+{
+    const auto direction = to - from;
+    const auto length = std::hypot(direction.x, direction.y);
+    if (length == 0.f)
+    {
+        return;
+    }
+    const auto normal = sf::Vector2f(-direction.y, direction.x) * (thickness / 2.f / length);
+    for (const auto corner:
+         {from + normal, from - normal, to + normal, from - normal, to - normal, to + normal})
+    {
+        vertices.append(sf::Vertex{corner, color});
+    }
+}
+
+/**
+ * \brief Appends the filled circle as a fan of triangles.
+ */
+void appendDisc(sf::VertexArray& vertices, const sf::Vector2f center, const float radius,
+                const sf::Color color)
+{
+    constexpr int SEGMENTS = 8;
+    const auto pointAt = [&](const int segment)
+    {
+        const auto angle = static_cast<float>(segment) * 2.f * std::numbers::pi_v<float> / SEGMENTS;
+        return center + sf::Vector2f(std::cos(angle), std::sin(angle)) * radius;
+    };
+    for (int segment = 0; segment < SEGMENTS; ++segment)
+    {
+        vertices.append(sf::Vertex{center, color});
+        vertices.append(sf::Vertex{pointAt(segment), color});
+        vertices.append(sf::Vertex{pointAt(segment + 1), color});
+    }
+}
+
+/**
+ * \brief Whether the plots may create textures, disabled by the headless window. Only the main
+ * thread draws the plots.
+ */
+bool areRenderTexturesEnabled = true;
+
+}// namespace
+
+PlotView::PlotView(TaskScheduler& scheduler)
+    : mScheduler(&scheduler)
+{
+}
+
+void PlotView::updateImGui(const std::span<const Series> series, const std::uint64_t version,
+                           const std::span<const std::string> xCategories)
+{
+    AllocationScope scope(AllocationSubsystem::Rendering);
+    mSeriesVersion = version;
+
+    // The caches of the series that are no longer displayed are released
+    if (mLevelsOfDetail.size() > series.size())
+    {
+        mLevelsOfDetail.resize(series.size());
+    }
+    if (mHoverIndices.size() > series.size())
+    {
+        mHoverIndices.resize(series.size());
+    }
+    auto isLogX = mIsLogX;
+    auto isLogY = mIsLogY;
+    ImGui::Checkbox("Log X", &isLogX);
+    ImGui::SameLine();
+    ImGui::Checkbox("Log Y", &isLogY);
+    ImGui::SameLine();
+    if (ImGui::Button("Fit"))
+    {
+        requestFit();
+    }
+    setLogScale(isLogX && xCategories.empty(), isLogY);
+
+    if (mIsFitRequested)
+    {
+        fit(series);
+        mIsFitRequested = false;
+    }
+
+    const auto canvasMin = ImGui::GetCursorScreenPos();
+    auto canvasSize = ImGui::GetContentRegionAvail();
+    canvasSize.x = std::max(canvasSize.x, LEFT_MARGIN + RIGHT_MARGIN + 50.f);
+    canvasSize.y = std::max(canvasSize.y, TOP_MARGIN + BOTTOM_MARGIN + 50.f);
+    ImGui::InvisibleButton("PlotCanvas", canvasSize);
+    const auto canvasEnd = ImGui::GetCursorScreenPos();
+
+    // The plot area has a whole number of pixels, so it matches its texture exactly
+    const auto plotSize =
+        sf::Vector2u(static_cast<unsigned int>(canvasSize.x - LEFT_MARGIN - RIGHT_MARGIN),
+                     static_cast<unsigned int>(canvasSize.y - TOP_MARGIN - BOTTOM_MARGIN));
+    const auto plotMin = ImVec2(canvasMin.x + LEFT_MARGIN, canvasMin.y + TOP_MARGIN);
+    const auto plotMax = ImVec2(plotMin.x + static_cast<float>(plotSize.x),
+                                plotMin.y + static_cast<float>(plotSize.y));
+    handleMouse(plotMin, plotMax);
+    updateHover(plotMin, plotMax, series);
+
+    updateStaticLayers(plotSize, series);
+    drawStaticLayers(plotMin, plotMax);
+    drawTickLabels(plotMin, plotMax, xCategories);
+    drawLegend(plotMin, plotMax, series);
+    drawMarkers(plotMin, plotMax);
+    drawHover(plotMin, plotMax, series, xCategories);
+
+    // The texture is drawn as an image on top of the canvas, which moves the cursor
+    ImGui::SetCursorScreenPos(canvasEnd);
+}
+
+void PlotView::setMarkers(std::vector<PlotMarker> markers)
+{
+    mMarkers = std::move(markers);
+}
+
+void PlotView::setAxisFormats(const NumberFormat& x, const NumberFormat& y) noexcept
+{
+    mXFormat = x;
+    mYFormat = y;
+}
+
+void PlotView::requestFit() noexcept
+{
+    mIsFitRequested = true;
+}
+
+void PlotView::setLogScale(const bool isLogX, const bool isLogY) noexcept
+{
+    if (isLogX != mIsLogX || isLogY != mIsLogY)
+    {
+        mIsLogX = isLogX;
+        mIsLogY = isLogY;
+        requestFit();
+    }
+}
+
+PlotViewport PlotView::viewport() const noexcept
+{
+    return {.xMin = mX.min,
+            .xMax = mX.max,
+            .yMin = mY.min,
+            .yMax = mY.max,
+            .isLogX = mIsLogX,
+            .isLogY = mIsLogY};
+}
+
+void PlotView::setViewport(const PlotViewport& viewport) noexcept
+{
+    mX = {viewport.xMin, viewport.xMax};
+    mY = {viewport.yMin, viewport.yMax};
+    mIsLogX = viewport.isLogX;
+    mIsLogY = viewport.isLogY;
+    mIsFitRequested = false;
+}
+
+double PlotView::toPlotSpace(const double value, const bool isLog)
+{
+    return isLog ? std::log10(value) : value;
+}
+
+double PlotView::toDataSpace(const double value, const bool isLog)
+{
+    return isLog ? std::pow(10.0, value) : value;
+}
+
+void PlotView::fit(const std::span<const Series> series)
+{
+    constexpr auto infinity = std::numeric_limits<double>::infinity();
+    Range x{infinity, -infinity};
+    Range y{infinity, -infinity};
+    for (const auto& [name, xs, ys]: series)
+    {
+        for (std::size_t i = 0; i < xs.size(); ++i)
+        {
+            const auto px = toPlotSpace(xs[i], mIsLogX);
+            const auto py = toPlotSpace(ys[i], mIsLogY);
+            if (std::isfinite(px) && std::isfinite(py))
+            {
+                x = {std::min(x.min, px), std::max(x.max, px)};
+                y = {std::min(y.min, py), std::max(y.max, py)};
+            }
+        }
+    }
+
+    const auto withPadding = [](Range range)
+    {
+        if (not std::isfinite(range.min))
+        {
+            return Range{};
+        }
+        const auto padding = range.max > range.min ? (range.max - range.min) * 0.05 : 0.5;
+        return Range{range.min - padding, range.max + padding};
+    };
+    mX = withMinimalWidth(withPadding(x));
+    mY = withMinimalWidth(withPadding(y));
+}
+
+void PlotView::handleMouse(const ImVec2& plotMin, const ImVec2& plotMax)
+{
+    const auto& io = ImGui::GetIO();
+    const auto width = static_cast<double>(plotMax.x - plotMin.x);
+    const auto height = static_cast<double>(plotMax.y - plotMin.y);
+
+    if (ImGui::IsItemActive() && ImGui::IsMouseDragging(ImGuiMouseButton_Left))
+    {
+        const auto dx = io.MouseDelta.x / width * (mX.max - mX.min);
+        const auto dy = io.MouseDelta.y / height * (mY.max - mY.min);
+        mX = withMinimalWidth({mX.min - dx, mX.max - dx});
+        mY = withMinimalWidth({mY.min + dy, mY.max + dy});
+    }
+
+    if (not ImGui::IsItemHovered())
+    {
+        return;
+    }
+
+    if (ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left))
+    {
+        requestFit();
+    }
+
+    if (io.MouseWheel != 0.f)
+    {
+        // Zooms around the point under the cursor, so it stays in place
+        const auto factor = std::pow(0.85, static_cast<double>(io.MouseWheel));
+        const auto anchorX = mX.min + (io.MousePos.x - plotMin.x) / width * (mX.max - mX.min);
+        const auto anchorY = mY.max - (io.MousePos.y - plotMin.y) / height * (mY.max - mY.min);
+        mX = withMinimalWidth(
+            {anchorX + (mX.min - anchorX) * factor, anchorX + (mX.max - anchorX) * factor});
+        mY = withMinimalWidth(
+            {anchorY + (mY.min - anchorY) * factor, anchorY + (mY.max - anchorY) * factor});
+    }
+}
+
+PlotView::Range PlotView::withMinimalWidth(const Range range)
+{
+    const auto magnitude = std::max(std::abs(range.min), std::abs(range.max));
+    const auto minimalWidth =
+        std::max(magnitude * MIN_RELATIVE_RANGE, std::numeric_limits<double>::min());
+    if (not std::isfinite(magnitude) || range.max - range.min >= minimalWidth)
+    {
+        return range;
+    }
+    const auto center = range.min + (range.max - range.min) / 2;
+    return {center - minimalWidth / 2, center + minimalWidth / 2};
+}
+
+void PlotView::updateStaticLayers(const sf::Vector2u size, const std::span<const Series> series)
+{
+    // The candidate keeps its vectors between frames, so an unchanged frame allocates nothing
+    auto& key = mCandidateLayersKey;
+    key.size = size;
+    key.x = mX;
+    key.y = mY;
+    key.isLogX = mIsLogX;
+    key.isLogY = mIsLogY;
+    key.seriesVersion = mSeriesVersion;
+    key.isDetailed.clear();
+    for (std::size_t i = 0; i < series.size(); ++i)
+    {
+        key.isDetailed.push_back(levelOfDetail(i, series[i]) != nullptr);
+    }
+    if (mStaticLayersKey == key)
+    {
+        return;
+    }
+    if (not mStaticLayersKey)
+    {
+        mStaticLayersKey.emplace();
+    }
+    std::swap(*mStaticLayersKey, key);
+    buildStaticLayers(size, series);
+    ++mStaticLayersDrawCount;
+
+    if (areRenderTexturesEnabled && not mIsRenderTextureUnavailable &&
+        (not mStaticLayers || mStaticLayers->getSize() != size))
+    {
+        try
+        {
+            mStaticLayers.emplace(size, sf::ContextSettings{0, 0, ANTIALIASING_LEVEL});
+        }
+        catch (const std::exception& exception)
+        {
+            spdlog::warn("The plot is drawn without caching, its texture can not be created: {}",
+                         exception.what());
+            mStaticLayers.reset();
+            mIsRenderTextureUnavailable = true;
+        }
+    }
+
+    if (mStaticLayers)
+    {
+        // Blending onto the transparent texture multiplies the colors by their alpha
+        mStaticLayers->clear(sf::Color::Transparent);
+        mStaticLayers->draw(mStaticVertices);
+        mStaticLayers->display();
+    }
+}
+
+void PlotView::buildStaticLayers(const sf::Vector2u size, const std::span<const Series> series)
+{
+    mStaticVertices.clear();
+    const auto width = static_cast<float>(size.x);
+    const auto height = static_cast<float>(size.y);
+    const auto scaleX = width / (mX.max - mX.min);
+    const auto scaleY = height / (mY.max - mY.min);
+
+    // Lines are centered on the pixels, like the ones of ImGui
+    const auto axisColor = toColor(AXIS_COLOR);
+    appendLine(mStaticVertices, {0.f, 0.5f}, {width, 0.5f}, 1.f, axisColor);
+    appendLine(mStaticVertices, {0.f, height - 0.5f}, {width, height - 0.5f}, 1.f, axisColor);
+    appendLine(mStaticVertices, {0.5f, 1.f}, {0.5f, height - 1.f}, 1.f, axisColor);
+    appendLine(mStaticVertices, {width - 0.5f, 1.f}, {width - 0.5f, height - 1.f}, 1.f, axisColor);
+
+    const auto gridColor = toColor(GRID_COLOR);
+    for (const auto tick: ticks(mX.min, mX.max, mIsLogX))
+    {
+        const auto x = static_cast<float>((tick - mX.min) * scaleX) + 0.5f;
+        appendLine(mStaticVertices, {x, 0.f}, {x, height}, 1.f, gridColor);
+    }
+    for (const auto tick: ticks(mY.min, mY.max, mIsLogY))
+    {
+        const auto y = height - static_cast<float>((tick - mY.min) * scaleY) + 0.5f;
+        appendLine(mStaticVertices, {0.f, y}, {width, y}, 1.f, gridColor);
+    }
+
+    for (std::size_t i = 0; i < series.size(); ++i)
+    {
+        const auto& [name, xs, ys] = series[i];
+        const auto color = toColor(SERIES_COLORS[i % SERIES_COLORS.size()]);
+
+        mScreenPoints.clear();
+        const auto addPoint = [&](const double dataX, const double dataY)
+        {
+            const auto x = toPlotSpace(dataX, mIsLogX);
+            const auto y = toPlotSpace(dataY, mIsLogY);
+            if (std::isfinite(x) && std::isfinite(y))
+            {
+                mScreenPoints.emplace_back(static_cast<float>((x - mX.min) * scaleX),
+                                           static_cast<float>(height - (y - mY.min) * scaleY));
+            }
+        };
+
+        if (const auto* pyramid = levelOfDetail(i, series[i]))
+        {
+            pyramid->envelope(toDataSpace(mX.min, mIsLogX), toDataSpace(mX.max, mIsLogX),
+                              size.x, mEnvelope);
+            for (const auto& [x, y]: mEnvelope)
+            {
+                addPoint(x, y);
+            }
+        }
+        else
+        {
+            const auto stride = xs.size() / MIN_LEVEL_OF_DETAIL_POINTS + 1;
+            for (std::size_t point = 0; point < xs.size(); point += stride)
+            {
+                addPoint(xs[point], ys[point]);
+            }
+        }
+
+        for (std::size_t point = 1; point < mScreenPoints.size(); ++point)
+        {
+            appendLine(mStaticVertices, mScreenPoints[point - 1], mScreenPoints[point], 1.5f,
+                       color);
+        }
+        if (mScreenPoints.size() <= MAX_MARKED_POINTS)
+        {
+            for (const auto& point: mScreenPoints)
+            {
+                appendDisc(mStaticVertices, point, 2.5f, color);
+            }
+        }
+    }
+}
+
+void PlotView::drawStaticLayers(const ImVec2& plotMin, const ImVec2& plotMax) const
+{
+    auto* drawList = ImGui::GetWindowDrawList();
+    if (mStaticLayers)
+    {
+        drawList->AddCallback(usePremultipliedAlpha, nullptr);
+        ImGui::SetCursorScreenPos(plotMin);
+        ImGui::Image(*mStaticLayers, sf::Vector2f(mStaticLayers->getSize()));
+        drawList->AddCallback(ImDrawCallback_ResetRenderState, nullptr);
+        return;
+    }
+
+    drawList->PushClipRect(plotMin, plotMax, true);
+    const auto whitePixel = ImGui::GetFontTexUvWhitePixel();
+    const auto count = mStaticVertices.getVertexCount();
+    for (std::size_t first = 0; first < count; first += VERTICES_PER_BATCH)
+    {
+        const auto batch = std::min(VERTICES_PER_BATCH, count - first);
+        drawList->PrimReserve(static_cast<int>(batch), static_cast<int>(batch));
+        for (auto i = first; i < first + batch; ++i)
+        {
+            const auto& [position, color, texCoords] = mStaticVertices[i];
+            drawList->PrimWriteIdx(static_cast<ImDrawIdx>(drawList->_VtxCurrentIdx));
+            drawList->PrimWriteVtx({plotMin.x + position.x, plotMin.y + position.y}, whitePixel,
+                                   IM_COL32(color.r, color.g, color.b, color.a));
+        }
+    }
+    drawList->PopClipRect();
+}
+
+void PlotView::drawTickLabels(const ImVec2& plotMin, const ImVec2& plotMax,
+                              const std::span<const std::string> xCategories)
+{
+    auto* drawList = ImGui::GetWindowDrawList();
+    const auto toScreenX = [&](const double x)
+    {
+        return plotMin.x + static_cast<float>((x - mX.min) / (mX.max - mX.min)) *
+                               (plotMax.x - plotMin.x);
+    };
+    const auto toScreenY = [&](const double y)
+    {
+        return plotMax.y - static_cast<float>((y - mY.min) / (mY.max - mY.min)) *
+                               (plotMax.y - plotMin.y);
+    };
+
+    auto xFormat = mXFormat;
+    auto yFormat = mYFormat;
+    xFormat.precision = TICK_PRECISION;
+    yFormat.precision = TICK_PRECISION;
+    for (const auto tick: ticks(mX.min, mX.max, mIsLogX))
+    {
+        const auto x = toScreenX(tick);
+        const char* text = nullptr;
+        if (xCategories.empty())
+        {
+            text = mLabels.format(toDataSpace(tick, mIsLogX), xFormat);
+        }
+        else if (tick >= 0 && tick == std::floor(tick) &&
+                 static_cast<std::size_t>(tick) < xCategories.size())
+        {
+            text = xCategories[static_cast<std::size_t>(tick)].c_str();
+        }
+        else
+        {
+            continue;
+        }
+        const auto textSize = ImGui::CalcTextSize(text);
+        drawList->AddText({x - textSize.x / 2.f, plotMax.y + 4.f}, LABEL_COLOR, text);
+    }
+
+    for (const auto tick: ticks(mY.min, mY.max, mIsLogY))
+    {
+        const auto y = toScreenY(tick);
+        const auto* text = mLabels.format(toDataSpace(tick, mIsLogY), yFormat);
+        const auto textSize = ImGui::CalcTextSize(text);
+        drawList->AddText({plotMin.x - textSize.x - 6.f, y - textSize.y / 2.f}, LABEL_COLOR,
+                          text);
+    }
+}
+
+void PlotView::drawLegend(const ImVec2& plotMin, const ImVec2& plotMax,
+                          const std::span<const Series> series) const
+{
+    auto* drawList = ImGui::GetWindowDrawList();
+    drawList->PushClipRect(plotMin, plotMax, true);
+
+    // Legend in the top left corner of the plot
+    const auto lineHeight = ImGui::GetTextLineHeight();
+    for (std::size_t i = 0; i < series.size(); ++i)
+    {
+        const auto color = SERIES_COLORS[i % SERIES_COLORS.size()];
+        const auto legendY = plotMin.y + 6.f + lineHeight * static_cast<float>(i);
+        const auto legend = ImVec2(plotMin.x + 8.f, legendY);
+        drawList->AddRectFilled({legend.x, legend.y + 3.f},
+                                {legend.x + 10.f, legend.y + lineHeight - 3.f}, color);
+        drawList->AddText({legend.x + 14.f, legend.y}, LABEL_COLOR, series[i].name.c_str());
+    }
+
+    drawList->PopClipRect();
+}
+
+const MinMaxPyramid* PlotView::levelOfDetail(const std::size_t index, const Series& series)
+{
+    if (series.x.size() < MIN_LEVEL_OF_DETAIL_POINTS)
+    {
+        // The series displayed at this index before may have needed one
+        if (index < mLevelsOfDetail.size())
+        {
+            mLevelsOfDetail[index] = {};
+        }
+        return nullptr;
+    }
+
+    if (mLevelsOfDetail.size() <= index)
+    {
+        mLevelsOfDetail.resize(index + 1);
+    }
+    auto& detail = mLevelsOfDetail[index];
+    if (detail.seriesVersion != mSeriesVersion)
+    {
+        // The pyramid copies the points, so the series may change while it is being built
+        detail.pyramid.reset();
+        detail.building = mScheduler->submit(TaskPriority::Interactive,
+                                             [x = series.x, y = series.y]() mutable
+                                             {
+                                                 return MinMaxPyramid(std::move(x), std::move(y));
+                                             });
+        detail.seriesVersion = mSeriesVersion;
+    }
+
+    if (detail.building.valid() &&
+        detail.building.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    {
+        detail.pyramid = detail.building.get();
+    }
+    return detail.pyramid ? &*detail.pyramid : nullptr;
+}
+
+std::size_t PlotView::memoryUsage() const noexcept
+{
+    auto bytes = std::size_t{0};
+    for (const auto& detail: mLevelsOfDetail)
+    {
+        if (detail.pyramid)
+        {
+            bytes += detail.pyramid->memoryUsage();
+        }
+    }
+    for (const auto& hover: mHoverIndices)
+    {
+        if (hover.index)
+        {
+            bytes += hover.index->memoryUsage();
+        }
+    }
+    if (mStaticLayers)
+    {
+        bytes += std::size_t{4} * mStaticLayers->getSize().x * mStaticLayers->getSize().y;
+    }
+    return bytes;
+}
+
+std::size_t PlotView::evictCaches()
+{
+    // The caches still being built hold no memory yet, and dropping them would only start
+    // the same builds again in the next frame
+    for (auto& detail: mLevelsOfDetail)
+    {
+        if (not detail.building.valid())
+        {
+            detail = {};
+        }
+    }
+    for (auto& hover: mHoverIndices)
+    {
+        if (not hover.building.valid())
+        {
+            hover = {};
+        }
+    }
+    return memoryUsage();
+}
+
+std::size_t PlotView::staticLayersDrawCount() const noexcept
+{
+    return mStaticLayersDrawCount;
+}
+
+void PlotView::setRenderTexturesEnabled(const bool isEnabled) noexcept
+{
+    areRenderTexturesEnabled = isEnabled;
+}
+
+void PlotView::drawMarkers(const ImVec2& plotMin, const ImVec2& plotMax) const
+{
+    auto* drawList = ImGui::GetWindowDrawList();
+    drawList->PushClipRect(plotMin, plotMax, true);
+
+    const auto scaleX = (plotMax.x - plotMin.x) / (mX.max - mX.min);
+    const auto scaleY = (plotMax.y - plotMin.y) / (mY.max - mY.min);
+    for (const auto& [x, y, label, color]: mMarkers)
+    {
+        const auto screenX =
+            static_cast<float>(plotMin.x + (toPlotSpace(x, mIsLogX) - mX.min) * scaleX);
+        if (y)
+        {
+            const auto screenY =
+                static_cast<float>(plotMax.y - (toPlotSpace(*y, mIsLogY) - mY.min) * scaleY);
+            drawList->AddCircle({screenX, screenY}, 6.f, color, 0, 2.f);
+            drawList->AddText({screenX + 8.f, screenY - 8.f - ImGui::GetTextLineHeight()}, color,
+                              label.c_str());
+        }
+        else
+        {
+            drawList->AddLine({screenX, plotMin.y}, {screenX, plotMax.y}, color, 1.5f);
+            drawList->AddText({screenX + 4.f, plotMin.y + 4.f}, color, label.c_str());
+        }
+    }
+
+    drawList->PopClipRect();
+}
+
+void PlotView::updateHover(const ImVec2& plotMin, const ImVec2& plotMax,
+                           const std::span<const Series> series)
+{
+    mHoveredPoint.reset();
+    const auto& mouse = ImGui::GetIO().MousePos;
+    if (not ImGui::IsItemHovered() || ImGui::IsItemActive() || mouse.x < plotMin.x ||
+        mouse.y < plotMin.y || mouse.x > plotMax.x || mouse.y > plotMax.y)
+    {
+        return;
+    }
+
+    // The indices are searched in the plot space, scaled to pixels
+    const auto scaleX = (plotMax.x - plotMin.x) / (mX.max - mX.min);
+    const auto scaleY = (plotMax.y - plotMin.y) / (mY.max - mY.min);
+    const auto mouseX = mX.min + (mouse.x - plotMin.x) / scaleX;
+    const auto mouseY = mY.min + (plotMax.y - mouse.y) / scaleY;
+    auto maxDistance = MAX_HOVER_DISTANCE;
+    for (std::size_t i = 0; i < series.size(); ++i)
+    {
+        const auto* index = hoverIndex(i, series[i]);
+        if (not index)
+        {
+            continue;
+        }
+        if (const auto nearest = index->nearest(mouseX, mouseY, scaleX, scaleY, maxDistance))
+        {
+            maxDistance = nearest->distance;
+            mHoveredPoint = HoveredPoint{i, nearest->index};
+        }
+    }
+}
+
+const NearestPointIndex* PlotView::hoverIndex(const std::size_t index, const Series& series)
+{
+    if (mHoverIndices.size() <= index)
+    {
+        mHoverIndices.resize(index + 1);
+    }
+    auto& hover = mHoverIndices[index];
+    if (hover.seriesVersion != mSeriesVersion || hover.isLogX != mIsLogX ||
+        hover.isLogY != mIsLogY)
+    {
+        hover.index.reset();
+        hover.building = mScheduler->submit(TaskPriority::Interactive,
+                                            [x = series.x, y = series.y, isLogX = mIsLogX,
+                                             isLogY = mIsLogY]() mutable
+                                            {
+                                                for (auto& value: x)
+                                                {
+                                                    value = toPlotSpace(value, isLogX);
+                                                }
+                                                for (auto& value: y)
+                                                {
+                                                    value = toPlotSpace(value, isLogY);
+                                                }
+                                                return NearestPointIndex(x, y);
+                                            });
+        hover.seriesVersion = mSeriesVersion;
+        hover.isLogX = mIsLogX;
+        hover.isLogY = mIsLogY;
+    }
+
+    if (hover.building.valid() &&
+        hover.building.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    {
+        hover.index = hover.building.get();
+    }
+    return hover.index ? &*hover.index : nullptr;
+}
+
+void PlotView::drawHover(const ImVec2& plotMin, const ImVec2& plotMax,
+                         const std::span<const Series> series,
+                         const std::span<const std::string> xCategories)
+{
+    if (not mHoveredPoint || mHoveredPoint->series >= series.size())
+    {
+        return;
+    }
+    const auto& [name, xs, ys] = series[mHoveredPoint->series];
+    const auto point = mHoveredPoint->point;
+    if (point >= xs.size())
+    {
+        return;
+    }
+
+    const auto scaleX = (plotMax.x - plotMin.x) / (mX.max - mX.min);
+    const auto scaleY = (plotMax.y - plotMin.y) / (mY.max - mY.min);
+    const auto x = toPlotSpace(xs[point], mIsLogX);
+    const auto y = toPlotSpace(ys[point], mIsLogY);
+    const auto screen = ImVec2(static_cast<float>(plotMin.x + (x - mX.min) * scaleX),
+                               static_cast<float>(plotMax.y - (y - mY.min) * scaleY));
+    const auto color = SERIES_COLORS[mHoveredPoint->series % SERIES_COLORS.size()];
+    ImGui::GetWindowDrawList()->AddCircle(screen, 5.f, color, 0, 2.f);
+
+    ImGui::BeginTooltip();
+    ImGui::TextUnformatted(name.c_str());
+    if (xs[point] >= 0 && xs[point] < static_cast<double>(xCategories.size()))
+    {
+        ImGui::Text("x: %s", xCategories[static_cast<std::size_t>(xs[point])].c_str());
+    }
+    else
+    {
+        ImGui::Text("x: %s", mLabels.format(xs[point], mXFormat));
+    }
+    ImGui::Text("y: %s", mLabels.format(ys[point], mYFormat));
+    ImGui::EndTooltip();
+}
+
+}// namespace BPlotter
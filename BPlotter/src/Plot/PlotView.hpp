@@ -0,0 +1,362 @@
+#pragma once
+
+#include <cstdint>
+#include <future>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <imgui.h>
+
+#include "Plot/MinMaxPyramid.hpp"
+#include "Plot/NearestPointIndex.hpp"
+#include "Plot/PlotViewport.hpp"
+#include "Plot/Series.hpp"
+#include "Tasks/TaskScheduler.hpp"
+#include "Utils/NumberFormat.hpp"
+
+namespace BPlotter
+{
+
+/**
+ * \brief Annotation of the plot at a given x coordinate.
+ */
+struct PlotMarker
+{
+    double x = 0;
+
+    /**
+     * \brief If set, the marker points at a single point of the plot. Otherwise it is
+     * a vertical line spanning the whole height of the plot.
+     */
+    std::optional<double> y;
+
+    std::string label;
+    ImU32 color = IM_COL32(255, 255, 255, 160);
+};
+
+/**
+ * \brief Interactive two-dimensional plot of series drawn with ImGui.
+ *
+ * The plot can be zoomed with the mouse wheel, panned by dragging it with the left mouse
+ * button and fitted back to the data with a double click. Both axes can be switched to
+ * a logarithmic scale, which is what most of the benchmark arguments (powers of two) need.
+ *
+ * Series with many points (e.g. every iteration or a long history) are summarized by
+ * a MinMaxPyramid built by a task of the TaskScheduler, so every frame draws only about as
+ * many points as there are pixels, regardless of the zoom.
+ *
+ * The frame, the grid and the series are rendered into a texture that is drawn again only
+ * when the view, the size of the plot or the series change. Every frame then just draws the
+ * texture and the overlays that are cheap to draw (the labels, the legend and the markers).
+ *
+ * Hovering a point shows its coordinates. The point is looked up in a NearestPointIndex of
+ * every series, which is built in the background when the plot is first hovered and again
+ * only when the series or the scales of the axes change.
+ */
+class PlotView
+{
+public:
+    /**
+     * \param scheduler Scheduler building the pyramids and the hover indices, must outlive
+     * the plot
+     */
+    explicit PlotView(TaskScheduler& scheduler);
+
+    /**
+     * \brief Displays the plot inside the current ImGui window, filling the available space.
+     * \param series Series to be displayed
+     * \param version Version of the series, which must change whenever any of their points
+     * change. The levels of detail, the hover indices and the drawn layers are cached for it,
+     * as new series may well reuse the memory of the previous ones.
+     * \param xCategories Labels of the x coordinates, if the X axis is not numeric
+     */
+    void updateImGui(std::span<const Series> series, std::uint64_t version,
+                     std::span<const std::string> xCategories = {});
+
+    /**
+     * \brief Sets the markers displayed on top of the series until they are set again.
+     * \param markers Markers to be displayed
+     */
+    void setMarkers(std::vector<PlotMarker> markers);
+
+    /**
+     * \brief Sets how the values on the axes are formatted, e.g. with the unit of the column.
+     * \param x Format of the numeric X values
+     * \param y Format of the Y values
+     */
+    void setAxisFormats(const NumberFormat& x, const NumberFormat& y) noexcept;
+
+    /**
+     * \brief The view will be fitted to the displayed data in the next update.
+     */
+    void requestFit() noexcept;
+
+    /**
+     * \brief Switches the axes between the linear and the logarithmic scale.
+     * \param isLogX True if the X axis should be logarithmic
+     * \param isLogY True if the Y axis should be logarithmic
+     */
+    void setLogScale(bool isLogX, bool isLogY) noexcept;
+
+    /**
+     * \brief Returns the visible part of the plot, e.g. to restore it later.
+     * \return Visible ranges and the scales of the axes
+     */
+    [[nodiscard]] PlotViewport viewport() const noexcept;
+
+    /**
+     * \brief Shows the given part of the plot, cancelling any requested fit.
+     * \param viewport Visible ranges and the scales of the axes
+     */
+    void setViewport(const PlotViewport& viewport) noexcept;
+
+    /**
+     * \brief Estimates the memory taken by the levels of detail and the hover indices of the
+     * displayed series and by the texture of the static layers.
+     * \return Number of bytes
+     */
+    [[nodiscard]] std::size_t memoryUsage() const noexcept;
+
+    /**
+     * \brief Releases the built levels of detail and hover indices, which are built again in the
+     * background once the series are displayed again. The ones still being built are kept.
+     * \return Number of bytes still held, see memoryUsage()
+     */
+    std::size_t evictCaches();
+
+    /**
+     * \return Number of times the static layers were drawn, which does not change while they
+     * are cached
+     */
+    [[nodiscard]] std::size_t staticLayersDrawCount() const noexcept;
+
+    /**
+     * \brief Allows or stops caching the static layers of all the plots in textures, which
+     * need a graphics context. Without them, the layers are drawn with ImGui every frame.
+     * \param isEnabled Whether the plots may create the textures
+     */
+    static void setRenderTexturesEnabled(bool isEnabled) noexcept;
+
+private:
+    /**
+     * \brief Visible range of an axis, in the (possibly logarithmic) plot space.
+     */
+    struct Range
+    {
+        bool operator==(const Range&) const = default;
+
+        double min = 0;
+        double max = 1;
+    };
+
+    /**
+     * \brief Everything the static layers are drawn out of. They are drawn again only when
+     * it changes.
+     */
+    struct StaticLayersKey
+    {
+        bool operator==(const StaticLayersKey&) const = default;
+
+        sf::Vector2u size;
+        Range x;
+        Range y;
+        bool isLogX = false;
+        bool isLogY = false;
+        std::uint64_t seriesVersion = 0;
+
+        /**
+         * \brief Whether the series are drawn out of their level of detail or only previewed.
+         */
+        std::vector<bool> isDetailed;
+    };
+
+    /**
+     * \brief Converts the data value to the plot space of the axis.
+     */
+    [[nodiscard]] static double toPlotSpace(double value, bool isLog);
+
+    /**
+     * \brief Converts the value in the plot space of the axis back to the data value.
+     */
+    [[nodiscard]] static double toDataSpace(double value, bool isLog);
+
+    /**
+     * \brief Sets the visible ranges so that all the points of the series are visible.
+     */
+    void fit(std::span<const Series> series);
+
+    /**
+     * \brief Zooms and pans the view according to the mouse input over the plot area.
+     */
+    void handleMouse(const ImVec2& plotMin, const ImVec2& plotMax);
+
+    /**
+     * \brief Widens the range around its center if it is too narrow for its magnitude, as
+     * zooming in further would leave no distinct ticks between its ends.
+     */
+    [[nodiscard]] static Range withMinimalWidth(Range range);
+
+    /**
+     * \brief Draws the static layers again if anything they are drawn out of changed.
+     * \param size Size of the plot area in pixels
+     * \param series Displayed series
+     */
+    void updateStaticLayers(sf::Vector2u size, std::span<const Series> series);
+
+    /**
+     * \brief Builds the triangles of the frame, the grid lines and the series, positioned
+     * relative to the top left corner of the plot area.
+     */
+    void buildStaticLayers(sf::Vector2u size, std::span<const Series> series);
+
+    /**
+     * \brief Draws the static layers onto the plot area, out of the texture if there is one.
+     */
+    void drawStaticLayers(const ImVec2& plotMin, const ImVec2& plotMax) const;
+
+    /**
+     * \brief Draws the tick labels of both axes.
+     */
+    void drawTickLabels(const ImVec2& plotMin, const ImVec2& plotMax,
+                        std::span<const std::string> xCategories);
+
+    /**
+     * \brief Draws the names of the series next to their colors.
+     */
+    void drawLegend(const ImVec2& plotMin, const ImVec2& plotMax,
+                    std::span<const Series> series) const;
+
+    /**
+     * \brief Returns the level of detail of the series, starting to build it if the series
+     * changed since it was last drawn.
+     * \param index Index of the series among the displayed ones
+     * \param series Displayed series
+     * \return The built level of detail, or nullptr if the series is small enough to be drawn
+     * directly or its level of detail is not built yet
+     */
+    const MinMaxPyramid* levelOfDetail(std::size_t index, const Series& series);
+
+    /**
+     * \brief Draws the markers with their labels.
+     */
+    void drawMarkers(const ImVec2& plotMin, const ImVec2& plotMax) const;
+
+    /**
+     * \brief Finds the point nearest to the mouse cursor, if it hovers the plot area.
+     */
+    void updateHover(const ImVec2& plotMin, const ImVec2& plotMax, std::span<const Series> series);
+
+    /**
+     * \brief Returns the hover index of the series, starting to build it if the series or
+     * the scales of the axes changed since it was built.
+     * \param index Index of the series among the displayed ones
+     * \param series Displayed series
+     * \return The built index, or nullptr if it is not built yet
+     */
+    const NearestPointIndex* hoverIndex(std::size_t index, const Series& series);
+
+    /**
+     * \brief Highlights the hovered point and shows its coordinates in a tooltip.
+     */
+    void drawHover(const ImVec2& plotMin, const ImVec2& plotMax, std::span<const Series> series,
+                   std::span<const std::string> xCategories);
+
+    /**
+     * \brief Pointer rather than reference, so that the panels owning a plot can be reset
+     * by assigning them.
+     */
+    TaskScheduler* mScheduler;
+    Range mX;
+    Range mY;
+    bool mIsLogX = false;
+    bool mIsLogY = false;
+    bool mIsFitRequested = true;
+
+    /**
+     * \brief Version of the displayed series, see updateImGui().
+     */
+    std::uint64_t mSeriesVersion = 0;
+    std::vector<PlotMarker> mMarkers;
+    NumberFormat mXFormat;
+    NumberFormat mYFormat;
+
+    /**
+     * \brief Formatted tick labels, which mostly stay the same from frame to frame.
+     */
+    FormattedNumberCache mLabels;
+
+    /**
+     * \brief Level of detail of a displayed series with many points.
+     */
+    struct LevelOfDetail
+    {
+        /**
+         * \brief Version of the series the pyramid is built for.
+         */
+        std::optional<std::uint64_t> seriesVersion;
+        std::future<MinMaxPyramid> building;
+        std::optional<MinMaxPyramid> pyramid;
+    };
+
+    /**
+     * \brief Index of the points of a displayed series in the plot space of the axes.
+     */
+    struct HoverIndex
+    {
+        std::optional<std::uint64_t> seriesVersion;
+        bool isLogX = false;
+        bool isLogY = false;
+        std::future<NearestPointIndex> building;
+        std::optional<NearestPointIndex> index;
+    };
+
+    struct HoveredPoint
+    {
+        std::size_t series = 0;
+        std::size_t point = 0;
+    };
+
+    /**
+     * \brief Hover indices of the displayed series, indexed like the series.
+     */
+    std::vector<HoverIndex> mHoverIndices;
+    std::optional<HoveredPoint> mHoveredPoint;
+
+    /**
+     * \brief Positions of the points of the drawn series within the plot area, reused between
+     * the builds of the static layers.
+     */
+    std::vector<sf::Vector2f> mScreenPoints;
+
+    /**
+     * \brief Levels of detail of the displayed series, indexed like the series.
+     */
+    std::vector<LevelOfDetail> mLevelsOfDetail;
+
+    /**
+     * \brief Points of the level of detail of the drawn series, reused between frames.
+     */
+    std::vector<EnvelopePoint> mEnvelope;
+
+    std::optional<StaticLayersKey> mStaticLayersKey;
+    std::size_t mStaticLayersDrawCount = 0;
+
+    /**
+     * \brief Key of the current frame, compared to the key of the drawn layers.
+     */
+    StaticLayersKey mCandidateLayersKey;
+    sf::VertexArray mStaticVertices{sf::PrimitiveType::Triangles};
+
+    /**
+     * \brief Static layers rendered with premultiplied alpha. If the texture can not be
+     * created, the vertices are drawn with ImGui every frame instead.
+     */
+    std::optional<sf::RenderTexture> mStaticLayers;
+    bool mIsRenderTextureUnavailable = false;
+};
+
+}// namespace BPlotter
@@ -0,0 +1,22 @@
+#pragma once
+
+namespace BPlotter
+{
+
+/**
+ * \brief Visible part of a plot. The ranges are in the plot space, i.e. they hold the decimal
+ * logarithms of the values if the axis is logarithmic.
+ */
+struct PlotViewport
+{
+    double xMin = 0;
+    double xMax = 1;
+    double yMin = 0;
+    double yMax = 1;
+    bool isLogX = false;
+    bool isLogY = false;
+
+    bool operator==(const PlotViewport&) const = default;
+};
+
+}// namespace BPlotter
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace BPlotter
+{
+
+/**
+ * \brief A named sequence of points that can be displayed on a plot.
+ *
+ * Points are stored as two separate vectors of coordinates of equal length,
+ * sorted by the x coordinate.
+ */
+struct Series
+{
+    std::string name;
+    std::vector<double> x;
+    std::vector<double> y;
+};
+
+}// namespace BPlotter
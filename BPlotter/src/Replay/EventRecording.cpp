@@ -0,0 +1,339 @@
+#include "EventRecording.hpp"
+#include "pch.hpp"
+
+#include <sstream>
+
+namespace BPlotter
+{
+
+namespace
+{
+
+/**
+ * \brief First line of a recording, changed whenever the format changes.
+ */
+constexpr auto RECORDING_HEADER = "BPlotterEvents 1";
+constexpr std::string_view FRAME_PREFIX = "frame ";
+
+bool isRecorded(const sf::Event& event)
+{
+    return event.is<sf::Event::Closed>() || event.is<sf::Event::Resized>() ||
+           event.is<sf::Event::FocusLost>() || event.is<sf::Event::FocusGained>() ||
+           event.is<sf::Event::TextEntered>() || event.is<sf::Event::KeyPressed>() ||
+           event.is<sf::Event::KeyReleased>() || event.is<sf::Event::MouseWheelScrolled>() ||
+           event.is<sf::Event::MouseButtonPressed>() ||
+           event.is<sf::Event::MouseButtonReleased>() || event.is<sf::Event::MouseMoved>() ||
+           event.is<sf::Event::MouseEntered>() || event.is<sf::Event::MouseLeft>();
+}
+
+template<typename KeyEvent>
+std::string keyLine(const std::string_view type, const KeyEvent& key)
+{
+    return fmt::format("{} {} {} {:d} {:d} {:d} {:d}", type, static_cast<int>(key.code),
+                       static_cast<int>(key.scancode), key.alt, key.control, key.shift,
+                       key.system);
+}
+
+template<typename ButtonEvent>
+std::string buttonLine(const std::string_view type, const ButtonEvent& button)
+{
+    return fmt::format("{} {} {} {}", type, static_cast<int>(button.button), button.position.x,
+                       button.position.y);
+}
+
+/**
+ * \brief Reads the fields of a key event, checking the enumerations are in their range.
+ */
+template<typename KeyEvent>
+std::optional<KeyEvent> readKey(std::istream& fields)
+{
+    auto code = 0;
+    auto scancode = 0;
+    KeyEvent key;
+    fields >> code >> scancode >> key.alt >> key.control >> key.shift >> key.system;
+    if (code < -1 || code >= static_cast<int>(sf::Keyboard::KeyCount) || scancode < -1 ||
+        scancode >= static_cast<int>(sf::Keyboard::ScancodeCount))
+    {
+        return std::nullopt;
+    }
+    key.code = static_cast<sf::Keyboard::Key>(code);
+    key.scancode = static_cast<sf::Keyboard::Scancode>(scancode);
+    return key;
+}
+
+template<typename ButtonEvent>
+std::optional<ButtonEvent> readButton(std::istream& fields)
+{
+    auto button = 0;
+    ButtonEvent event;
+    fields >> button >> event.position.x >> event.position.y;
+    if (button < 0 || button >= static_cast<int>(sf::Mouse::ButtonCount))
+    {
+        return std::nullopt;
+    }
+    event.button = static_cast<sf::Mouse::Button>(button);
+    return event;
+}
+
+}// namespace
+
+void EventRecording::beginFrame(const float deltaTime)
+{
+    mFrames.push_back({deltaTime, {}});
+}
+
+void EventRecording::record(const sf::Event& event)
+{
+    if (not isRecorded(event))
+    {
+        return;
+    }
+    // Events that come before any frame belong to the first one
+    if (mFrames.empty())
+    {
+        beginFrame(0);
+    }
+    mFrames.back().events.push_back(event);
+}
+
+std::span<const RecordedFrame> EventRecording::frames() const noexcept
+{
+    return mFrames;
+}
+
+std::size_t EventRecording::eventCount() const noexcept
+{
+    auto count = std::size_t{0};
+    for (const auto& frame: mFrames)
+    {
+        count += frame.events.size();
+    }
+    return count;
+}
+
+cpp::result<void, std::string> EventRecording::write(std::ostream& output) const
+{
+    output << RECORDING_HEADER << '\n';
+    for (const auto& frame: mFrames)
+    {
+        output << FRAME_PREFIX << fmt::format("{}", frame.deltaTime) << '\n';
+        for (const auto& event: frame.events)
+        {
+            output << *toRecordedLine(event) << '\n';
+        }
+    }
+    if (not output)
+    {
+        return cpp::fail(std::string("Unable to write the event recording"));
+    }
+    return {};
+}
+
+cpp::result<EventRecording, std::string> EventRecording::read(std::istream& input)
+{
+    std::string line;
+    const auto readLine = [&input, &line]
+    {
+        if (not std::getline(input, line))
+        {
+            return false;
+        }
+        // Recordings edited on Windows keep their line endings
+        if (line.ends_with('\r'))
+        {
+            line.pop_back();
+        }
+        return true;
+    };
+    if (not readLine() || line != RECORDING_HEADER)
+    {
+        return cpp::fail(std::string("Not an event recording or written by another version"));
+    }
+
+    EventRecording recording;
+    for (auto lineNumber = 2; readLine(); ++lineNumber)
+    {
+        if (line.empty())
+        {
+            continue;
+        }
+
+        if (line.starts_with(FRAME_PREFIX))
+        {
+            std::istringstream fields(line.substr(FRAME_PREFIX.size()));
+            auto deltaTime = 0.f;
+            if (not(fields >> deltaTime) || deltaTime < 0 || not(fields >> std::ws).eof())
+            {
+                return cpp::fail(fmt::format("Line {}: invalid frame '{}'", lineNumber, line));
+            }
+            recording.beginFrame(deltaTime);
+            continue;
+        }
+
+        if (recording.mFrames.empty())
+        {
+            return cpp::fail(fmt::format("Line {}: event before the first frame", lineNumber));
+        }
+        auto event = fromRecordedLine(line);
+        if (not event)
+        {
+            return cpp::fail(fmt::format("Line {}: invalid event '{}'", lineNumber, line));
+        }
+        recording.mFrames.back().events.push_back(*event);
+    }
+    return recording;
+}
+
+std::optional<std::string> toRecordedLine(const sf::Event& event)
+{
+    if (event.is<sf::Event::Closed>())
+    {
+        return "Closed";
+    }
+    if (const auto* resized = event.getIf<sf::Event::Resized>())
+    {
+        return fmt::format("Resized {} {}", resized->size.x, resized->size.y);
+    }
+    if (event.is<sf::Event::FocusLost>())
+    {
+        return "FocusLost";
+    }
+    if (event.is<sf::Event::FocusGained>())
+    {
+        return "FocusGained";
+    }
+    if (const auto* text = event.getIf<sf::Event::TextEntered>())
+    {
+        return fmt::format("TextEntered {}", static_cast<std::uint32_t>(text->unicode));
+    }
+    if (const auto* key = event.getIf<sf::Event::KeyPressed>())
+    {
+        return keyLine("KeyPressed", *key);
+    }
+    if (const auto* key = event.getIf<sf::Event::KeyReleased>())
+    {
+        return keyLine("KeyReleased", *key);
+    }
+    if (const auto* wheel = event.getIf<sf::Event::MouseWheelScrolled>())
+    {
+        return fmt::format("MouseWheelScrolled {} {} {} {}", static_cast<int>(wheel->wheel),
+                           wheel->delta, wheel->position.x, wheel->position.y);
+    }
+    if (const auto* button = event.getIf<sf::Event::MouseButtonPressed>())
+    {
+        return buttonLine("MouseButtonPressed", *button);
+    }
+    if (const auto* button = event.getIf<sf::Event::MouseButtonReleased>())
+    {
+        return buttonLine("MouseButtonReleased", *button);
+    }
+    if (const auto* moved = event.getIf<sf::Event::MouseMoved>())
+    {
+        return fmt::format("MouseMoved {} {}", moved->position.x, moved->position.y);
+    }
+    if (event.is<sf::Event::MouseEntered>())
+    {
+        return "MouseEntered";
+    }
+    if (event.is<sf::Event::MouseLeft>())
+    {
+        return "MouseLeft";
+    }
+    return std::nullopt;
+}
+
+std::optional<sf::Event> fromRecordedLine(const std::string_view line)
+{
+    std::istringstream fields{std::string(line)};
+    std::string type;
+    fields >> type;
+
+    // Missing or trailing fields mean the line is not what it claims to be
+    const auto complete = [&fields](const auto& event) -> std::optional<sf::Event>
+    {
+        if (fields.fail() || not(fields >> std::ws).eof())
+        {
+            return std::nullopt;
+        }
+        return sf::Event(event);
+    };
+    const auto completeIf = [&complete](const auto& event) -> std::optional<sf::Event>
+    {
+        if (not event)
+        {
+            return std::nullopt;
+        }
+        return complete(*event);
+    };
+
+    if (type == "Closed")
+    {
+        return complete(sf::Event::Closed{});
+    }
+    if (type == "Resized")
+    {
+        sf::Event::Resized resized;
+        fields >> resized.size.x >> resized.size.y;
+        return complete(resized);
+    }
+    if (type == "FocusLost")
+    {
+        return complete(sf::Event::FocusLost{});
+    }
+    if (type == "FocusGained")
+    {
+        return complete(sf::Event::FocusGained{});
+    }
+    if (type == "TextEntered")
+    {
+        auto unicode = std::uint32_t{0};
+        fields >> unicode;
+        return complete(sf::Event::TextEntered{static_cast<char32_t>(unicode)});
+    }
+    if (type == "KeyPressed")
+    {
+        return completeIf(readKey<sf::Event::KeyPressed>(fields));
+    }
+    if (type == "KeyReleased")
+    {
+        return completeIf(readKey<sf::Event::KeyReleased>(fields));
+    }
+    if (type == "MouseWheelScrolled")
+    {
+        auto wheel = 0;
+        sf::Event::MouseWheelScrolled scrolled;
+        fields >> wheel >> scrolled.delta >> scrolled.position.x >> scrolled.position.y;
+        if (wheel != static_cast<int>(sf::Mouse::Wheel::Vertical) &&
+            wheel != static_cast<int>(sf::Mouse::Wheel::Horizontal))
+        {
+            return std::nullopt;
+        }
+        scrolled.wheel = static_cast<sf::Mouse::Wheel>(wheel);
+        return complete(scrolled);
+    }
+    if (type == "MouseButtonPressed")
+    {
+        return completeIf(readButton<sf::Event::MouseButtonPressed>(fields));
+    }
+    if (type == "MouseButtonReleased")
+    {
+        return completeIf(readButton<sf::Event::MouseButtonReleased>(fields));
+    }
+    if (type == "MouseMoved")
+    {
+        sf::Event::MouseMoved moved;
+        fields >> moved.position.x >> moved.position.y;
+        return complete(moved);
+    }
+    if (type == "MouseEntered")
+    {
+        return complete(sf::Event::MouseEntered{});
+    }
+    if (type == "MouseLeft")
+    {
+        return complete(sf::Event::MouseLeft{});
+    }
+    return std::nullopt;
+}
+
+}// namespace BPlotter
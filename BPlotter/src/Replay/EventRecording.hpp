@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <SFML/Window/Event.hpp>
+#include <result.hpp>
+
+namespace BPlotter
+{
+
+/**
+ * \brief Events processed by the application during a single frame.
+ */
+struct RecordedFrame
+{
+    /**
+     * \brief Time passed since the previous frame, which the replay uses instead of the clock.
+     */
+    float deltaTime = 0;
+    std::vector<sf::Event> events;
+};
+
+/**
+ * \brief Stream of the window events processed by the application, frame by frame, so that
+ * a real user session (opening a file, filtering, zooming, comparing) can be replayed with
+ * the same timing to measure the frames reproducibly.
+ *
+ * Recordings are stored as text with a frame or an event per line, so they can be reviewed
+ * and edited by hand. Only the events of the keyboard, the mouse and the window are
+ * recorded; joysticks, touches and sensors are ignored by the application anyway.
+ */
+class EventRecording
+{
+public:
+    /**
+     * \brief Starts a new frame, to which the following events belong.
+     * \param deltaTime Time passed since the previous frame, in seconds
+     */
+    void beginFrame(float deltaTime);
+
+    /**
+     * \brief Appends the event to the current frame, ignoring the events that are not recorded.
+     * \param event Event processed by the application
+     */
+    void record(const sf::Event& event);
+
+    [[nodiscard]] std::span<const RecordedFrame> frames() const noexcept;
+    [[nodiscard]] std::size_t eventCount() const noexcept;
+
+    /**
+     * \brief Writes the recording as text.
+     * \param output Text output stream
+     * \return Nothing or an error message if the stream failed
+     */
+    cpp::result<void, std::string> write(std::ostream& output) const;
+
+    /**
+     * \brief Reads a recording written by write().
+     * \param input Text input stream
+     * \return Read recording or an error message pointing at the invalid line
+     */
+    static cpp::result<EventRecording, std::string> read(std::istream& input);
+
+private:
+    std::vector<RecordedFrame> mFrames;
+};
+
+/**
+ * \brief Converts the event to a line of the recording.
+ * \param event Window event
+ * \return Line describing the event, nullopt if the event is not recorded
+ */
+std::optional<std::string> toRecordedLine(const sf::Event& event);
+
+/**
+ * \brief Reads the event from a line of the recording.
+ * \param line Line written by toRecordedLine()
+ * \return Event, nullopt if the line does not describe a valid event
+ */
+std::optional<sf::Event> fromRecordedLine(std::string_view line);
+
+}// namespace BPlotter
@@ -0,0 +1,55 @@
+#include "FrameTimings.hpp"
+#include "pch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace BPlotter
+{
+
+void FrameTimings::record(const float seconds)
+{
+    mSeconds.push_back(seconds);
+}
+
+std::size_t FrameTimings::frameCount() const noexcept
+{
+    return mSeconds.size();
+}
+
+float FrameTimings::percentile(const double fraction) const
+{
+    if (mSeconds.empty())
+    {
+        return 0;
+    }
+    const auto rank = static_cast<std::size_t>(
+        std::ceil(std::clamp(fraction, 0.0, 1.0) * static_cast<double>(mSeconds.size())));
+    const auto index = std::max<std::size_t>(rank, 1) - 1;
+    auto sorted = mSeconds;
+    const auto nth = sorted.begin() + static_cast<std::ptrdiff_t>(index);
+    std::nth_element(sorted.begin(), nth, sorted.end());
+    return *nth;
+}
+
+float FrameTimings::mean() const noexcept
+{
+    if (mSeconds.empty())
+    {
+        return 0;
+    }
+    return std::accumulate(mSeconds.begin(), mSeconds.end(), 0.f) /
+           static_cast<float>(mSeconds.size());
+}
+
+void FrameTimings::exportCsv(std::ostream& output) const
+{
+    output << "frame,milliseconds\n";
+    for (std::size_t frame = 0; frame < mSeconds.size(); ++frame)
+    {
+        output << frame << ',' << mSeconds[frame] * 1000.f << '\n';
+    }
+}
+
+}// namespace BPlotter
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+namespace BPlotter
+{
+
+/**
+ * \brief Durations of all the frames of a replayed session, summarized by percentiles so
+ * that the sessions can be compared between the builds.
+ */
+class FrameTimings
+{
+public:
+    /**
+     * \brief Appends the duration of a frame.
+     * \param seconds Time spent building and rendering the frame
+     */
+    void record(float seconds);
+
+    [[nodiscard]] std::size_t frameCount() const noexcept;
+
+    /**
+     * \brief Duration not exceeded by the given fraction of the frames (nearest rank).
+     * \param fraction Fraction of the frames, e.g. 0.99 for the 99th percentile
+     * \return Duration in seconds, zero if there are no frames
+     */
+    [[nodiscard]] float percentile(double fraction) const;
+
+    /**
+     * \brief Mean duration of a frame.
+     * \return Duration in seconds, zero if there are no frames
+     */
+    [[nodiscard]] float mean() const noexcept;
+
+    /**
+     * \brief Writes the durations as CSV, one row per frame.
+     * \param output Stream the CSV is written to
+     */
+    void exportCsv(std::ostream& output) const;
+
+private:
+    std::vector<float> mSeconds;
+};
+
+}// namespace BPlotter
@@ -0,0 +1,230 @@
+#include "SessionSnapshot.hpp"
+#include "pch.hpp"
+
+#include "Benchmark/ShardMerge.hpp"
+#include "Utils/BinaryIo.hpp"
+
+namespace BPlotter
+{
+
+namespace
+{
+
+constexpr std::uint32_t SESSION_MAGIC = 0x53535042;// "BPSS"
+constexpr std::uint32_t SESSION_VERSION = 1;
+
+void writeRun(std::ostream& output, const SessionRun& run)
+{
+    writeString(output, run.source);
+    writeString(output, run.cacheKey);
+}
+
+bool readRun(std::istream& input, SessionRun& run)
+{
+    return readString(input, run.source) && readString(input, run.cacheKey);
+}
+
+void writeDimension(std::ostream& output, const Dimension& dimension)
+{
+    writeValue(output, static_cast<std::uint8_t>(dimension.kind));
+    writeValue(output, static_cast<std::uint64_t>(dimension.index));
+    writeString(output, dimension.key);
+}
+
+bool readDimension(std::istream& input, Dimension& dimension)
+{
+    auto kind = std::uint8_t{0};
+    auto index = std::uint64_t{0};
+    if (!readValue(input, kind) || !readValue(input, index) ||
+        !readString(input, dimension.key) ||
+        kind > static_cast<std::uint8_t>(DimensionKind::Column))
+    {
+        return false;
+    }
+    dimension.kind = static_cast<DimensionKind>(kind);
+    dimension.index = static_cast<std::size_t>(index);
+    return true;
+}
+
+void writeBool(std::ostream& output, const bool value)
+{
+    writeValue(output, static_cast<std::uint8_t>(value));
+}
+
+bool readBool(std::istream& input, bool& value)
+{
+    auto byte = std::uint8_t{0};
+    if (!readValue(input, byte))
+    {
+        return false;
+    }
+    value = byte != 0;
+    return true;
+}
+
+}// namespace
+
+cpp::result<void, std::string> writeSession(const SessionSnapshot& snapshot,
+                                            std::ostream& output)
+{
+    writeValue(output, SESSION_MAGIC);
+    writeValue(output, SESSION_VERSION);
+
+    writeBool(output, snapshot.displayedRun.has_value());
+    if (snapshot.displayedRun)
+    {
+        writeRun(output, *snapshot.displayedRun);
+    }
+    writeValue(output, static_cast<std::uint32_t>(snapshot.storedRuns.size()));
+    for (const auto& run: snapshot.storedRuns)
+    {
+        writeRun(output, run);
+    }
+
+    writeString(output, snapshot.filter);
+    writeBool(output, snapshot.isRegexFilter);
+
+    const auto& key = snapshot.pivotKey;
+    writeDimension(output, key.x);
+    writeValue(output, static_cast<std::uint64_t>(key.y));
+    writeDimension(output, key.group);
+    writeValue(output, static_cast<std::uint8_t>(key.aggregation));
+    writeString(output, key.aggregateName);
+    writeString(output, key.nameFilter);
+    writeBool(output, snapshot.isPivotFiltered);
+
+    const auto& viewport = snapshot.plotViewport;
+    for (const auto value: {viewport.xMin, viewport.xMax, viewport.yMin, viewport.yMax})
+    {
+        writeValue(output, value);
+    }
+    writeBool(output, viewport.isLogX);
+    writeBool(output, viewport.isLogY);
+
+    writeValue(output, static_cast<std::uint32_t>(snapshot.derivedMetrics.size()));
+    for (const auto& metric: snapshot.derivedMetrics)
+    {
+        writeString(output, metric.name);
+        writeString(output, metric.expression);
+    }
+    writeValue(output, static_cast<std::uint64_t>(snapshot.memoryLimit));
+
+    if (!output)
+    {
+        return cpp::fail(std::string("Unable to write the session"));
+    }
+    return {};
+}
+
+cpp::result<SessionSnapshot, std::string> readSession(std::istream& input)
+{
+    auto magic = std::uint32_t{0};
+    auto version = std::uint32_t{0};
+    if (!readValue(input, magic) || !readValue(input, version) || magic != SESSION_MAGIC ||
+        version != SESSION_VERSION)
+    {
+        return cpp::fail(std::string("Not a session or written by another version"));
+    }
+
+    SessionSnapshot snapshot;
+    auto isGood = true;
+    const auto read = [&isGood](const bool isRead)
+    {
+        isGood = isGood && isRead;
+        return isGood;
+    };
+
+    auto hasDisplayedRun = false;
+    if (read(readBool(input, hasDisplayedRun)) && hasDisplayedRun)
+    {
+        read(readRun(input, snapshot.displayedRun.emplace()));
+    }
+    auto storedRuns = std::uint32_t{0};
+    read(readValue(input, storedRuns));
+    for (std::uint32_t i = 0; i < storedRuns && isGood; ++i)
+    {
+        read(readRun(input, snapshot.storedRuns.emplace_back()));
+    }
+
+    read(readString(input, snapshot.filter));
+    read(readBool(input, snapshot.isRegexFilter));
+
+    auto& key = snapshot.pivotKey;
+    auto y = std::uint64_t{0};
+    auto aggregation = std::uint8_t{0};
+    read(readDimension(input, key.x));
+    read(readValue(input, y));
+    read(readDimension(input, key.group));
+    read(readValue(input, aggregation));
+    read(readString(input, key.aggregateName));
+    read(readString(input, key.nameFilter));
+    read(readBool(input, snapshot.isPivotFiltered));
+    key.y = static_cast<ColumnIndex>(y);
+    key.aggregation = static_cast<Aggregation>(aggregation);
+    read(aggregation <= static_cast<std::uint8_t>(Aggregation::Count));
+
+    auto& viewport = snapshot.plotViewport;
+    for (auto* value: {&viewport.xMin, &viewport.xMax, &viewport.yMin, &viewport.yMax})
+    {
+        read(readValue(input, *value));
+    }
+    read(readBool(input, viewport.isLogX));
+    read(readBool(input, viewport.isLogY));
+
+    auto metrics = std::uint32_t{0};
+    read(readValue(input, metrics));
+    for (std::uint32_t i = 0; i < metrics && isGood; ++i)
+    {
+        auto& metric = snapshot.derivedMetrics.emplace_back();
+        read(readString(input, metric.name) && readString(input, metric.expression));
+    }
+    auto memoryLimit = std::uint64_t{0};
+    read(readValue(input, memoryLimit));
+    snapshot.memoryLimit = static_cast<std::size_t>(memoryLimit);
+
+    if (!isGood)
+    {
+        return cpp::fail(std::string("The session is corrupted or incomplete"));
+    }
+    return snapshot;
+}
+
+std::string runCacheKey(const std::filesystem::path& source)
+{
+    std::error_code error;
+    const auto path = std::filesystem::absolute(source, error).lexically_normal();
+    const auto modified = std::filesystem::last_write_time(path, error);
+    if (error)
+    {
+        return {};
+    }
+    if (not std::filesystem::is_directory(path, error))
+    {
+        const auto identity = fmt::format("{}|{}|{}", path.string(),
+                                          std::filesystem::file_size(path, error),
+                                          modified.time_since_epoch().count());
+        return fmt::format("{:016x}", std::hash<std::string>{}(identity));
+    }
+
+    // Shards rewritten in place leave the time of their directory as it was
+    const auto files = listResultFiles(path);
+    if (not files)
+    {
+        return {};
+    }
+    auto identity = fmt::format("{}|{}", path.string(), modified.time_since_epoch().count());
+    for (const auto& file: files.value())
+    {
+        const auto size = std::filesystem::file_size(file, error);
+        const auto fileModified = std::filesystem::last_write_time(file, error);
+        if (error)
+        {
+            return {};
+        }
+        identity += fmt::format("|{}|{}|{}", file.filename().string(), size,
+                                fileModified.time_since_epoch().count());
+    }
+    return fmt::format("{:016x}", std::hash<std::string>{}(identity));
+}
+
+}// namespace BPlotter
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <filesystem>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <result.hpp>
+
+#include "Memory/MemoryBudget.hpp"
+#include "Pivot/PivotEngine.hpp"
+#include "Plot/PlotViewport.hpp"
+
+namespace BPlotter
+{
+
+/**
+ * \brief Run that was open when the session was saved.
+ */
+struct SessionRun
+{
+    /**
+     * \brief Path of the benchmark file or the directory of its shards.
+     */
+    std::string source;
+
+    /**
+     * \brief Identity of the source when it was parsed, see runCacheKey(). The parsed results
+     * are cached under this key, so they are reused only if the source did not change since.
+     */
+    std::string cacheKey;
+
+    bool operator==(const SessionRun&) const = default;
+};
+
+/**
+ * \brief Definition of a derived metric, which is computed again when the session is restored.
+ */
+struct SessionMetric
+{
+    std::string name;
+    std::string expression;
+
+    bool operator==(const SessionMetric&) const = default;
+};
+
+/**
+ * \brief Workspace of the application that survives a restart: the open runs and what was
+ * displayed for them. The window layout is persisted separately by ImGui.
+ */
+struct SessionSnapshot
+{
+    std::optional<SessionRun> displayedRun;
+
+    /**
+     * \brief Runs kept in the run library, in its order.
+     */
+    std::vector<SessionRun> storedRuns;
+
+    std::string filter;
+    bool isRegexFilter = false;
+
+    /**
+     * \brief Displayed pivot view, which identifies its memoized series.
+     */
+    PivotKey pivotKey;
+    bool isPivotFiltered = false;
+    PlotViewport plotViewport;
+
+    std::vector<SessionMetric> derivedMetrics;
+    std::size_t memoryLimit = MemoryBudget::DEFAULT_LIMIT;
+
+    bool operator==(const SessionSnapshot&) const = default;
+};
+
+/**
+ * \brief Writes the snapshot in a compact binary form.
+ * \param snapshot Snapshot to be written
+ * \param output Binary output stream
+ * \return Error message if the snapshot could not be written
+ */
+cpp::result<void, std::string> writeSession(const SessionSnapshot& snapshot,
+                                            std::ostream& output);
+
+/**
+ * \brief Reads the snapshot written by writeSession().
+ * \param input Binary input stream
+ * \return Read snapshot or an error message if the data is corrupted or incomplete
+ */
+cpp::result<SessionSnapshot, std::string> readSession(std::istream& input);
+
+/**
+ * \brief Identifies the current contents of the source of a run by its path, size and
+ * modification time, without reading it. A directory of shards is identified by the sizes
+ * and the modification times of all its result files.
+ * \param source Path of the benchmark file or the directory of its shards
+ * \return Key of the source or an empty string if it does not exist
+ */
+std::string runCacheKey(const std::filesystem::path& source);
+
+}// namespace BPlotter
@@ -0,0 +1,162 @@
+#include "SessionStore.hpp"
+#include "pch.hpp"
+
+#include <fstream>
+#include <unordered_set>
+
+namespace BPlotter
+{
+
+namespace
+{
+
+constexpr auto SESSION_FILE = "session.bin";
+constexpr auto RUNS_DIRECTORY = "runs";
+
+/**
+ * \brief Writes the file next to its final location and renames it once it is complete,
+ * so a crash never leaves a partially written file behind.
+ * \param path Final path of the file
+ * \param write Writes the contents, returns false on failure
+ * \return True if the file was written
+ */
+template<typename Write>
+bool writeAtomically(const std::filesystem::path& path, Write write)
+{
+    auto temporary = path;
+    temporary += ".tmp";
+    {
+        std::ofstream output(temporary, std::ios::binary | std::ios::trunc);
+        if (!write(output) || !output.flush())
+        {
+            spdlog::warn("[SessionStore] Unable to write {}", temporary.string());
+            return false;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error)
+    {
+        spdlog::warn("[SessionStore] Unable to replace {}: {}", path.string(), error.message());
+        return false;
+    }
+    return true;
+}
+
+}// namespace
+
+SessionStore::SessionStore(std::filesystem::path directory, TaskScheduler& scheduler)
+    : mDirectory(std::move(directory))
+    , mScheduler(scheduler)
+{
+}
+
+SessionStore::~SessionStore()
+{
+    wait();
+}
+
+cpp::result<std::optional<SessionSnapshot>, std::string> SessionStore::load() const
+{
+    const auto path = mDirectory / SESSION_FILE;
+    if (!std::filesystem::exists(path))
+    {
+        return std::optional<SessionSnapshot>();
+    }
+
+    std::ifstream input(path, std::ios::binary);
+    auto snapshot = readSession(input);
+    if (snapshot.has_error())
+    {
+        return cpp::fail(fmt::format("Unable to read {}: {}", path.string(), snapshot.error()));
+    }
+    return std::optional<SessionSnapshot>(std::move(snapshot).value());
+}
+
+std::filesystem::path SessionStore::runCachePath(const std::string_view cacheKey) const
+{
+    return mDirectory / RUNS_DIRECTORY / fmt::format("{}.bin", cacheKey);
+}
+
+bool SessionStore::save(SessionSnapshot snapshot, std::vector<SessionRunCache> runCaches)
+{
+    if (isSaving())
+    {
+        return false;
+    }
+    wait();
+    mSave = mScheduler.submit(TaskPriority::Background,
+                              [this, snapshot = std::move(snapshot),
+                               runCaches = std::move(runCaches)]
+                              {
+                                  write(snapshot, runCaches);
+                              });
+    return true;
+}
+
+bool SessionStore::isSaving() const
+{
+    return mSave.valid() &&
+           mSave.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
+
+void SessionStore::wait()
+{
+    if (mSave.valid())
+    {
+        mSave.get();
+    }
+}
+
+void SessionStore::write(const SessionSnapshot& snapshot,
+                         const std::vector<SessionRunCache>& runCaches) const
+{
+    const auto runsDirectory = mDirectory / RUNS_DIRECTORY;
+    std::error_code error;
+    std::filesystem::create_directories(runsDirectory, error);
+    if (error)
+    {
+        spdlog::warn("[SessionStore] Unable to create {}: {}", runsDirectory.string(),
+                     error.message());
+        return;
+    }
+
+    for (const auto& runCache: runCaches)
+    {
+        writeAtomically(runCachePath(runCache.cacheKey),
+                        [&runCache](std::ofstream& output)
+                        {
+                            return runCache.results->writeCache(output).has_value();
+                        });
+    }
+
+    const auto isWritten = writeAtomically(mDirectory / SESSION_FILE,
+                                           [&snapshot](std::ofstream& output)
+                                           {
+                                               return writeSession(snapshot, output).has_value();
+                                           });
+    if (!isWritten)
+    {
+        return;
+    }
+
+    // Only now the previous snapshot can not refer to the cached results any more
+    std::unordered_set<std::string> referenced;
+    if (snapshot.displayedRun)
+    {
+        referenced.insert(runCachePath(snapshot.displayedRun->cacheKey).filename().string());
+    }
+    for (const auto& run: snapshot.storedRuns)
+    {
+        referenced.insert(runCachePath(run.cacheKey).filename().string());
+    }
+    for (const auto& entry: std::filesystem::directory_iterator(runsDirectory, error))
+    {
+        if (!referenced.contains(entry.path().filename().string()))
+        {
+            std::filesystem::remove(entry.path(), error);
+        }
+    }
+}
+
+}// namespace BPlotter
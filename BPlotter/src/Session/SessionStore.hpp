@@ -0,0 +1,106 @@
+#pragma once
+
+#include <filesystem>
+#include <future>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <result.hpp>
+
+#include "Benchmark/BenchmarkResults.hpp"
+#include "Session/SessionSnapshot.hpp"
+#include "Tasks/TaskScheduler.hpp"
+
+namespace BPlotter
+{
+
+/**
+ * \brief Parsed results of a run to be encoded by BenchmarkResults::writeCache() and stored
+ * under its cache key.
+ */
+struct SessionRunCache
+{
+    std::string cacheKey;
+
+    /**
+     * \brief Results read by the background task, which must not change until the save
+     * finishes, see SessionStore::wait().
+     */
+    const BenchmarkResults* results = nullptr;
+};
+
+/**
+ * \brief Saves the session snapshot together with the parsed results of its runs to a
+ * directory and reads them back on the next start.
+ *
+ * The files are written by a background task, so saving does not stall the frame. The
+ * results of the runs are encoded there as well, straight into their files.
+ * The snapshot replaces the previous one atomically, and the cached results that are no
+ * longer referenced by it are removed afterwards.
+ */
+class SessionStore
+{
+public:
+    /**
+     * \brief Creates the store. Nothing is touched on the disk until the first save.
+     * \param directory Directory of the session
+     * \param scheduler Scheduler writing the files, must outlive the store
+     */
+    SessionStore(std::filesystem::path directory, TaskScheduler& scheduler);
+    SessionStore(const SessionStore&) = delete;
+    SessionStore& operator=(const SessionStore&) = delete;
+
+    /**
+     * \brief Waits for the pending save.
+     */
+    ~SessionStore();
+
+    /**
+     * \brief Reads the last saved snapshot.
+     * \return The snapshot, nullopt if no session was saved yet, or an error message if the
+     * saved session can not be read
+     */
+    [[nodiscard]] cpp::result<std::optional<SessionSnapshot>, std::string> load() const;
+
+    /**
+     * \brief Path of the cached results of a run, which may not exist.
+     * \param cacheKey Cache key of the run
+     * \return Path of the cache file
+     */
+    [[nodiscard]] std::filesystem::path runCachePath(std::string_view cacheKey) const;
+
+    /**
+     * \brief Starts saving the snapshot in the background.
+     * \param snapshot Snapshot to be saved
+     * \param runCaches Results of the runs of the snapshot that are not cached yet, read
+     * until the save finishes
+     * \return False if the previous save is still in progress, in which case nothing is saved
+     */
+    bool save(SessionSnapshot snapshot, std::vector<SessionRunCache> runCaches);
+
+    /**
+     * \brief Checks whether a save is in progress.
+     * \return True if the files are being written
+     */
+    [[nodiscard]] bool isSaving() const;
+
+    /**
+     * \brief Blocks until the pending save, if any, is finished.
+     */
+    void wait();
+
+private:
+    /**
+     * \brief Writes the files of the session, runs in the background task.
+     */
+    void write(const SessionSnapshot& snapshot,
+               const std::vector<SessionRunCache>& runCaches) const;
+
+    std::filesystem::path mDirectory;
+    TaskScheduler& mScheduler;
+    std::future<void> mSave;
+};
+
+}// namespace BPlotter
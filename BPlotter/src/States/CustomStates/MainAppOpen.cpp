@@ -1,12 +1,171 @@
 #include "MainAppOpen.hpp"
 #include "pch.hpp"
 
+#include "Analysis/CacheHierarchy.hpp"
+#include "Benchmark/BenchmarkParser.hpp"
+#include "Benchmark/ShardMerge.hpp"
+#include "Utils/FrameArena.hpp"
+
+#include <fstream>
+#include <random>
+
 namespace BPlotter
 {
 
-MainAppOpen::MainAppOpen(StateStack& stack)
+namespace
+{
+
+/**
+ * \brief Returns a directory for the cache files of the evicted runs, unique for this
+ * instance of the application so that several users of a machine do not share it.
+ */
+std::filesystem::path runCacheDirectory()
+{
+    std::error_code error;
+    auto directory = std::filesystem::temp_directory_path(error);
+    if (error)
+    {
+        directory = std::filesystem::current_path();
+    }
+    std::random_device random;
+    const auto suffix = (std::uint64_t{random()} << 32) | random();
+    return directory / fmt::format("BPlotter-{:016x}", suffix);
+}
+
+/**
+ * \brief Loads the results of a run from its benchmark file.
+ * \param source Path to the JSON file generated by Google Benchmark, or to a directory
+ * of such files holding the shards of a single run
+ * \param scheduler Scheduler loading the shards in parallel
+ * \return Loaded results or an error message
+ */
+cpp::result<BenchmarkResults, std::string> loadRun(const std::filesystem::path& source,
+                                                   TaskScheduler& scheduler)
+{
+    if (not std::filesystem::is_directory(source))
+    {
+        return loadBenchmarkResults(source, scheduler);
+    }
+
+    // A directory holds the shards of a single run, e.g. produced by several CI hosts
+    auto merged = loadShardedResults(source, scheduler);
+    if (not merged)
+    {
+        return cpp::fail(merged.error());
+    }
+    for (const auto& duplicate: merged->report.duplicates)
+    {
+        spdlog::warn("[MainAppOpen] {} is in several shards, keeping the first one", duplicate);
+    }
+    for (const auto& mismatch: merged->report.contextMismatches)
+    {
+        spdlog::warn("[MainAppOpen] Shards come from different machines: {}", mismatch);
+    }
+    return std::move(merged->results);
+}
+
+/**
+ * \brief Checks whether the name filter of the pivot key is the one typed by the user, without
+ * formatting it.
+ * \param nameFilter Name filter of the pivot key, "<kind>:<input>" or empty if not filtered
+ * \param isFiltered Whether the pivot uses only the benchmarks matching the filter
+ * \param kind Kind of the typed filter
+ * \param input Typed filter
+ * \return True if the key does not need a new name filter
+ */
+bool isSameNameFilter(const std::string_view nameFilter, const bool isFiltered,
+                      const std::string_view kind, const std::string_view input)
+{
+    if (not isFiltered)
+    {
+        return nameFilter.empty();
+    }
+    return nameFilter.size() == kind.size() + 1 + input.size() && nameFilter.starts_with(kind) &&
+           nameFilter[kind.size()] == ':' && nameFilter.ends_with(input);
+}
+
+/**
+ * \brief Checks whether the pivot view refers only to the columns present in the results.
+ */
+bool isPivotKeyValid(const PivotKey& key, const BenchmarkResults& results)
+{
+    const auto isValid = [&results](const Dimension& dimension)
+    {
+        return dimension.kind != DimensionKind::Column || dimension.index < results.columnCount();
+    };
+    return key.y < results.columnCount() && isValid(key.x) && isValid(key.group);
+}
+
+}// namespace
+
+MainAppOpen::MainAppOpen(StateStack& stack, TaskScheduler& scheduler,
+                         const ApplicationOptions& options)
     : State(stack)
+    , mTaskScheduler(scheduler)
+    , mRunLibrary(mMemoryBudget, runCacheDirectory())
+    , mPivotWorker(scheduler)
+    , mPlotView(scheduler)
+    , mScalingPanel(scheduler)
+    , mDistributionPanel(scheduler)
+    , mHistoryPanel(scheduler)
+    , mResultsTablePanel(scheduler)
 {
+    if (const auto sessionDirectory = options.sessionDirectoryInUse())
+    {
+        mSessionStore.emplace(*sessionDirectory, scheduler);
+    }
+
+    // The displayed run is never evicted, so its evictor has nothing to release
+    mResultsMemory = mMemoryBudget.track("Displayed run", MemoryCategory::Run,
+                                         [this]
+                                         {
+                                             return mResults.memoryUsage();
+                                         });
+    mMemoryBudget.setPinned(mResultsMemory, true);
+
+    // The displayed snapshot is not a part of the views, so it stays valid
+    mPivotMemory = mMemoryBudget.track("Pivot views", MemoryCategory::DerivedCache,
+                                       [this]
+                                       {
+                                           return mPivotWorker.evictViews();
+                                       });
+
+    // The levels of detail and the hover indices are built again when the plot needs them,
+    // only the texture of the displayed plot stays
+    mPlotMemory = mMemoryBudget.track("Plot caches", MemoryCategory::DerivedCache,
+                                      [this]
+                                      {
+                                          return mPlotView.evictCaches();
+                                      });
+
+    // Only the distributions of the displayed run are kept, so there is nothing to release
+    mDistributionMemory = mMemoryBudget.track("Repetition distributions",
+                                              MemoryCategory::DerivedCache,
+                                              [this]
+                                              {
+                                                  return mDistributionPanel.memoryUsage();
+                                              });
+    mMemoryBudget.setPinned(mDistributionMemory, true);
+
+    mResultsTableMemory = mMemoryBudget.track("Table sort orders", MemoryCategory::DerivedCache,
+                                              [this]
+                                              {
+                                                  return mResultsTablePanel.evict();
+                                              });
+
+    restoreSession();
+}
+
+MainAppOpen::~MainAppOpen()
+{
+    if (not mSessionStore)
+    {
+        return;
+    }
+    // The application is closing, so the last changes are saved right away
+    mSessionStore->wait();
+    saveSessionIfChanged();
+    mSessionStore->wait();
 }
 void MainAppOpen::draw(sf::RenderWindow& target) const
 {
@@ -17,6 +176,26 @@ bool MainAppOpen::fixedUpdate(const float deltaTime)
 }
 bool MainAppOpen::update(const float deltaTime)
 {
+    mPivotWorker.update();
+    mNameFilter.setQuery(mFilterInput.data(),
+                         mIsRegexFilter ? FilterMode::Regex : FilterMode::Substring);
+    mNameFilter.update(FILTER_BUDGET_PER_FRAME);
+
+    // The displayed snapshot does not need the cached pivot views, and the plot caches are
+    // marked as used only when the plot is drawn, so reporting them does not protect them
+    mMemoryBudget.update(mResultsMemory, mResults.memoryUsage());
+    mMemoryBudget.resize(mPivotMemory, mPivotWorker.memoryUsage());
+    mMemoryBudget.resize(mPlotMemory, mPlotView.memoryUsage());
+    mMemoryBudget.update(mDistributionMemory, mDistributionPanel.memoryUsage());
+    mMemoryBudget.update(mResultsTableMemory, mResultsTablePanel.memoryUsage());
+    mMemoryBudget.enforce();
+
+    if (const auto now = std::chrono::steady_clock::now();
+        now - mLastSessionSave >= SESSION_SAVE_INTERVAL)
+    {
+        mLastSessionSave = now;
+        saveSessionIfChanged();
+    }
     return true;
 }
 bool MainAppOpen::handleEvent(const sf::Event& event)
@@ -25,7 +204,512 @@ bool MainAppOpen::handleEvent(const sf::Event& event)
 }
 bool MainAppOpen::updateImGui(const float deltaTime)
 {
+    mMemoryBudget.beginFrame();
+    updateImGuiFileMenu();
+    updateImGuiBenchmarkList();
+    mDerivedMetricsPanel.updateImGui(mResults,
+                                     [this]
+                                     {
+                                         waitForResultsReaders();
+                                     });
+    updateImGuiPivot();
+    mScalingPanel.updateImGui(mResults);
+    mDistributionPanel.updateImGui(mResults);
+    mHistoryPanel.updateImGui();
+    mMemoryPanel.updateImGui(mMemoryBudget);
+    mResultsTablePanel.updateImGui(mResults);
     return true;
 }
 
-}// namespace BPlotter
\ No newline at end of file
+void MainAppOpen::loadResults(const std::filesystem::path& path)
+{
+    // The identity is taken before parsing, so a change made meanwhile is noticed next time
+    auto cacheKey = runCacheKey(path);
+    auto results = loadRun(path, mTaskScheduler);
+    if (not results)
+    {
+        spdlog::error("[MainAppOpen] Unable to load {}: {}", path.string(), results.error());
+        return;
+    }
+
+    mRunCacheKeys[path.string()] = std::move(cacheKey);
+    openResults(std::move(results.value()), path.string());
+    spdlog::info("[MainAppOpen] Loaded {} rows ({} benchmark names) from {}", mResults.size(),
+                 mResults.names().size(), path.string());
+}
+
+void MainAppOpen::waitForResultsReaders()
+{
+    mPivotWorker.wait();
+    if (mSessionStore)
+    {
+        mSessionStore->wait();
+    }
+}
+
+void MainAppOpen::openResults(BenchmarkResults results, std::string name)
+{
+    waitForResultsReaders();
+    if (not mResults.empty())
+    {
+        mRunLibrary.store(std::move(mResultsName), std::move(mResults));
+    }
+
+    mResults = std::move(results);
+    mResultsName = std::move(name);
+    mDerivedMetricsPanel.reapply(mResults);
+    mNameFilter.reset(mResults.names());
+    mPivotWorker.reset(mResults);
+    mPivotKey = PivotKey{.x = {DimensionKind::Argument, 0}, .group = {DimensionKind::Family}};
+    mIsFitPending = true;
+    mScalingPanel = ScalingPanel(mTaskScheduler);
+    mDistributionPanel = DistributionPanel(mTaskScheduler);
+    mResultsTablePanel = ResultsTablePanel(mTaskScheduler);
+    mCacheOverlayInputs = {};
+
+    mMemoryBudget.update(mResultsMemory, mResults.memoryUsage());
+    mMemoryBudget.resize(mPivotMemory, mPivotWorker.memoryUsage());
+    mMemoryBudget.enforce();
+}
+
+void MainAppOpen::openStoredRun(const std::size_t index)
+{
+    auto name = mRunLibrary.name(index);
+    auto results = mRunLibrary.take(index);
+    if (not results)
+    {
+        spdlog::error("[MainAppOpen] Unable to open {}: {}", name, results.error());
+        return;
+    }
+    openResults(std::move(results.value()), std::move(name));
+    spdlog::info("[MainAppOpen] Switched to {}", mResultsName);
+}
+
+void MainAppOpen::restoreSession()
+{
+    if (not mSessionStore)
+    {
+        return;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    auto loaded = mSessionStore->load();
+    if (not loaded)
+    {
+        spdlog::warn("[MainAppOpen] Starting a new session: {}", loaded.error());
+        return;
+    }
+    if (not loaded.value())
+    {
+        return;
+    }
+    const auto& snapshot = *loaded.value();
+    mMemoryBudget.setLimit(snapshot.memoryLimit);
+
+    for (const auto& run: snapshot.storedRuns)
+    {
+        // Stored runs are read from their cached results only once they are displayed
+        if (isRunCacheValid(run))
+        {
+            mRunLibrary.storeCached(run.source, mSessionStore->runCachePath(run.cacheKey));
+            mRunCacheKeys[run.source] = run.cacheKey;
+        }
+        else if (auto results = restoreRun(run))
+        {
+            mRunLibrary.store(run.source, std::move(results.value()));
+        }
+        else
+        {
+            spdlog::warn("[MainAppOpen] Unable to restore {}: {}", run.source, results.error());
+        }
+    }
+
+    if (snapshot.displayedRun)
+    {
+        if (auto results = restoreRun(*snapshot.displayedRun))
+        {
+            openResults(std::move(results.value()), snapshot.displayedRun->source);
+        }
+        else
+        {
+            spdlog::warn("[MainAppOpen] Unable to restore {}: {}",
+                         snapshot.displayedRun->source, results.error());
+        }
+    }
+    for (const auto& metric: snapshot.derivedMetrics)
+    {
+        if (const auto defined = mDerivedMetricsPanel.define(mResults, metric.name,
+                                                             metric.expression);
+            defined.has_error())
+        {
+            spdlog::warn("[MainAppOpen] Unable to restore metric {}: {}", metric.name,
+                         defined.error());
+        }
+    }
+
+    mFilterInput.fill('\0');
+    snapshot.filter.copy(mFilterInput.data(), mFilterInput.size() - 1);
+    mIsRegexFilter = snapshot.isRegexFilter;
+    if (not mResults.empty() && isPivotKeyValid(snapshot.pivotKey, mResults))
+    {
+        mPivotKey = snapshot.pivotKey;
+        mIsPivotFiltered = snapshot.isPivotFiltered;
+        mPlotView.setViewport(snapshot.plotViewport);
+        mIsFitPending = false;
+    }
+
+    mSavedSession = captureSession();
+    spdlog::info("[MainAppOpen] Restored the session in {} ms",
+                 std::chrono::duration_cast<std::chrono::milliseconds>(
+                     std::chrono::steady_clock::now() - start)
+                     .count());
+}
+
+cpp::result<BenchmarkResults, std::string> MainAppOpen::restoreRun(const SessionRun& run)
+{
+    if (isRunCacheValid(run))
+    {
+        std::ifstream input(mSessionStore->runCachePath(run.cacheKey), std::ios::binary);
+        if (auto results = BenchmarkResults::readCache(input))
+        {
+            mRunCacheKeys[run.source] = run.cacheKey;
+            return results;
+        }
+    }
+
+    auto cacheKey = runCacheKey(run.source);
+    auto results = loadRun(run.source, mTaskScheduler);
+    if (results)
+    {
+        mRunCacheKeys[run.source] = std::move(cacheKey);
+    }
+    return results;
+}
+
+bool MainAppOpen::isRunCacheValid(const SessionRun& run) const
+{
+    return mSessionStore && not run.cacheKey.empty() && run.cacheKey == runCacheKey(run.source) &&
+           std::filesystem::exists(mSessionStore->runCachePath(run.cacheKey));
+}
+
+SessionSnapshot MainAppOpen::captureSession() const
+{
+    const auto sessionRun = [this](const std::string& source)
+    {
+        const auto found = mRunCacheKeys.find(source);
+        return SessionRun{source, found != mRunCacheKeys.end() ? found->second : std::string()};
+    };
+
+    SessionSnapshot snapshot{.filter = mFilterInput.data(),
+                             .isRegexFilter = mIsRegexFilter,
+                             .pivotKey = mPivotKey,
+                             .isPivotFiltered = mIsPivotFiltered,
+                             .plotViewport = mPlotView.viewport(),
+                             .memoryLimit = mMemoryBudget.limit()};
+    if (not mResults.empty())
+    {
+        snapshot.displayedRun = sessionRun(mResultsName);
+    }
+    for (std::size_t i = 0; i < mRunLibrary.size(); ++i)
+    {
+        snapshot.storedRuns.push_back(sessionRun(mRunLibrary.name(i)));
+    }
+    for (const auto& metric: mDerivedMetricsPanel.metrics())
+    {
+        snapshot.derivedMetrics.push_back({metric.name, metric.expression.source()});
+    }
+    return snapshot;
+}
+
+void MainAppOpen::saveSessionIfChanged()
+{
+    if (not mSessionStore || mSessionStore->isSaving())
+    {
+        return;
+    }
+    auto snapshot = captureSession();
+    if (snapshot == mSavedSession)
+    {
+        return;
+    }
+
+    // Parsed results never change, so they are encoded only once for all the saves. The
+    // background task encodes them, the results wait for it before they change.
+    std::vector<SessionRunCache> runCaches;
+    if (const auto& run = snapshot.displayedRun;
+        run && not run->cacheKey.empty() &&
+        not std::filesystem::exists(mSessionStore->runCachePath(run->cacheKey)))
+    {
+        runCaches.push_back({run->cacheKey, &mResults});
+    }
+
+    mSavedSession = snapshot;
+    mSessionStore->save(std::move(snapshot), std::move(runCaches));
+}
+
+void MainAppOpen::updateImGuiFileMenu()
+{
+    if (ImGui::BeginMenu("File"))
+    {
+        ImGui::InputText("Path", mPathInput.data(), mPathInput.size());
+        if (ImGui::Button("Open"))
+        {
+            loadResults(mPathInput.data());
+            ImGui::CloseCurrentPopup();
+        }
+
+        if (mRunLibrary.size() > 0)
+        {
+            ImGui::Separator();
+            ImGui::TextDisabled("Previously opened");
+            std::optional<std::size_t> selected;
+            for (std::size_t i = 0; i < mRunLibrary.size(); ++i)
+            {
+                ImGui::PushID(static_cast<int>(i));
+                if (ImGui::MenuItem(mRunLibrary.name(i).c_str(),
+                                    mRunLibrary.isResident(i) ? nullptr : "on disk"))
+                {
+                    selected = i;
+                }
+                ImGui::PopID();
+            }
+            // Switched only after the loop, it changes the library
+            if (selected)
+            {
+                openStoredRun(*selected);
+            }
+        }
+        ImGui::EndMenu();
+    }
+}
+
+void MainAppOpen::updateImGuiBenchmarkList()
+{
+    if (ImGui::Begin("Benchmarks"))
+    {
+        ImGui::InputText("Filter", mFilterInput.data(), mFilterInput.size());
+        ImGui::SameLine();
+        ImGui::Checkbox("Regex", &mIsRegexFilter);
+
+        if (not mNameFilter.error().empty())
+        {
+            ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.5f, 1.0f), "%s", mNameFilter.error().c_str());
+        }
+
+        const auto matches = mNameFilter.matches();
+        ImGui::Text("%zu / %zu benchmarks%s", matches.size(), mResults.names().size(),
+                    mNameFilter.isFinished() ? "" : " (filtering...)");
+
+        if (ImGui::BeginChild("BenchmarkNames"))
+        {
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(matches.size()));
+            while (clipper.Step())
+            {
+                for (auto row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+                {
+                    const auto name = mResults.names().get(matches[row]);
+                    ImGui::TextUnformatted(name.data(), name.data() + name.size());
+                }
+            }
+        }
+        ImGui::EndChild();
+    }
+    ImGui::End();
+}
+
+void MainAppOpen::updateImGuiPivot()
+{
+    if (ImGui::Begin("Pivot"))
+    {
+        if (mResults.empty())
+        {
+            ImGui::TextUnformatted("Open the benchmark results to plot them.");
+        }
+        else
+        {
+            // The key is changed in place, copying it every frame would allocate its strings
+            auto& key = mPivotKey;
+            auto isKeyChanged = false;
+            const auto& dimensions = mPivotWorker.dimensions();
+            isKeyChanged |= dimensionCombo("X", key.x, dimensions);
+            ImGui::SameLine();
+            isKeyChanged |= dimensionCombo("Group by", key.group, dimensions);
+
+            if (ImGui::BeginCombo("Y", frameArena().copy(mResults.columnName(key.y))))
+            {
+                for (ColumnIndex column = 0; column < mResults.columnCount(); ++column)
+                {
+                    const auto* name = frameArena().copy(mResults.columnName(column));
+                    if (ImGui::Selectable(name, column == key.y) && column != key.y)
+                    {
+                        key.y = column;
+                        isKeyChanged = true;
+                    }
+                }
+                ImGui::EndCombo();
+            }
+            ImGui::SameLine();
+            if (ImGui::BeginCombo("Aggregation", toString(key.aggregation).c_str()))
+            {
+                for (const auto aggregation: {Aggregation::Mean, Aggregation::Min,
+                                              Aggregation::Max, Aggregation::Sum,
+                                              Aggregation::Count})
+                {
+                    if (ImGui::Selectable(toString(aggregation).c_str(),
+                                          aggregation == key.aggregation) &&
+                        aggregation != key.aggregation)
+                    {
+                        key.aggregation = aggregation;
+                        isKeyChanged = true;
+                    }
+                }
+                ImGui::EndCombo();
+            }
+
+            const auto* rowsLabel =
+                key.aggregateName.empty() ? "Iterations" : key.aggregateName.c_str();
+            if (ImGui::BeginCombo("Rows", rowsLabel))
+            {
+                // The empty aggregate name stands for the iteration rows
+                const auto& aggregateNames = mResults.aggregateNames();
+                for (StringId id = 0; id < aggregateNames.size(); ++id)
+                {
+                    const auto name = aggregateNames.get(id);
+                    if (ImGui::Selectable(name.empty() ? "Iterations" : frameArena().copy(name),
+                                          name == key.aggregateName) &&
+                        name != key.aggregateName)
+                    {
+                        key.aggregateName = name;
+                        isKeyChanged = true;
+                    }
+                }
+                ImGui::EndCombo();
+            }
+            ImGui::SameLine();
+            ImGui::Checkbox("Only filtered benchmarks", &mIsPivotFiltered);
+            if (isKeyChanged)
+            {
+                mIsFitPending = true;
+            }
+
+            // The memoized view is identified by the filter, so it can be computed
+            // only once the filter knows all the matching names
+            const auto* filterKind = mIsRegexFilter ? "regex" : "substring";
+            if (not mIsPivotFiltered || mNameFilter.isFinished())
+            {
+                if (not isSameNameFilter(key.nameFilter, mIsPivotFiltered, filterKind,
+                                         mFilterInput.data()))
+                {
+                    key.nameFilter = mIsPivotFiltered ? frameArena().format("%s:%s", filterKind,
+                                                                            mFilterInput.data())
+                                                      : "";
+                    mIsFitPending = true;
+                }
+                mPivotWorker.request(key, mNameFilter.matches());
+            }
+
+            // The plot shows the last finished pivot until the requested one finishes, and
+            // while the name filter is still being computed
+            const auto* snapshot = mPivotWorker.snapshot();
+            if (snapshot != nullptr && mIsFitPending && snapshot->key == mPivotKey)
+            {
+                mPlotView.requestFit();
+                mIsFitPending = false;
+            }
+            if (mPivotWorker.isBusy())
+            {
+                ImGui::SameLine();
+                ImGui::TextDisabled("Pivoting...");
+            }
+
+            ImGui::Checkbox("Cache overlay", &mIsCacheOverlayShown);
+            if (mIsCacheOverlayShown)
+            {
+                ImGui::SameLine();
+                ImGui::SetNextItemWidth(120.f);
+                ImGui::InputDouble("Bytes per X", &mBytesPerX);
+                mBytesPerX = std::max(mBytesPerX, 1e-9);
+                ImGui::SameLine();
+                ImGui::Checkbox("Detect knees", &mIsKneeDetectionEnabled);
+            }
+            updateCacheOverlay();
+
+            if (snapshot != nullptr)
+            {
+                // Only the columns of the results have known units
+                const auto xFormat = mPivotKey.x.kind == DimensionKind::Column
+                                         ? formatOfColumn(mResults.columnName(mPivotKey.x.index))
+                                         : NumberFormat();
+                mPlotView.setAxisFormats(xFormat, formatOfColumn(mResults.columnName(mPivotKey.y)));
+                mPlotView.updateImGui(snapshot->result.series, snapshot->generation,
+                                      snapshot->result.xCategories);
+                mMemoryBudget.touch(mPlotMemory);
+            }
+        }
+    }
+    ImGui::End();
+}
+
+void MainAppOpen::updateCacheOverlay()
+{
+    // The snapshots are immutable, so the generation identifies the content of the pivot
+    const auto* snapshot = mPivotWorker.snapshot();
+    const CacheOverlayInputs inputs{snapshot != nullptr ? snapshot->generation : 0,
+                                    mIsCacheOverlayShown, mIsKneeDetectionEnabled, mBytesPerX};
+    if (inputs == mCacheOverlayInputs)
+    {
+        return;
+    }
+    mCacheOverlayInputs = inputs;
+
+    std::vector<PlotMarker> markers;
+    if (mIsCacheOverlayShown && snapshot != nullptr && snapshot->result.xCategories.empty())
+    {
+        // Boundaries are expressed in the units of the X axis from now on
+        auto boundaries = cacheBoundaries(mResults.context());
+        for (auto& boundary: boundaries)
+        {
+            boundary.bytes /= mBytesPerX;
+            markers.push_back({boundary.bytes, std::nullopt, boundary.label});
+        }
+
+        if (mIsKneeDetectionEnabled)
+        {
+            for (const auto& series: snapshot->result.series)
+            {
+                for (const auto& knee: detectCacheKnees(series, boundaries))
+                {
+                    markers.push_back({knee.x, knee.y,
+                                       fmt::format("{} knee ({})", series.name,
+                                                   boundaries[knee.boundary].label),
+                                       IM_COL32(255, 184, 108, 255)});
+                }
+            }
+        }
+    }
+    mPlotView.setMarkers(std::move(markers));
+}
+
+bool MainAppOpen::dimensionCombo(const char* label, Dimension& dimension,
+                                 const std::vector<Dimension>& dimensions) const
+{
+    auto isChanged = false;
+    ImGui::SetNextItemWidth(200.f);
+    if (ImGui::BeginCombo(label, toString(dimension, mResults, frameArena())))
+    {
+        for (const auto& candidate: dimensions)
+        {
+            if (ImGui::Selectable(toString(candidate, mResults, frameArena()),
+                                  candidate == dimension) &&
+                candidate != dimension)
+            {
+                dimension = candidate;
+                isChanged = true;
+            }
+        }
+        ImGui::EndCombo();
+    }
+    return isChanged;
+}
+
+}// namespace BPlotter
@@ -1,6 +1,30 @@
 #pragma once
 
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "ApplicationOptions.hpp"
+#include "Benchmark/BenchmarkResults.hpp"
+#include "Filter/NameFilter.hpp"
+#include "Memory/MemoryBudget.hpp"
+#include "Memory/RunLibrary.hpp"
+#include "Panels/DerivedMetricsPanel.hpp"
+#include "Panels/DistributionPanel.hpp"
+#include "Panels/HistoryPanel.hpp"
+#include "Panels/MemoryPanel.hpp"
+#include "Panels/ResultsTablePanel.hpp"
+#include "Panels/ScalingPanel.hpp"
+#include "Pivot/PivotWorker.hpp"
+#include "Plot/PlotView.hpp"
+#include "Session/SessionStore.hpp"
 #include "States/State.hpp"
+#include "Tasks/TaskScheduler.hpp"
 
 namespace BPlotter
 {
@@ -13,7 +37,18 @@ class StateStack;
 class MainAppOpen : public State
 {
 public:
-    explicit MainAppOpen(StateStack& stack);
+    /**
+     * \brief Creates the state, restoring the session saved when the application was closed.
+     * \param stack Stack of the application states
+     * \param scheduler Scheduler of all the background work of the application
+     * \param options Settings of the application, which tell where the session is saved
+     */
+    MainAppOpen(StateStack& stack, TaskScheduler& scheduler, const ApplicationOptions& options);
+
+    /**
+     * \brief Saves the session, if there is one, waiting until it is written.
+     */
+    ~MainAppOpen() override;
 
     /**
      * \brief Draws only this state to the passed target
@@ -44,6 +79,203 @@ public:
      * \param deltaTime the time that has passed since the application was last updated.
      */
     bool updateImGui(float deltaTime) override;
+
+private:
+    /**
+     * \brief Loads the benchmark results from the file and indexes the benchmark names.
+     * \param path Path to the JSON file generated by Google Benchmark, or to a directory
+     * of such files holding the shards of a single run
+     */
+    void loadResults(const std::filesystem::path& path);
+
+    /**
+     * \brief Waits for the background tasks reading the displayed results, the pivot and the
+     * session save, before the results change.
+     */
+    void waitForResultsReaders();
+
+    /**
+     * \brief Displays the results, keeping the previously displayed ones in the run library.
+     * \param results Results to be displayed
+     * \param name Name of the results displayed to the user
+     */
+    void openResults(BenchmarkResults results, std::string name);
+
+    /**
+     * \brief Displays the run taken out of the run library.
+     * \param index Index of the run inside the library
+     */
+    void openStoredRun(std::size_t index);
+
+    /**
+     * \brief Opens the runs and restores the views of the previous session.
+     */
+    void restoreSession();
+
+    /**
+     * \brief Reads the run of the previous session from its cached results, or parses its
+     * source if it changed since it was cached.
+     * \param run Run of the previous session
+     * \return Results of the run or an error message
+     */
+    cpp::result<BenchmarkResults, std::string> restoreRun(const SessionRun& run);
+
+    /**
+     * \brief Checks whether the cached results of the run can be used instead of its source.
+     * \param run Run of the previous session
+     * \return True if the source did not change since it was cached
+     */
+    [[nodiscard]] bool isRunCacheValid(const SessionRun& run) const;
+
+    /**
+     * \brief Captures the current workspace.
+     * \return Snapshot of the session
+     */
+    [[nodiscard]] SessionSnapshot captureSession() const;
+
+    /**
+     * \brief Starts saving the session in the background if it changed since the last save.
+     * The displayed results are encoded here, only if they are not cached yet.
+     */
+    void saveSessionIfChanged();
+
+    /**
+     * \brief Displays the menu allowing to open the benchmark results or switch to one of
+     * the previously opened runs.
+     */
+    void updateImGuiFileMenu();
+
+    /**
+     * \brief Displays the filterable list of the benchmark names.
+     */
+    void updateImGuiBenchmarkList();
+
+    /**
+     * \brief Displays the controls of the pivot and the plot of the series it produces.
+     */
+    void updateImGuiPivot();
+
+    /**
+     * \brief Marks the cache boundaries of the machine (and the knees of the series near
+     * them) on the pivot plot, treating the X values as working set sizes. The markers
+     * are computed again only when something they depend on changes.
+     */
+    void updateCacheOverlay();
+
+    /**
+     * \brief Displays a combo box allowing to pick one of the dimensions.
+     * \param label Label of the combo box
+     * \param dimension Currently selected dimension, changed on selection
+     * \param dimensions Dimensions to choose from
+     * \return Whether another dimension was selected
+     */
+    bool dimensionCombo(const char* label, Dimension& dimension,
+                        const std::vector<Dimension>& dimensions) const;
+
+    /**
+     * \brief Time of the frame that can be spent on filtering the benchmark names.
+     */
+    static constexpr std::chrono::microseconds FILTER_BUDGET_PER_FRAME{4000};
+
+    /**
+     * \brief How often the session is checked for changes and saved.
+     */
+    static constexpr std::chrono::seconds SESSION_SAVE_INTERVAL{2};
+
+    TaskScheduler& mTaskScheduler;
+    std::array<char, 512> mPathInput{};
+    std::array<char, 256> mFilterInput{};
+    bool mIsRegexFilter = false;
+
+    /**
+     * \brief Accounts the memory of the runs and the caches derived from them. Declared
+     * before all of them, so it outlives them.
+     */
+    MemoryBudget mMemoryBudget;
+
+    /**
+     * \brief Previously opened runs, kept for switching back to them.
+     */
+    RunLibrary mRunLibrary;
+
+    /**
+     * \brief Currently opened benchmark results.
+     */
+    BenchmarkResults mResults;
+    std::string mResultsName;
+    MemoryEntryId mResultsMemory = 0;
+
+    /**
+     * \brief Filter of the names of the currently opened benchmark results.
+     */
+    NameFilter mNameFilter;
+
+    /**
+     * \brief Turns the rows of the currently opened results into plottable series in the
+     * background. Must be waited for before the results change.
+     */
+    PivotWorker mPivotWorker;
+    PivotKey mPivotKey;
+    bool mIsPivotFiltered = false;
+
+    /**
+     * \brief The plot is fitted once the pivot of the changed view finishes.
+     */
+    bool mIsFitPending = false;
+    MemoryEntryId mPivotMemory = 0;
+    PlotView mPlotView;
+    MemoryEntryId mPlotMemory = 0;
+
+    bool mIsCacheOverlayShown = false;
+    bool mIsKneeDetectionEnabled = true;
+
+    /**
+     * \brief How many bytes of the working set correspond to a unit on the X axis.
+     */
+    double mBytesPerX = 1;
+
+    /**
+     * \brief Everything the markers of the cache overlay depend on.
+     */
+    struct CacheOverlayInputs
+    {
+        /**
+         * \brief Generation of the displayed pivot snapshot, zero if there is none.
+         */
+        std::uint64_t pivotGeneration = 0;
+        bool isShown = false;
+        bool isKneeDetectionEnabled = false;
+
+        /**
+         * \brief NaN until the first update, so that the default inputs never match.
+         */
+        double bytesPerX = std::numeric_limits<double>::quiet_NaN();
+
+        bool operator==(const CacheOverlayInputs&) const = default;
+    };
+    CacheOverlayInputs mCacheOverlayInputs;
+
+    ScalingPanel mScalingPanel;
+    DistributionPanel mDistributionPanel;
+    MemoryEntryId mDistributionMemory = 0;
+    DerivedMetricsPanel mDerivedMetricsPanel;
+    HistoryPanel mHistoryPanel;
+    MemoryPanel mMemoryPanel;
+    ResultsTablePanel mResultsTablePanel;
+    MemoryEntryId mResultsTableMemory = 0;
+
+    /**
+     * \brief Store of the session, none for the replayed and headless runs.
+     */
+    std::optional<SessionStore> mSessionStore;
+    SessionSnapshot mSavedSession;
+    std::chrono::steady_clock::time_point mLastSessionSave;
+
+    /**
+     * \brief Identities of the sources of the open runs taken when they were parsed,
+     * which are the keys of their cached results.
+     */
+    std::unordered_map<std::string, std::string> mRunCacheKeys;
 };
 
 }// namespace BPlotter
\ No newline at end of file
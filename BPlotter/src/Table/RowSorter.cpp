@@ -0,0 +1,213 @@
+#include "RowSorter.hpp"
+#include "pch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace BPlotter
+{
+
+namespace
+{
+
+/**
+ * \brief Minimal number of rows worth sorting in a task of their own.
+ */
+constexpr std::size_t ROWS_PER_TASK = 32768;
+
+/**
+ * \brief Row together with its sort key, so sorting does not jump around the column.
+ */
+struct KeyedRow
+{
+    double key = 0;
+    std::uint32_t row = 0;
+};
+
+/**
+ * \brief Orders the rows by their keys, missing keys last and the equal keys by their rows.
+ */
+bool isBefore(const KeyedRow& left, const KeyedRow& right)
+{
+    const auto isLeftMissing = std::isnan(left.key);
+    const auto isRightMissing = std::isnan(right.key);
+    if (isLeftMissing != isRightMissing)
+    {
+        return isRightMissing;
+    }
+    if (not isLeftMissing && left.key != right.key)
+    {
+        return left.key < right.key;
+    }
+    return left.row < right.row;
+}
+
+/**
+ * \brief Sorts the chunks of the rows in parallel, then merges the neighboring chunks in
+ * parallel until a single one is left.
+ */
+void parallelSort(std::vector<KeyedRow>& rows, TaskScheduler& scheduler)
+{
+    // The calling thread sorts a chunk as well
+    const auto chunkCount = std::clamp<std::size_t>(rows.size() / ROWS_PER_TASK, 1,
+                                                    scheduler.threadCount() + 1);
+    std::vector<std::size_t> bounds(chunkCount + 1);
+    for (std::size_t chunk = 0; chunk <= chunkCount; ++chunk)
+    {
+        bounds[chunk] = rows.size() * chunk / chunkCount;
+    }
+    const auto at = [&rows, &bounds](const std::size_t chunk)
+    {
+        return rows.begin() + static_cast<std::ptrdiff_t>(bounds[chunk]);
+    };
+
+    scheduler.parallelFor(chunkCount, 1,
+                          [&at](const std::size_t chunk, std::size_t)
+                          {
+                              std::sort(at(chunk), at(chunk + 1), isBefore);
+                          });
+
+    for (std::size_t width = 1; width < chunkCount; width *= 2)
+    {
+        // The last run of the chunks is left as it is if it has no neighbor to merge with
+        const auto mergeCount = (chunkCount + width - 1) / (2 * width);
+        scheduler.parallelFor(mergeCount, 1,
+                              [&at, width, chunkCount](const std::size_t merge, std::size_t)
+                              {
+                                  const auto first = merge * 2 * width;
+                                  std::inplace_merge(at(first), at(first + width),
+                                                     at(std::min(first + 2 * width, chunkCount)),
+                                                     isBefore);
+                              });
+    }
+}
+
+/**
+ * \brief Rank of every string of the interner in the alphabetical order.
+ */
+std::vector<double> alphabeticalRanks(const StringInterner& strings)
+{
+    std::vector<StringId> ids(strings.size());
+    std::iota(ids.begin(), ids.end(), StringId{0});
+    std::ranges::sort(ids,
+                      [&strings](const StringId left, const StringId right)
+                      {
+                          return strings.get(left) < strings.get(right);
+                      });
+
+    std::vector<double> ranks(strings.size());
+    for (std::size_t rank = 0; rank < ids.size(); ++rank)
+    {
+        ranks[ids[rank]] = static_cast<double>(rank);
+    }
+    return ranks;
+}
+
+}// namespace
+
+RowSorter::RowSorter(TaskScheduler& scheduler)
+    : mScheduler(&scheduler)
+{
+}
+
+std::span<const std::uint32_t> RowSorter::order(const BenchmarkResults& results,
+                                                const SortKey& key)
+{
+    assert(results.size() <= std::numeric_limits<std::uint32_t>::max());
+    if (mSortedResults != &results || mSortedRows != results.size())
+    {
+        mPermutations.clear();
+        mSortedResults = &results;
+        mSortedRows = results.size();
+    }
+
+    const auto cached = std::ranges::find(mPermutations, key, &Permutation::key);
+    if (cached != mPermutations.end())
+    {
+        // The last used permutation is kept at the back, so eviction can spare it
+        std::rotate(cached, cached + 1, mPermutations.end());
+        return mPermutations.back().rows;
+    }
+
+    const auto keys = sortKeys(results, key);
+    std::vector<KeyedRow> keyedRows(keys.size());
+    for (std::size_t row = 0; row < keys.size(); ++row)
+    {
+        keyedRows[row] = {keys[row], static_cast<std::uint32_t>(row)};
+    }
+    parallelSort(keyedRows, *mScheduler);
+
+    auto& permutation = mPermutations.emplace_back(Permutation{key, {}});
+    permutation.rows.resize(keyedRows.size());
+    std::ranges::transform(keyedRows, permutation.rows.begin(), &KeyedRow::row);
+    return permutation.rows;
+}
+
+std::size_t RowSorter::memoryUsage() const noexcept
+{
+    auto bytes = std::size_t{0};
+    for (const auto& permutation: mPermutations)
+    {
+        bytes += sizeof(Permutation) + permutation.rows.capacity() * sizeof(std::uint32_t);
+    }
+    return bytes;
+}
+
+std::size_t RowSorter::evict()
+{
+    if (mPermutations.size() > 1)
+    {
+        mPermutations.erase(mPermutations.begin(), mPermutations.end() - 1);
+    }
+    return memoryUsage();
+}
+
+std::vector<double> RowSorter::sortKeys(const BenchmarkResults& results,
+                                        const SortKey& key) const
+{
+    std::vector<double> keys(results.size());
+    switch (key.kind)
+    {
+        case TableColumnKind::Name:
+        {
+            const auto ranks = alphabeticalRanks(results.names());
+            std::ranges::transform(results.nameColumn(), keys.begin(),
+                                   [&ranks](const StringId name)
+                                   {
+                                       return ranks[name];
+                                   });
+            break;
+        }
+        case TableColumnKind::Aggregate:
+        {
+            // The iteration rows have no aggregate name, so they go first
+            const auto ranks = alphabeticalRanks(results.aggregateNames());
+            for (std::size_t row = 0; row < keys.size(); ++row)
+            {
+                keys[row] = results.runTypeColumn()[row] == RunType::Aggregate
+                                ? ranks[results.aggregateNameColumn()[row]]
+                                : -1.0;
+            }
+            break;
+        }
+        case TableColumnKind::Numeric:
+        {
+            const auto column = results.column(key.column);
+            std::ranges::copy(column, keys.begin());
+            break;
+        }
+    }
+
+    if (key.direction == SortDirection::Descending)
+    {
+        for (auto& value: keys)
+        {
+            value = -value;
+        }
+    }
+    return keys;
+}
+
+}// namespace BPlotter
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Benchmark/BenchmarkResults.hpp"
+#include "Tasks/TaskScheduler.hpp"
+
+namespace BPlotter
+{
+
+/**
+ * \brief Kind of the column of the results table.
+ */
+enum class TableColumnKind
+{
+    Name,
+
+    /**
+     * \brief Name of the aggregate (e.g. "mean"), empty for the iteration rows.
+     */
+    Aggregate,
+
+    /**
+     * \brief Numeric column of the results, selected by its index.
+     */
+    Numeric,
+};
+
+enum class SortDirection
+{
+    Ascending,
+    Descending,
+};
+
+/**
+ * \brief Column and direction the rows of the results table are sorted by.
+ */
+struct SortKey
+{
+    bool operator==(const SortKey&) const = default;
+
+    TableColumnKind kind = TableColumnKind::Name;
+
+    /**
+     * \brief Index of the numeric column, ignored by the other kinds.
+     */
+    ColumnIndex column = 0;
+
+    SortDirection direction = SortDirection::Ascending;
+};
+
+/**
+ * \brief Sorts the rows of the results for the results table without moving them.
+ *
+ * Sorting produces a permutation of the row indices, which is cached per column and direction,
+ * so switching back and forth between the columns costs nothing after the first sort. Rows are
+ * sorted in parallel, by chunks that are merged afterwards. Rows with a missing value are
+ * always placed last and the equal rows keep their original order, so the order is the same
+ * on every machine.
+ *
+ * The permutations are computed again whenever rows are appended to the results.
+ */
+class RowSorter
+{
+public:
+    /**
+     * \param scheduler Scheduler sorting the chunks, must outlive the sorter
+     */
+    explicit RowSorter(TaskScheduler& scheduler);
+
+    /**
+     * \brief Returns the order of the rows sorted by the key, sorting them if it is not cached.
+     * \param results Results whose rows are sorted
+     * \param key Column and direction to sort by
+     * \return Indices of the rows in the sorted order. Valid until the next call.
+     */
+    [[nodiscard]] std::span<const std::uint32_t> order(const BenchmarkResults& results,
+                                                       const SortKey& key);
+
+    /**
+     * \brief Estimates the heap memory taken by the cached permutations.
+     * \return Number of bytes
+     */
+    [[nodiscard]] std::size_t memoryUsage() const noexcept;
+
+    /**
+     * \brief Releases all the cached permutations except the last used one.
+     * \return Number of bytes still held
+     */
+    std::size_t evict();
+
+private:
+    struct Permutation
+    {
+        SortKey key;
+        std::vector<std::uint32_t> rows;
+    };
+
+    /**
+     * \brief Computes the keys the rows are sorted by, negated for the descending order.
+     * Strings are replaced by their rank in the alphabetical order.
+     */
+    [[nodiscard]] std::vector<double> sortKeys(const BenchmarkResults& results,
+                                               const SortKey& key) const;
+
+    /**
+     * \brief What the permutations were computed for, to detect when they are outdated.
+     */
+    TaskScheduler* mScheduler;
+    const BenchmarkResults* mSortedResults = nullptr;
+    std::size_t mSortedRows = 0;
+
+    /**
+     * \brief Cached permutations, the last used one is at the back.
+     */
+    std::vector<Permutation> mPermutations;
+};
+
+}// namespace BPlotter
@@ -0,0 +1,304 @@
+#include "TaskScheduler.hpp"
+#include "pch.hpp"
+
+#include <algorithm>
+#include <exception>
+
+namespace BPlotter
+{
+
+namespace
+{
+
+/**
+ * \brief Scheduler and worker of the calling thread, so that the tasks pushed by a task go
+ * to the queues of its own thread.
+ */
+thread_local const TaskScheduler* currentScheduler = nullptr;
+thread_local std::size_t currentWorker = 0;
+
+/**
+ * \brief Progress of a single parallelFor(), shared with the tasks running its chunks, which
+ * may start after it returned.
+ */
+struct ParallelLoop
+{
+    std::size_t count = 0;
+    std::size_t grainSize = 0;
+    std::size_t chunkCount = 0;
+    const std::function<void(std::size_t, std::size_t)>* body = nullptr;
+    CancellationToken token;
+
+    std::atomic<std::size_t> nextChunk{0};
+    std::atomic<std::size_t> finishedChunks{0};
+    std::atomic<bool> isSkipping{false};
+
+    std::mutex errorMutex;
+    std::exception_ptr error;
+};
+
+/**
+ * \brief Runs the chunks of the loop until none is left. The body is only touched for a
+ * claimed chunk, while the loop still waits for it.
+ */
+void runChunks(ParallelLoop& loop)
+{
+    for (auto chunk = loop.nextChunk++; chunk < loop.chunkCount; chunk = loop.nextChunk++)
+    {
+        if (loop.token.isCancelled())
+        {
+            loop.isSkipping = true;
+        }
+        if (not loop.isSkipping)
+        {
+            const auto begin = chunk * loop.grainSize;
+            try
+            {
+                (*loop.body)(begin, std::min(begin + loop.grainSize, loop.count));
+            }
+            catch (...)
+            {
+                std::lock_guard lock(loop.errorMutex);
+                if (not loop.error)
+                {
+                    loop.error = std::current_exception();
+                }
+                loop.isSkipping = true;
+            }
+        }
+        if (loop.finishedChunks.fetch_add(1) + 1 == loop.chunkCount)
+        {
+            loop.finishedChunks.notify_all();
+        }
+    }
+}
+
+}// namespace
+
+const char* toString(const TaskPriority priority)
+{
+    switch (priority)
+    {
+        case TaskPriority::Interactive: return "Interactive";
+        case TaskPriority::Background: return "Background";
+    }
+    return "";
+}
+
+CancellationToken::CancellationToken(std::shared_ptr<const std::atomic<bool>> isCancelled)
+    : mIsCancelled(std::move(isCancelled))
+{
+}
+
+bool CancellationToken::isCancelled() const noexcept
+{
+    return mIsCancelled && mIsCancelled->load(std::memory_order_relaxed);
+}
+
+CancellationSource::CancellationSource()
+    : mIsCancelled(std::make_shared<std::atomic<bool>>(false))
+{
+}
+
+CancellationToken CancellationSource::token() const
+{
+    return CancellationToken(mIsCancelled);
+}
+
+void CancellationSource::cancel() noexcept
+{
+    mIsCancelled->store(true, std::memory_order_relaxed);
+}
+
+bool CancellationSource::isCancelled() const noexcept
+{
+    return mIsCancelled->load(std::memory_order_relaxed);
+}
+
+TaskScheduler::TaskScheduler(const std::size_t threadCount)
+{
+    const auto count = std::max<std::size_t>(threadCount, 1);
+    mWorkers.reserve(count);
+    for (std::size_t worker = 0; worker < count; ++worker)
+    {
+        mWorkers.push_back(std::make_unique<Worker>());
+    }
+    // Only once all the workers exist, as the threads steal from each other
+    mThreads.reserve(count);
+    for (std::size_t worker = 0; worker < count; ++worker)
+    {
+        mThreads.emplace_back(
+            [this, worker]
+            {
+                run(worker);
+            });
+    }
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    {
+        std::lock_guard lock(mSleepMutex);
+        mIsStopping = true;
+    }
+    mWakeUp.notify_all();
+    mThreads.clear();
+}
+
+bool TaskScheduler::parallelFor(const std::size_t count, const std::size_t grainSize,
+                                const std::function<void(std::size_t, std::size_t)>& body,
+                                const TaskPriority priority, const CancellationToken& token)
+{
+    if (count == 0)
+    {
+        return not token.isCancelled();
+    }
+
+    auto loop = std::make_shared<ParallelLoop>();
+    loop->count = count;
+    loop->grainSize = std::max<std::size_t>(grainSize, 1);
+    loop->chunkCount = (count + loop->grainSize - 1) / loop->grainSize;
+    loop->body = &body;
+    loop->token = token;
+
+    // The calling thread takes one of the chunks, the helpers that find none left do nothing
+    const auto helperCount = std::min(loop->chunkCount - 1, mWorkers.size());
+    for (std::size_t helper = 0; helper < helperCount; ++helper)
+    {
+        push(priority,
+             [loop]
+             {
+                 runChunks(*loop);
+             });
+    }
+    runChunks(*loop);
+
+    for (auto finished = loop->finishedChunks.load(); finished != loop->chunkCount;
+         finished = loop->finishedChunks.load())
+    {
+        loop->finishedChunks.wait(finished);
+    }
+    if (loop->error)
+    {
+        std::rethrow_exception(loop->error);
+    }
+    return not loop->isSkipping;
+}
+
+std::size_t TaskScheduler::threadCount() const noexcept
+{
+    return mWorkers.size();
+}
+
+TaskSchedulerStatistics TaskScheduler::statistics() const
+{
+    TaskSchedulerStatistics statistics;
+    statistics.threadCount = mWorkers.size();
+    for (std::size_t priority = 0; priority < TASK_PRIORITY_COUNT; ++priority)
+    {
+        statistics.queuedTasks[priority] = mQueuedTasks[priority].load(std::memory_order_relaxed);
+    }
+    statistics.executedTasks = mExecutedTasks.load(std::memory_order_relaxed);
+    statistics.stolenTasks = mStolenTasks.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+std::size_t TaskScheduler::defaultThreadCount()
+{
+    return std::max(2u, std::thread::hardware_concurrency()) - 1;
+}
+
+void TaskScheduler::push(const TaskPriority priority, std::function<void()> function)
+{
+    const auto worker = currentScheduler == this ? currentWorker
+                                                 : mNextWorker++ % mWorkers.size();
+    const auto index = static_cast<std::size_t>(priority);
+    {
+        auto& target = *mWorkers[worker];
+        std::lock_guard lock(target.mutex);
+        target.queues[index].push_back({std::move(function), currentAllocationSubsystem()});
+        ++mQueuedTasks[index];
+    }
+
+    // Taking the mutex orders the push before the check of a thread that is falling asleep
+    {
+        std::lock_guard lock(mSleepMutex);
+    }
+    mWakeUp.notify_one();
+}
+
+TaskScheduler::Task TaskScheduler::pop(const std::size_t worker)
+{
+    for (std::size_t priority = 0; priority < TASK_PRIORITY_COUNT; ++priority)
+    {
+        if (mQueuedTasks[priority].load() == 0)
+        {
+            continue;
+        }
+        for (std::size_t offset = 0; offset < mWorkers.size(); ++offset)
+        {
+            const auto isOwn = offset == 0;
+            auto& victim = *mWorkers[(worker + offset) % mWorkers.size()];
+            std::lock_guard lock(victim.mutex);
+            auto& queue = victim.queues[priority];
+            if (queue.empty())
+            {
+                continue;
+            }
+            Task task;
+            if (isOwn)
+            {
+                task = std::move(queue.back());
+                queue.pop_back();
+            }
+            else
+            {
+                task = std::move(queue.front());
+                queue.pop_front();
+                ++mStolenTasks;
+            }
+            --mQueuedTasks[priority];
+            return task;
+        }
+    }
+    return {};
+}
+
+void TaskScheduler::run(const std::size_t worker)
+{
+    currentScheduler = this;
+    currentWorker = worker;
+    while (true)
+    {
+        if (auto task = pop(worker); task.function)
+        {
+            AllocationScope scope(task.subsystem);
+            task.function();
+            ++mExecutedTasks;
+            continue;
+        }
+
+        std::unique_lock lock(mSleepMutex);
+        mWakeUp.wait(lock,
+                     [this]
+                     {
+                         return mIsStopping || queuedTasks() > 0;
+                     });
+        if (mIsStopping && queuedTasks() == 0)
+        {
+            return;
+        }
+    }
+}
+
+std::size_t TaskScheduler::queuedTasks() const noexcept
+{
+    auto count = std::size_t{0};
+    for (const auto& queued: mQueuedTasks)
+    {
+        count += queued.load();
+    }
+    return count;
+}
+
+}// namespace BPlotter
@@ -0,0 +1,234 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "Memory/AllocationTracker.hpp"
+
+namespace BPlotter
+{
+
+/**
+ * \brief Order in which the queued tasks are started.
+ */
+enum class TaskPriority : std::uint8_t
+{
+    /**
+     * \brief Work the user waits for to see the result, such as the series of the plot.
+     */
+    Interactive,
+
+    /**
+     * \brief Work nobody looks at yet, such as saving the session.
+     */
+    Background,
+};
+
+constexpr std::size_t TASK_PRIORITY_COUNT = 2;
+
+/**
+ * \brief Converts the priority to text that can be displayed.
+ * \param priority Priority of the tasks
+ * \return Name of the priority
+ */
+const char* toString(TaskPriority priority);
+
+/**
+ * \brief Tells the work started with it that it is no longer needed. Obtained from a
+ * CancellationSource; a default constructed token is never cancelled.
+ */
+class CancellationToken
+{
+public:
+    CancellationToken() = default;
+
+    [[nodiscard]] bool isCancelled() const noexcept;
+
+private:
+    friend class CancellationSource;
+    explicit CancellationToken(std::shared_ptr<const std::atomic<bool>> isCancelled);
+
+    std::shared_ptr<const std::atomic<bool>> mIsCancelled;
+};
+
+/**
+ * \brief Cancels the work started with its tokens. The work checks the tokens on its own, so
+ * it stops at its next check, not immediately.
+ */
+class CancellationSource
+{
+public:
+    CancellationSource();
+
+    [[nodiscard]] CancellationToken token() const;
+    void cancel() noexcept;
+    [[nodiscard]] bool isCancelled() const noexcept;
+
+private:
+    std::shared_ptr<std::atomic<bool>> mIsCancelled;
+};
+
+/**
+ * \brief Counters of the scheduler displayed in the performance panel.
+ */
+struct TaskSchedulerStatistics
+{
+    std::size_t threadCount = 0;
+
+    /**
+     * \brief Tasks waiting to be started, for each priority.
+     */
+    std::array<std::size_t, TASK_PRIORITY_COUNT> queuedTasks{};
+    std::uint64_t executedTasks = 0;
+
+    /**
+     * \brief Tasks a thread took out of the queue of another one, since it had none left.
+     */
+    std::uint64_t stolenTasks = 0;
+};
+
+/**
+ * \brief Runs all the background work of the application on a single pool of threads, so
+ * that features do not start threads of their own and oversubscribe the cores.
+ *
+ * Every thread has a queue for each priority. A thread takes the newest task of its own
+ * queues, which the task it ran before likely pushed and whose data are still in its cache,
+ * and once they are empty it steals the oldest task of another thread. The interactive
+ * tasks of all the queues are started before any background one.
+ *
+ * A task must not block on the future of another task, which may be queued behind it;
+ * parallelFor() is meant for splitting the work of a task instead. The allocations of a task
+ * are attributed to the AllocationSubsystem of the thread that queued it.
+ */
+class TaskScheduler
+{
+public:
+    /**
+     * \brief Starts the threads.
+     * \param threadCount Number of the threads, by default one less than the number of the
+     * cores, as the main thread renders the frames meanwhile
+     */
+    explicit TaskScheduler(std::size_t threadCount = defaultThreadCount());
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    /**
+     * \brief Runs all the queued tasks, then stops the threads.
+     */
+    ~TaskScheduler();
+
+    /**
+     * \brief Queues the function to be run by one of the threads.
+     * \param priority Priority of the task
+     * \param function Function to be run, its exceptions are stored in the returned future
+     * \return Future of the result of the function
+     */
+    template<typename Function>
+    [[nodiscard]] std::future<std::invoke_result_t<std::decay_t<Function>>> submit(
+        TaskPriority priority, Function&& function);
+
+    /**
+     * \brief Runs the body over the range [0, count) split into chunks, in parallel. The
+     * calling thread runs the chunks as well, so it can be called from a task too.
+     * \param count Size of the range
+     * \param grainSize Number of the indices of a chunk, large enough for a chunk to outweigh
+     * the cost of its task
+     * \param body Function called with the bounds [begin, end) of every chunk
+     * \param priority Priority of the tasks of the chunks
+     * \param token Once cancelled, the chunks that did not start yet are skipped
+     * \return False if some chunks were skipped
+     *
+     * Returns once all the started chunks finish. The first exception thrown by the body
+     * skips the remaining chunks and is rethrown.
+     */
+    bool parallelFor(std::size_t count, std::size_t grainSize,
+                     const std::function<void(std::size_t, std::size_t)>& body,
+                     TaskPriority priority = TaskPriority::Interactive,
+                     const CancellationToken& token = {});
+
+    [[nodiscard]] std::size_t threadCount() const noexcept;
+    [[nodiscard]] TaskSchedulerStatistics statistics() const;
+
+    [[nodiscard]] static std::size_t defaultThreadCount();
+
+private:
+    struct Task
+    {
+        std::function<void()> function;
+
+        /**
+         * \brief Subsystem of the thread that queued the task, which the task runs in.
+         */
+        AllocationSubsystem subsystem = AllocationSubsystem::Other;
+    };
+
+    struct Worker
+    {
+        std::mutex mutex;
+        std::array<std::deque<Task>, TASK_PRIORITY_COUNT> queues;
+    };
+
+    /**
+     * \brief Queues the task to the calling thread, if it is one of the threads of the
+     * scheduler, otherwise to the threads in turn.
+     */
+    void push(TaskPriority priority, std::function<void()> function);
+
+    /**
+     * \brief Takes the most urgent task, from the worker's own queues first.
+     * \return The task, or one with an empty function if all the queues are empty
+     */
+    Task pop(std::size_t worker);
+
+    void run(std::size_t worker);
+
+    [[nodiscard]] std::size_t queuedTasks() const noexcept;
+
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+    std::vector<std::jthread> mThreads;
+
+    /**
+     * \brief Worker the next task pushed from outside of the scheduler goes to.
+     */
+    std::atomic<std::size_t> mNextWorker{0};
+
+    std::array<std::atomic<std::size_t>, TASK_PRIORITY_COUNT> mQueuedTasks{};
+    std::atomic<std::uint64_t> mExecutedTasks{0};
+    std::atomic<std::uint64_t> mStolenTasks{0};
+
+    /**
+     * \brief The idle threads sleep until a task is pushed or the scheduler stops.
+     */
+    std::mutex mSleepMutex;
+    std::condition_variable mWakeUp;
+    bool mIsStopping = false;
+};
+
+template<typename Function>
+std::future<std::invoke_result_t<std::decay_t<Function>>> TaskScheduler::submit(
+    const TaskPriority priority, Function&& function)
+{
+    using Result = std::invoke_result_t<std::decay_t<Function>>;
+
+    // The packaged task can not be copied, but the queued function must be
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Function>(function));
+    auto future = task->get_future();
+    push(priority,
+         [task = std::move(task)]
+         {
+             (*task)();
+         });
+    return future;
+}
+
+}// namespace BPlotter
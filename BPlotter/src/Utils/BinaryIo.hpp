@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace BPlotter
+{
+
+/**
+ * \brief Writes the value as its raw bytes, in the byte order of the machine.
+ * \param output Binary output stream
+ * \param value Trivially copyable value
+ */
+template<typename T>
+void writeValue(std::ostream& output, const T& value)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    output.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/**
+ * \brief Reads the value written by writeValue().
+ * \param input Binary input stream
+ * \param value Read value
+ * \return False if the stream ended or failed before the whole value was read
+ */
+template<typename T>
+bool readValue(std::istream& input, T& value)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    return static_cast<bool>(input.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+/**
+ * \brief Writes the text preceded by its length.
+ * \param output Binary output stream
+ * \param text Text to be written
+ */
+inline void writeString(std::ostream& output, const std::string_view text)
+{
+    writeValue(output, static_cast<std::uint32_t>(text.size()));
+    output.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+/**
+ * \brief Counts the bytes left in the stream, leaving its position where it was.
+ * \param input Binary input stream
+ * \return Number of bytes, or the largest size if the stream can not be sought
+ */
+inline std::size_t remainingBytes(std::istream& input)
+{
+    const auto position = input.tellg();
+    if (position == std::istream::pos_type(-1) || !input.seekg(0, std::ios::end))
+    {
+        input.clear();
+        return std::numeric_limits<std::size_t>::max();
+    }
+    const auto end = input.tellg();
+    input.seekg(position);
+    return static_cast<std::size_t>(end - position);
+}
+
+/**
+ * \brief Texts up to this length are read without checking the rest of the stream first,
+ * which would mean seeking for every one of them.
+ */
+constexpr auto UNCHECKED_STRING_SIZE = std::uint32_t{4096};
+
+/**
+ * \brief Reads the text written by writeString().
+ *
+ * A length longer than the rest of the stream fails the stream before anything is allocated
+ * for it, so that a corrupted length does not allocate up to 4 GiB.
+ * \param input Binary input stream
+ * \param text Read text, empty if the read failed
+ * \return False if the stream ended or failed before the whole text was read
+ */
+inline bool readString(std::istream& input, std::string& text)
+{
+    auto size = std::uint32_t{0};
+    if (!readValue(input, size) ||
+        (size > UNCHECKED_STRING_SIZE && size > remainingBytes(input)))
+    {
+        input.setstate(std::ios::failbit);
+        text.clear();
+        return false;
+    }
+    text.resize(size);
+    if (!input.read(text.data(), size))
+    {
+        text.clear();
+        return false;
+    }
+    return true;
+}
+
+}// namespace BPlotter
@@ -0,0 +1,118 @@
+#include "FrameArena.hpp"
+#include "pch.hpp"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace BPlotter
+{
+
+FrameArena::FrameArena(const std::size_t capacity)
+{
+    mChunks.push_back({std::make_unique<std::byte[]>(capacity), capacity});
+}
+
+void* FrameArena::allocate(const std::size_t bytes, const std::size_t alignment)
+{
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+    const auto padding = [this, alignment]
+    {
+        const auto address = reinterpret_cast<std::uintptr_t>(mChunks.back().data.get() + mOffset);
+        return (alignment - address % alignment) % alignment;
+    };
+    if (mOffset + padding() + bytes > mChunks.back().size)
+    {
+        grow(bytes + alignment);
+    }
+
+    auto* data = mChunks.back().data.get() + mOffset + padding();
+    mOffset = static_cast<std::size_t>(data - mChunks.back().data.get()) + bytes;
+    return data;
+}
+
+const char* FrameArena::copy(const std::string_view text)
+{
+    auto* copied = static_cast<char*>(allocate(text.size() + 1, 1));
+    std::memcpy(copied, text.data(), text.size());
+    copied[text.size()] = '\0';
+    return copied;
+}
+
+const char* FrameArena::format(const char* format, ...)
+{
+    // The text is formatted right into the free space, and again if it does not fit
+    const auto free = mChunks.back().size - mOffset;
+    auto* text = reinterpret_cast<char*>(mChunks.back().data.get() + mOffset);
+
+    std::va_list arguments;
+    va_start(arguments, format);
+    std::va_list retry;
+    va_copy(retry, arguments);
+    const auto length = std::vsnprintf(text, free, format, arguments);
+    va_end(arguments);
+
+    if (length < 0)
+    {
+        va_end(retry);
+        return "";
+    }
+    const auto size = static_cast<std::size_t>(length) + 1;
+    if (size <= free)
+    {
+        mOffset += size;
+    }
+    else
+    {
+        text = static_cast<char*>(allocate(size, 1));
+        std::vsnprintf(text, size, format, retry);
+    }
+    va_end(retry);
+    return text;
+}
+
+void FrameArena::reset()
+{
+    if (mChunks.size() > 1)
+    {
+        const auto total = capacity();
+        mChunks.clear();
+        mChunks.push_back({std::make_unique<std::byte[]>(total), total});
+    }
+    mOffset = 0;
+    mUsedInFullChunks = 0;
+}
+
+std::size_t FrameArena::used() const noexcept
+{
+    return mUsedInFullChunks + mOffset;
+}
+
+std::size_t FrameArena::capacity() const noexcept
+{
+    auto total = std::size_t{0};
+    for (const auto& chunk: mChunks)
+    {
+        total += chunk.size;
+    }
+    return total;
+}
+
+void FrameArena::grow(const std::size_t bytes)
+{
+    mUsedInFullChunks += mOffset;
+    const auto size = std::max(bytes, mChunks.back().size * 2);
+    mChunks.push_back({std::make_unique<std::byte[]>(size), size});
+    mOffset = 0;
+}
+
+FrameArena& frameArena()
+{
+    static FrameArena arena;
+    return arena;
+}
+
+}// namespace BPlotter
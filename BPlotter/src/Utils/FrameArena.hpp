@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace BPlotter
+{
+
+/**
+ * \brief Bump allocator for the data that lives only until the end of the frame, like the
+ * labels passed to ImGui or the ticks of an axis.
+ *
+ * Allocating just moves an offset inside a chunk and nothing is freed one by one: the whole
+ * arena is reset at once when the frame ends. If a frame needs more memory than there is,
+ * another chunk is added and the chunks are merged into a single bigger one on the next
+ * reset, so once the arena grows to fit a frame it does not touch the heap anymore.
+ *
+ * The arena is not thread-safe, it is meant to be used by the thread building the frame.
+ */
+class FrameArena
+{
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 256 * 1024;
+
+    /**
+     * \brief Creates the arena with a single chunk.
+     * \param capacity Size of the chunk in bytes
+     */
+    explicit FrameArena(std::size_t capacity = DEFAULT_CAPACITY);
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /**
+     * \brief Allocates uninitialized memory valid until the next reset.
+     * \param bytes Number of bytes
+     * \param alignment Alignment of the memory, a power of two
+     * \return Pointer to the memory
+     */
+    [[nodiscard]] void* allocate(std::size_t bytes, std::size_t alignment);
+
+    /**
+     * \brief Copies the text into the arena, e.g. to pass a string view to ImGui.
+     * \param text Text to be copied
+     * \return Null-terminated copy of the text
+     */
+    [[nodiscard]] const char* copy(std::string_view text);
+
+    /**
+     * \brief Formats the text into the arena in the style of printf(), like ImGui does.
+     * \param format Format string of printf()
+     * \return Null-terminated formatted text
+     */
+    [[nodiscard]] const char* format(const char* format, ...);
+
+    /**
+     * \brief Releases everything allocated since the last reset, which must not be used
+     * anymore. Merges the chunks into one if the frame did not fit the first chunk.
+     */
+    void reset();
+
+    /**
+     * \brief Number of bytes allocated since the last reset, including the alignment.
+     * \return Number of bytes
+     */
+    [[nodiscard]] std::size_t used() const noexcept;
+
+    /**
+     * \brief Total size of all the chunks.
+     * \return Number of bytes
+     */
+    [[nodiscard]] std::size_t capacity() const noexcept;
+
+private:
+    struct Chunk
+    {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t size = 0;
+    };
+
+    /**
+     * \brief Adds a chunk that has at least the given number of free bytes.
+     */
+    void grow(std::size_t bytes);
+
+    std::vector<Chunk> mChunks;
+
+    /**
+     * \brief Offset of the free memory in the last chunk.
+     */
+    std::size_t mOffset = 0;
+
+    /**
+     * \brief Bytes allocated in all the chunks but the last one.
+     */
+    std::size_t mUsedInFullChunks = 0;
+};
+
+/**
+ * \brief Allocator of the standard containers taking memory from a FrameArena, so the
+ * containers must not outlive the frame.
+ */
+template<typename T>
+class FrameAllocator
+{
+public:
+    using value_type = T;
+
+    explicit FrameAllocator(FrameArena& arena) noexcept
+        : mArena(&arena)
+    {
+    }
+
+    template<typename U>
+    FrameAllocator(const FrameAllocator<U>& other) noexcept
+        : mArena(other.mArena)
+    {
+    }
+
+    [[nodiscard]] T* allocate(const std::size_t count)
+    {
+        return static_cast<T*>(mArena->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, std::size_t) noexcept
+    {
+        // Released all at once when the arena is reset
+    }
+
+    template<typename U>
+    bool operator==(const FrameAllocator<U>& other) const noexcept
+    {
+        return mArena == other.mArena;
+    }
+
+private:
+    template<typename U>
+    friend class FrameAllocator;
+
+    FrameArena* mArena;
+};
+
+template<typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+/**
+ * \brief Arena of the frame being built, reset by the Application when the frame is rendered.
+ * \return Arena of the current frame
+ */
+FrameArena& frameArena();
+
+}// namespace BPlotter
@@ -3,6 +3,8 @@
 #include <spdlog/sinks/base_sink.h>
 #include <string>
 
+#include "Memory/AllocationTracker.hpp"
+
 /**
  * \brief A log entry that can be displayed in ImGui.
  */
@@ -61,6 +63,7 @@ protected:
      */
     void sink_it_(const spdlog::details::log_msg& msg) override
     {
+        BPlotter::AllocationScope scope(BPlotter::AllocationSubsystem::Logging);
         spdlog::memory_buf_t formatted;
         this->formatter_->format(msg, formatted);
         log->log(fmt::to_string(formatted), msg.level);
@@ -0,0 +1,238 @@
+#include "NumberFormat.hpp"
+#include "pch.hpp"
+
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+namespace BPlotter
+{
+
+namespace
+{
+
+/**
+ * \brief Digits of a scaled value, which differs from the exact one by the rounding error.
+ */
+constexpr int SCALED_PRECISION = 15;
+
+/**
+ * \brief Most entries the cache holds before it is emptied, to keep the probing short.
+ */
+constexpr std::size_t MAX_CACHE_LOAD = FormattedNumberCache::CAPACITY * 3 / 4;
+
+/**
+ * \brief Text returned when the number does not fit the buffer. Unlike an empty view, its data
+ * can still be passed where a null-terminated string is expected.
+ */
+constexpr std::string_view EMPTY_TEXT = "";
+
+struct Prefix
+{
+    double factor;
+    const char* symbol;
+};
+
+constexpr std::array TIME_PREFIXES{Prefix{1, "ns"}, Prefix{1e3, "us"}, Prefix{1e6, "ms"},
+                                   Prefix{1e9, "s"}};
+constexpr std::array DECIMAL_PREFIXES{Prefix{1, ""},     Prefix{1e3, "k"},  Prefix{1e6, "M"},
+                                      Prefix{1e9, "G"},  Prefix{1e12, "T"}, Prefix{1e15, "P"},
+                                      Prefix{1e18, "E"}};
+constexpr std::array BINARY_PREFIXES{
+    Prefix{1, ""},
+    Prefix{1024.0, "Ki"},
+    Prefix{1024.0 * 1024, "Mi"},
+    Prefix{1024.0 * 1024 * 1024, "Gi"},
+    Prefix{1024.0 * 1024 * 1024 * 1024, "Ti"},
+    Prefix{1024.0 * 1024 * 1024 * 1024 * 1024, "Pi"},
+    Prefix{1024.0 * 1024 * 1024 * 1024 * 1024 * 1024, "Ei"},
+};
+
+/**
+ * \brief Largest prefix that keeps the magnitude of the value at least one.
+ */
+Prefix prefixOf(const double value, const std::span<const Prefix> prefixes)
+{
+    const auto magnitude = std::abs(value);
+    auto chosen = prefixes.front();
+    for (const auto& prefix: prefixes)
+    {
+        if (magnitude >= prefix.factor)
+        {
+            chosen = prefix;
+        }
+    }
+    return chosen;
+}
+
+std::span<const Prefix> prefixesOf(const NumberFormat& format)
+{
+    switch (format.unit)
+    {
+        case Unit::None: return {};
+        case Unit::Nanoseconds: return TIME_PREFIXES;
+        case Unit::ItemsPerSecond: return DECIMAL_PREFIXES;
+        case Unit::Bytes:
+        case Unit::BytesPerSecond:
+            if (format.prefixes == Prefixes::Binary)
+            {
+                return BINARY_PREFIXES;
+            }
+            return DECIMAL_PREFIXES;
+    }
+    return {};
+}
+
+const char* suffixOf(const Unit unit)
+{
+    switch (unit)
+    {
+        case Unit::None:
+        case Unit::Nanoseconds: return "";
+        case Unit::Bytes: return "B";
+        case Unit::BytesPerSecond: return "B/s";
+        case Unit::ItemsPerSecond: return " items/s";
+    }
+    return "";
+}
+
+std::size_t hashOf(const std::uint64_t valueBits, const NumberFormat& format)
+{
+    auto hash = valueBits ^ (static_cast<std::uint64_t>(format.unit) << 8 |
+                             static_cast<std::uint64_t>(format.prefixes) << 16 |
+                             static_cast<std::uint64_t>(format.precision) << 24);
+    // Finalizer of MurmurHash3, the low bits of doubles are often all zero
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return static_cast<std::size_t>(hash);
+}
+
+}// namespace
+
+NumberFormat formatOfColumn(const std::string_view columnName)
+{
+    if (columnName == "real_time" || columnName == "cpu_time")
+    {
+        return {.unit = Unit::Nanoseconds};
+    }
+    if (columnName == "bytes_per_second")
+    {
+        return {.unit = Unit::BytesPerSecond};
+    }
+    if (columnName == "items_per_second")
+    {
+        return {.unit = Unit::ItemsPerSecond};
+    }
+    return {};
+}
+
+std::string_view formatNumber(double value, const NumberFormat& format,
+                              const std::span<char> buffer) noexcept
+{
+    auto* const first = buffer.data();
+    auto* const last = first + buffer.size();
+
+    const auto prefixes = prefixesOf(format);
+    const auto* symbol = "";
+    auto isScaled = false;
+    if (not prefixes.empty() && std::isfinite(value))
+    {
+        const auto prefix = prefixOf(value, prefixes);
+        isScaled = prefix.factor != 1;
+        value /= prefix.factor;
+        symbol = prefix.symbol;
+    }
+
+    const auto precision = format.precision == 0 && isScaled ? SCALED_PRECISION : format.precision;
+    const auto [end, error] = precision == 0
+                                  ? std::to_chars(first, last, value)
+                                  : std::to_chars(first, last, value, std::chars_format::general,
+                                                  static_cast<int>(precision));
+    if (error != std::errc())
+    {
+        return EMPTY_TEXT;
+    }
+
+    auto* position = end;
+    const auto append = [&position, last](const char* text)
+    {
+        const auto length = std::strlen(text);
+        if (static_cast<std::size_t>(last - position) < length)
+        {
+            return false;
+        }
+        std::memcpy(position, text, length);
+        position += length;
+        return true;
+    };
+    // A missing value has no unit
+    if (format.unit != Unit::None && std::isfinite(value))
+    {
+        const auto* space = format.unit == Unit::ItemsPerSecond ? "" : " ";
+        if (not append(space) || not append(symbol) || not append(suffixOf(format.unit)))
+        {
+            return EMPTY_TEXT;
+        }
+    }
+    if (position != last)
+    {
+        *position = '\0';
+    }
+    return {first, static_cast<std::size_t>(position - first)};
+}
+
+FormattedNumberCache::FormattedNumberCache()
+    : mEntries(std::make_unique<Entry[]>(CAPACITY))
+{
+}
+
+const char* FormattedNumberCache::format(const double value, const NumberFormat& format)
+{
+    const auto valueBits = std::bit_cast<std::uint64_t>(value);
+    if (mSize >= MAX_CACHE_LOAD)
+    {
+        clear();
+    }
+
+    // Linear probing, the table is never full so an empty entry is always found
+    auto index = hashOf(valueBits, format) % CAPACITY;
+    while (mEntries[index].isUsed)
+    {
+        const auto& entry = mEntries[index];
+        if (entry.valueBits == valueBits && entry.format == format)
+        {
+            return entry.text;
+        }
+        index = (index + 1) % CAPACITY;
+    }
+
+    auto& entry = mEntries[index];
+    entry.valueBits = valueBits;
+    entry.format = format;
+    entry.isUsed = true;
+    // The buffer is large enough for any number, so the text is always null-terminated
+    const auto text =
+        formatNumber(value, format, std::span<char>(entry.text, NUMBER_BUFFER_SIZE - 1));
+    entry.text[text.size()] = '\0';
+    ++mSize;
+    return entry.text;
+}
+
+std::size_t FormattedNumberCache::size() const noexcept
+{
+    return mSize;
+}
+
+void FormattedNumberCache::clear() noexcept
+{
+    for (std::size_t i = 0; i < CAPACITY; ++i)
+    {
+        mEntries[i].isUsed = false;
+    }
+    mSize = 0;
+}
+
+}// namespace BPlotter
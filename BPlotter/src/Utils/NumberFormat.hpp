@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+
+namespace BPlotter
+{
+
+/**
+ * \brief Unit of a formatted value, which is scaled to the prefix that suits its magnitude.
+ */
+enum class Unit : std::uint8_t
+{
+    None,
+
+    /**
+     * \brief Times, which the parser converts to nanoseconds. Scaled up to seconds.
+     */
+    Nanoseconds,
+    Bytes,
+    BytesPerSecond,
+    ItemsPerSecond,
+};
+
+/**
+ * \brief Prefixes of the byte units: powers of 1000 (kB, MB) or of 1024 (KiB, MiB).
+ */
+enum class Prefixes : std::uint8_t
+{
+    Decimal,
+    Binary,
+};
+
+/**
+ * \brief How a number is formatted.
+ */
+struct NumberFormat
+{
+    Unit unit = Unit::None;
+    Prefixes prefixes = Prefixes::Binary;
+
+    /**
+     * \brief Number of significant digits, like the precision of printf("%g"). Zero stands
+     * for the shortest text that reads back as the same value; scaled values, which are no
+     * longer exact, get 15 digits instead so that the error of the scaling is not shown.
+     */
+    std::uint8_t precision = 0;
+
+    bool operator==(const NumberFormat&) const = default;
+};
+
+/**
+ * \brief Size of a buffer that fits any formatted number with its unit and the terminating
+ * null character.
+ */
+constexpr std::size_t NUMBER_BUFFER_SIZE = 48;
+
+/**
+ * \brief Guesses the unit of a column of the benchmark results from its name, following the
+ * names used by Google Benchmark (real_time, bytes_per_second, items_per_second).
+ * \param columnName Name of the column
+ * \return Format of the values of the column
+ */
+NumberFormat formatOfColumn(std::string_view columnName);
+
+/**
+ * \brief Formats the number with std::to_chars, scaling it to the prefix of its unit. Does
+ * not allocate.
+ * \param value Value in the base unit, e.g. in nanoseconds
+ * \param format How the value is formatted
+ * \param buffer Buffer the text is written to, null-terminated if there is space left
+ * \return Text written into the buffer, or an empty text that is still null-terminated if the
+ * buffer is too small
+ */
+std::string_view formatNumber(double value, const NumberFormat& format,
+                              std::span<char> buffer) noexcept;
+
+/**
+ * \brief Remembers the formatted numbers, so that labels that stay the same from frame to
+ * frame, such as the ticks of an axis, are formatted only once.
+ *
+ * It is a fixed-size hash table with open addressing that is emptied once it gets too full,
+ * so neither a lookup nor an insertion allocates.
+ */
+class FormattedNumberCache
+{
+public:
+    static constexpr std::size_t CAPACITY = 1024;
+
+    FormattedNumberCache();
+
+    /**
+     * \brief Formats the number, or finds it formatted already.
+     * \param value Value in the base unit
+     * \param format How the value is formatted
+     * \return Null-terminated text valid until the cache is emptied, which may happen on any
+     * later call
+     */
+    [[nodiscard]] const char* format(double value, const NumberFormat& format);
+
+    /**
+     * \brief Number of the cached texts.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    void clear() noexcept;
+
+private:
+    struct Entry
+    {
+        std::uint64_t valueBits = 0;
+        NumberFormat format;
+        bool isUsed = false;
+        char text[NUMBER_BUFFER_SIZE]{};
+    };
+
+    std::unique_ptr<Entry[]> mEntries;
+    std::size_t mSize = 0;
+};
+
+}// namespace BPlotter
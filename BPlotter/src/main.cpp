@@ -1,7 +1,9 @@
 #include "Application.hpp"
 #include "pch.hpp"
 
-int main()
+#include "Compare/CompareCommand.hpp"
+
+int main(int argc, char* argv[])
 {
 #if (defined(_MSC_VER) && defined(_DEBUG))
     _CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
@@ -14,9 +16,24 @@ int main()
     #endif
 #endif
 
+    // The compare mode runs headless, before anything creates a window or initializes ImGui
+    if (argc > 1 && std::string_view(argv[1]) == "compare")
+    {
+        const auto arguments = std::vector<std::string_view>(argv + 2, argv + argc);
+        return static_cast<int>(BPlotter::runCompareCommand(arguments));
+    }
+
+    const auto arguments = std::vector<std::string_view>(argv + 1, argv + argc);
+    auto options = BPlotter::parseApplicationArguments(arguments);
+    if (options.has_error())
+    {
+        fmt::print(stderr, "{}\n\n{}", options.error(), BPlotter::APPLICATION_USAGE);
+        return 2;
+    }
+
     try
     {
-        const auto application = std::make_unique<BPlotter::Application>();
+        const auto application = std::make_unique<BPlotter::Application>(std::move(*options));
         application->run();
     }
     catch (const std::exception& e)
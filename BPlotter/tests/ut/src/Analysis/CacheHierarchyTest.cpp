@@ -0,0 +1,54 @@
+#include "Analysis/CacheHierarchy.hpp"
+#include "gtest/gtest.h"
+
+namespace
+{
+
+using namespace BPlotter;
+
+BenchmarkContext contextWithCaches()
+{
+    BenchmarkContext context;
+    context.caches = {{"Unified", 2, 1024.0 * 1024.0, 2},
+                      {"Data", 1, 32 * 1024.0, 2},
+                      {"Instruction", 1, 32 * 1024.0, 2}};
+    return context;
+}
+
+TEST(CacheHierarchyTest, ListsDataCachesFromTheSmallest)
+{
+    const auto boundaries = cacheBoundaries(contextWithCaches());
+
+    ASSERT_EQ(boundaries.size(), 2);
+    EXPECT_EQ(boundaries[0].label, "L1d 32 KiB (shared by 2)");
+    EXPECT_DOUBLE_EQ(boundaries[0].bytes, 32 * 1024.0);
+    EXPECT_EQ(boundaries[1].label, "L2 1 MiB (shared by 2)");
+}
+
+TEST(CacheHierarchyTest, DetectsKneeNearCacheBoundary)
+{
+    // Time per element is flat while the data fits into L1 and grows once it does not
+    Series series{"BM_Traverse"};
+    for (double bytes = 1024; bytes <= 1024 * 1024; bytes *= 2)
+    {
+        series.x.push_back(bytes);
+        series.y.push_back(bytes <= 32 * 1024 ? 1.0 : bytes / (32 * 1024));
+    }
+
+    const auto boundaries = cacheBoundaries(contextWithCaches());
+    const auto knees = detectCacheKnees(series, boundaries);
+
+    ASSERT_EQ(knees.size(), 1);
+    EXPECT_EQ(knees[0].boundary, 0);
+    EXPECT_DOUBLE_EQ(knees[0].x, 32 * 1024);
+    EXPECT_NEAR(knees[0].slopeIncrease, 1.0, 1e-9);
+}
+
+TEST(CacheHierarchyTest, LinearSeriesHasNoKnees)
+{
+    Series series{"BM_Linear", {1024, 4096, 32768, 262144}, {1, 4, 32, 256}};
+
+    EXPECT_TRUE(detectCacheKnees(series, cacheBoundaries(contextWithCaches())).empty());
+}
+
+}// namespace
@@ -0,0 +1,132 @@
+#include "Analysis/ChangePointDetection.hpp"
+#include "TestUtils/TemporaryDirectory.hpp"
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <random>
+
+namespace
+{
+
+using namespace BPlotter;
+
+/**
+ * \brief History with the given levels, each run having three noisy repetitions.
+ */
+std::vector<HistoryPoint> noisyHistory(const std::vector<double>& levels, const double noise)
+{
+    std::mt19937 generator(42);
+    std::normal_distribution<double> distribution(0, noise);
+    std::vector<HistoryPoint> points;
+    for (std::size_t run = 0; run < levels.size(); ++run)
+    {
+        for (auto repetition = 0; repetition < 3; ++repetition)
+        {
+            points.push_back({static_cast<std::int64_t>(run) * 100,
+                              levels[run] + distribution(generator)});
+        }
+    }
+    return points;
+}
+
+std::vector<double> levels(const std::vector<std::pair<std::size_t, double>>& steps)
+{
+    std::vector<double> result;
+    for (const auto& [runs, level]: steps)
+    {
+        result.insert(result.end(), runs, level);
+    }
+    return result;
+}
+
+TEST(ChangePointDetectionTest, FindsSingleLevelShift)
+{
+    const auto points = noisyHistory(levels({{30, 100}, {20, 110}}), 1);
+
+    const auto changes = detectChangePoints(points);
+
+    ASSERT_EQ(changes.size(), 1);
+    EXPECT_EQ(changes[0].run, 30);
+    EXPECT_EQ(changes[0].timestamp, 3000);
+    EXPECT_NEAR(changes[0].relativeChange, 0.1, 0.01);
+}
+
+TEST(ChangePointDetectionTest, FindsSeveralLevelShifts)
+{
+    const auto points = noisyHistory(levels({{20, 100}, {20, 130}, {20, 90}}), 1);
+
+    const auto changes = detectChangePoints(points);
+
+    ASSERT_EQ(changes.size(), 2);
+    EXPECT_EQ(changes[0].run, 20);
+    EXPECT_NEAR(changes[0].after, 130, 1);
+    EXPECT_EQ(changes[1].run, 40);
+    EXPECT_NEAR(changes[1].before, 130, 1);
+    EXPECT_NEAR(changes[1].after, 90, 1);
+}
+
+TEST(ChangePointDetectionTest, IgnoresNoise)
+{
+    EXPECT_TRUE(detectChangePoints(noisyHistory(levels({{100, 100}}), 2)).empty());
+}
+
+TEST(ChangePointDetectionTest, IgnoresSignificantButTinyShifts)
+{
+    const auto points = noisyHistory(levels({{30, 100}, {30, 100.5}}), 0.01);
+
+    EXPECT_TRUE(detectChangePoints(points).empty());
+    EXPECT_EQ(detectChangePoints(points, {.minimalRelativeChange = 0.001}).size(), 1);
+}
+
+TEST(ChangePointDetectionTest, RanksRegressionsOfAllBenchmarks)
+{
+    const TemporaryDirectory directory;
+    auto store = HistoryStore::open(directory / "history").value();
+    const auto slower = levels({{10, 100}, {10, 150}});
+    const auto slightlySlower = levels({{10, 100}, {10, 120}});
+    const auto faster = levels({{10, 100}, {10, 50}});
+    for (std::size_t run = 0; run < slower.size(); ++run)
+    {
+        BenchmarkResults results;
+        results.append({.name = "BM_Faster", .runName = "BM_Faster", .realTime = faster[run]});
+        results.append({.name = "BM_Slower", .runName = "BM_Slower", .realTime = slower[run]});
+        results.append({.name = "BM_SlightlySlower",
+                        .runName = "BM_SlightlySlower",
+                        .realTime = slightlySlower[run]});
+        ASSERT_TRUE(store.ingest(results, std::to_string(run), run * 100).value());
+    }
+
+    TaskScheduler scheduler(2);
+    const auto regressions = detectRegressions(store, "real_time", false, scheduler);
+
+    ASSERT_EQ(regressions.size(), 2);
+    EXPECT_EQ(store.benchmarks().get(regressions[0].benchmark), "BM_Slower");
+    EXPECT_NEAR(regressions[0].magnitude, 0.5, 1e-9);
+    EXPECT_EQ(store.benchmarks().get(regressions[1].benchmark), "BM_SlightlySlower");
+
+    const auto throughputDrops = detectRegressions(store, "real_time", true, scheduler);
+    ASSERT_EQ(throughputDrops.size(), 1);
+    EXPECT_EQ(store.benchmarks().get(throughputDrops[0].benchmark), "BM_Faster");
+}
+
+TEST(ChangePointDetectionTest, SkipsBenchmarksOnceCancelled)
+{
+    const TemporaryDirectory directory;
+    auto store = HistoryStore::open(directory / "history").value();
+    const auto slower = levels({{10, 100}, {10, 150}});
+    for (std::size_t run = 0; run < slower.size(); ++run)
+    {
+        BenchmarkResults results;
+        results.append({.name = "BM_Slower", .runName = "BM_Slower", .realTime = slower[run]});
+        ASSERT_TRUE(store.ingest(results, std::to_string(run), run * 100).value());
+    }
+
+    TaskScheduler scheduler(2);
+    CancellationSource cancellation;
+    cancellation.cancel();
+
+    EXPECT_TRUE(
+        detectRegressions(store, "real_time", false, scheduler, {}, cancellation.token()).empty());
+}
+
+}// namespace
@@ -0,0 +1,136 @@
+#include "Analysis/RepetitionDistribution.hpp"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+namespace
+{
+
+using namespace BPlotter;
+
+std::vector<double> normalSamples(const double mean, const double deviation,
+                                  const std::size_t count, const unsigned seed)
+{
+    std::mt19937 generator(seed);
+    std::normal_distribution<double> distribution(mean, deviation);
+    std::vector<double> samples(count);
+    for (auto& sample: samples)
+    {
+        sample = distribution(generator);
+    }
+    return samples;
+}
+
+TEST(RepetitionDistributionTest, SummarizesBoxWithTukeyWhiskers)
+{
+    const std::vector<double> samples{1, 2, 3, 4, 5, 6, 7, 8, 9, 100};
+
+    const auto box = summarizeBox(samples);
+
+    EXPECT_DOUBLE_EQ(box.firstQuartile, 3.25);
+    EXPECT_DOUBLE_EQ(box.median, 5.5);
+    EXPECT_DOUBLE_EQ(box.thirdQuartile, 7.75);
+    EXPECT_DOUBLE_EQ(box.lowerWhisker, 1);
+    EXPECT_DOUBLE_EQ(box.upperWhisker, 9);
+    EXPECT_EQ(box.outliers, 1);
+}
+
+TEST(RepetitionDistributionTest, DensityIntegratesToOne)
+{
+    auto samples = normalSamples(100, 5, 200, 1);
+    std::ranges::sort(samples);
+
+    const auto estimate = estimateDensity(samples, 256);
+
+    ASSERT_EQ(estimate.density.size(), 256);
+    EXPECT_LE(estimate.first, samples.front());
+    EXPECT_GE(estimate.last(), samples.back());
+    const auto area = std::accumulate(estimate.density.begin(), estimate.density.end(), 0.0) *
+                      estimate.step;
+    EXPECT_NEAR(area, 1, 0.01);
+}
+
+TEST(RepetitionDistributionTest, EstimatesDensityOfEqualSamples)
+{
+    const std::vector<double> samples(10, 42.0);
+
+    const auto estimate = estimateDensity(samples, 64);
+
+    EXPECT_GT(estimate.bandwidth, 0);
+    EXPECT_LT(estimate.first, 42);
+    EXPECT_GT(estimate.last(), 42);
+}
+
+TEST(RepetitionDistributionTest, CountsModesOfDensity)
+{
+    auto unimodal = normalSamples(100, 5, 300, 2);
+    auto bimodal = normalSamples(100, 3, 150, 3);
+    const auto second = normalSamples(130, 3, 150, 4);
+    bimodal.insert(bimodal.end(), second.begin(), second.end());
+
+    EXPECT_EQ(analyzeDistribution({"BM_Unimodal", unimodal}).modes, 1);
+    EXPECT_TRUE(analyzeDistribution({"BM_Bimodal", bimodal}).isMultimodal());
+    EXPECT_EQ(countModes(std::vector<float>{0, 1, 0.95f, 1, 0}, 0.1), 1);
+    EXPECT_EQ(countModes(std::vector<float>{0, 1, 0.1f, 1, 0}, 0.1), 2);
+    EXPECT_EQ(countModes(std::vector<float>{0, 1, 0, 0.05f, 0}, 0.1), 1);
+    EXPECT_EQ(countModes(std::vector<float>{}, 0.1), 0);
+}
+
+TEST(RepetitionDistributionTest, BuildsHistogramOfAllSamples)
+{
+    const auto distribution = analyzeDistribution({"BM_Sort", normalSamples(10, 1, 100, 5)});
+
+    const auto& counts = distribution.histogram.counts;
+    EXPECT_EQ(counts.size(), 10);
+    EXPECT_EQ(std::accumulate(counts.begin(), counts.end(), 0u), 100);
+    EXPECT_DOUBLE_EQ(distribution.histogram.first, distribution.samples.front());
+    EXPECT_TRUE(std::ranges::is_sorted(distribution.samples));
+}
+
+TEST(RepetitionDistributionTest, CollectsRepetitionsOfIterationRows)
+{
+    BenchmarkResults results;
+    for (const auto time: {10.0, 11.0, 12.0})
+    {
+        results.append({.name = "BM_Sort", .runName = "BM_Sort", .realTime = time});
+        results.append({.name = "BM_Find", .runName = "BM_Find", .realTime = time});
+    }
+    results.append({.name = "BM_Sort_mean",
+                    .runName = "BM_Sort",
+                    .runType = RunType::Aggregate,
+                    .aggregateName = "mean",
+                    .realTime = 11});
+    results.append({.name = "BM_Copy", .runName = "BM_Copy", .realTime = 1});
+
+    const auto samples = collectRepetitions(
+        results, static_cast<ColumnIndex>(BuiltinColumn::RealTime), 3);
+
+    ASSERT_EQ(samples.size(), 2);
+    EXPECT_EQ(samples[0].name, "BM_Sort");
+    EXPECT_EQ(samples[0].values, (std::vector<double>{10, 11, 12}));
+    EXPECT_EQ(samples[1].name, "BM_Find");
+}
+
+TEST(RepetitionDistributionTest, AnalyzesDistributionsInParallel)
+{
+    TaskScheduler scheduler(2);
+    std::vector<RepetitionSamples> samples;
+    for (auto i = 0; i < 100; ++i)
+    {
+        samples.push_back({"BM_" + std::to_string(i), normalSamples(i + 10, 1, 20, i)});
+    }
+
+    const auto distributions = analyzeDistributions(samples, scheduler).value();
+
+    ASSERT_EQ(distributions.size(), 100);
+    EXPECT_EQ(distributions[42].name, "BM_42");
+    EXPECT_NEAR(distributions[42].mean, 52, 1);
+
+    CancellationSource source;
+    source.cancel();
+    EXPECT_FALSE(analyzeDistributions(samples, scheduler, {}, source.token()));
+}
+
+}// namespace
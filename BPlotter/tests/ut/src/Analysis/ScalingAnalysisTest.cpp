@@ -0,0 +1,79 @@
+#include "Analysis/ScalingAnalysis.hpp"
+#include "gtest/gtest.h"
+
+#include <string>
+
+namespace
+{
+
+using namespace BPlotter;
+
+void append(BenchmarkResults& results, const std::string& name, double threads, double realTime)
+{
+    BenchmarkRow row;
+    row.name = name;
+    row.runName = name;
+    row.threads = threads;
+    row.realTime = realTime;
+    results.append(row);
+}
+
+TEST(ScalingAnalysisTest, RecoversSerialFractionOfAmdahlScaling)
+{
+    BenchmarkResults results;
+    for (const auto threads: {1, 2, 4, 8, 16})
+    {
+        const auto time = 100.0 / amdahlSpeedup(0.1, threads);
+        append(results, "BM_Work/1024/threads:" + std::to_string(threads), threads, time);
+    }
+
+    const auto scaling = analyzeScaling(
+        results, static_cast<ColumnIndex>(BuiltinColumn::RealTime), false);
+
+    ASSERT_EQ(scaling.size(), 1);
+    const auto& family = scaling.front();
+    EXPECT_EQ(family.name, "BM_Work/1024");
+    ASSERT_EQ(family.points.size(), 5);
+    EXPECT_NEAR(family.points.back().speedup, amdahlSpeedup(0.1, 16), 1e-9);
+    EXPECT_NEAR(family.points.back().efficiency, amdahlSpeedup(0.1, 16) / 16, 1e-9);
+    EXPECT_NEAR(family.amdahl.serialFraction, 0.1, 1e-9);
+    EXPECT_NEAR(family.amdahl.rmsError, 0, 1e-9);
+    EXPECT_GT(family.gustafson.rmsError, 0);
+}
+
+TEST(ScalingAnalysisTest, RatesAreHigherIsBetter)
+{
+    BenchmarkResults results;
+    append(results, "BM_Queue/threads:2", 2, 10);
+    append(results, "BM_Queue/threads:4", 4, 18);
+    append(results, "BM_Queue/threads:4", 4, 22);
+
+    const auto scaling = analyzeScaling(
+        results, static_cast<ColumnIndex>(BuiltinColumn::RealTime), true);
+
+    ASSERT_EQ(scaling.size(), 1);
+    // Repetitions are averaged and the speedup is relative to the smallest thread count
+    EXPECT_DOUBLE_EQ(scaling.front().points.back().speedup, 2.0);
+    EXPECT_DOUBLE_EQ(scaling.front().points.back().efficiency, 1.0);
+    EXPECT_NEAR(scaling.front().gustafson.serialFraction, 0, 1e-9);
+}
+
+TEST(ScalingAnalysisTest, SkipsFamiliesWithSingleThreadCount)
+{
+    BenchmarkResults results;
+    append(results, "BM_Single/8", 1, 10);
+
+    EXPECT_TRUE(
+        analyzeScaling(results, static_cast<ColumnIndex>(BuiltinColumn::RealTime), false).empty());
+}
+
+TEST(ScalingAnalysisTest, FindsLargestEfficientThreadCount)
+{
+    ScalingFamily family;
+    family.points = {{1, 0, 1, 1}, {2, 0, 1.9, 0.95}, {4, 0, 3.2, 0.8}, {8, 0, 4, 0.5}};
+
+    EXPECT_EQ(family.maxEfficientThreads(0.75), 4);
+    EXPECT_EQ(family.maxEfficientThreads(0.99), 1);
+}
+
+}// namespace
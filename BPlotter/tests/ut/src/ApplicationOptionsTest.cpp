@@ -0,0 +1,78 @@
+#include "ApplicationOptions.hpp"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+namespace
+{
+
+using namespace BPlotter;
+
+cpp::result<ApplicationOptions, std::string> parse(
+    const std::vector<std::string_view>& arguments)
+{
+    return parseApplicationArguments(arguments);
+}
+
+TEST(ApplicationOptionsTest, DefaultsWithoutArguments)
+{
+    const auto parsed = parse({});
+
+    ASSERT_FALSE(parsed.has_error()) << parsed.error();
+    EXPECT_FALSE(parsed->recordPath);
+    EXPECT_FALSE(parsed->replayPath);
+    EXPECT_FALSE(parsed->isHeadless);
+    EXPECT_FALSE(parsed->frameLimit);
+    EXPECT_EQ(parsed->resolution, (sf::Vector2u{1280, 720}));
+    EXPECT_EQ(parsed->frameReportPath, "frame_timings.csv");
+    EXPECT_FALSE(parsed->isMeasuringFrames());
+    EXPECT_EQ(parsed->sessionDirectoryInUse(), ApplicationOptions::DEFAULT_SESSION_DIRECTORY);
+}
+
+TEST(ApplicationOptionsTest, ParsesRecordAndReplay)
+{
+    const auto recorded = parse({"--record", "session.events"});
+    ASSERT_FALSE(recorded.has_error()) << recorded.error();
+    EXPECT_EQ(recorded->recordPath, "session.events");
+
+    const auto replayed = parse({"--replay", "session.events", "--frame-report", "frames.csv"});
+    ASSERT_FALSE(replayed.has_error()) << replayed.error();
+    EXPECT_EQ(replayed->replayPath, "session.events");
+    EXPECT_EQ(replayed->frameReportPath, "frames.csv");
+    EXPECT_TRUE(replayed->isMeasuringFrames());
+    EXPECT_FALSE(replayed->sessionDirectoryInUse());
+}
+
+TEST(ApplicationOptionsTest, ParsesHeadlessRuns)
+{
+    const auto parsed = parse({"--headless", "--frames", "600", "--resolution", "1920x1080"});
+
+    ASSERT_FALSE(parsed.has_error()) << parsed.error();
+    EXPECT_TRUE(parsed->isHeadless);
+    EXPECT_EQ(parsed->frameLimit, 600u);
+    EXPECT_EQ(parsed->resolution, (sf::Vector2u{1920, 1080}));
+    EXPECT_TRUE(parsed->isMeasuringFrames());
+    EXPECT_FALSE(parsed->sessionDirectoryInUse());
+}
+
+TEST(ApplicationOptionsTest, ParsesSessionDirectory)
+{
+    const auto parsed = parse({"--headless", "--session", "benchmark-session"});
+
+    ASSERT_FALSE(parsed.has_error()) << parsed.error();
+    EXPECT_EQ(parsed->sessionDirectoryInUse(), "benchmark-session");
+    EXPECT_TRUE(parse({"--session"}).has_error());
+}
+
+TEST(ApplicationOptionsTest, RejectsInvalidArguments)
+{
+    EXPECT_TRUE(parse({"--record"}).has_error());
+    EXPECT_TRUE(parse({"--verbose"}).has_error());
+    EXPECT_TRUE(parse({"session.events"}).has_error());
+    EXPECT_TRUE(parse({"--frames", "-1"}).has_error());
+    EXPECT_TRUE(parse({"--resolution", "1920"}).has_error());
+    EXPECT_TRUE(parse({"--resolution", "0x1080"}).has_error());
+    EXPECT_TRUE(parse({"--record", "a.events", "--replay", "b.events"}).has_error());
+}
+
+}// namespace
@@ -0,0 +1,126 @@
+#include "Application.hpp"
+#include "Platform/HeadlessWindow.hpp"
+#include "Session/SessionStore.hpp"
+#include "TestUtils/TemporaryDirectory.hpp"
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+
+using namespace BPlotter;
+
+class ApplicationTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        options.isHeadless = true;
+        options.frameReportPath = directory / "frames.csv";
+    }
+
+    /**
+     * \brief Creates the application in a headless window, which the test keeps driving.
+     */
+    std::unique_ptr<Application> createApplication()
+    {
+        auto headless = std::make_unique<HeadlessWindow>(sf::Vector2u{800, 600});
+        window = headless.get();
+        return std::make_unique<Application>(options, std::move(headless),
+                                             std::make_unique<FixedFrameClock>());
+    }
+
+    TemporaryDirectory directory;
+    ApplicationOptions options;
+    HeadlessWindow* window = nullptr;
+};
+
+TEST_F(ApplicationTest, RunsTheFramesWithoutDisplay)
+{
+    options.frameLimit = 30;
+    const auto application = createApplication();
+    application->run();
+
+    EXPECT_EQ(window->frameCount(), 30u);
+    EXPECT_EQ(application->frameTimings().frameCount(), 30u);
+    EXPECT_TRUE(std::filesystem::exists(options.frameReportPath));
+}
+
+TEST_F(ApplicationTest, ProcessesThePushedEvents)
+{
+    options.frameLimit = 100;
+    const auto application = createApplication();
+    window->pushEvent(sf::Event::MouseMoved{{400, 10}});
+    window->pushEvent(sf::Event::MouseButtonPressed{sf::Mouse::Button::Left, {400, 10}});
+    window->pushEvent(sf::Event::Closed{});
+    application->run();
+
+    EXPECT_EQ(window->frameCount(), 1u);
+}
+
+TEST_F(ApplicationTest, ReplaysTheRecordedSession)
+{
+    EventRecording recording;
+    recording.beginFrame(0.016f);
+    recording.record(sf::Event::MouseMoved{{100, 100}});
+    recording.beginFrame(0.5f);
+    recording.record(sf::Event::Resized{{1024, 768}});
+    recording.beginFrame(0.016f);
+    recording.record(sf::Event::FocusLost{});
+    recording.beginFrame(0.016f);
+    options.replayPath = directory / "session.events";
+    {
+        std::ofstream output(*options.replayPath);
+        ASSERT_FALSE(recording.write(output).has_error());
+    }
+
+    const auto application = createApplication();
+    application->run();
+
+    EXPECT_EQ(application->frameTimings().frameCount(), 4u);
+    EXPECT_EQ(window->getSize(), (sf::Vector2u{1024, 768}));
+}
+
+TEST_F(ApplicationTest, AllocatesNothingInIdleFrames)
+{
+    if (not isAllocationHookInstalled())
+    {
+        GTEST_SKIP() << "The allocations are counted only with BPLOTTER_ALLOCATION_TRACKING";
+    }
+
+    // The restored session displays a run, so the idle frames draw its pivot plot
+    const auto source = directory / "run.json";
+    std::ofstream(source) << R"({"context": {"num_cpus": 4}, "benchmarks": [)"
+                          << R"({"name": "BM_Copy/64", "run_type": "iteration", "iterations": 1,)"
+                          << R"( "real_time": 2, "cpu_time": 2, "time_unit": "ns"},)"
+                          << R"({"name": "BM_Copy/128", "run_type": "iteration", "iterations": 1,)"
+                          << R"( "real_time": 4, "cpu_time": 4, "time_unit": "ns"}]})";
+    options.sessionDirectory = directory / "session";
+    {
+        TaskScheduler scheduler(1);
+        SessionStore store(*options.sessionDirectory, scheduler);
+        store.save(SessionSnapshot{.displayedRun = SessionRun{source.string(), ""}}, {});
+        store.wait();
+    }
+    options.frameLimit = 120;
+    const auto application = createApplication();
+    setAllocationTrackingEnabled(true);
+    application->run();
+    setAllocationTrackingEnabled(false);
+
+    // The first frames parse the run, pivot it and lay out the windows, the last one only draws
+    const auto& tracker = application->allocationTracker();
+    ASSERT_EQ(tracker.frameCount(), 120u);
+    EXPECT_EQ(tracker.frame(tracker.frameCount() - 1).total().allocations, 0u);
+}
+
+TEST_F(ApplicationTest, FailsOnAnInvalidRecording)
+{
+    options.replayPath = directory / "missing.events";
+
+    EXPECT_THROW(createApplication(), std::runtime_error);
+}
+
+}// namespace
@@ -0,0 +1,33 @@
+#include "Benchmark/BenchmarkName.hpp"
+#include "gtest/gtest.h"
+
+namespace
+{
+
+using namespace BPlotter;
+
+TEST(BenchmarkNameTest, SplitsNameIntoComponents)
+{
+    const auto name =
+        parseBenchmarkName("BM_Copy<std::vector<int>, 8>/64/len:16/threads:4/real_time");
+
+    EXPECT_EQ(name.family, "BM_Copy<std::vector<int>, 8>");
+    EXPECT_EQ(name.baseName, "BM_Copy");
+    EXPECT_EQ(name.templateParameters, (std::vector<std::string_view>{"std::vector<int>", "8"}));
+    EXPECT_EQ(name.arguments, (std::vector<std::string_view>{"64"}));
+    EXPECT_EQ(name.namedArgument("len"), "16");
+    EXPECT_EQ(name.namedArgument("threads"), "4");
+    EXPECT_EQ(name.flags, (std::vector<std::string_view>{"real_time"}));
+}
+
+TEST(BenchmarkNameTest, NameWithoutArguments)
+{
+    const auto name = parseBenchmarkName("BM_Sort");
+
+    EXPECT_EQ(name.family, "BM_Sort");
+    EXPECT_EQ(name.baseName, "BM_Sort");
+    EXPECT_TRUE(name.arguments.empty());
+    EXPECT_TRUE(name.namedArgument("threads").empty());
+}
+
+}// namespace
@@ -0,0 +1,123 @@
+#include "Benchmark/BenchmarkParser.hpp"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <sstream>
+
+namespace
+{
+
+using namespace BPlotter;
+
+constexpr auto RESULTS = R"({
+  "context": {
+    "date": "2024-03-01T10:00:00+01:00",
+    "host_name": "builder",
+    "executable": "./benchmarks",
+    "num_cpus": 8,
+    "mhz_per_cpu": 3600,
+    "cpu_scaling_enabled": false,
+    "library_build_type": "release",
+    "caches": [
+      {"type": "Data", "level": 1, "size": 32768, "num_sharing": 2},
+      {"type": "Unified", "level": 3, "size": 8388608, "num_sharing": 8}
+    ]
+  },
+  "benchmarks": [
+    {
+      "name": "BM_Copy/64",
+      "run_name": "BM_Copy/64",
+      "run_type": "iteration",
+      "repetitions": 1,
+      "repetition_index": 0,
+      "threads": 1,
+      "iterations": 1000,
+      "real_time": 2.5,
+      "cpu_time": 2.0,
+      "time_unit": "us",
+      "bytes_per_second": 1.0e9
+    },
+    {
+      "name": "BM_Copy/64_cv",
+      "run_name": "BM_Copy/64",
+      "run_type": "aggregate",
+      "aggregate_name": "cv",
+      "aggregate_unit": "percentage",
+      "iterations": 1,
+      "real_time": 0.05,
+      "cpu_time": 0.04,
+      "time_unit": "us"
+    },
+    {
+      "name": "BM_Failing",
+      "error_occurred": true,
+      "error_message": "out of memory"
+    }
+  ]
+})";
+
+TEST(BenchmarkParserTest, ParsesRowsAndContext)
+{
+    std::istringstream input(RESULTS);
+    const auto results = parseBenchmarkResults(input);
+    ASSERT_TRUE(results.has_value());
+    ASSERT_EQ(results.value().size(), 2);
+
+    const auto& parsed = results.value();
+    EXPECT_EQ(parsed.context().hostName, "builder");
+    EXPECT_EQ(parsed.context().numCpus, 8);
+    ASSERT_EQ(parsed.context().caches.size(), 2);
+    EXPECT_EQ(parsed.context().caches[1].type, "Unified");
+    EXPECT_EQ(parsed.context().caches[1].level, 3);
+    EXPECT_DOUBLE_EQ(parsed.context().caches[1].size, 8388608);
+    EXPECT_EQ(parsed.context().caches[1].numSharing, 8);
+    EXPECT_EQ(parsed.names().get(parsed.nameColumn()[1]), "BM_Copy/64_cv");
+    EXPECT_EQ(parsed.runNameColumn()[0], parsed.runNameColumn()[1]);
+    EXPECT_EQ(parsed.runTypeColumn()[1], RunType::Aggregate);
+    EXPECT_EQ(parsed.aggregateNames().get(parsed.aggregateNameColumn()[1]), "cv");
+}
+
+TEST(BenchmarkParserTest, ConvertsTimesToNanoseconds)
+{
+    std::istringstream input(RESULTS);
+    const auto results = parseBenchmarkResults(input);
+    ASSERT_TRUE(results.has_value());
+
+    const auto realTime = results.value().column(BuiltinColumn::RealTime);
+    EXPECT_DOUBLE_EQ(realTime[0], 2500.0);
+    // Relative aggregates are not scaled
+    EXPECT_DOUBLE_EQ(realTime[1], 0.05);
+}
+
+TEST(BenchmarkParserTest, StoresUserCountersAsColumns)
+{
+    std::istringstream input(RESULTS);
+    const auto results = parseBenchmarkResults(input);
+    ASSERT_TRUE(results.has_value());
+
+    const auto column = results.value().findColumn("bytes_per_second");
+    ASSERT_TRUE(column.has_value());
+    EXPECT_DOUBLE_EQ(results.value().column(*column)[0], 1.0e9);
+    EXPECT_TRUE(std::isnan(results.value().column(*column)[1]));
+}
+
+TEST(BenchmarkParserTest, ReportsInvalidDocuments)
+{
+    std::istringstream notJson("not a json");
+    EXPECT_TRUE(parseBenchmarkResults(notJson).has_error());
+
+    std::istringstream noBenchmarks(R"({"context": {}})");
+    EXPECT_TRUE(parseBenchmarkResults(noBenchmarks).has_error());
+}
+
+TEST(BenchmarkParserTest, RecognizesResultFiles)
+{
+    EXPECT_TRUE(isResultFile("results/run.json"));
+    EXPECT_TRUE(isResultFile("run.json.gz"));
+    EXPECT_TRUE(isResultFile("run.json.zst"));
+    EXPECT_FALSE(isResultFile("run.json.bak"));
+    EXPECT_FALSE(isResultFile("notes.txt"));
+    EXPECT_FALSE(isResultFile(".json"));
+}
+
+}// namespace
@@ -0,0 +1,164 @@
+#include "Benchmark/BenchmarkParser.hpp"
+#include "Benchmark/DecompressingStreamBuffer.hpp"
+#include "TestUtils/TemporaryDirectory.hpp"
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <zlib.h>
+#include <zstd.h>
+
+namespace
+{
+
+using namespace BPlotter;
+
+std::string gzip(const std::string& data)
+{
+    z_stream stream{};
+    // 16 makes zlib write the gzip header
+    deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+    std::string compressed(deflateBound(&stream, data.size()), '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in = static_cast<uInt>(data.size());
+    stream.next_out = reinterpret_cast<Bytef*>(compressed.data());
+    stream.avail_out = static_cast<uInt>(compressed.size());
+    deflate(&stream, Z_FINISH);
+    compressed.resize(stream.total_out);
+    deflateEnd(&stream);
+    return compressed;
+}
+
+std::string zstd(const std::string& data)
+{
+    std::string compressed(ZSTD_compressBound(data.size()), '\0');
+    compressed.resize(
+        ZSTD_compress(compressed.data(), compressed.size(), data.data(), data.size(), 3));
+    return compressed;
+}
+
+/**
+ * \brief Data spanning many chunks of the decompressing buffer.
+ */
+std::string largeData()
+{
+    std::string data;
+    for (auto i = 0; data.size() < 5 * DecompressingStreamBuffer::CHUNK_SIZE; ++i)
+    {
+        data += std::to_string(i * 7919 % 100003) + ',';
+    }
+    return data;
+}
+
+std::string decompress(const std::string& compressed, TaskScheduler& scheduler, std::string& error)
+{
+    auto source = std::make_unique<std::istringstream>(compressed);
+    const auto compression = detectCompression(*source);
+    DecompressingStreamBuffer buffer(std::move(source), compression, scheduler);
+    std::istream stream(&buffer);
+    std::string result{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+    error = buffer.error();
+    return result;
+}
+
+using Compressor = std::string (*)(const std::string&);
+
+class DecompressingStreamBufferTest : public ::testing::TestWithParam<Compressor>
+{
+protected:
+    TaskScheduler scheduler{2};
+};
+
+TEST(CompressionDetectionTest, DetectsCompressionByMagicBytes)
+{
+    EXPECT_EQ(detectCompression(std::span<const char>(gzip("{}"))), Compression::Gzip);
+    EXPECT_EQ(detectCompression(std::span<const char>(zstd("{}"))), Compression::Zstd);
+    EXPECT_EQ(detectCompression(std::span<const char>(std::string("{}"))), Compression::None);
+
+    std::istringstream stream("{\"a\": 1}");
+    EXPECT_EQ(detectCompression(stream), Compression::None);
+    EXPECT_EQ(stream.get(), '{');
+}
+
+TEST_P(DecompressingStreamBufferTest, DecompressesDataSpanningManyChunks)
+{
+    const auto data = largeData();
+    std::string error;
+
+    EXPECT_EQ(decompress(GetParam()(data), scheduler, error), data);
+    EXPECT_EQ(error, "");
+}
+
+TEST_P(DecompressingStreamBufferTest, DecompressesWhenAllThreadsAreReading)
+{
+    const auto data = largeData();
+    const auto compressed = GetParam()(data);
+    TaskScheduler single(1);
+    std::string error;
+
+    // The decompression task is queued behind the reader, which must not wait for it
+    auto reading = single.submit(TaskPriority::Interactive,
+                                 [&]
+                                 {
+                                     return decompress(compressed, single, error);
+                                 });
+
+    EXPECT_EQ(reading.get(), data);
+    EXPECT_EQ(error, "");
+}
+
+TEST_P(DecompressingStreamBufferTest, ReportsTruncatedData)
+{
+    auto compressed = GetParam()(largeData());
+    compressed.resize(compressed.size() / 2);
+    std::string error;
+
+    decompress(compressed, scheduler, error);
+
+    EXPECT_NE(error, "");
+}
+
+TEST_P(DecompressingStreamBufferTest, StopsWhenNotReadTillTheEnd)
+{
+    auto source = std::make_unique<std::istringstream>(GetParam()(largeData()));
+    const auto compression = detectCompression(*source);
+    DecompressingStreamBuffer buffer(std::move(source), compression, scheduler);
+    std::istream stream(&buffer);
+
+    std::string prefix(10, '\0');
+    stream.read(prefix.data(), static_cast<std::streamsize>(prefix.size()));
+
+    EXPECT_EQ(prefix, largeData().substr(0, prefix.size()));
+}
+
+TEST_P(DecompressingStreamBufferTest, LoadsCompressedResults)
+{
+    std::string json = R"({"context": {"date": "2024-03-01T10:00:00+01:00"}, "benchmarks": [)";
+    for (auto i = 0; i < 5000; ++i)
+    {
+        const auto index = std::to_string(i);
+        json += std::string(i == 0 ? "" : ",") + R"({"name": "BM_Test/)" + index +
+                R"(", "run_name": "BM_Test/)" + index +
+                R"(", "run_type": "iteration", "iterations": 10, "real_time": )" + index +
+                R"(, "cpu_time": 1, "time_unit": "ns"})";
+    }
+    json += "]}";
+    const TemporaryDirectory directory;
+    const auto path = directory / "CompressedResults.json.cmp";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << GetParam()(json);
+    }
+
+    const auto results = loadBenchmarkResults(path, scheduler);
+
+    ASSERT_FALSE(results.has_error()) << results.error();
+    EXPECT_EQ(results->size(), 5000);
+    EXPECT_DOUBLE_EQ(results->column(BuiltinColumn::RealTime)[4999], 4999);
+}
+
+INSTANTIATE_TEST_SUITE_P(Formats, DecompressingStreamBufferTest, ::testing::Values(&gzip, &zstd));
+
+}// namespace
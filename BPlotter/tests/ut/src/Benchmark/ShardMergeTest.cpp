@@ -0,0 +1,109 @@
+#include "Benchmark/ShardMerge.hpp"
+#include "TestUtils/TemporaryDirectory.hpp"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+
+using namespace BPlotter;
+
+Shard shardWith(std::string name, const std::vector<std::pair<std::string_view, double>>& rows,
+                const int numCpus = 8)
+{
+    Shard shard{std::move(name)};
+    for (const auto& [runName, realTime]: rows)
+    {
+        shard.results.append({.name = runName, .runName = runName, .realTime = realTime});
+    }
+    shard.results.setContext({.numCpus = numCpus});
+    return shard;
+}
+
+std::vector<std::string> runNamesOf(const BenchmarkResults& results)
+{
+    std::vector<std::string> names;
+    for (const auto id: results.runNameColumn())
+    {
+        names.emplace_back(results.names().get(id));
+    }
+    return names;
+}
+
+TEST(ShardMergeTest, MergesShardsOrderedByRunName)
+{
+    std::vector<Shard> shards;
+    shards.push_back(shardWith("a.json", {{"BM_Sort", 1}, {"BM_Copy", 2}, {"BM_Sort", 3}}));
+    shards.push_back(shardWith("b.json", {{"BM_Hash", 4}, {"BM_Alloc", 5}}));
+    shards.back().results.append({.name = "BM_Alloc", .realTime = 6, .counters = {{"bytes", 7}}});
+
+    const auto merged = mergeShards(shards);
+
+    EXPECT_EQ(runNamesOf(merged.results),
+              (std::vector<std::string>{"BM_Alloc", "BM_Alloc", "BM_Copy", "BM_Hash", "BM_Sort",
+                                        "BM_Sort"}));
+    const auto realTimes = merged.results.column(BuiltinColumn::RealTime);
+    EXPECT_EQ(std::vector<double>(realTimes.begin(), realTimes.end()),
+              (std::vector<double>{5, 6, 2, 4, 1, 3}));
+    const auto bytes = merged.results.findColumn("bytes");
+    ASSERT_TRUE(bytes);
+    EXPECT_DOUBLE_EQ(merged.results.column(*bytes)[1], 7);
+    EXPECT_TRUE(std::isnan(merged.results.column(*bytes)[0]));
+    EXPECT_TRUE(merged.report.duplicates.empty());
+    EXPECT_TRUE(merged.report.contextMismatches.empty());
+}
+
+TEST(ShardMergeTest, KeepsFirstShardOfDuplicates)
+{
+    std::vector<Shard> shards;
+    shards.push_back(shardWith("a.json", {{"BM_Sort", 1}, {"BM_Sort", 2}}));
+    shards.push_back(shardWith("b.json", {{"BM_Sort", 3}, {"BM_Copy", 4}}));
+    shards.push_back(shardWith("c.json", {{"BM_Sort", 5}}));
+
+    const auto merged = mergeShards(shards);
+
+    EXPECT_EQ(runNamesOf(merged.results),
+              (std::vector<std::string>{"BM_Copy", "BM_Sort", "BM_Sort"}));
+    EXPECT_DOUBLE_EQ(merged.results.column(BuiltinColumn::RealTime)[1], 1);
+    EXPECT_EQ(merged.report.duplicates, std::vector<std::string>{"BM_Sort"});
+}
+
+TEST(ShardMergeTest, ReportsMismatchedContexts)
+{
+    std::vector<Shard> shards;
+    shards.push_back(shardWith("a.json", {{"BM_Sort", 1}}, 8));
+    shards.push_back(shardWith("b.json", {{"BM_Copy", 2}}, 16));
+
+    const auto merged = mergeShards(shards);
+
+    ASSERT_EQ(merged.report.contextMismatches.size(), 1);
+    EXPECT_EQ(merged.report.contextMismatches[0],
+              "b.json: num_cpus '16' differs from '8' in a.json");
+    EXPECT_EQ(merged.results.context().numCpus, 8);
+}
+
+TEST(ShardMergeTest, LoadsDirectoryOfShards)
+{
+    const TemporaryDirectory directory;
+    for (const auto& [file, name]: {std::pair{"1.json", "BM_B"}, std::pair{"2.json", "BM_A"}})
+    {
+        std::ofstream(directory / file)
+            << R"({"context": {"num_cpus": 4}, "benchmarks": [{"name": ")" << name
+            << R"(", "run_type": "iteration", "iterations": 1, "real_time": 1, "cpu_time": 1,)"
+            << R"( "time_unit": "ns"}]})";
+    }
+    std::ofstream(directory / "notes.txt") << "not a shard";
+
+    TaskScheduler scheduler(2);
+    const auto merged = loadShardedResults(directory.path(), scheduler);
+    const auto missing = loadShardedResults(directory / "missing", scheduler);
+
+    ASSERT_FALSE(merged.has_error()) << merged.error();
+    EXPECT_EQ(runNamesOf(merged->results), (std::vector<std::string>{"BM_A", "BM_B"}));
+    EXPECT_TRUE(missing.has_error());
+}
+
+}// namespace
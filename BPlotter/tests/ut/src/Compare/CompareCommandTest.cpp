@@ -0,0 +1,76 @@
+#include "Compare/CompareCommand.hpp"
+#include "TestUtils/TemporaryDirectory.hpp"
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace
+{
+
+using namespace BPlotter;
+
+cpp::result<CompareArguments, std::string> parse(const std::vector<std::string_view>& arguments)
+{
+    return parseCompareArguments(arguments);
+}
+
+TEST(CompareCommandTest, ParsesFilesAndOptions)
+{
+    const auto parsed = parse({"old.json", "--metric", "bytes_per_second", "new.json",
+                               "--threshold", "0.1", "--threshold-for", "BM_(a|b)=x=0.2",
+                               "--alpha", "0.01", "--higher-is-better", "--no-color"});
+
+    ASSERT_FALSE(parsed.has_error()) << parsed.error();
+    EXPECT_EQ(parsed->baseline, "old.json");
+    EXPECT_EQ(parsed->candidate, "new.json");
+    EXPECT_EQ(parsed->options.metric, "bytes_per_second");
+    EXPECT_DOUBLE_EQ(parsed->options.threshold, 0.1);
+    EXPECT_DOUBLE_EQ(parsed->options.alpha, 0.01);
+    EXPECT_EQ(parsed->options.isHigherBetter, true);
+    EXPECT_FALSE(parsed->isColored);
+    ASSERT_EQ(parsed->options.thresholds.size(), 1);
+    EXPECT_EQ(parsed->options.thresholds[0].source, "BM_(a|b)=x");
+    EXPECT_DOUBLE_EQ(parsed->options.thresholds[0].threshold, 0.2);
+}
+
+TEST(CompareCommandTest, RejectsInvalidArguments)
+{
+    EXPECT_TRUE(parse({"old.json"}).has_error());
+    EXPECT_TRUE(parse({"old.json", "new.json", "--threshold"}).has_error());
+    EXPECT_TRUE(parse({"old.json", "new.json", "--threshold", "abc"}).has_error());
+    EXPECT_TRUE(parse({"old.json", "new.json", "--threshold-for", "BM_("}).has_error());
+    EXPECT_TRUE(parse({"old.json", "new.json", "--threshold-for", "(=0.1"}).has_error());
+    EXPECT_TRUE(parse({"old.json", "new.json", "--verbose"}).has_error());
+}
+
+TEST(CompareCommandTest, FailsOnMissingFiles)
+{
+    const std::vector<std::string_view> arguments{"missing-baseline.json",
+                                                  "missing-candidate.json"};
+
+    EXPECT_EQ(runCompareCommand(arguments), CompareExitCode::Error);
+}
+
+TEST(CompareCommandTest, FailsWhenNoBenchmarkIsCompared)
+{
+    const TemporaryDirectory directory;
+    const auto write = [&directory](const std::string& name, const std::string& benchmark)
+    {
+        std::ofstream(directory / name)
+            << R"({"context": {}, "benchmarks": [{"name": ")" << benchmark << R"(", "run_name": ")"
+            << benchmark << R"(", "run_type": "iteration", "real_time": 1, "time_unit": "ns"}]})";
+        return (directory / name).string();
+    };
+    const auto baseline = write("baseline.json", "BM_Copy");
+    const auto candidate = write("candidate.json", "BM_Sort");
+    const auto unchanged = write("unchanged.json", "BM_Copy");
+
+    EXPECT_EQ(runCompareCommand(std::vector<std::string_view>{baseline, candidate}),
+              CompareExitCode::Error);
+    EXPECT_EQ(runCompareCommand(std::vector<std::string_view>{baseline, unchanged}),
+              CompareExitCode::NoRegression);
+}
+
+}// namespace
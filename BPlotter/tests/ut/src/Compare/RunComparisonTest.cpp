@@ -0,0 +1,145 @@
+#include "Compare/RunComparison.hpp"
+#include "gtest/gtest.h"
+
+namespace
+{
+
+using namespace BPlotter;
+
+BenchmarkResults resultsWith(const std::vector<std::pair<std::string_view, double>>& rows)
+{
+    BenchmarkResults results;
+    for (const auto& [name, realTime]: rows)
+    {
+        results.append({.name = name, .runName = name, .realTime = realTime});
+    }
+    return results;
+}
+
+BenchmarkResults repeated(const std::string_view name, const std::vector<double>& times)
+{
+    std::vector<std::pair<std::string_view, double>> rows;
+    for (const auto time: times)
+    {
+        rows.emplace_back(name, time);
+    }
+    return resultsWith(rows);
+}
+
+TEST(RunComparisonTest, ComputesExactMannWhitneyPValue)
+{
+    const std::vector<double> lower{1, 2, 3, 4};
+    const std::vector<double> higher{5, 6, 7, 8};
+
+    // Only 2 of the 70 arrangements are as extreme as the complete separation
+    EXPECT_NEAR(mannWhitneyPValue(lower, higher), 2.0 / 70, 1e-12);
+    EXPECT_NEAR(mannWhitneyPValue(std::vector<double>{1, 3, 5, 7},
+                                  std::vector<double>{2, 4, 6, 8}),
+                2.0 * 24 / 70, 1e-12);
+    EXPECT_DOUBLE_EQ(mannWhitneyPValue(lower, {}), 1);
+}
+
+TEST(RunComparisonTest, ApproximatesPValueWithTies)
+{
+    const std::vector<double> baseline(20, 1.0);
+    std::vector<double> candidate(20, 2.0);
+
+    EXPECT_LT(mannWhitneyPValue(baseline, candidate), 1e-6);
+    EXPECT_DOUBLE_EQ(mannWhitneyPValue(baseline, baseline), 1);
+}
+
+TEST(RunComparisonTest, FlagsSignificantRegressionsAboveThreshold)
+{
+    TaskScheduler scheduler(2);
+    const auto baseline = repeated("BM_Sort", {100, 101, 99, 100, 102, 98});
+    const auto candidate = repeated("BM_Sort", {110, 111, 109, 110, 112, 108});
+
+    const auto comparisons = compareResults(baseline, candidate, scheduler, {}).value();
+
+    ASSERT_EQ(comparisons.size(), 1);
+    EXPECT_EQ(comparisons[0].verdict, Verdict::Regression);
+    EXPECT_NEAR(comparisons[0].relativeChange, 0.1, 1e-12);
+    ASSERT_TRUE(comparisons[0].pValue);
+    EXPECT_LT(*comparisons[0].pValue, 0.05);
+
+    const auto reversed = compareResults(candidate, baseline, scheduler, {}).value();
+    EXPECT_EQ(reversed[0].verdict, Verdict::Improvement);
+}
+
+TEST(RunComparisonTest, IgnoresInsignificantDifferences)
+{
+    TaskScheduler scheduler(2);
+    const auto baseline = repeated("BM_Noisy", {100, 150, 60, 130, 80, 110});
+    const auto candidate = repeated("BM_Noisy", {120, 160, 70, 140, 90, 115});
+
+    const auto comparisons = compareResults(baseline, candidate, scheduler, {}).value();
+
+    EXPECT_GT(comparisons[0].relativeChange, 0.05);
+    EXPECT_EQ(comparisons[0].verdict, Verdict::Unchanged);
+}
+
+TEST(RunComparisonTest, UsesThresholdAloneWithoutEnoughRepetitions)
+{
+    TaskScheduler scheduler(2);
+    const auto baseline = resultsWith({{"BM_Fast", 100}, {"BM_Slow", 100}});
+    const auto candidate = resultsWith({{"BM_Fast", 104}, {"BM_Slow", 120}, {"BM_New", 1}});
+
+    ComparisonOptions options;
+    options.thresholds.push_back({std::regex("Fast"), "Fast", 0.01});
+    const auto comparisons = compareResults(baseline, candidate, scheduler, options).value();
+
+    ASSERT_EQ(comparisons.size(), 3);
+    EXPECT_EQ(comparisons[0].name, "BM_Fast");
+    EXPECT_FALSE(comparisons[0].pValue);
+    EXPECT_DOUBLE_EQ(comparisons[0].threshold, 0.01);
+    EXPECT_EQ(comparisons[0].verdict, Verdict::Regression);
+    EXPECT_EQ(comparisons[1].verdict, Verdict::Regression);
+    EXPECT_EQ(comparisons[2].name, "BM_New");
+    EXPECT_EQ(comparisons[2].verdict, Verdict::OnlyInCandidate);
+}
+
+TEST(RunComparisonTest, HonorsDirectionOfMetric)
+{
+    TaskScheduler scheduler(2);
+    const auto baseline = resultsWith({{"BM_Copy", 100}});
+    const auto candidate = resultsWith({{"BM_Copy", 50}});
+
+    const auto lowerIsBetter = compareResults(baseline, candidate, scheduler, {}).value();
+    const auto higherIsBetter =
+        compareResults(baseline, candidate, scheduler, {.isHigherBetter = true}).value();
+
+    EXPECT_EQ(lowerIsBetter[0].verdict, Verdict::Improvement);
+    EXPECT_EQ(higherIsBetter[0].verdict, Verdict::Regression);
+    EXPECT_TRUE(compareResults(baseline, candidate, scheduler, {.metric = "missing"}).has_error());
+}
+
+TEST(RunComparisonTest, FallsBackToMeanOfAggregatesOnlyResults)
+{
+    TaskScheduler scheduler(2);
+    const auto aggregatesOf = [](const double mean)
+    {
+        BenchmarkResults results;
+        const std::vector<std::pair<std::string_view, double>> aggregates{
+            {"mean", mean}, {"median", mean + 5}, {"stddev", 1}};
+        for (const auto& [aggregate, time]: aggregates)
+        {
+            results.append({.name = "BM_Sort_" + std::string(aggregate),
+                            .runName = "BM_Sort",
+                            .runType = RunType::Aggregate,
+                            .aggregateName = aggregate,
+                            .realTime = time});
+        }
+        return results;
+    };
+
+    const auto comparisons =
+        compareResults(aggregatesOf(100), aggregatesOf(120), scheduler, {}).value();
+
+    ASSERT_EQ(comparisons.size(), 1);
+    EXPECT_EQ(comparisons[0].baselineRepetitions, 1);
+    EXPECT_DOUBLE_EQ(comparisons[0].baseline, 100);
+    EXPECT_DOUBLE_EQ(comparisons[0].candidate, 120);
+    EXPECT_EQ(comparisons[0].verdict, Verdict::Regression);
+}
+
+}// namespace
@@ -0,0 +1,134 @@
+#include "Expression/DerivedMetrics.hpp"
+#include "gtest/gtest.h"
+
+#include <cmath>
+
+namespace
+{
+
+using namespace BPlotter;
+
+BenchmarkResults resultsWithCounters(const std::size_t rows)
+{
+    BenchmarkResults results;
+    for (std::size_t i = 0; i < rows; ++i)
+    {
+        BenchmarkRow row{.name = "BM_Test", .runName = "BM_Test", .realTime = 2.0 * (i + 1)};
+        row.counters = {{"INSTRUCTIONS", 3.0 * (i + 1)}, {"CYCLES", 1.5 * (i + 1)}};
+        if (i % 2 == 0)
+        {
+            row.counters.emplace_back("CACHE-MISSES", 1.0);
+        }
+        results.append(row);
+    }
+    return results;
+}
+
+std::vector<double> evaluate(const std::string_view source, const BenchmarkResults& results)
+{
+    auto expression = CompiledExpression::compile(source, results);
+    EXPECT_FALSE(expression.has_error()) << expression.error();
+    std::vector<double> values(results.size());
+    expression->evaluate(results, 0, values);
+    return values;
+}
+
+TEST(CompiledExpressionTest, RespectsOperatorPrecedence)
+{
+    const auto results = resultsWithCounters(3);
+
+    const auto values = evaluate("1 + INSTRUCTIONS / CYCLES * -(2 - 4)", results);
+
+    EXPECT_EQ(values, std::vector<double>(3, 5.0));
+}
+
+TEST(CompiledExpressionTest, EvaluatesAcrossManyBlocks)
+{
+    const auto results = resultsWithCounters(5000);
+
+    const auto values = evaluate("real_time * 1e-9 + INSTRUCTIONS - CYCLES", results);
+
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        EXPECT_DOUBLE_EQ(values[i], 2.0 * (i + 1) * 1e-9 + 1.5 * (i + 1));
+    }
+}
+
+TEST(CompiledExpressionTest, RecognizesColumnsWithDashes)
+{
+    const auto results = resultsWithCounters(2);
+
+    const auto unquoted = evaluate("CACHE-MISSES/INSTRUCTIONS", results);
+    const auto quoted = evaluate("\"CACHE-MISSES\" / INSTRUCTIONS", results);
+
+    EXPECT_DOUBLE_EQ(unquoted[0], 1.0 / 3.0);
+    EXPECT_TRUE(std::isnan(unquoted[1]));
+    EXPECT_DOUBLE_EQ(quoted[0], unquoted[0]);
+}
+
+TEST(CompiledExpressionTest, FoldsConstantExpressions)
+{
+    const auto results = resultsWithCounters(2);
+
+    EXPECT_EQ(evaluate("(1 + 2) * 4", results), std::vector<double>(2, 12.0));
+}
+
+TEST(CompiledExpressionTest, ReportsErrors)
+{
+    const auto results = resultsWithCounters(1);
+
+    EXPECT_TRUE(CompiledExpression::compile("INSTRUCTIONS /", results).has_error());
+    EXPECT_TRUE(CompiledExpression::compile("(CYCLES", results).has_error());
+    EXPECT_TRUE(CompiledExpression::compile("CYCLES CYCLES", results).has_error());
+    EXPECT_EQ(CompiledExpression::compile("BRANCHES / 2", results).error(),
+              "unknown column 'BRANCHES' at position 9");
+}
+
+TEST(DerivedMetricsTest, AddsColumnAndEvaluatesAppendedRows)
+{
+    auto results = resultsWithCounters(2);
+    DerivedMetrics metrics;
+
+    const auto ipc = metrics.define(results, "IPC", "INSTRUCTIONS / CYCLES");
+    ASSERT_FALSE(ipc.has_error()) << ipc.error();
+    const auto doubled = metrics.define(results, "IPC2", "IPC * 2");
+    ASSERT_FALSE(doubled.has_error()) << doubled.error();
+
+    BenchmarkRow row{.name = "BM_Test", .runName = "BM_Test"};
+    row.counters = {{"INSTRUCTIONS", 8.0}, {"CYCLES", 2.0}};
+    results.append(row);
+    metrics.update(results);
+
+    EXPECT_EQ(results.findColumn("IPC"), *ipc);
+    const auto values = results.column(*doubled);
+    EXPECT_EQ(std::vector<double>(values.begin(), values.end()),
+              (std::vector<double>{4.0, 4.0, 8.0}));
+}
+
+TEST(DerivedMetricsTest, RejectsExistingNames)
+{
+    auto results = resultsWithCounters(1);
+    DerivedMetrics metrics;
+
+    EXPECT_TRUE(metrics.define(results, "CYCLES", "INSTRUCTIONS").has_error());
+    EXPECT_TRUE(metrics.metrics().empty());
+}
+
+TEST(DerivedMetricsTest, ReappliesToResultsThatAlreadyHaveTheColumn)
+{
+    auto results = resultsWithCounters(1);
+    DerivedMetrics metrics;
+    const auto ipc = metrics.define(results, "IPC", "INSTRUCTIONS / CYCLES");
+    ASSERT_FALSE(ipc.has_error()) << ipc.error();
+    EXPECT_TRUE(results.isComputedColumn(*ipc));
+    results.mutableColumn(*ipc)[0] = 0.0;
+
+    metrics.reapply(results);
+
+    ASSERT_EQ(metrics.metrics().size(), 1u);
+    EXPECT_EQ(metrics.metrics()[0].column, *ipc);
+    EXPECT_EQ(results.column(*ipc)[0], 2.0);
+    EXPECT_FALSE(results.isComputedColumn(*results.findColumn("CYCLES")));
+}
+
+}// namespace
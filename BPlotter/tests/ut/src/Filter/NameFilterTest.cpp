@@ -0,0 +1,113 @@
+#include "Filter/NameFilter.hpp"
+#include "gtest/gtest.h"
+
+#include <chrono>
+
+namespace
+{
+
+using namespace BPlotter;
+
+class NameFilterTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        for (const auto name: {"BM_VectorPushBack/8", "BM_VectorPushBack/64", "BM_MapInsert/8",
+                               "BM_MapInsert/64", "BM_UnorderedMapInsert/8", "BM_Sort"})
+        {
+            names.intern(name);
+        }
+        filter.reset(names);
+    }
+
+    std::vector<std::string_view> run(std::string_view query, FilterMode mode)
+    {
+        filter.setQuery(query, mode);
+        while (not filter.update(std::chrono::microseconds(1000)))
+        {
+        }
+
+        std::vector<std::string_view> result;
+        for (const auto id: filter.matches())
+        {
+            result.push_back(names.get(id));
+        }
+        return result;
+    }
+
+    StringInterner names;
+    NameFilter filter;
+};
+
+TEST_F(NameFilterTest, EmptyQueryMatchesEverything)
+{
+    EXPECT_EQ(run("", FilterMode::Substring).size(), names.size());
+}
+
+TEST_F(NameFilterTest, SubstringQueryIsCaseInsensitive)
+{
+    const std::vector<std::string_view> expected = {"BM_MapInsert/8", "BM_MapInsert/64",
+                                                    "BM_UnorderedMapInsert/8"};
+    EXPECT_EQ(run("mapinsert", FilterMode::Substring), expected);
+}
+
+TEST_F(NameFilterTest, ShortSubstringQueryWithoutTrigramsStillMatches)
+{
+    const std::vector<std::string_view> expected = {"BM_VectorPushBack/64", "BM_MapInsert/64"};
+    EXPECT_EQ(run("64", FilterMode::Substring), expected);
+}
+
+TEST_F(NameFilterTest, ExtendedQueryRefinesPreviousMatches)
+{
+    run("Map", FilterMode::Substring);
+    const std::vector<std::string_view> expected = {"BM_MapInsert/64"};
+    EXPECT_EQ(run("MapInsert/64", FilterMode::Substring), expected);
+}
+
+TEST_F(NameFilterTest, ShortenedQueryFindsMatchesAgain)
+{
+    run("MapInsert/64", FilterMode::Substring);
+    EXPECT_EQ(run("MapInsert", FilterMode::Substring).size(), 3);
+}
+
+TEST_F(NameFilterTest, RegexQueryMatchesNames)
+{
+    const std::vector<std::string_view> expected = {"BM_VectorPushBack/8", "BM_MapInsert/8"};
+    EXPECT_EQ(run("^BM_(Vector|Map).*/8$", FilterMode::Regex), expected);
+}
+
+TEST_F(NameFilterTest, RegexQueryWithOptionalCharactersIsNotOverfiltered)
+{
+    const std::vector<std::string_view> expected = {"BM_Sort"};
+    EXPECT_EQ(run("BM_Sorts?", FilterMode::Regex), expected);
+    EXPECT_EQ(run("B[M]_S\\w*", FilterMode::Regex), expected);
+    EXPECT_EQ(run("BM_\\Sort", FilterMode::Regex), expected);
+}
+
+TEST_F(NameFilterTest, RegexQueryWithCharacterCodesIsNotOverfiltered)
+{
+    const std::vector<std::string_view> expected = {"BM_Sort"};
+    EXPECT_EQ(run("BM_\\x53ort", FilterMode::Regex), expected);
+    EXPECT_EQ(run("BM_\\u0053ort", FilterMode::Regex), expected);
+    EXPECT_EQ(run("(BM)_\\1?Sort", FilterMode::Regex), expected);
+}
+
+TEST_F(NameFilterTest, InvalidRegexReportsError)
+{
+    EXPECT_TRUE(run("BM_(Map", FilterMode::Regex).empty());
+    EXPECT_FALSE(filter.error().empty());
+}
+
+TEST_F(NameFilterTest, NewlyInternedNamesAreFiltered)
+{
+    run("Sort", FilterMode::Substring);
+    names.intern("BM_StableSort");
+    filter.indexNewNames();
+    while (not filter.update(std::chrono::microseconds(1000)))
+    {
+    }
+    EXPECT_EQ(filter.matches().size(), 2);
+}
+
+}// namespace
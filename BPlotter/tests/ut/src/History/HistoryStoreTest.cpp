@@ -0,0 +1,156 @@
+#include "History/HistoryStore.hpp"
+#include "TestUtils/TemporaryDirectory.hpp"
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+
+using namespace BPlotter;
+
+class HistoryStoreTest : public ::testing::Test
+{
+protected:
+    static BenchmarkResults run(const double copyTime, const double sortTime)
+    {
+        BenchmarkResults results;
+        results.append({.name = "BM_Sort", .runName = "BM_Sort", .realTime = sortTime});
+        results.append({.name = "BM_Copy", .runName = "BM_Copy", .realTime = copyTime});
+        results.append({.name = "BM_Sort", .runName = "BM_Sort", .realTime = sortTime + 1});
+        return results;
+    }
+
+    HistoryStore openStore() const
+    {
+        auto store = HistoryStore::open(directory);
+        EXPECT_FALSE(store.has_error()) << store.error();
+        return std::move(store).value();
+    }
+
+    TemporaryDirectory temporary;
+
+    /**
+     * \brief Directory of the store, created by the store itself.
+     */
+    std::filesystem::path directory = temporary / "history";
+};
+
+TEST_F(HistoryStoreTest, ParsesTimestampsWithTimeZones)
+{
+    EXPECT_EQ(parseTimestamp("1970-01-02T00:00:00Z"), 86400);
+    EXPECT_EQ(parseTimestamp("2024-03-01T10:00:00+01:00"), 1709283600);
+    EXPECT_EQ(parseTimestamp("2024-03-01 09:00:00"), 1709283600);
+    EXPECT_EQ(parseTimestamp("2024-03-01T09:00:00.123456-00:30"), 1709285400);
+    EXPECT_FALSE(parseTimestamp("2024-02-30T09:00:00"));
+    EXPECT_FALSE(parseTimestamp("yesterday"));
+}
+
+TEST_F(HistoryStoreTest, AnswersHistoryOfBenchmarkAfterReopening)
+{
+    {
+        auto store = openStore();
+        ASSERT_TRUE(store.ingest(run(1, 10), "first", 200).value());
+        ASSERT_TRUE(store.ingest(run(2, 20), "second", 100).value());
+    }
+
+    const auto store = openStore();
+    EXPECT_EQ(store.runCount(), 2);
+    EXPECT_EQ(store.benchmarks().size(), 2);
+
+    const auto sort = store.history("BM_Sort", "real_time");
+    ASSERT_EQ(sort.size(), 4);
+    EXPECT_EQ(sort[0].timestamp, 100);
+    EXPECT_DOUBLE_EQ(sort[0].value, 20);
+    EXPECT_DOUBLE_EQ(sort[1].value, 21);
+    EXPECT_EQ(sort[2].timestamp, 200);
+    EXPECT_DOUBLE_EQ(sort[3].value, 11);
+
+    const auto copy = store.history("BM_Copy", "real_time");
+    ASSERT_EQ(copy.size(), 2);
+    EXPECT_DOUBLE_EQ(copy[0].value, 2);
+    EXPECT_DOUBLE_EQ(copy[1].value, 1);
+
+    EXPECT_TRUE(store.history("BM_Missing", "real_time").empty());
+    EXPECT_TRUE(store.history("BM_Copy", "missing").empty());
+}
+
+TEST_F(HistoryStoreTest, ReadsHistoriesOfAllBenchmarksAtOnce)
+{
+    auto store = openStore();
+    ASSERT_TRUE(store.ingest(run(1, 10), "first", 200).value());
+    ASSERT_TRUE(store.ingest(run(2, 20), "second", 100).value());
+
+    const auto histories = store.histories("real_time");
+
+    ASSERT_EQ(histories.size(), 2);
+    for (BenchmarkId id = 0; id < histories.size(); ++id)
+    {
+        const auto expected = store.history(store.benchmarks().get(id), "real_time");
+        ASSERT_EQ(histories[id].size(), expected.size());
+        for (std::size_t i = 0; i < expected.size(); ++i)
+        {
+            EXPECT_EQ(histories[id][i].timestamp, expected[i].timestamp);
+            EXPECT_DOUBLE_EQ(histories[id][i].value, expected[i].value);
+        }
+    }
+}
+
+TEST_F(HistoryStoreTest, IngestsEachRunOnce)
+{
+    auto store = openStore();
+
+    EXPECT_TRUE(store.ingest(run(1, 10), "run", 100).value());
+    EXPECT_FALSE(store.ingest(run(1, 10), "run", 100).value());
+    EXPECT_EQ(store.runCount(), 1);
+    EXPECT_EQ(store.history("BM_Copy", "real_time").size(), 1);
+}
+
+TEST_F(HistoryStoreTest, DropsRunsThatWereNotCommitted)
+{
+    {
+        auto store = openStore();
+        ASSERT_TRUE(store.ingest(run(1, 10), "first", 100).value());
+        ASSERT_TRUE(store.ingest(run(2, 20), "second", 200).value());
+    }
+    // Simulate a crash before the second run was committed
+    const auto runs = directory / "runs.bin";
+    std::filesystem::resize_file(runs, std::filesystem::file_size(runs) - 1);
+
+    auto store = openStore();
+    EXPECT_EQ(store.runCount(), 1);
+    EXPECT_EQ(store.history("BM_Copy", "real_time").size(), 1);
+
+    ASSERT_TRUE(store.ingest(run(3, 30), "second", 300).value());
+    const auto copy = openStore().history("BM_Copy", "real_time");
+    ASSERT_EQ(copy.size(), 2);
+    EXPECT_DOUBLE_EQ(copy[1].value, 3);
+}
+
+TEST_F(HistoryStoreTest, RollsBackIndexWhenRunFailsToCommit)
+{
+    auto store = openStore();
+    ASSERT_TRUE(store.ingest(run(1, 10), "first", 100).value());
+    const auto index = directory / "index.bin";
+    const auto indexSize = std::filesystem::file_size(index);
+
+    // A directory in place of the runs makes appending the run fail
+    const auto runs = directory / "runs.bin";
+    const auto saved = directory / "runs.saved";
+    std::filesystem::rename(runs, saved);
+    std::filesystem::create_directory(runs);
+    EXPECT_TRUE(store.ingest(run(2, 20), "second", 200).has_error());
+    EXPECT_EQ(std::filesystem::file_size(index), indexSize);
+
+    // The next run reuses the segment of the failed one
+    std::filesystem::remove(runs);
+    std::filesystem::rename(saved, runs);
+    ASSERT_TRUE(store.ingest(run(3, 30), "third", 300).value());
+    const auto copy = openStore().history("BM_Copy", "real_time");
+    ASSERT_EQ(copy.size(), 2);
+    EXPECT_DOUBLE_EQ(copy[0].value, 1);
+    EXPECT_DOUBLE_EQ(copy[1].value, 3);
+}
+
+}// namespace
@@ -0,0 +1,127 @@
+#include "Memory/AllocationTracker.hpp"
+#include "gtest/gtest.h"
+
+#include <sstream>
+#include <string>
+
+namespace
+{
+
+using namespace BPlotter;
+
+class AllocationTrackerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        setAllocationTrackingEnabled(true);
+    }
+
+    void TearDown() override
+    {
+        setAllocationTrackingEnabled(false);
+    }
+
+    static AllocationCounts countsOf(const AllocationTotals& totals,
+                                     const AllocationSubsystem subsystem)
+    {
+        return totals[static_cast<std::size_t>(subsystem)];
+    }
+};
+
+TEST_F(AllocationTrackerTest, AttributesTheOperationsToTheInnermostScope)
+{
+    const auto before = allocationTotals();
+    {
+        AllocationScope parser(AllocationSubsystem::Parser);
+        recordAllocation(100);
+        {
+            AllocationScope logging(AllocationSubsystem::Logging);
+            recordAllocation(8);
+            recordFree();
+        }
+        recordFree();
+    }
+    const auto after = allocationTotals();
+
+    EXPECT_EQ(countsOf(after, AllocationSubsystem::Parser) -
+                  countsOf(before, AllocationSubsystem::Parser),
+              (AllocationCounts{1, 1, 100}));
+    EXPECT_EQ(countsOf(after, AllocationSubsystem::Logging) -
+                  countsOf(before, AllocationSubsystem::Logging),
+              (AllocationCounts{1, 1, 8}));
+}
+
+TEST_F(AllocationTrackerTest, CountsNothingWhileDisabled)
+{
+    AllocationScope statistics(AllocationSubsystem::Statistics);
+    const auto before = allocationTotals();
+    setAllocationTrackingEnabled(false);
+    recordAllocation(64);
+    recordFree();
+    setAllocationTrackingEnabled(true);
+
+    EXPECT_EQ(countsOf(allocationTotals(), AllocationSubsystem::Statistics),
+              countsOf(before, AllocationSubsystem::Statistics));
+}
+
+TEST_F(AllocationTrackerTest, RecordsTheDifferenceOfEachFrame)
+{
+    AllocationTracker tracker;
+    tracker.endFrame(0.f);
+    {
+        AllocationScope rendering(AllocationSubsystem::Rendering);
+        recordAllocation(10);
+        recordAllocation(20);
+    }
+    tracker.endFrame(0.016f);
+    tracker.endFrame(0.008f);
+
+    ASSERT_EQ(tracker.frameCount(), 3u);
+    EXPECT_EQ(tracker.frame(1).seconds, 0.016f);
+    EXPECT_EQ(countsOf(tracker.frame(1).subsystems, AllocationSubsystem::Rendering),
+              (AllocationCounts{2, 0, 30}));
+    EXPECT_EQ(countsOf(tracker.frame(2).subsystems, AllocationSubsystem::Rendering),
+              AllocationCounts{});
+    EXPECT_GE(tracker.frame(1).total().allocations, 2u);
+}
+
+TEST_F(AllocationTrackerTest, KeepsOnlyTheLastFrames)
+{
+    AllocationTracker tracker;
+    for (std::size_t i = 0; i < AllocationTracker::HISTORY_SIZE + 10; ++i)
+    {
+        tracker.endFrame(static_cast<float>(i));
+    }
+
+    ASSERT_EQ(tracker.frameCount(), AllocationTracker::HISTORY_SIZE);
+    EXPECT_EQ(tracker.frame(0).seconds, 10.f);
+    EXPECT_EQ(tracker.frame(AllocationTracker::HISTORY_SIZE - 1).seconds,
+              static_cast<float>(AllocationTracker::HISTORY_SIZE + 9));
+}
+
+TEST_F(AllocationTrackerTest, ExportsOneRowPerFrame)
+{
+    AllocationTracker tracker;
+    tracker.endFrame(0.001f);
+    tracker.endFrame(0.002f);
+
+    std::ostringstream output;
+    tracker.exportCsv(output);
+    std::istringstream lines(output.str());
+    std::string header;
+    std::getline(lines, header);
+    EXPECT_EQ(header.rfind("frame,milliseconds,Other allocations,Other frees,Other bytes", 0),
+              0u);
+
+    std::string row;
+    auto rows = 0;
+    while (std::getline(lines, row))
+    {
+        EXPECT_EQ(row.rfind(std::to_string(rows) + ",", 0), 0u);
+        ++rows;
+    }
+    EXPECT_EQ(rows, 2);
+}
+
+}// namespace
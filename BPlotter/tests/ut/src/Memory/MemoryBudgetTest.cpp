@@ -0,0 +1,116 @@
+#include "Memory/MemoryBudget.hpp"
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+
+using namespace BPlotter;
+
+class MemoryBudgetTest : public ::testing::Test
+{
+protected:
+    MemoryEntryId track(const std::string& name, const std::size_t bytes,
+                        const std::size_t bytesAfterEviction = 0)
+    {
+        const auto id = budget.track(name, MemoryCategory::Run,
+                                     [this, name, bytesAfterEviction]
+                                     {
+                                         evicted.push_back(name);
+                                         return bytesAfterEviction;
+                                     });
+        budget.update(id, bytes);
+        return id;
+    }
+
+    MemoryBudget budget{100};
+    std::vector<std::string> evicted;
+};
+
+TEST_F(MemoryBudgetTest, EvictsLeastRecentlyUsedEntriesUntilWithinLimit)
+{
+    const auto first = track("first", 40);
+    track("second", 40);
+    track("third", 40);
+    budget.touch(first);
+
+    EXPECT_EQ(budget.used(), 120u);
+    EXPECT_EQ(budget.enforce(), 40u);
+    EXPECT_EQ(evicted, std::vector<std::string>{"second"});
+    EXPECT_EQ(budget.used(), 80u);
+    EXPECT_EQ(budget.entries()[1].bytes, 0u);
+}
+
+TEST_F(MemoryBudgetTest, NeverEvictsPinnedEntries)
+{
+    const auto pinned = track("pinned", 90);
+    budget.setPinned(pinned, true);
+    track("cold", 30);
+    budget.touch(pinned);
+    track("hot", 30);
+
+    EXPECT_EQ(budget.enforce(), 60u);
+    EXPECT_EQ(evicted, (std::vector<std::string>{"cold", "hot"}));
+    EXPECT_EQ(budget.used(), 90u);
+}
+
+TEST_F(MemoryBudgetTest, NeverEvictsEntriesUsedInTheCurrentFrame)
+{
+    const auto used = track("used", 60);
+    track("cold", 30);
+    const auto reported = track("reported", 30);
+
+    budget.beginFrame();
+    budget.touch(used);
+    budget.resize(reported, 50);
+
+    EXPECT_EQ(budget.enforce(), 80u);
+    EXPECT_EQ(evicted, (std::vector<std::string>{"cold", "reported"}));
+    EXPECT_EQ(budget.used(), 60u);
+}
+
+TEST_F(MemoryBudgetTest, EvictsNothingWhenTheLimitCannotBeReached)
+{
+    const auto pinned = track("pinned", 90);
+    budget.setPinned(pinned, true);
+    const auto used = track("used", 30);
+    track("cold", 30);
+
+    budget.beginFrame();
+    budget.touch(used);
+
+    EXPECT_EQ(budget.enforce(), 0u);
+    EXPECT_TRUE(evicted.empty());
+    EXPECT_EQ(budget.used(), 150u);
+}
+
+TEST_F(MemoryBudgetTest, AccountsPartialEvictionAndReloading)
+{
+    const auto cache = track("cache", 150, 20);
+
+    EXPECT_EQ(budget.enforce(), 130u);
+    EXPECT_EQ(budget.used(), 20u);
+
+    budget.update(cache, 70);
+    EXPECT_EQ(budget.used(), 70u);
+    EXPECT_EQ(budget.enforce(), 0u);
+    EXPECT_EQ(evicted.size(), 1u);
+}
+
+TEST_F(MemoryBudgetTest, UntrackedEntriesReleaseTheirMemory)
+{
+    const auto first = track("first", 60);
+    const auto second = track("second", 30);
+
+    budget.untrack(first);
+
+    EXPECT_EQ(budget.used(), 30u);
+    ASSERT_EQ(budget.entries().size(), 1u);
+    EXPECT_EQ(budget.entries()[0].id, second);
+    EXPECT_EQ(budget.evict(second), 30u);
+    EXPECT_EQ(budget.used(), 0u);
+}
+
+}// namespace
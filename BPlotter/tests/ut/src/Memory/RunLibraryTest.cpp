@@ -0,0 +1,146 @@
+#include "Memory/RunLibrary.hpp"
+#include "TestUtils/TemporaryDirectory.hpp"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <sstream>
+
+namespace
+{
+
+using namespace BPlotter;
+
+class RunLibraryTest : public ::testing::Test
+{
+protected:
+    static BenchmarkResults run(const double time)
+    {
+        BenchmarkResults results;
+        results.append({.name = "BM_Sort/8", .runName = "BM_Sort/8", .realTime = time});
+        BenchmarkRow aggregate{.name = "BM_Sort/8_mean",
+                               .runName = "BM_Sort/8",
+                               .runType = RunType::Aggregate,
+                               .aggregateName = "mean",
+                               .realTime = time};
+        aggregate.counters = {{"bytes_per_second", 2 * time}};
+        results.append(aggregate);
+        results.addColumn("IPC");
+        results.mutableColumn(*results.findColumn("IPC"))[1] = 1.5;
+        results.setContext({.hostName = "host",
+                            .numCpus = 8,
+                            .caches = {{.type = "Data", .level = 1, .size = 32768}}});
+        return results;
+    }
+
+    TemporaryDirectory temporary;
+
+    /**
+     * \brief Directory of the cache files, created by the library only once it evicts a run.
+     */
+    std::filesystem::path directory = temporary / "runs";
+    MemoryBudget budget{1};
+};
+
+TEST_F(RunLibraryTest, WritesAndReadsCacheWithoutLosingAnything)
+{
+    const auto original = run(10);
+    std::stringstream stream;
+    ASSERT_FALSE(original.writeCache(stream).has_error());
+
+    const auto restored = BenchmarkResults::readCache(stream);
+    ASSERT_FALSE(restored.has_error()) << restored.error();
+    ASSERT_EQ(restored->size(), original.size());
+    ASSERT_EQ(restored->columnCount(), original.columnCount());
+    for (ColumnIndex column = 0; column < original.columnCount(); ++column)
+    {
+        EXPECT_EQ(restored->columnName(column), original.columnName(column));
+        EXPECT_EQ(restored->isComputedColumn(column), original.isComputedColumn(column));
+        for (std::size_t row = 0; row < original.size(); ++row)
+        {
+            const auto expected = original.column(column)[row];
+            const auto actual = restored->column(column)[row];
+            EXPECT_TRUE(actual == expected || (std::isnan(actual) && std::isnan(expected)));
+        }
+    }
+    EXPECT_EQ(restored->names().get(restored->runNameColumn()[1]), "BM_Sort/8");
+    EXPECT_EQ(restored->aggregateNames().get(restored->aggregateNameColumn()[1]), "mean");
+    EXPECT_EQ(restored->runTypeColumn()[1], RunType::Aggregate);
+    EXPECT_EQ(restored->context().numCpus, 8);
+    ASSERT_EQ(restored->context().caches.size(), 1u);
+    EXPECT_EQ(restored->context().caches[0].size, 32768);
+}
+
+TEST_F(RunLibraryTest, RejectsTruncatedCache)
+{
+    std::stringstream stream;
+    ASSERT_FALSE(run(10).writeCache(stream).has_error());
+    const auto data = stream.str();
+
+    std::stringstream truncated(data.substr(0, data.size() - 1));
+    EXPECT_TRUE(BenchmarkResults::readCache(truncated).has_error());
+    std::stringstream garbage("not a cache at all");
+    EXPECT_TRUE(BenchmarkResults::readCache(garbage).has_error());
+}
+
+TEST_F(RunLibraryTest, RejectsCorruptedLengthsWithoutAllocatingThem)
+{
+    std::stringstream stream;
+    ASSERT_FALSE(run(10).writeCache(stream).has_error());
+    const auto data = stream.str();
+
+    // The number of rows, the number of names and the length of the first name
+    for (const auto offset: {std::size_t{8}, std::size_t{16}, std::size_t{20}})
+    {
+        auto corruptedData = data;
+        std::fill_n(corruptedData.begin() + static_cast<std::ptrdiff_t>(offset), 4, '\xff');
+        std::stringstream corrupted(corruptedData);
+
+        const auto restored = BenchmarkResults::readCache(corrupted);
+        ASSERT_TRUE(restored.has_error()) << offset;
+        EXPECT_EQ(restored.error(), "The results cache is corrupted");
+    }
+}
+
+TEST_F(RunLibraryTest, EvictsRunsToCacheFilesAndReadsThemBack)
+{
+    {
+        RunLibrary library(budget, directory);
+        library.store("first", run(10));
+        library.store("second", run(20));
+        EXPECT_GT(budget.used(), 0u);
+
+        budget.enforce();
+
+        EXPECT_EQ(budget.used(), 0u);
+        EXPECT_FALSE(library.isResident(0));
+        EXPECT_FALSE(library.isResident(1));
+        EXPECT_TRUE(std::filesystem::exists(directory));
+
+        const auto second = library.take(1);
+        ASSERT_FALSE(second.has_error()) << second.error();
+        EXPECT_EQ(second->column(BuiltinColumn::RealTime)[0], 20);
+        ASSERT_EQ(library.size(), 1u);
+        EXPECT_EQ(library.name(0), "first");
+        EXPECT_EQ(budget.entries().size(), 1u);
+    }
+    EXPECT_FALSE(std::filesystem::exists(directory));
+    EXPECT_TRUE(budget.entries().empty());
+}
+
+TEST_F(RunLibraryTest, KeepsRunsInMemoryWithinBudget)
+{
+    budget.setLimit(MemoryBudget::DEFAULT_LIMIT);
+    RunLibrary library(budget, directory);
+    library.store("first", run(10));
+
+    budget.enforce();
+
+    EXPECT_TRUE(library.isResident(0));
+    EXPECT_EQ(library.take(0)->column(BuiltinColumn::RealTime)[0], 10);
+    EXPECT_EQ(budget.used(), 0u);
+    EXPECT_FALSE(std::filesystem::exists(directory));
+}
+
+}// namespace
@@ -0,0 +1,76 @@
+#include "Panels/ScalingPanel.hpp"
+#include "Platform/HeadlessWindow.hpp"
+#include "gtest/gtest.h"
+
+#include <optional>
+#include <string>
+
+namespace
+{
+
+using namespace BPlotter;
+
+class ScalingPanelTest : public ::testing::Test
+{
+protected:
+    /**
+     * \brief Runs a frame displaying the panel in a window of a fixed size.
+     */
+    void drawFrame()
+    {
+        window.updateImGui(sf::seconds(1.f / 60.f), std::nullopt);
+        ImGui::SetNextWindowPos({0.f, 0.f});
+        ImGui::SetNextWindowSize({640.f, 480.f});
+        panel.updateImGui(results);
+        ImGui::Render();
+    }
+
+    void append(const std::string& family, double threads, double realTime)
+    {
+        const auto name = family + "/threads:" + std::to_string(static_cast<int>(threads));
+        BenchmarkRow row;
+        row.name = name;
+        row.runName = name;
+        row.threads = threads;
+        row.realTime = realTime;
+        results.append(row);
+    }
+
+    HeadlessWindow window{{800, 600}};
+    TaskScheduler scheduler{1};
+    BenchmarkResults results;
+    ScalingPanel panel{scheduler};
+};
+
+TEST_F(ScalingPanelTest, KeepsLayersWhileResultsAreTheSame)
+{
+    append("BM_Work", 1, 100);
+    append("BM_Work", 2, 60);
+
+    // The window is laid out during its first frames
+    drawFrame();
+    drawFrame();
+    const auto drawCount = panel.staticLayersDrawCount();
+    drawFrame();
+    drawFrame();
+
+    EXPECT_GT(drawCount, 0u);
+    EXPECT_EQ(panel.staticLayersDrawCount(), drawCount);
+}
+
+TEST_F(ScalingPanelTest, DrawsLayersAgainWhenResultsChange)
+{
+    append("BM_Work", 1, 100);
+    append("BM_Work", 2, 60);
+    drawFrame();
+    drawFrame();
+    const auto drawCount = panel.staticLayersDrawCount();
+
+    // The rebuilt series have as many points as before, and may well reuse the same memory
+    append("BM_Work", 2, 55);
+    drawFrame();
+
+    EXPECT_EQ(panel.staticLayersDrawCount(), drawCount + 1);
+}
+
+}// namespace
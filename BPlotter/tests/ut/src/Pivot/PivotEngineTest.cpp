@@ -0,0 +1,142 @@
+#include "Pivot/PivotEngine.hpp"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+namespace
+{
+
+using namespace BPlotter;
+
+class PivotEngineTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        engine.reset(results);
+    }
+
+    void append(std::string_view name, double realTime, RunType type = RunType::Iteration,
+                std::string_view aggregate = "")
+    {
+        BenchmarkRow row;
+        row.name = name;
+        row.runName = name;
+        row.runType = type;
+        row.aggregateName = aggregate;
+        row.realTime = realTime;
+        results.append(row);
+    }
+
+    BenchmarkResults results;
+    PivotEngine engine;
+    PivotKey key{.x = {DimensionKind::Argument, 0}, .group = {DimensionKind::Family}};
+};
+
+TEST_F(PivotEngineTest, GroupsRowsIntoSortedSeries)
+{
+    append("BM_Vector/64", 40);
+    append("BM_Vector/8", 10);
+    append("BM_List/8", 30);
+
+    const auto& result = engine.pivot(key, {});
+
+    ASSERT_EQ(result.series.size(), 2);
+    EXPECT_EQ(result.series[0].name, "BM_List");
+    EXPECT_EQ(result.series[1].name, "BM_Vector");
+    EXPECT_EQ(result.series[1].x, (std::vector<double>{8, 64}));
+    EXPECT_EQ(result.series[1].y, (std::vector<double>{10, 40}));
+    EXPECT_TRUE(result.xCategories.empty());
+}
+
+TEST_F(PivotEngineTest, AggregatesRowsFallingIntoTheSamePoint)
+{
+    append("BM_Vector/8", 10);
+    append("BM_Vector/8", 20);
+    append("BM_Vector/8", 90, RunType::Aggregate, "mean");
+
+    key.aggregation = Aggregation::Max;
+    EXPECT_EQ(engine.pivot(key, {}).series[0].y, (std::vector<double>{20}));
+
+    key.aggregation = Aggregation::Mean;
+    EXPECT_EQ(engine.pivot(key, {}).series[0].y, (std::vector<double>{15}));
+
+    key.aggregateName = "mean";
+    EXPECT_EQ(engine.pivot(key, {}).series[0].y, (std::vector<double>{90}));
+}
+
+TEST_F(PivotEngineTest, MemoizedViewIsUpdatedWithNewRowsOnly)
+{
+    append("BM_Vector/8", 10);
+    EXPECT_EQ(engine.pivot(key, {}).series[0].x.size(), 1);
+    EXPECT_EQ(engine.memoizedViews(), 1);
+
+    append("BM_Vector/16", 10);
+    append("BM_Vector/8", 30);
+    const auto& result = engine.pivot(key, {});
+    EXPECT_EQ(result.series[0].x, (std::vector<double>{8, 16}));
+    EXPECT_EQ(result.series[0].y, (std::vector<double>{20, 10}));
+    EXPECT_EQ(engine.memoizedViews(), 1);
+}
+
+TEST_F(PivotEngineTest, EvictionKeepsOnlyTheLastView)
+{
+    append("BM_Vector/8", 10);
+    append("BM_Vector/8", 30);
+    key.aggregation = Aggregation::Max;
+    engine.pivot(key, {});
+    key.aggregation = Aggregation::Min;
+    const auto& last = engine.pivot(key, {});
+    const auto bytes = engine.memoryUsage();
+
+    EXPECT_LT(engine.evictViews(), bytes);
+    EXPECT_EQ(engine.memoizedViews(), 1);
+    EXPECT_EQ(last.series[0].y, (std::vector<double>{10}));
+}
+
+TEST_F(PivotEngineTest, NonNumericValuesBecomeCategories)
+{
+    append("BM_Sort<int>/8", 10);
+    append("BM_Sort<double>/8", 20);
+
+    key.x = {DimensionKind::TemplateParameter, 0};
+    key.group = {DimensionKind::Argument, 0};
+    const auto& result = engine.pivot(key, {});
+
+    EXPECT_EQ(result.xCategories, (std::vector<std::string>{"double", "int"}));
+    ASSERT_EQ(result.series.size(), 1);
+    EXPECT_EQ(result.series[0].x, (std::vector<double>{0, 1}));
+    EXPECT_EQ(result.series[0].y, (std::vector<double>{20, 10}));
+}
+
+TEST_F(PivotEngineTest, NameFilterSelectsRows)
+{
+    append("BM_Vector/8", 10);
+    append("BM_List/8", 30);
+
+    key.nameFilter = "substring:List";
+    const std::vector<StringId> matching = {*results.names().find("BM_List/8")};
+    const auto& result = engine.pivot(key, matching);
+
+    ASSERT_EQ(result.series.size(), 1);
+    EXPECT_EQ(result.series[0].name, "BM_List");
+}
+
+TEST_F(PivotEngineTest, ListsAvailableDimensions)
+{
+    append("BM_Copy<int>/8/threads:2", 10);
+
+    const auto& dimensions = engine.dimensions();
+    const auto contains = [&](const Dimension& dimension)
+    {
+        return std::ranges::find(dimensions, dimension) != dimensions.end();
+    };
+    EXPECT_TRUE(contains({DimensionKind::Argument, 0}));
+    EXPECT_TRUE(contains({DimensionKind::TemplateParameter, 0}));
+    EXPECT_TRUE(contains({DimensionKind::NamedArgument, 0, "threads"}));
+    EXPECT_TRUE(
+        contains({DimensionKind::Column, static_cast<ColumnIndex>(BuiltinColumn::CpuTime)}));
+    EXPECT_FALSE(contains({DimensionKind::Argument, 1}));
+}
+
+}// namespace
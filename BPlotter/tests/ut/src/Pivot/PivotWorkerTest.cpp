@@ -0,0 +1,104 @@
+#include "Pivot/PivotWorker.hpp"
+#include "gtest/gtest.h"
+
+#include <string_view>
+#include <vector>
+
+namespace
+{
+
+using namespace BPlotter;
+
+class PivotWorkerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        append("BM_Vector/8", 10);
+        append("BM_Vector/64", 40);
+        append("BM_List/8", 30);
+        worker.reset(results);
+    }
+
+    void append(std::string_view name, double realTime)
+    {
+        BenchmarkRow row;
+        row.name = name;
+        row.runName = name;
+        row.realTime = realTime;
+        results.append(row);
+    }
+
+    BenchmarkResults results;
+    TaskScheduler scheduler{2};
+    PivotWorker worker{scheduler};
+    PivotKey key{.x = {DimensionKind::Argument, 0}, .group = {DimensionKind::Family}};
+};
+
+TEST_F(PivotWorkerTest, PublishesTheSnapshotOnceItIsComputed)
+{
+    EXPECT_EQ(worker.snapshot(), nullptr);
+    EXPECT_FALSE(worker.dimensions().empty());
+
+    worker.request(key, {});
+    worker.wait();
+
+    const auto* snapshot = worker.snapshot();
+    ASSERT_NE(snapshot, nullptr);
+    EXPECT_EQ(snapshot->key, key);
+    ASSERT_EQ(snapshot->result.series.size(), 2u);
+    EXPECT_EQ(snapshot->result.series[1].y, (std::vector<double>{10, 40}));
+    EXPECT_FALSE(worker.isBusy());
+}
+
+TEST_F(PivotWorkerTest, KeepsTheSnapshotWhenTheSameViewIsRequestedAgain)
+{
+    worker.request(key, {});
+    worker.wait();
+    const auto generation = worker.snapshot()->generation;
+
+    worker.request(key, {});
+    EXPECT_FALSE(worker.isBusy());
+    worker.update();
+    EXPECT_EQ(worker.snapshot()->generation, generation);
+}
+
+TEST_F(PivotWorkerTest, ComputesOnlyTheLatestOfTheRequestsMadeMeanwhile)
+{
+    worker.request(key, {});
+    auto byName = key;
+    byName.group = {DimensionKind::Name};
+    worker.request(byName, {});
+    auto maximum = key;
+    maximum.aggregation = Aggregation::Max;
+    worker.request(maximum, {});
+    worker.wait();
+
+    const auto* snapshot = worker.snapshot();
+    ASSERT_NE(snapshot, nullptr);
+    EXPECT_EQ(snapshot->key, maximum);
+    EXPECT_GT(snapshot->generation, 1u);
+}
+
+TEST_F(PivotWorkerTest, PassesTheMatchingNamesToAFilteredView)
+{
+    key.nameFilter = "substring:List";
+    const std::vector<StringId> list{results.nameColumn()[2]};
+
+    worker.request(key, list);
+    worker.wait();
+    ASSERT_EQ(worker.snapshot()->result.series.size(), 1u);
+    EXPECT_EQ(worker.snapshot()->result.series[0].name, "BM_List");
+}
+
+TEST_F(PivotWorkerTest, DropsTheSnapshotOnReset)
+{
+    worker.request(key, {});
+    worker.wait();
+    EXPECT_GT(worker.memoryUsage(), 0u);
+
+    worker.reset(results);
+    EXPECT_EQ(worker.snapshot(), nullptr);
+}
+
+}// namespace
@@ -0,0 +1,89 @@
+#include "Platform/FrameScheduler.hpp"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <thread>
+
+namespace
+{
+
+using namespace BPlotter;
+
+constexpr auto STEP = 0.25f;
+
+FrameSchedulerSettings unlimitedSettings()
+{
+    return {.fixedStep = STEP, .maxStepsPerFrame = 100, .fixedUpdateBudget = std::nullopt};
+}
+
+TEST(FrameSchedulerTest, RunsTheStepsThatBecameDue)
+{
+    FrameScheduler scheduler(unlimitedSettings());
+    auto simulated = 0.f;
+    const auto fixedUpdate = [&simulated](const float step)
+    {
+        simulated += step;
+    };
+
+    EXPECT_EQ(scheduler.advance(0.1f, fixedUpdate), 0u);
+    EXPECT_EQ(scheduler.advance(0.2f, fixedUpdate), 1u);
+    EXPECT_EQ(scheduler.advance(0.75f, fixedUpdate), 3u);
+    EXPECT_FLOAT_EQ(simulated, 1.f);
+
+    const auto& statistics = scheduler.statistics();
+    EXPECT_EQ(statistics.frames, 3u);
+    EXPECT_EQ(statistics.fixedSteps, 4u);
+    EXPECT_EQ(statistics.compensatedSteps, 2u);
+    EXPECT_EQ(statistics.droppedSteps, 0u);
+    EXPECT_EQ(statistics.lastFrameSteps, 3u);
+}
+
+TEST(FrameSchedulerTest, DropsTheStepsBeyondTheCap)
+{
+    auto settings = unlimitedSettings();
+    settings.maxStepsPerFrame = 4;
+    FrameScheduler scheduler(settings);
+    const auto fixedUpdate = [](float)
+    {
+    };
+
+    // A stall of ten seconds runs four steps, not forty, and does not leave any behind
+    EXPECT_EQ(scheduler.advance(10.1f, fixedUpdate), 4u);
+    EXPECT_EQ(scheduler.advance(0.2f, fixedUpdate), 1u);
+
+    const auto& statistics = scheduler.statistics();
+    EXPECT_EQ(statistics.droppedSteps, 36u);
+    EXPECT_EQ(statistics.framesWithDroppedSteps, 1u);
+    EXPECT_DOUBLE_EQ(statistics.simulatedSeconds, 1.25);
+    EXPECT_NEAR(statistics.elapsedSeconds, 10.3, 1e-5);
+}
+
+TEST(FrameSchedulerTest, RunsOneStepWhenTheCapIsZero)
+{
+    auto settings = unlimitedSettings();
+    settings.maxStepsPerFrame = 0;
+    FrameScheduler scheduler(settings);
+    const auto fixedUpdate = [](float)
+    {
+    };
+
+    EXPECT_EQ(scheduler.advance(10.1f, fixedUpdate), 1u);
+    EXPECT_EQ(scheduler.statistics().droppedSteps, 39u);
+}
+
+TEST(FrameSchedulerTest, StopsCatchingUpOnceTheBudgetIsSpent)
+{
+    auto settings = unlimitedSettings();
+    settings.fixedUpdateBudget = 0.001f;
+    FrameScheduler scheduler(settings);
+    const auto slowUpdate = [](float)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    };
+
+    // The first step always runs, the budget is spent by then
+    EXPECT_EQ(scheduler.advance(2.f, slowUpdate), 1u);
+    EXPECT_EQ(scheduler.statistics().droppedSteps, 7u);
+}
+
+}// namespace
@@ -0,0 +1,99 @@
+#include "Plot/MinMaxPyramid.hpp"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace
+{
+
+using namespace BPlotter;
+
+std::vector<double> indices(const std::size_t size)
+{
+    std::vector<double> x(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        x[i] = static_cast<double>(i);
+    }
+    return x;
+}
+
+TEST(MinMaxPyramidTest, ReturnsAllVisiblePointsWhenTheyFitTheBuckets)
+{
+    const std::vector<double> y = {5, 1, 4, 2, 3, 9, 0, 7};
+    const MinMaxPyramid pyramid(indices(y.size()), y);
+    std::vector<EnvelopePoint> envelope;
+
+    pyramid.envelope(2, 4, 100, envelope);
+
+    // The neighbors outside of the range are included
+    ASSERT_EQ(envelope.size(), 5u);
+    EXPECT_EQ(envelope.front().x, 1);
+    EXPECT_EQ(envelope.back().x, 5);
+    EXPECT_EQ(envelope[2].y, 2);
+}
+
+TEST(MinMaxPyramidTest, KeepsExtremesOfEveryBucketInTheirOrder)
+{
+    constexpr std::size_t SIZE = 1 << 16;
+    std::vector<double> y(SIZE);
+    for (std::size_t i = 0; i < SIZE; ++i)
+    {
+        y[i] = std::sin(static_cast<double>(i) * 0.01) * 100.0 + static_cast<double>(i % 7);
+    }
+    y[12345] = 1000;
+    y[54321] = -1000;
+    const MinMaxPyramid pyramid(indices(SIZE), y);
+    std::vector<EnvelopePoint> envelope;
+
+    pyramid.envelope(0, SIZE, 500, envelope);
+
+    EXPECT_LE(envelope.size(), 2u * 500u + 4u);
+    EXPECT_TRUE(std::ranges::is_sorted(envelope, {}, &EnvelopePoint::x));
+    EXPECT_EQ(std::ranges::max(envelope, {}, &EnvelopePoint::y).x, 12345);
+    EXPECT_EQ(std::ranges::min(envelope, {}, &EnvelopePoint::y).x, 54321);
+}
+
+TEST(MinMaxPyramidTest, ZoomedRangeHasTheSameExtremesAsTheRawPoints)
+{
+    constexpr std::size_t SIZE = 100000;
+    std::vector<double> y(SIZE);
+    for (std::size_t i = 0; i < SIZE; ++i)
+    {
+        y[i] = static_cast<double>((i * 7919) % 1009);
+    }
+    const MinMaxPyramid pyramid(indices(SIZE), y);
+    std::vector<EnvelopePoint> envelope;
+
+    pyramid.envelope(20000, 30000, 100, envelope);
+
+    const auto rawMax = *std::max_element(y.begin() + 20000, y.begin() + 30001);
+    const auto rawMin = *std::min_element(y.begin() + 20000, y.begin() + 30001);
+    EXPECT_LE(envelope.size(), 2u * 100u + 4u);
+    EXPECT_GE(std::ranges::max(envelope, {}, &EnvelopePoint::y).y, rawMax);
+    EXPECT_LE(std::ranges::min(envelope, {}, &EnvelopePoint::y).y, rawMin);
+    EXPECT_LE(envelope.front().x, 20000);
+    EXPECT_GE(envelope.back().x, 30000);
+}
+
+TEST(MinMaxPyramidTest, SkipsMissingValues)
+{
+    constexpr auto NaN = std::numeric_limits<double>::quiet_NaN();
+    std::vector<double> y(64, NaN);
+    y[10] = 3;
+    y[40] = -2;
+    const MinMaxPyramid pyramid(indices(y.size()), y);
+    std::vector<EnvelopePoint> envelope;
+
+    pyramid.envelope(0, 63, 2, envelope);
+
+    ASSERT_EQ(envelope.size(), 2u);
+    EXPECT_EQ(envelope[0].x, 10);
+    EXPECT_EQ(envelope[1].x, 40);
+    EXPECT_GT(pyramid.memoryUsage(), 2 * 64 * sizeof(double));
+}
+
+}// namespace
@@ -0,0 +1,80 @@
+#include "Plot/NearestPointIndex.hpp"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+using namespace BPlotter;
+
+TEST(NearestPointIndexTest, FindsTheSameNearestPointAsScanningAllPoints)
+{
+    std::mt19937 random(42);
+    std::uniform_real_distribution<double> coordinate(0, 1000);
+    std::vector<double> x(20000);
+    std::vector<double> y(x.size());
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        x[i] = coordinate(random);
+        y[i] = coordinate(random) / 100.0;
+    }
+    const NearestPointIndex index(x, y);
+    ASSERT_EQ(index.size(), x.size());
+
+    // The axes are scaled differently, as the ones of a plot usually are
+    constexpr double scaleX = 0.5;
+    constexpr double scaleY = 40.0;
+    for (int query = 0; query < 200; ++query)
+    {
+        const auto queryX = coordinate(random);
+        const auto queryY = coordinate(random) / 100.0;
+
+        auto bestDistance = std::numeric_limits<double>::infinity();
+        for (std::size_t i = 0; i < x.size(); ++i)
+        {
+            bestDistance = std::min(bestDistance, std::hypot((x[i] - queryX) * scaleX,
+                                                             (y[i] - queryY) * scaleY));
+        }
+
+        const auto nearest = index.nearest(queryX, queryY, scaleX, scaleY, 1e9);
+        ASSERT_TRUE(nearest);
+        EXPECT_DOUBLE_EQ(nearest->distance, bestDistance);
+        EXPECT_DOUBLE_EQ(std::hypot((x[nearest->index] - queryX) * scaleX,
+                                    (y[nearest->index] - queryY) * scaleY),
+                         bestDistance);
+    }
+}
+
+TEST(NearestPointIndexTest, IgnoresPointsFartherThanTheMaximalDistance)
+{
+    const std::vector<double> x = {0, 10, 20};
+    const std::vector<double> y = {0, 0, 0};
+    const NearestPointIndex index(x, y);
+
+    EXPECT_FALSE(index.nearest(5, 4, 1, 1, 4));
+    const auto nearest = index.nearest(12, 0, 1, 1, 4);
+    ASSERT_TRUE(nearest);
+    EXPECT_EQ(nearest->index, 1u);
+    EXPECT_DOUBLE_EQ(nearest->distance, 2);
+}
+
+TEST(NearestPointIndexTest, SkipsPointsWithNonFiniteCoordinates)
+{
+    constexpr auto NaN = std::numeric_limits<double>::quiet_NaN();
+    const std::vector<double> x = {1, 2, 3, std::numeric_limits<double>::infinity()};
+    const std::vector<double> y = {5, NaN, 7, 2};
+    const NearestPointIndex index(x, y);
+
+    EXPECT_EQ(index.size(), 2u);
+    const auto nearest = index.nearest(2, 6.1, 1, 1, 10);
+    ASSERT_TRUE(nearest);
+    EXPECT_EQ(nearest->index, 2u);
+    EXPECT_FALSE(NearestPointIndex().nearest(0, 0, 1, 1, 10));
+}
+
+}// namespace
@@ -0,0 +1,142 @@
+#include "Plot/PlotView.hpp"
+#include "Platform/HeadlessWindow.hpp"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <future>
+#include <numeric>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+using namespace BPlotter;
+
+class PlotViewTest : public ::testing::Test
+{
+protected:
+    /**
+     * \brief Runs a frame displaying the series in a window of a fixed size.
+     */
+    void drawFrame(const std::vector<Series>& series, const std::uint64_t version)
+    {
+        window.updateImGui(sf::seconds(1.f / 60.f), std::nullopt);
+        ImGui::SetNextWindowPos({0.f, 0.f});
+        ImGui::SetNextWindowSize({640.f, 480.f});
+        ImGui::Begin("Plot");
+        plot.updateImGui(series, version);
+        ImGui::End();
+        ImGui::Render();
+    }
+
+    /**
+     * \brief Draws frames until the background tasks of the plot built some of its caches.
+     */
+    void drawUntilCached(const std::vector<Series>& series, const std::uint64_t version)
+    {
+        for (auto frame = 0; frame < 1000 && plot.memoryUsage() == 0; ++frame)
+        {
+            drawFrame(series, version);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    /**
+     * \brief Series large enough to be drawn out of a level of detail.
+     */
+    static Series largeSeries()
+    {
+        Series series{"BM_Sort"};
+        series.x.resize(100000);
+        std::iota(series.x.begin(), series.x.end(), 0.0);
+        series.y = series.x;
+        return series;
+    }
+
+    HeadlessWindow window{{800, 600}};
+    TaskScheduler scheduler{1};
+    PlotView plot{scheduler};
+};
+
+TEST_F(PlotViewTest, KeepsLayersWhileVersionOfSeriesIsTheSame)
+{
+    const std::vector<Series> series{{"BM_Sort", {1, 2, 3}, {10, 20, 30}}};
+
+    // The window is laid out during its first frames
+    drawFrame(series, 1);
+    drawFrame(series, 1);
+    const auto drawCount = plot.staticLayersDrawCount();
+    drawFrame(series, 1);
+    drawFrame(series, 1);
+
+    EXPECT_GT(drawCount, 0u);
+    EXPECT_EQ(plot.staticLayersDrawCount(), drawCount);
+}
+
+TEST_F(PlotViewTest, DrawsLayersAgainForNewVersionInSameMemory)
+{
+    std::vector<Series> series{{"BM_Sort", {1, 2, 3}, {10, 20, 30}}};
+    drawFrame(series, 1);
+    drawFrame(series, 1);
+    const auto drawCount = plot.staticLayersDrawCount();
+
+    // Same storage, size and last point, as a new snapshot may well get them
+    series[0].y[1] = 25;
+    drawFrame(series, 2);
+
+    EXPECT_EQ(plot.staticLayersDrawCount(), drawCount + 1);
+}
+
+TEST_F(PlotViewTest, ReleasesCachesOfSeriesNoLongerDisplayed)
+{
+    drawUntilCached({largeSeries()}, 1);
+    ASSERT_GT(plot.memoryUsage(), 0u);
+
+    // Without a graphics context there is no texture, so nothing else is held
+    drawFrame({}, 2);
+    EXPECT_EQ(plot.memoryUsage(), 0u);
+}
+
+TEST_F(PlotViewTest, EvictsCachesOfDisplayedSeries)
+{
+    const std::vector<Series> series{largeSeries()};
+    drawUntilCached(series, 1);
+    ASSERT_GT(plot.memoryUsage(), 0u);
+
+    EXPECT_EQ(plot.evictCaches(), 0u);
+    drawUntilCached(series, 1);
+    EXPECT_GT(plot.memoryUsage(), 0u);
+}
+
+TEST_F(PlotViewTest, KeepsCachesStillBeingBuiltWhenEvicting)
+{
+    std::promise<void> started;
+    std::promise<void> release;
+    auto blocker = scheduler.submit(TaskPriority::Interactive,
+                                    [&started, released = release.get_future()]
+                                    {
+                                        started.set_value();
+                                        released.wait();
+                                    });
+    started.get_future().wait();
+
+    // The window is laid out during its first frames
+    const std::vector<Series> series{largeSeries()};
+    drawFrame(series, 1);
+    drawFrame(series, 1);
+    const auto queuedTasks = scheduler.statistics().queuedTasks[0];
+    ASSERT_GT(queuedTasks, 0u);
+
+    // A dropped build would be started again in the next frame
+    plot.evictCaches();
+    drawFrame(series, 1);
+    EXPECT_EQ(scheduler.statistics().queuedTasks[0], queuedTasks);
+
+    release.set_value();
+    drawUntilCached(series, 1);
+    EXPECT_GT(plot.memoryUsage(), 0u);
+}
+
+}// namespace
@@ -0,0 +1,131 @@
+#include "Replay/EventRecording.hpp"
+#include "gtest/gtest.h"
+
+#include <sstream>
+#include <vector>
+
+namespace
+{
+
+using namespace BPlotter;
+
+std::vector<sf::Event> recordedEvents()
+{
+    return {
+        sf::Event::Closed{},
+        sf::Event::Resized{{1920, 1080}},
+        sf::Event::FocusLost{},
+        sf::Event::FocusGained{},
+        sf::Event::TextEntered{U'é'},
+        sf::Event::KeyPressed{sf::Keyboard::Key::A, sf::Keyboard::Scancode::A, false, true,
+                              false, false},
+        sf::Event::KeyReleased{sf::Keyboard::Key::Escape, sf::Keyboard::Scancode::Escape, true,
+                               false, true, true},
+        sf::Event::MouseWheelScrolled{sf::Mouse::Wheel::Vertical, -1.5f, {10, 20}},
+        sf::Event::MouseButtonPressed{sf::Mouse::Button::Right, {30, 40}},
+        sf::Event::MouseButtonReleased{sf::Mouse::Button::Left, {-5, 0}},
+        sf::Event::MouseMoved{{640, 360}},
+        sf::Event::MouseEntered{},
+        sf::Event::MouseLeft{},
+    };
+}
+
+std::string lineOf(const sf::Event& event)
+{
+    return toRecordedLine(event).value_or("");
+}
+
+TEST(EventRecordingTest, RoundTripsEveryRecordedEvent)
+{
+    const auto events = recordedEvents();
+    EventRecording recording;
+    recording.beginFrame(0.016f);
+    recording.record(events.front());
+    recording.beginFrame(0.25f);
+    for (std::size_t i = 1; i < events.size(); ++i)
+    {
+        recording.record(events[i]);
+    }
+
+    std::stringstream text;
+    ASSERT_FALSE(recording.write(text).has_error());
+    const auto read = EventRecording::read(text);
+
+    ASSERT_FALSE(read.has_error()) << read.error();
+    ASSERT_EQ(read->frames().size(), 2u);
+    EXPECT_EQ(read->eventCount(), events.size());
+    EXPECT_FLOAT_EQ(read->frames()[0].deltaTime, 0.016f);
+    EXPECT_FLOAT_EQ(read->frames()[1].deltaTime, 0.25f);
+    EXPECT_EQ(lineOf(read->frames()[0].events[0]), "Closed");
+    for (std::size_t i = 1; i < events.size(); ++i)
+    {
+        EXPECT_EQ(lineOf(read->frames()[1].events[i - 1]), lineOf(events[i]));
+    }
+}
+
+TEST(EventRecordingTest, KeepsTheFieldsOfTheEvents)
+{
+    const auto key = fromRecordedLine("KeyReleased 36 36 1 0 1 1");
+    ASSERT_TRUE(key);
+    const auto* released = key->getIf<sf::Event::KeyReleased>();
+    ASSERT_NE(released, nullptr);
+    EXPECT_EQ(released->code, sf::Keyboard::Key::Escape);
+    EXPECT_TRUE(released->alt);
+    EXPECT_FALSE(released->control);
+
+    const auto wheel = fromRecordedLine("MouseWheelScrolled 1 2.5 -3 4");
+    ASSERT_TRUE(wheel);
+    const auto* scrolled = wheel->getIf<sf::Event::MouseWheelScrolled>();
+    ASSERT_NE(scrolled, nullptr);
+    EXPECT_EQ(scrolled->wheel, sf::Mouse::Wheel::Horizontal);
+    EXPECT_FLOAT_EQ(scrolled->delta, 2.5f);
+    EXPECT_EQ(scrolled->position.x, -3);
+    EXPECT_EQ(scrolled->position.y, 4);
+}
+
+TEST(EventRecordingTest, IgnoresTheEventsTheApplicationDoesNotUse)
+{
+    EventRecording recording;
+    recording.record(sf::Event::JoystickConnected{0});
+    EXPECT_TRUE(recording.frames().empty());
+    EXPECT_FALSE(toRecordedLine(sf::Event::JoystickConnected{0}));
+
+    // Events polled before the first frame belong to it
+    recording.record(sf::Event::MouseEntered{});
+    ASSERT_EQ(recording.frames().size(), 1u);
+    EXPECT_EQ(recording.frames()[0].deltaTime, 0.f);
+    EXPECT_EQ(recording.eventCount(), 1u);
+}
+
+TEST(EventRecordingTest, ReadsRecordingsWithWindowsLineEndings)
+{
+    std::istringstream text("BPlotterEvents 1\r\nframe 0.5\r\n\r\nMouseMoved 1 2\r\n");
+    const auto read = EventRecording::read(text);
+
+    ASSERT_FALSE(read.has_error()) << read.error();
+    ASSERT_EQ(read->frames().size(), 1u);
+    EXPECT_EQ(lineOf(read->frames()[0].events.at(0)), "MouseMoved 1 2");
+}
+
+TEST(EventRecordingTest, RejectsInvalidRecordings)
+{
+    const auto readError = [](const std::string& text)
+    {
+        std::istringstream input(text);
+        const auto read = EventRecording::read(input);
+        return read.has_error() ? read.error() : std::string();
+    };
+
+    EXPECT_FALSE(readError("").empty());
+    EXPECT_FALSE(readError("BPlotterEvents 2\n").empty());
+    EXPECT_EQ(readError("BPlotterEvents 1\nClosed\n"), "Line 2: event before the first frame");
+    EXPECT_EQ(readError("BPlotterEvents 1\nframe -1\n"), "Line 2: invalid frame 'frame -1'");
+    EXPECT_EQ(readError("BPlotterEvents 1\nframe 0\nClosed 1\n"),
+              "Line 3: invalid event 'Closed 1'");
+    EXPECT_FALSE(readError("BPlotterEvents 1\nframe 0\nMouseMoved 1\n").empty());
+    EXPECT_FALSE(readError("BPlotterEvents 1\nframe 0\nKeyPressed 500 0 0 0 0 0\n").empty());
+    EXPECT_FALSE(readError("BPlotterEvents 1\nframe 0\nMouseButtonPressed 9 0 0\n").empty());
+    EXPECT_FALSE(readError("BPlotterEvents 1\nframe 0\nJoystickConnected 0\n").empty());
+}
+
+}// namespace
@@ -0,0 +1,42 @@
+#include "Replay/FrameTimings.hpp"
+#include "gtest/gtest.h"
+
+#include <sstream>
+
+namespace
+{
+
+using namespace BPlotter;
+
+TEST(FrameTimingsTest, SummarizesTheFrames)
+{
+    FrameTimings timings;
+    EXPECT_EQ(timings.percentile(0.5), 0.f);
+    EXPECT_EQ(timings.mean(), 0.f);
+
+    for (auto frame = 1; frame <= 100; ++frame)
+    {
+        timings.record(static_cast<float>(frame) / 1000.f);
+    }
+
+    EXPECT_EQ(timings.frameCount(), 100u);
+    EXPECT_FLOAT_EQ(timings.percentile(0.5), 0.050f);
+    EXPECT_FLOAT_EQ(timings.percentile(0.99), 0.099f);
+    EXPECT_FLOAT_EQ(timings.percentile(1), 0.100f);
+    EXPECT_FLOAT_EQ(timings.percentile(0), 0.001f);
+    EXPECT_NEAR(timings.mean(), 0.0505f, 1e-6);
+}
+
+TEST(FrameTimingsTest, ExportsMillisecondsPerFrame)
+{
+    FrameTimings timings;
+    timings.record(0.002f);
+    timings.record(0.0165f);
+
+    std::ostringstream csv;
+    timings.exportCsv(csv);
+
+    EXPECT_EQ(csv.str(), "frame,milliseconds\n0,2\n1,16.5\n");
+}
+
+}// namespace
@@ -0,0 +1,137 @@
+#include "Session/SessionStore.hpp"
+#include "TestUtils/TemporaryDirectory.hpp"
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+
+using namespace BPlotter;
+
+class SessionStoreTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        std::ofstream(source) << "{}";
+    }
+
+    SessionSnapshot snapshot() const
+    {
+        SessionSnapshot snapshot;
+        snapshot.displayedRun = SessionRun{source.string(), runCacheKey(source)};
+        snapshot.storedRuns = {{"missing.json", ""}};
+        snapshot.filter = "BM_Sort";
+        snapshot.isRegexFilter = true;
+        snapshot.pivotKey.x = {.kind = DimensionKind::NamedArgument, .key = "threads"};
+        snapshot.pivotKey.group = {.kind = DimensionKind::Column, .index = 6};
+        snapshot.pivotKey.aggregation = Aggregation::Max;
+        snapshot.pivotKey.aggregateName = "median";
+        snapshot.plotViewport = {.xMin = 1, .xMax = 3, .yMin = -2, .yMax = 5, .isLogX = true};
+        snapshot.derivedMetrics = {{"IPC", "INSTRUCTIONS / CYCLES"}};
+        snapshot.memoryLimit = 123456;
+        return snapshot;
+    }
+
+    TemporaryDirectory directory;
+    std::filesystem::path source = directory / "run.json";
+    TaskScheduler scheduler{1};
+};
+
+TEST_F(SessionStoreTest, WritesAndReadsSnapshot)
+{
+    std::stringstream stream;
+    ASSERT_FALSE(writeSession(snapshot(), stream).has_error());
+
+    const auto read = readSession(stream);
+    ASSERT_FALSE(read.has_error()) << read.error();
+    EXPECT_EQ(read.value(), snapshot());
+}
+
+TEST_F(SessionStoreTest, RejectsTruncatedSnapshot)
+{
+    std::stringstream stream;
+    ASSERT_FALSE(writeSession(snapshot(), stream).has_error());
+    const auto data = stream.str();
+
+    std::stringstream truncated(data.substr(0, data.size() - 1));
+    EXPECT_TRUE(readSession(truncated).has_error());
+}
+
+TEST_F(SessionStoreTest, RejectsCorruptedLengthOfString)
+{
+    std::stringstream stream;
+    ASSERT_FALSE(writeSession(snapshot(), stream).has_error());
+    auto data = stream.str();
+
+    // Length of the source of the displayed run, after the header and its flag
+    data.replace(9, 4, "\xff\xff\xff\xff");
+    std::stringstream corrupted(data);
+    EXPECT_TRUE(readSession(corrupted).has_error());
+}
+
+TEST_F(SessionStoreTest, CacheKeyChangesWithTheSource)
+{
+    const auto key = runCacheKey(source);
+    EXPECT_FALSE(key.empty());
+    EXPECT_EQ(runCacheKey(source), key);
+
+    std::ofstream(source) << "{\"benchmarks\": []}";
+    EXPECT_NE(runCacheKey(source), key);
+    EXPECT_TRUE(runCacheKey(directory / "missing.json").empty());
+}
+
+TEST_F(SessionStoreTest, CacheKeyChangesWithTheShardsOfDirectory)
+{
+    const auto shards = directory / "shards";
+    std::filesystem::create_directories(shards);
+    std::ofstream(shards / "first.json") << "{}";
+    const auto key = runCacheKey(shards);
+    EXPECT_FALSE(key.empty());
+
+    // Rewriting a shard in place leaves the time of the directory as it was
+    const auto directoryTime = std::filesystem::last_write_time(shards);
+    std::ofstream(shards / "first.json") << "{\"benchmarks\": []}";
+    std::filesystem::last_write_time(shards, directoryTime);
+    EXPECT_NE(runCacheKey(shards), key);
+}
+
+TEST_F(SessionStoreTest, SavesInBackgroundAndRemovesUnreferencedCaches)
+{
+    const auto sessionDirectory = directory / "session";
+    SessionStore store(sessionDirectory, scheduler);
+    auto loaded = store.load();
+    ASSERT_FALSE(loaded.has_error()) << loaded.error();
+    EXPECT_FALSE(loaded.value());
+
+    BenchmarkResults results;
+    results.append({.name = "BM_Sort", .runName = "BM_Sort", .realTime = 10});
+    auto first = snapshot();
+    first.displayedRun->cacheKey = "first";
+    ASSERT_TRUE(store.save(first, {{"first", &results}}));
+    store.wait();
+    {
+        // The results are encoded by the background task
+        std::ifstream input(store.runCachePath("first"), std::ios::binary);
+        const auto cached = BenchmarkResults::readCache(input);
+        ASSERT_FALSE(cached.has_error()) << cached.error();
+        EXPECT_EQ(cached->size(), 1);
+    }
+
+    const auto second = snapshot();
+    ASSERT_TRUE(store.save(second, {{second.displayedRun->cacheKey, &results}}));
+    store.wait();
+    EXPECT_FALSE(store.isSaving());
+    EXPECT_FALSE(std::filesystem::exists(store.runCachePath("first")));
+    EXPECT_TRUE(std::filesystem::exists(store.runCachePath(second.displayedRun->cacheKey)));
+
+    loaded = SessionStore(sessionDirectory, scheduler).load();
+    ASSERT_FALSE(loaded.has_error()) << loaded.error();
+    ASSERT_TRUE(loaded.value());
+    EXPECT_EQ(*loaded.value(), second);
+}
+
+}// namespace
@@ -0,0 +1,113 @@
+#include "Table/RowSorter.hpp"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+using namespace BPlotter;
+
+constexpr auto REAL_TIME = static_cast<ColumnIndex>(BuiltinColumn::RealTime);
+constexpr auto NaN = std::numeric_limits<double>::quiet_NaN();
+
+class RowSorterTest : public ::testing::Test
+{
+protected:
+    void append(std::string_view name, double realTime, std::string_view aggregate = "")
+    {
+        BenchmarkRow row;
+        row.name = name;
+        row.runName = name;
+        row.runType = aggregate.empty() ? RunType::Iteration : RunType::Aggregate;
+        row.aggregateName = aggregate;
+        row.realTime = realTime;
+        results.append(row);
+    }
+
+    std::vector<std::uint32_t> order(const SortKey& key)
+    {
+        const auto rows = sorter.order(results, key);
+        return {rows.begin(), rows.end()};
+    }
+
+    BenchmarkResults results;
+    TaskScheduler scheduler{3};
+    RowSorter sorter{scheduler};
+};
+
+TEST_F(RowSorterTest, SortsNumericColumnWithMissingValuesLast)
+{
+    append("BM_A", 30);
+    append("BM_B", NaN);
+    append("BM_C", 10);
+    append("BM_D", 30);
+
+    const SortKey ascending{.kind = TableColumnKind::Numeric, .column = REAL_TIME};
+    EXPECT_EQ(order(ascending), (std::vector<std::uint32_t>{2, 0, 3, 1}));
+
+    auto descending = ascending;
+    descending.direction = SortDirection::Descending;
+    EXPECT_EQ(order(descending), (std::vector<std::uint32_t>{0, 3, 2, 1}));
+}
+
+TEST_F(RowSorterTest, SortsStringColumnsAlphabetically)
+{
+    append("BM_Sort/64", 1);
+    append("BM_Copy/8", 2, "mean");
+    append("BM_Sort/8", 3, "median");
+    append("BM_Copy/8", 4);
+
+    EXPECT_EQ(order({.kind = TableColumnKind::Name}), (std::vector<std::uint32_t>{1, 3, 0, 2}));
+    EXPECT_EQ(order({.kind = TableColumnKind::Aggregate}),
+              (std::vector<std::uint32_t>{0, 3, 1, 2}));
+}
+
+TEST_F(RowSorterTest, ParallelSortMatchesStableSort)
+{
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int> value(0, 1000);
+    for (int row = 0; row < 300000; ++row)
+    {
+        append("BM_Random", row % 97 == 0 ? NaN : value(random));
+    }
+
+    const auto column = results.column(REAL_TIME);
+    std::vector<std::uint32_t> expected(results.size());
+    std::iota(expected.begin(), expected.end(), 0u);
+    std::ranges::stable_sort(expected,
+                             [column](const std::uint32_t left, const std::uint32_t right)
+                             {
+                                 return !std::isnan(column[left]) &&
+                                        (std::isnan(column[right]) || column[left] < column[right]);
+                             });
+
+    EXPECT_EQ(order({.kind = TableColumnKind::Numeric, .column = REAL_TIME}), expected);
+}
+
+TEST_F(RowSorterTest, CachesPermutationsUntilRowsAreAppended)
+{
+    append("BM_B", 2);
+    append("BM_A", 1);
+
+    const SortKey byTime{.kind = TableColumnKind::Numeric, .column = REAL_TIME};
+    const auto* first = sorter.order(results, byTime).data();
+    EXPECT_EQ(sorter.order(results, {.kind = TableColumnKind::Name}).size(), 2u);
+    EXPECT_EQ(sorter.order(results, byTime).data(), first);
+
+    // Eviction keeps only the last used permutation
+    const auto before = sorter.memoryUsage();
+    EXPECT_LT(sorter.evict(), before);
+    EXPECT_EQ(sorter.order(results, byTime).data(), first);
+
+    append("BM_C", 0);
+    EXPECT_EQ(order(byTime), (std::vector<std::uint32_t>{2, 1, 0}));
+}
+
+}// namespace
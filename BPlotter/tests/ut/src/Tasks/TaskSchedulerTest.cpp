@@ -0,0 +1,194 @@
+#include "Tasks/TaskScheduler.hpp"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+
+using namespace BPlotter;
+
+TEST(TaskSchedulerTest, ReturnsTheResultsOfTheTasks)
+{
+    TaskScheduler scheduler(4);
+    std::vector<std::future<int>> futures;
+    for (auto i = 0; i < 100; ++i)
+    {
+        futures.push_back(scheduler.submit(TaskPriority::Interactive,
+                                           [i]
+                                           {
+                                               return i * i;
+                                           }));
+    }
+    for (auto i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(futures[i].get(), i * i);
+    }
+
+    auto failing = scheduler.submit(TaskPriority::Background,
+                                    []
+                                    {
+                                        throw std::runtime_error("failed");
+                                    });
+    EXPECT_THROW(failing.get(), std::runtime_error);
+}
+
+TEST(TaskSchedulerTest, StartsInteractiveTasksFirst)
+{
+    TaskScheduler scheduler(1);
+    std::promise<void> started;
+    std::promise<void> release;
+    auto blocker = scheduler.submit(TaskPriority::Interactive,
+                                    [&started, released = release.get_future()]
+                                    {
+                                        started.set_value();
+                                        released.wait();
+                                    });
+    started.get_future().wait();
+
+    std::vector<TaskPriority> order;
+    const auto record = [&order](const TaskPriority priority)
+    {
+        return [&order, priority]
+        {
+            order.push_back(priority);
+        };
+    };
+    auto background = scheduler.submit(TaskPriority::Background, record(TaskPriority::Background));
+    auto interactive =
+        scheduler.submit(TaskPriority::Interactive, record(TaskPriority::Interactive));
+    EXPECT_EQ(scheduler.statistics().queuedTasks[0], 1u);
+    EXPECT_EQ(scheduler.statistics().queuedTasks[1], 1u);
+
+    release.set_value();
+    background.get();
+    interactive.get();
+    EXPECT_EQ(order, (std::vector{TaskPriority::Interactive, TaskPriority::Background}));
+}
+
+TEST(TaskSchedulerTest, ParallelForVisitsEveryIndexOnce)
+{
+    TaskScheduler scheduler(3);
+    std::vector<std::atomic<int>> visits(1000);
+    EXPECT_TRUE(scheduler.parallelFor(visits.size(), 7,
+                                      [&visits](const std::size_t begin, const std::size_t end)
+                                      {
+                                          for (auto i = begin; i < end; ++i)
+                                          {
+                                              ++visits[i];
+                                          }
+                                      }));
+    for (const auto& visit: visits)
+    {
+        EXPECT_EQ(visit, 1);
+    }
+}
+
+TEST(TaskSchedulerTest, ParallelForInsideTaskDoesNotWaitForTheBusyThreads)
+{
+    // The only thread runs the outer task, so the calling thread has to run every chunk
+    TaskScheduler scheduler(1);
+    auto sum = scheduler.submit(TaskPriority::Interactive,
+                                [&scheduler]
+                                {
+                                    std::atomic<std::size_t> total{0};
+                                    scheduler.parallelFor(100, 1,
+                                                          [&total](const std::size_t begin,
+                                                                   const std::size_t end)
+                                                          {
+                                                              for (auto i = begin; i < end; ++i)
+                                                              {
+                                                                  total += i;
+                                                              }
+                                                          });
+                                    return total.load();
+                                });
+    EXPECT_EQ(sum.get(), 4950u);
+}
+
+TEST(TaskSchedulerTest, CancellationSkipsTheRemainingChunks)
+{
+    TaskScheduler scheduler(2);
+    CancellationSource source;
+    std::atomic<int> chunks{0};
+    const auto isFinished =
+        scheduler.parallelFor(10000, 1,
+                              [&source, &chunks](std::size_t, std::size_t)
+                              {
+                                  ++chunks;
+                                  source.cancel();
+                              },
+                              TaskPriority::Background, source.token());
+
+    EXPECT_FALSE(isFinished);
+    EXPECT_LT(chunks, 10000);
+    EXPECT_FALSE(CancellationToken().isCancelled());
+}
+
+TEST(TaskSchedulerTest, ParallelForRethrowsTheException)
+{
+    TaskScheduler scheduler(2);
+    EXPECT_THROW(scheduler.parallelFor(64, 1,
+                                       [](const std::size_t begin, std::size_t)
+                                       {
+                                           if (begin == 10)
+                                           {
+                                               throw std::runtime_error("failed");
+                                           }
+                                       }),
+                 std::runtime_error);
+}
+
+TEST(TaskSchedulerTest, RunsTheQueuedTasksBeforeStopping)
+{
+    std::atomic<int> executed{0};
+    {
+        TaskScheduler scheduler(2);
+        for (auto i = 0; i < 50; ++i)
+        {
+            static_cast<void>(scheduler.submit(TaskPriority::Background,
+                                               [&executed]
+                                               {
+                                                   ++executed;
+                                               }));
+        }
+    }
+    EXPECT_EQ(executed, 50);
+}
+
+TEST(TaskSchedulerTest, RunsTheTasksInTheAllocationScopeOfTheirSubmitter)
+{
+    TaskScheduler scheduler(2);
+    const auto subsystemOfTask = []
+    {
+        return currentAllocationSubsystem();
+    };
+    std::future<AllocationSubsystem> parsing;
+    {
+        AllocationScope scope(AllocationSubsystem::Parser);
+        parsing = scheduler.submit(TaskPriority::Background, subsystemOfTask);
+    }
+    EXPECT_EQ(parsing.get(), AllocationSubsystem::Parser);
+    EXPECT_EQ(scheduler.submit(TaskPriority::Background, subsystemOfTask).get(),
+              AllocationSubsystem::Other);
+
+    std::atomic<int> unscopedChunks{0};
+    {
+        AllocationScope scope(AllocationSubsystem::Statistics);
+        scheduler.parallelFor(64, 1,
+                              [&unscopedChunks](std::size_t, std::size_t)
+                              {
+                                  if (currentAllocationSubsystem() !=
+                                      AllocationSubsystem::Statistics)
+                                  {
+                                      ++unscopedChunks;
+                                  }
+                              });
+    }
+    EXPECT_EQ(unscopedChunks, 0);
+}
+
+}// namespace
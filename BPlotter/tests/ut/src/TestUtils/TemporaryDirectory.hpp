@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <system_error>
+
+namespace BPlotter
+{
+
+/**
+ * \brief Directory of a single test, created empty and removed with its content when the test
+ * ends.
+ *
+ * Its name is random for the process and counted within it, so neither the tests of one run nor
+ * the runs of several builds on the same machine share a directory.
+ */
+class TemporaryDirectory
+{
+public:
+    TemporaryDirectory()
+        : mPath(std::filesystem::temp_directory_path() / uniqueName())
+    {
+        std::filesystem::create_directories(mPath);
+    }
+
+    ~TemporaryDirectory()
+    {
+        std::error_code error;
+        std::filesystem::remove_all(mPath, error);
+    }
+
+    TemporaryDirectory(const TemporaryDirectory&) = delete;
+    TemporaryDirectory& operator=(const TemporaryDirectory&) = delete;
+
+    [[nodiscard]] const std::filesystem::path& path() const noexcept
+    {
+        return mPath;
+    }
+
+    /**
+     * \param name Name of a file or a directory inside, which is not created
+     * \return Path of the file or the directory
+     */
+    std::filesystem::path operator/(const std::filesystem::path& name) const
+    {
+        return mPath / name;
+    }
+
+private:
+    static std::string uniqueName()
+    {
+        static const auto processId = []
+        {
+            std::random_device random;
+            return (std::uint64_t{random()} << 32) | random();
+        }();
+        static std::atomic<std::uint64_t> counter = 0;
+        return "BPlotterTest-" + std::to_string(processId) + "-" + std::to_string(counter++);
+    }
+
+    std::filesystem::path mPath;
+};
+
+}// namespace BPlotter
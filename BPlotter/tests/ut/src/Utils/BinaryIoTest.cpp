@@ -0,0 +1,49 @@
+#include "Utils/BinaryIo.hpp"
+#include "gtest/gtest.h"
+
+#include <sstream>
+#include <string>
+
+namespace
+{
+
+using namespace BPlotter;
+
+TEST(BinaryIoTest, ReadsWrittenStrings)
+{
+    std::stringstream stream;
+    writeString(stream, "BM_Sort");
+    writeString(stream, std::string(2 * UNCHECKED_STRING_SIZE, 'x'));
+
+    auto text = std::string();
+    ASSERT_TRUE(readString(stream, text));
+    EXPECT_EQ(text, "BM_Sort");
+    ASSERT_TRUE(readString(stream, text));
+    EXPECT_EQ(text, std::string(2 * UNCHECKED_STRING_SIZE, 'x'));
+    EXPECT_FALSE(readString(stream, text));
+}
+
+TEST(BinaryIoTest, RejectsLengthBeyondEndOfStream)
+{
+    std::stringstream stream;
+    writeValue(stream, std::uint32_t{0xfffffff0});
+    stream << "BM_Sort";
+
+    auto text = std::string("previous");
+    EXPECT_FALSE(readString(stream, text));
+    EXPECT_TRUE(text.empty());
+    EXPECT_LT(text.capacity(), UNCHECKED_STRING_SIZE);
+}
+
+TEST(BinaryIoTest, RejectsTruncatedString)
+{
+    std::stringstream stream;
+    writeValue(stream, std::uint32_t{16});
+    stream << "BM_Sort";
+
+    auto text = std::string();
+    EXPECT_FALSE(readString(stream, text));
+    EXPECT_TRUE(text.empty());
+}
+
+}// namespace
@@ -0,0 +1,72 @@
+#include "Utils/FrameArena.hpp"
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace
+{
+
+using namespace BPlotter;
+
+TEST(FrameArenaTest, AllocatesAlignedMemory)
+{
+    FrameArena arena(1024);
+    const auto* byte = arena.allocate(1, 1);
+    const auto* value = arena.allocate(sizeof(double), alignof(double));
+    const auto* wide = arena.allocate(64, 64);
+
+    EXPECT_NE(byte, value);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(value) % alignof(double), 0u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(wide) % 64, 0u);
+    EXPECT_GE(arena.used(), 1 + sizeof(double) + 64);
+}
+
+TEST(FrameArenaTest, CopiesAndFormatsNullTerminatedText)
+{
+    FrameArena arena(64);
+    EXPECT_STREQ(arena.copy(std::string_view("BM_Sort/64").substr(0, 7)), "BM_Sort");
+    EXPECT_STREQ(arena.format("%.1f MiB", 12.25), "12.2 MiB");
+
+    // Longer than the whole chunk, so it is formatted again into a new one
+    const std::string longText(200, 'x');
+    EXPECT_EQ(std::string_view(arena.format("%s!", longText.c_str())), longText + "!");
+}
+
+TEST(FrameArenaTest, MergesChunksOnResetSoTheNextFrameFits)
+{
+    FrameArena arena(128);
+    for (int i = 0; i < 10; ++i)
+    {
+        static_cast<void>(arena.allocate(100, 8));
+    }
+    const auto grownCapacity = arena.capacity();
+    EXPECT_GT(grownCapacity, 128u);
+
+    arena.reset();
+    EXPECT_EQ(arena.used(), 0u);
+    EXPECT_EQ(arena.capacity(), grownCapacity);
+
+    // The same frame now fits the single chunk
+    for (int i = 0; i < 10; ++i)
+    {
+        static_cast<void>(arena.allocate(100, 8));
+    }
+    EXPECT_EQ(arena.capacity(), grownCapacity);
+}
+
+TEST(FrameArenaTest, BacksStandardContainers)
+{
+    FrameArena arena(256);
+    FrameVector<int> values{FrameAllocator<int>(arena)};
+    for (int i = 0; i < 1000; ++i)
+    {
+        values.push_back(i);
+    }
+    EXPECT_EQ(values.size(), 1000u);
+    EXPECT_EQ(values[999], 999);
+    EXPECT_GE(arena.used(), 1000 * sizeof(int));
+}
+
+}// namespace
@@ -0,0 +1,99 @@
+#include "Utils/NumberFormat.hpp"
+#include "gtest/gtest.h"
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <string_view>
+
+namespace
+{
+
+using namespace BPlotter;
+
+std::string format(const double value, const NumberFormat& format)
+{
+    std::array<char, NUMBER_BUFFER_SIZE> buffer{};
+    return std::string(formatNumber(value, format, buffer));
+}
+
+TEST(NumberFormatTest, WritesTheShortestRepresentationWithoutUnit)
+{
+    EXPECT_EQ(format(0.1, {}), "0.1");
+    EXPECT_EQ(format(1234567.0, {}), "1234567");
+    EXPECT_EQ(format(-2.5e-7, {}), "-2.5e-07");
+    EXPECT_EQ(format(0.1 + 0.2, {.precision = 6}), "0.3");
+}
+
+TEST(NumberFormatTest, ScalesTimesUpToSeconds)
+{
+    const NumberFormat time{.unit = Unit::Nanoseconds};
+    EXPECT_EQ(format(0, time), "0 ns");
+    EXPECT_EQ(format(999, time), "999 ns");
+    EXPECT_EQ(format(1500, time), "1.5 us");
+    EXPECT_EQ(format(2.25e6, time), "2.25 ms");
+    EXPECT_EQ(format(-3e9, time), "-3 s");
+    EXPECT_EQ(format(7.2e12, time), "7200 s");
+    EXPECT_EQ(format(1234.5678, {.unit = Unit::Nanoseconds, .precision = 3}), "1.23 us");
+}
+
+TEST(NumberFormatTest, ScalesBytesWithDecimalOrBinaryPrefixes)
+{
+    EXPECT_EQ(format(512, {.unit = Unit::Bytes}), "512 B");
+    EXPECT_EQ(format(1536, {.unit = Unit::Bytes}), "1.5 KiB");
+    EXPECT_EQ(format(3.0 * 1024 * 1024 * 1024, {.unit = Unit::BytesPerSecond}), "3 GiB/s");
+    EXPECT_EQ(format(1500, {.unit = Unit::Bytes, .prefixes = Prefixes::Decimal}), "1.5 kB");
+    EXPECT_EQ(format(2.5e6, {.unit = Unit::ItemsPerSecond}), "2.5M items/s");
+    EXPECT_EQ(format(12, {.unit = Unit::ItemsPerSecond}), "12 items/s");
+}
+
+TEST(NumberFormatTest, HandlesMissingValuesAndSmallBuffers)
+{
+    EXPECT_EQ(format(std::numeric_limits<double>::quiet_NaN(), {.unit = Unit::Nanoseconds}),
+              "nan");
+    EXPECT_EQ(format(-std::numeric_limits<double>::infinity(), {}), "-inf");
+
+    std::array<char, 4> small{};
+    const auto truncated = formatNumber(1500, {.unit = Unit::Nanoseconds}, small);
+    EXPECT_TRUE(truncated.empty());
+    ASSERT_NE(truncated.data(), nullptr);
+    EXPECT_EQ(*truncated.data(), '\0');
+    EXPECT_EQ(formatNumber(12, {}, small), "12");
+    EXPECT_EQ(small[2], '\0');
+
+    std::array<char, NUMBER_BUFFER_SIZE> buffer{};
+    const auto longest = formatNumber(-std::numeric_limits<double>::denorm_min(),
+                                      {.unit = Unit::ItemsPerSecond}, buffer);
+    EXPECT_FALSE(longest.empty());
+    EXPECT_LT(longest.size(), NUMBER_BUFFER_SIZE);
+}
+
+TEST(NumberFormatTest, GuessesTheUnitsOfTheBenchmarkColumns)
+{
+    EXPECT_EQ(formatOfColumn("real_time").unit, Unit::Nanoseconds);
+    EXPECT_EQ(formatOfColumn("cpu_time").unit, Unit::Nanoseconds);
+    EXPECT_EQ(formatOfColumn("bytes_per_second").unit, Unit::BytesPerSecond);
+    EXPECT_EQ(formatOfColumn("items_per_second").unit, Unit::ItemsPerSecond);
+    EXPECT_EQ(formatOfColumn("iterations").unit, Unit::None);
+}
+
+TEST(NumberFormatTest, CachesTheFormattedTexts)
+{
+    FormattedNumberCache cache;
+    const NumberFormat time{.unit = Unit::Nanoseconds};
+    const auto* first = cache.format(1500, time);
+    EXPECT_STREQ(first, "1.5 us");
+    EXPECT_EQ(cache.format(1500, time), first);
+    EXPECT_STREQ(cache.format(1500, {}), "1500");
+    EXPECT_EQ(cache.size(), 2u);
+
+    // Emptied once it gets too full, the texts are still right afterwards
+    for (auto i = 0; i < static_cast<int>(FormattedNumberCache::CAPACITY); ++i)
+    {
+        EXPECT_STREQ(cache.format(i, {}), std::to_string(i).c_str());
+    }
+    EXPECT_LT(cache.size(), FormattedNumberCache::CAPACITY);
+}
+
+}// namespace